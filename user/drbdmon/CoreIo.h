@@ -3,6 +3,7 @@
 
 #include <default_types.h>
 #include <terminal/MouseEvent.h>
+#include <StringView.h>
 
 class CoreIo
 {
@@ -13,7 +14,8 @@ class CoreIo
         EVENT_LINE      = 1,
         SIGNAL          = 2,
         STDIN           = 3,
-        WAKEUP          = 4
+        WAKEUP          = 4,
+        SERVER          = 5
     };
 
     enum class signal_type : uint32_t
@@ -33,14 +35,12 @@ class CoreIo
     // @throws std::bad_alloc, EventsIoException
     virtual event wait_event() = 0;
 
-    // Returns the current event line
+    // Returns the current batch of event lines and sets line_count to the number of lines
+    // in the batch, which is zero if no complete event lines are available.
+    // The returned lines remain valid until the next call of either wait_event()
+    // or get_event_lines().
     // @throws std::bad_alloc, EventsIoException
-    virtual std::string* get_event_line() = 0;
-
-    // Can be called optionally to free the current event line
-    // Otherwise, the current event line will be freed whenever the next
-    // event line is prepared, or upon destruction of the EventsIo instance
-    virtual void free_event_line() = 0;
+    virtual const StringView* get_event_lines(size_t& line_count) = 0;
 
     // @throws std::bad_alloc, EventsIoException
     virtual signal_type get_signal() = 0;
@@ -17,6 +17,7 @@ extern "C"
 #include <integerparse.h>
 #include <utils.h>
 #include <comparators.h>
+#include <timestamps.h>
 #include <DrbdMon.h>
 #include <DrbdMonConsts.h>
 #include <CoreIo.h>
@@ -35,32 +36,26 @@ const std::string DrbdMon::OPT_HELP_KEY = "help";
 const std::string DrbdMon::OPT_VERSION_KEY = "version";
 const std::string DrbdMon::OPT_FREQ_LMT_KEY = "freqlmt";
 const std::string DrbdMon::OPT_EVENTS_LOG_KEY = "events-log";
+const std::string DrbdMon::OPT_EVENTS_SEEK_KEY = "events-log-seek";
+const std::string DrbdMon::OPT_EVENTS_SPEED_KEY = "events-log-speed";
+const std::string DrbdMon::OPT_PIPELINE_KEY = "pipeline";
+const std::string DrbdMon::OPT_SERVER_KEY = "server";
 const ConfigOption DrbdMon::OPT_HELP(true, OPT_HELP_KEY);
 const ConfigOption DrbdMon::OPT_VERSION(true, OPT_VERSION_KEY);
 const ConfigOption DrbdMon::OPT_FREQ_LMT(false, OPT_FREQ_LMT_KEY);
 const ConfigOption DrbdMon::OPT_EVENTS_LOG(false, OPT_EVENTS_LOG_KEY);
+const ConfigOption DrbdMon::OPT_EVENTS_SEEK(false, OPT_EVENTS_SEEK_KEY);
+const ConfigOption DrbdMon::OPT_EVENTS_SPEED(false, OPT_EVENTS_SPEED_KEY);
+const ConfigOption DrbdMon::OPT_PIPELINE(true, OPT_PIPELINE_KEY);
+const ConfigOption DrbdMon::OPT_SERVER(false, OPT_SERVER_KEY);
 
 const std::string DrbdMon::UNIT_SFX_SECONDS = "s";
 const std::string DrbdMon::UNIT_SFX_MILLISECONDS = "ms";
 const uint16_t DrbdMon::MAX_INTERVAL = 10000;
 const uint16_t DrbdMon::DFLT_INTERVAL = 40;
 
-const std::string DrbdMon::TOKEN_DELIMITER = " ";
-
 const char DrbdMon::DEBUG_SEQ_PFX = '~';
 
-const std::string DrbdMon::MODE_EXISTS  = "exists";
-const std::string DrbdMon::MODE_CREATE  = "create";
-const std::string DrbdMon::MODE_CHANGE  = "change";
-const std::string DrbdMon::MODE_RENAME  = "rename";
-const std::string DrbdMon::MODE_DESTROY = "destroy";
-
-const std::string DrbdMon::TYPE_RESOURCE    = "resource";
-const std::string DrbdMon::TYPE_CONNECTION  = "connection";
-const std::string DrbdMon::TYPE_DEVICE      = "device";
-const std::string DrbdMon::TYPE_PEER_DEVICE = "peer-device";
-const std::string DrbdMon::TYPE_SEPARATOR   = "-";
-
 static bool string_ends_with(const std::string& text, const std::string& suffix);
 
 // @throws std::bad_alloc
@@ -95,12 +90,18 @@ SystemApi& DrbdMon::get_system_api() const noexcept
 // @throws std::bad_alloc
 void DrbdMon::run()
 {
-    std::unique_ptr<PropsMap>               event_props;
+    std::unique_ptr<EventProps>             event_props;
+    std::unique_ptr<EventProps>             next_event_props;
     std::unique_ptr<EventsSourceSpawner>    events_source;
     std::unique_ptr<EventsIo>               events_io;
     std::unique_ptr<MessageLogNotification> msg_log_notifier;
     std::unique_ptr<SubProcessNotification> sub_proc_notifier;
     std::unique_ptr<GenericDisplay>         display;
+    // Pipeline mode only, must be destroyed before the events_io instance
+    std::unique_ptr<EventsQueue>            events_queue;
+    std::unique_ptr<EventsReader>           events_reader;
+    // Reused for each event line to avoid per-line allocations
+    std::string                             event_line_buffer;
 
     try
     {
@@ -113,20 +114,55 @@ void DrbdMon::run()
             );
             timer_available = config.dsp_interval != 0;
             timer_armed = false;
+            refresh_sched_mgr = std::unique_ptr<RefreshScheduler>(new RefreshScheduler(MAX_INTERVAL));
+            refresh_sched = refresh_sched_mgr.get();
+            refresh_sched->set_frame_budget(bounds<uint16_t>(0, config.dsp_interval, MAX_INTERVAL));
 
             configurables = std::unique_ptr<Configurable*[]>(new Configurable*[2]);
             configurables[0] = dynamic_cast<Configurable*> (this);
             configurables[1] = nullptr;
             configure_options();
 
-            event_props   = std::unique_ptr<PropsMap>(new PropsMap(&comparators::compare_string));
+            event_props   = std::unique_ptr<EventProps>(new EventProps());
+            next_event_props = std::unique_ptr<EventProps>(new EventProps());
 
             events_source = std::unique_ptr<EventsSourceSpawner>(new EventsSourceSpawner(log));
 
-            events_source->spawn_source(&(mon_env.events_file_path));
-            events_io = std::unique_ptr<EventsIo>(
-                new EventsIo(events_source->get_events_out_fd(), events_source->get_events_err_fd())
+            // In headless mode, the DRBD state is served to clients instead of being displayed
+            const bool headless = !mon_env.server_socket_path.empty();
+
+            events_source->spawn_source(
+                &(mon_env.events_file_path),
+                &(mon_env.events_seek_time),
+                &(mon_env.events_replay_speed)
             );
+            if (pipeline_mode)
+            {
+                // The events channel is read by the EventsReader instance instead of EventsIo
+                events_io = std::unique_ptr<EventsIo>(
+                    new EventsIo(-1, events_source->get_events_err_fd(), !headless)
+                );
+                events_queue = std::unique_ptr<EventsQueue>(new EventsQueue());
+                events_reader = std::unique_ptr<EventsReader>(
+                    new EventsReader(
+                        events_source->get_events_out_fd(),
+                        *events_queue,
+                        dynamic_cast<EventsIoWakeup*> (events_io.get())
+                    )
+                );
+                // EventsIo blocks the signals it handles, which is inherited by the reader thread
+                events_reader->start();
+            }
+            else
+            {
+                events_io = std::unique_ptr<EventsIo>(
+                    new EventsIo(
+                        events_source->get_events_out_fd(),
+                        events_source->get_events_err_fd(),
+                        !headless
+                    )
+                );
+            }
 
             msg_log_notifier = std::unique_ptr<MessageLogNotification>(
                 new MessageLogNotification(log, dynamic_cast<EventsIoWakeup*> (events_io.get()))
@@ -140,27 +176,39 @@ void DrbdMon::run()
             // because SIGCHLD is blocked during reinitialization
             events_source->cleanup_child_processes();
 
-            // Create the display and keep a pointer of the implementation's type for later use
-            // as a configurable object
-            // Do not add anything that might throw between display_impl allocation and
-            // display interface unique_ptr initialization to ensure deallocation of the display
-            // object if the current scope is left
-            DisplayController* display_impl = nullptr;
+            if (headless)
+            {
+                std::unique_ptr<StateServer> server(
+                    new StateServer(mon_env.server_socket_path, *rsc_dir, log)
+                );
+                events_io->register_server(server->get_poll_fd());
+                state_server = server.get();
+                display = std::unique_ptr<GenericDisplay>(dynamic_cast<GenericDisplay*> (server.release()));
+            }
+            else
             {
+                // Create the display and keep a pointer of the implementation's type for later use
+                // as a configurable object
+                // Do not add anything that might throw between display_impl allocation and
+                // display interface unique_ptr initialization to ensure deallocation of the display
+                // object if the current scope is left
+                DisplayController* display_impl = nullptr;
                 DrbdMonCore* const core_instance    = dynamic_cast<DrbdMonCore*> (this);
                 SubProcessObserver* const sub_proc_obs = dynamic_cast<SubProcessObserver*> (sub_proc_notifier.get());
                 ResourcesMap& rsc_map               = rsc_dir->get_resources_map();
                 ResourcesMap& prb_rsc_map           = rsc_dir->get_problem_resources_map();
+                ResourcesMap& flt_rsc_map           = rsc_dir->get_filtered_resources_map();
                 display_impl = new DisplayController(
                     *core_instance,
                     mon_env,
                     *sub_proc_obs,
                     rsc_map,
-                    prb_rsc_map
+                    prb_rsc_map,
+                    flt_rsc_map
                 );
-            }
 
-            display = std::unique_ptr<GenericDisplay>(dynamic_cast<GenericDisplay*> (display_impl));
+                display = std::unique_ptr<GenericDisplay>(dynamic_cast<GenericDisplay*> (display_impl));
+            }
             display->initialize();
 
             // Show an initial display while reading the initial DRBD status
@@ -173,53 +221,76 @@ void DrbdMon::run()
                 {
                     case EventsIo::event::EVENT_LINE:
                     {
-                        std::string* event_line = events_io->get_event_line();
-                        if (event_line != nullptr)
+                        size_t line_count {0};
+                        const StringView* line_batch = events_io->get_event_lines(line_count);
+                        if (line_count > 0)
                         {
-                            uint32_t update_counter {0};
-                            while (event_line != nullptr)
+                            // Only one batch is applied per wait_event() call, so that signals, keys,
+                            // timers and wakeups are not starved while events keep arriving.
+                            // Consecutive 'change' events for the same object are merged and applied
+                            // as one event, the last event's values take precedence
+                            const StringView* pending_line = nullptr;
+                            for (size_t line_idx = 0; line_idx < line_count; ++line_idx)
                             {
-                                tokenize_event_message(display.get(), *event_line, *event_props);
-                                events_io->free_event_line();
-                                clear_event_props(*event_props);
-                                event_line = events_io->get_event_line();
-                                if (have_initial_state)
+                                const StringView& next_line = line_batch[line_idx];
+                                bool have_event = false;
+                                try
+                                {
+                                    have_event = tokenize_event_message(next_line, *next_event_props);
+                                }
+                                catch (EventMessageException&)
+                                {
+                                    // Apply the events preceding the malformed event line
+                                    // before reporting the error
+                                    if (pending_line != nullptr)
+                                    {
+                                        apply_event_message(
+                                            display.get(), *pending_line, *event_props, event_line_buffer
+                                        );
+                                    }
+                                    throw;
+                                }
+                                if (have_event)
                                 {
-                                    if (update_counter >= MAX_EVENT_BUNDLE)
+                                    if (pending_line != nullptr)
                                     {
-                                        if (timer_available)
+                                        if (is_coalescable(*pending_line, *event_props, *next_event_props))
                                         {
-                                            cond_display_update(display.get());
+                                            next_event_props->merge_preceding(*event_props);
                                         }
                                         else
                                         {
-                                            display->notify_drbd_changed();
+                                            apply_event_message(
+                                                display.get(), *pending_line, *event_props, event_line_buffer
+                                            );
                                         }
-                                        update_counter = 0;
-                                    }
-                                    else
-                                    {
-                                        ++update_counter;
                                     }
+                                    event_props.swap(next_event_props);
+                                    pending_line = &next_line;
                                 }
                             }
-                        }
-                        else
-                        {
-                            std::string debug_info("EventsIo::get_event_line() returned nullptr");
-                            throw EventMessageException(nullptr, &debug_info, nullptr);
-                        }
-                        if (have_initial_state)
-                        {
-                            if (timer_available)
+                            if (pending_line != nullptr)
                             {
-                                cond_display_update(display.get());
+                                apply_event_message(
+                                    display.get(), *pending_line, *event_props, event_line_buffer
+                                );
                             }
-                            else
+                            event_props->clear();
+                            next_event_props->clear();
+                            rsc_dir->update_resource_maps();
+
+                            // Decide on display updates once per batch rather than once per line
+                            if (have_initial_state)
                             {
-                                display->notify_drbd_changed();
+                                refresh_sched->events_applied(line_count);
+                                cond_display_update(display.get());
                             }
                         }
+                        else
+                        {
+                            std::string debug_info("EventsIo::get_event_lines() returned an empty batch");
+                            throw EventMessageException(nullptr, &debug_info, nullptr);
+                        }
                         break;
                     }
                     case EventsIo::event::SIGNAL:
@@ -254,9 +325,8 @@ void DrbdMon::run()
                             }
                             case CoreIo::signal_type::SIGNAL_TIMER:
                             {
-                                display->notify_drbd_changed();
-                                update_timestamp();
                                 timer_armed = false;
+                                timed_display_update(display.get());
                                 break;
                             }
                             case CoreIo::signal_type::SIGNAL_GENERIC:
@@ -313,6 +383,34 @@ void DrbdMon::run()
                             display->notify_message_log_changed();
                         }
 
+                        if (events_reader != nullptr)
+                        {
+                            // Check for a failure of the reader thread before applying the queued
+                            // events, so that all events that were read before the failure are
+                            // applied before the failure is reported
+                            const bool reader_failed = events_reader->is_failed();
+                            const size_t record_count = apply_queued_events(
+                                display.get(), *events_queue, *event_props, event_line_buffer
+                            );
+                            if (reader_failed)
+                            {
+                                events_reader->check_failure();
+                            }
+                            if (record_count > 0 && have_initial_state)
+                            {
+                                refresh_sched->events_applied(record_count);
+                                cond_display_update(display.get());
+                            }
+                        }
+
+                        break;
+                    }
+                    case EventsIo::event::SERVER:
+                    {
+                        if (state_server != nullptr)
+                        {
+                            state_server->process_io();
+                        }
                         break;
                     }
                     case EventsIo::event::NONE:
@@ -454,51 +552,176 @@ void DrbdMon::shutdown(const DrbdMonCore::finish_action action) noexcept
     shutdown_flag = true;
 }
 
-// @throws std::bad_alloc, EventsMessageException, EventObjectException
-void DrbdMon::tokenize_event_message(GenericDisplay* const display_ptr, std::string& event_line, PropsMap& event_props)
+// @throws std::bad_alloc, EventMessageException
+bool DrbdMon::tokenize_event_message(const StringView& event_line, EventProps& event_props)
+{
+    bool have_event = false;
+    try
+    {
+        have_event = event_props.parse(event_line);
+    }
+    catch (EventMessageException& event_exc)
+    {
+        complete_event_exception(event_exc, event_line);
+        throw;
+    }
+    return have_event;
+}
+
+// @throws std::bad_alloc, EventMessageException, EventObjectException
+void DrbdMon::apply_event_message(
+    GenericDisplay* const display_ptr,
+    const StringView& event_line,
+    EventProps& event_props,
+    std::string& line_buffer
+)
 {
     try
     {
-        StringTokenizer tokens(event_line, TOKEN_DELIMITER);
-        if (tokens.has_next())
+        event_line.assign_to(line_buffer);
+        process_event_message(
+            display_ptr, event_props.get_mode_id(), event_props.get_type_id(), event_props, line_buffer
+        );
+    }
+    catch (EventMessageException& event_exc)
+    {
+        complete_event_exception(event_exc, event_line);
+        throw;
+    }
+}
+
+// @throws std::bad_alloc, EventMessageException, EventObjectException
+size_t DrbdMon::apply_queued_events(
+    GenericDisplay* const display_ptr,
+    EventsQueue& queue,
+    EventProps& parse_props,
+    std::string& line_buffer
+)
+{
+    // Records that are published after this point cause another wakeup
+    queue.begin_drain();
+
+    // Consecutive 'change' events for the same object are merged and applied
+    // as one event, the last event's values take precedence
+    const size_t record_count = queue.get_available();
+    EventsQueue::event_record* pending_record = nullptr;
+    for (size_t record_idx = 0; record_idx < record_count; ++record_idx)
+    {
+        EventsQueue::event_record& next_record = queue.peek(record_idx);
+        if (next_record.parse_failed)
         {
-            std::string event_mode = tokens.next();
-            if (tokens.has_next())
+            // Apply the events preceding the malformed event line before reporting the error
+            if (pending_record != nullptr)
             {
-                std::string event_type = tokens.next();
-                parse_event_props(tokens, event_props, event_line);
-
-                process_event_message(display_ptr, event_mode, event_type, event_props, event_line);
+                apply_event_message(
+                    display_ptr, StringView(pending_record->event_line), pending_record->event_props, line_buffer
+                );
+                pending_record = nullptr;
             }
+            // Parse the event line again to throw the EventMessageException on this thread
+            static_cast<void> (tokenize_event_message(StringView(next_record.event_line), parse_props));
+        }
+        else
+        if (next_record.have_event)
+        {
+            if (pending_record != nullptr)
+            {
+                if (is_coalescable(
+                    StringView(pending_record->event_line), pending_record->event_props, next_record.event_props
+                ))
+                {
+                    // The merged values refer to the pending record, which is released together with
+                    // the next record
+                    next_record.event_props.merge_preceding(pending_record->event_props);
+                }
+                else
+                {
+                    apply_event_message(
+                        display_ptr, StringView(pending_record->event_line), pending_record->event_props, line_buffer
+                    );
+                }
+            }
+            pending_record = &next_record;
         }
     }
-    catch (EventMessageException& event_exc)
+    if (pending_record != nullptr)
     {
-        // Update information for the debug log
-        if (event_exc.get_debug_info() == nullptr)
+        apply_event_message(
+            display_ptr, StringView(pending_record->event_line), pending_record->event_props, line_buffer
+        );
+    }
+    rsc_dir->update_resource_maps();
+    queue.release(record_count);
+
+    return record_count;
+}
+
+// @throws std::bad_alloc, EventMessageException
+bool DrbdMon::is_coalescable(
+    const StringView& pending_line,
+    EventProps& pending_props,
+    EventProps& next_props
+)
+{
+    bool coalescable = next_props.is_same_object_change(pending_props);
+    if (coalescable)
+    {
+        try
         {
-            std::string debug_info("Event line caused an EventMessageException (no debug information available)");
-            event_exc.set_debug_info(&debug_info);
+            // Some properties affect an object's state beyond setting the property's value,
+            // events that set such properties must be applied before the next event
+            const EventKeywords::keyword event_type = pending_props.get_type_id();
+            if (event_type == EventKeywords::keyword::TYPE_CONNECTION)
+            {
+                coalescable = !DrbdConnection::has_transition_effects(pending_props, next_props);
+            }
+            else
+            if (event_type == EventKeywords::keyword::TYPE_DEVICE ||
+                event_type == EventKeywords::keyword::TYPE_PEER_DEVICE)
+            {
+                coalescable = !DrbdVolume::has_transition_effects(pending_props, next_props);
+            }
         }
-        if (event_exc.get_event_line() == nullptr)
+        catch (EventMessageException& event_exc)
         {
-            event_exc.set_event_line(&event_line);
+            complete_event_exception(event_exc, pending_line);
+            throw;
         }
-        throw;
+    }
+    return coalescable;
+}
+
+// Adds the event line and missing debug information to an EventMessageException
+// @throws std::bad_alloc
+void DrbdMon::complete_event_exception(EventMessageException& event_exc, const StringView& event_line)
+{
+    if (event_exc.get_debug_info() == nullptr)
+    {
+        std::string debug_info("Event line caused an EventMessageException (no debug information available)");
+        event_exc.set_debug_info(&debug_info);
+    }
+    if (event_exc.get_event_line() == nullptr)
+    {
+        const std::string event_line_copy(event_line.to_string());
+        event_exc.set_event_line(&event_line_copy);
     }
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
 void DrbdMon::process_event_message(
     GenericDisplay* const display,
-    std::string& event_mode,
-    std::string& event_type,
-    PropsMap& event_props,
+    const EventKeywords::keyword event_mode,
+    const EventKeywords::keyword event_type,
+    EventProps& event_props,
     std::string& event_line
 )
 {
-    bool is_exists_event = event_mode == MODE_EXISTS;
-    if (is_exists_event || event_mode == MODE_CREATE)
+    // Changes are reported only after the initial state has been received
+    const bool report_changes = have_initial_state && state_server != nullptr;
+    const uint64_t prev_change_seq = rsc_dir->get_change_seq();
+
+    bool is_exists_event = event_mode == EventKeywords::keyword::MODE_EXISTS;
+    if (is_exists_event || event_mode == EventKeywords::keyword::MODE_CREATE)
     {
         if (is_exists_event)
         {
@@ -521,27 +744,27 @@ void DrbdMon::process_event_message(
             }
         }
 
-        if (event_type == TYPE_CONNECTION)
+        if (event_type == EventKeywords::keyword::TYPE_CONNECTION)
         {
             rsc_dir->create_connection(event_props, event_line);
         }
         else
-        if (event_type == TYPE_DEVICE)
+        if (event_type == EventKeywords::keyword::TYPE_DEVICE)
         {
             rsc_dir->create_device(event_props, event_line);
         }
         else
-        if (event_type == TYPE_PEER_DEVICE)
+        if (event_type == EventKeywords::keyword::TYPE_PEER_DEVICE)
         {
             rsc_dir->create_peer_device(event_props, event_line);
         }
         else
-        if (event_type == TYPE_RESOURCE)
+        if (event_type == EventKeywords::keyword::TYPE_RESOURCE)
         {
             rsc_dir->create_resource(event_props, event_line);
         }
         else
-        if (event_type == TYPE_SEPARATOR && event_mode == MODE_EXISTS)
+        if (event_type == EventKeywords::keyword::TYPE_SEPARATOR && event_mode == EventKeywords::keyword::MODE_EXISTS)
         {
             // "exists -" line from drbdsetup
             // Report recovering from errors that triggered reinitialization
@@ -583,6 +806,7 @@ void DrbdMon::process_event_message(
             // Indicate that the initial state is available now
             // (This can be used to disable display updates until an initial state is available)
             have_initial_state = true;
+            rsc_dir->update_resource_maps();
             display->exit_initial_display();
 
             // In case that multiple "exists -" lines are received,
@@ -592,7 +816,7 @@ void DrbdMon::process_event_message(
         }
     }
     else
-    if (event_mode == MODE_CHANGE)
+    if (event_mode == EventKeywords::keyword::MODE_CHANGE)
     {
         if (!have_initial_state)
         {
@@ -603,29 +827,29 @@ void DrbdMon::process_event_message(
             throw EventMessageException(&error_msg, &debug_info, &event_line);
         }
 
-        if (event_type == TYPE_CONNECTION)
+        if (event_type == EventKeywords::keyword::TYPE_CONNECTION)
         {
             rsc_dir->update_connection(event_props, event_line);
         }
         else
-        if (event_type == TYPE_DEVICE)
+        if (event_type == EventKeywords::keyword::TYPE_DEVICE)
         {
             rsc_dir->update_device(event_props, event_line);
         }
         else
-        if (event_type == TYPE_PEER_DEVICE)
+        if (event_type == EventKeywords::keyword::TYPE_PEER_DEVICE)
         {
             rsc_dir->update_peer_device(event_props, event_line);
         }
         else
-        if (event_type == TYPE_RESOURCE)
+        if (event_type == EventKeywords::keyword::TYPE_RESOURCE)
         {
             rsc_dir->update_resource(event_props, event_line);
         }
         // unknown object types are skipped
     }
     else
-    if (event_mode == MODE_RENAME)
+    if (event_mode == EventKeywords::keyword::MODE_RENAME)
     {
         if (!have_initial_state)
         {
@@ -635,7 +859,7 @@ void DrbdMon::process_event_message(
             throw EventMessageException(&error_msg, &debug_info, &event_line);
         }
 
-        if (event_type == TYPE_RESOURCE)
+        if (event_type == EventKeywords::keyword::TYPE_RESOURCE)
         {
             rsc_dir->rename_resource(event_props, event_line);
         }
@@ -648,7 +872,7 @@ void DrbdMon::process_event_message(
         }
     }
     else
-    if (event_mode == MODE_DESTROY)
+    if (event_mode == EventKeywords::keyword::MODE_DESTROY)
     {
         if (!have_initial_state)
         {
@@ -658,28 +882,33 @@ void DrbdMon::process_event_message(
             throw EventMessageException(&error_msg, &debug_info, &event_line);
         }
 
-        if (event_type == TYPE_CONNECTION)
+        if (event_type == EventKeywords::keyword::TYPE_CONNECTION)
         {
             rsc_dir->destroy_connection(event_props, event_line);
         }
         else
-        if (event_type == TYPE_DEVICE)
+        if (event_type == EventKeywords::keyword::TYPE_DEVICE)
         {
             rsc_dir->destroy_device(event_props, event_line);
         }
         else
-        if (event_type == TYPE_PEER_DEVICE)
+        if (event_type == EventKeywords::keyword::TYPE_PEER_DEVICE)
         {
             rsc_dir->destroy_peer_device(event_props, event_line);
         }
         else
-        if (event_type == TYPE_RESOURCE)
+        if (event_type == EventKeywords::keyword::TYPE_RESOURCE)
         {
             rsc_dir->destroy_resource(event_props, event_line);
         }
         // unknown object types are skipped
     }
     // unknown message modes are skipped
+
+    if (report_changes && rsc_dir->get_change_seq() != prev_change_seq)
+    {
+        state_server->event_applied(event_props, event_line);
+    }
 }
 
 /**
@@ -691,73 +920,16 @@ DrbdMonCore::finish_action DrbdMon::get_fin_action() const
     return mon_env.fin_action;
 }
 
-/**
- *  Loads the event_props map with the properties contained in tokens
- *
- * @param: tokens StringTokenizer that returns the 'key:value' tokens from a 'drbdsetup event2' line
- * @param: event_props Property map to load the key == value mappings into
- */
-// @throws std::bad_alloc, EventMessageException
-void DrbdMon::parse_event_props(StringTokenizer& tokens, PropsMap& event_props, std::string& event_line)
-{
-    while (tokens.has_next())
-    {
-        std::string prop_entry = tokens.next();
-
-        size_t split_index = prop_entry.find(":");
-        if (split_index != std::string::npos)
-        {
-            std::unique_ptr<std::string> key(new std::string(prop_entry, 0, split_index));
-            ++split_index;
-            std::unique_ptr<std::string> value(
-                new std::string(prop_entry, split_index, prop_entry.length() - split_index)
-            );
-            try
-            {
-                event_props.insert(key.get(), value.get());
-                static_cast<void> (key.release());
-                static_cast<void> (value.release());
-            }
-            catch (dsaext::DuplicateInsertException& dup_exc)
-            {
-                // Duplicate key, malformed event line
-                std::string error_msg("Received an events line with a duplicate key");
-
-                std::string debug_info("Duplicate key ");
-                debug_info += *(key.get());
-                debug_info += " on event line";
-
-                throw EventMessageException(&error_msg, &debug_info, &event_line);
-            }
-        }
-    }
-}
-
-/**
- * Clears the event_props map and frees all its entries
- */
-void DrbdMon::clear_event_props(PropsMap& event_props)
-{
-    PropsMap::NodesIterator clear_iter(event_props);
-    while (clear_iter.has_next())
-    {
-        PropsMap::Node* node = clear_iter.next();
-        delete node->get_key();
-        delete node->get_value();
-    }
-    event_props.clear();
-}
-
 // Frees resources
 // @throws std::bad_alloc
 void DrbdMon::cleanup(
-    PropsMap*               event_props,
+    EventProps*             event_props,
     EventsIo*               events_io
 )
 {
     if (event_props != nullptr)
     {
-        clear_event_props(*event_props);
+        event_props->clear();
     }
 }
 
@@ -883,6 +1055,10 @@ void DrbdMon::announce_options(Configurator& collector)
     collector.add_config_option(owner, OPT_VERSION);
     collector.add_config_option(owner, OPT_FREQ_LMT);
     collector.add_config_option(owner, OPT_EVENTS_LOG);
+    collector.add_config_option(owner, OPT_EVENTS_SEEK);
+    collector.add_config_option(owner, OPT_EVENTS_SPEED);
+    collector.add_config_option(owner, OPT_PIPELINE);
+    collector.add_config_option(owner, OPT_SERVER);
 }
 
 void DrbdMon::options_help() noexcept
@@ -892,6 +1068,15 @@ void DrbdMon::options_help() noexcept
     std::cerr << "  --version        Display version information\n";
     std::cerr << "  --help           Display help\n";
     std::cerr << "  --events-log <file>      Display the DRBD state saved in the specified file\n";
+    std::cerr << "  --events-log-seek <time> Display the saved DRBD state at the specified time\n";
+    std::cerr << "    <time>                 Timestamp in the events file, may be abbreviated,\n";
+    std::cerr << "                           e.g. 2024-03-01T14:20, local time if there is no\n";
+    std::cerr << "                           UTC offset\n";
+    std::cerr << "  --events-log-speed <factor>\n";
+    std::cerr << "                           Replay the saved DRBD events faster by the specified factor\n";
+    std::cerr << "  --pipeline               Read DRBD events on a separate thread\n";
+    std::cerr << "  --server <socket>        Run without a terminal and serve the DRBD state to local\n";
+    std::cerr << "                           clients through the specified UNIX domain socket\n";
     std::cerr << "  --freqlmt <interval>     Set a frequency limit for display updates\n";
     std::cerr << "    <interval>             Minimum delay between display updates [integer]\n";
     std::cerr << "    Supported unit suffixes: s (seconds), ms (milliseconds)\n";
@@ -931,6 +1116,11 @@ void DrbdMon::set_flag(const std::string& key)
                      " (" << DrbdMonConsts::BUILD_HASH << ")" << std::endl;
         throw ConfigurationException();
     }
+    else
+    if (key == OPT_PIPELINE.key)
+    {
+        pipeline_mode = true;
+    }
 }
 
 // @throws std::bad_alloc, ConfigurationException
@@ -976,7 +1166,7 @@ void DrbdMon::set_option(const std::string& key, const std::string& value)
             interval *= factor;
             if (interval > 0)
             {
-                interval_timer_mgr->set_interval(interval);
+                refresh_sched->set_frame_budget(interval);
             }
         }
         catch (dsaext::NumberFormatException&)
@@ -994,6 +1184,43 @@ void DrbdMon::set_option(const std::string& key, const std::string& value)
     {
         mon_env.events_file_path = value;
     }
+    else
+    if (key == OPT_SERVER.key)
+    {
+        mon_env.server_socket_path = value;
+        mon_env.headless = true;
+    }
+    else
+    if (key == OPT_EVENTS_SEEK.key)
+    {
+        int64_t seek_usecs = 0;
+        if (!timestamps::parse_timestamp(value, seek_usecs))
+        {
+            std::string error_message("Invalid time ");
+            error_message += value;
+            error_message += " for configuration option ";
+            error_message += OPT_EVENTS_SEEK.key;
+            log.add_entry(MessageLog::log_level::ALERT, error_message);
+            throw ConfigurationException();
+        }
+        mon_env.events_seek_time = value;
+    }
+    else
+    if (key == OPT_EVENTS_SPEED.key)
+    {
+        char* parse_end = nullptr;
+        const double speed = std::strtod(value.c_str(), &parse_end);
+        if (parse_end == value.c_str() || *parse_end != '\0' || !(speed > 0))
+        {
+            std::string error_message("Invalid replay speed factor ");
+            error_message += value;
+            error_message += " for configuration option ";
+            error_message += OPT_EVENTS_SPEED.key;
+            log.add_entry(MessageLog::log_level::ALERT, error_message);
+            throw ConfigurationException();
+        }
+        mon_env.events_replay_speed = value;
+    }
 }
 
 uint32_t DrbdMon::get_problem_count() const noexcept
@@ -1001,17 +1228,43 @@ uint32_t DrbdMon::get_problem_count() const noexcept
     return rsc_dir->get_problem_count();
 }
 
+uint64_t DrbdMon::get_drbd_change_seq() const noexcept
+{
+    return rsc_dir->get_change_seq();
+}
+
+bool DrbdMon::is_resource_changed_since(
+    const NameTable::handle rsc_name_handle,
+    const uint64_t          since_seq
+) const noexcept
+{
+    return rsc_dir->is_resource_changed_since(rsc_name_handle, since_seq);
+}
+
+const RefreshScheduler& DrbdMon::get_refresh_scheduler() const noexcept
+{
+    return *refresh_sched;
+}
+
+// @throws std::bad_alloc
+void DrbdMon::set_resource_filter(std::unique_ptr<ResourceFilter> filter)
+{
+    rsc_dir->set_resource_filter(std::move(filter));
+}
+
+const ResourceFilter* DrbdMon::get_resource_filter() const noexcept
+{
+    return rsc_dir->get_resource_filter();
+}
+
 void DrbdMon::notify_config_changed()
 {
     // Apply interval timer change
-    if (interval_timer_mgr != nullptr)
+    if (interval_timer_mgr != nullptr && refresh_sched != nullptr)
     {
         const uint16_t dsp_interval = config.dsp_interval;
         timer_available = dsp_interval != 0;
-        if (timer_available)
-        {
-            interval_timer_mgr->set_interval(bounds<uint16_t>(0, dsp_interval, MAX_INTERVAL));
-        }
+        refresh_sched->set_frame_budget(bounds<uint16_t>(0, dsp_interval, MAX_INTERVAL));
     }
 }
 
@@ -1027,41 +1280,49 @@ void DrbdMon::disable_interval_timer() noexcept
     );
 }
 
+// @return Time in milliseconds until the next display update is due, 0 if it is due already
 // @throws TimerException
-inline bool DrbdMon::is_interval_exceeded()
+inline uint16_t DrbdMon::get_remaining_interval()
 {
     if (clock_gettime(CLOCK_MONOTONIC, &cur_timestamp) != 0)
     {
         throw TimerException();
     }
-    time_t secs_diff = (cur_timestamp.tv_sec - prev_timestamp.tv_sec);
-    long nanosecs_diff = (cur_timestamp.tv_nsec - prev_timestamp.tv_nsec);
-
-    struct timespec interval = interval_timer_mgr->get_interval();
-    bool exceeded = (
-        secs_diff > interval.tv_sec ||
-        (secs_diff == interval.tv_sec && nanosecs_diff >= interval.tv_nsec)
-    );
-    return exceeded;
+    const uint64_t elapsed_msecs = timespec_diff_nsecs(prev_timestamp, cur_timestamp) / 1000000;
+    const uint16_t interval = refresh_sched->get_interval();
+    return elapsed_msecs < interval ? static_cast<uint16_t> (interval - elapsed_msecs) : 0;
 }
 
+// Updates the display immediately if the refresh interval has elapsed or if a resource has entered
+// a problem state, otherwise defers the display update until the interval timer expires
 inline void DrbdMon::cond_display_update(GenericDisplay* const display_ptr)
 {
     try
     {
+        if (!timer_available || rsc_dir->get_problem_entry_seq() != displayed_problem_seq)
+        {
+            update_display(display_ptr);
+        }
+        else
         if (!timer_armed)
         {
-            if (is_interval_exceeded())
+            const uint16_t remaining_interval = get_remaining_interval();
+            if (remaining_interval == 0)
             {
-                display_ptr->notify_drbd_changed();
-                prev_timestamp = cur_timestamp;
+                update_display(display_ptr);
             }
             else
             {
+                refresh_sched->update_deferred();
+                interval_timer_mgr->set_interval(remaining_interval);
                 interval_timer_mgr->arm_timer();
                 timer_armed = true;
             }
         }
+        else
+        {
+            refresh_sched->update_deferred();
+        }
     }
     catch (TimerException&)
     {
@@ -1070,14 +1331,50 @@ inline void DrbdMon::cond_display_update(GenericDisplay* const display_ptr)
     }
 }
 
-inline void DrbdMon::update_timestamp() noexcept
+inline void DrbdMon::timed_display_update(GenericDisplay* const display_ptr)
 {
-    if (clock_gettime(CLOCK_MONOTONIC, &prev_timestamp) != 0)
+    try
+    {
+        update_display(display_ptr);
+    }
+    catch (TimerException&)
     {
         disable_interval_timer();
+        display_ptr->notify_drbd_changed();
     }
 }
 
+// @throws TimerException
+inline void DrbdMon::update_display(GenericDisplay* const display_ptr)
+{
+    struct timespec render_start;
+    if (clock_gettime(CLOCK_MONOTONIC, &render_start) != 0)
+    {
+        throw TimerException();
+    }
+    const bool rendered = display_ptr->notify_drbd_changed();
+    if (clock_gettime(CLOCK_MONOTONIC, &prev_timestamp) != 0)
+    {
+        throw TimerException();
+    }
+    displayed_problem_seq = rsc_dir->get_problem_entry_seq();
+    if (rendered)
+    {
+        refresh_sched->frame_rendered(timespec_diff_nsecs(render_start, prev_timestamp));
+    }
+    else
+    {
+        refresh_sched->frame_unchanged();
+    }
+}
+
+inline uint64_t DrbdMon::timespec_diff_nsecs(const struct timespec& start, const struct timespec& end) noexcept
+{
+    const int64_t diff_nsecs = (static_cast<int64_t> (end.tv_sec - start.tv_sec) * 1000000000LL) +
+        (end.tv_nsec - start.tv_nsec);
+    return diff_nsecs > 0 ? static_cast<uint64_t> (diff_nsecs) : 0;
+}
+
 static bool string_ends_with(const std::string& text, const std::string& suffix)
 {
     const size_t pos = text.rfind(suffix);
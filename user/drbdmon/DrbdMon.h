@@ -15,7 +15,9 @@
 #include <objects/DrbdConnection.h>
 #include <objects/DrbdVolume.h>
 #include <objects/VolumesContainer.h>
-#include <StringTokenizer.h>
+#include <EventProps.h>
+#include <EventKeywords.h>
+#include <EventsQueue.h>
 #include <terminal/GenericDisplay.h>
 #include <subprocess/EventsSourceSpawner.h>
 #include <MessageLog.h>
@@ -23,9 +25,12 @@
 #include <Configurator.h>
 #include <comparators.h>
 #include <IntervalTimer.h>
+#include <RefreshScheduler.h>
 
 // FIXME: Move to system_api
 #include <platform/Linux/EventsIo.h>
+#include <platform/Linux/EventsReader.h>
+#include <platform/Linux/StateServer.h>
 
 extern "C"
 {
@@ -35,45 +40,32 @@ extern "C"
 class DrbdMon : public DrbdMonCore, public Configurable, public Configurator
 {
   public:
-    static const std::string TOKEN_DELIMITER;
-
     static const char DEBUG_SEQ_PFX;
 
     static const std::string OPT_HELP_KEY;
     static const std::string OPT_VERSION_KEY;
     static const std::string OPT_FREQ_LMT_KEY;
     static const std::string OPT_EVENTS_LOG_KEY;
+    static const std::string OPT_EVENTS_SEEK_KEY;
+    static const std::string OPT_EVENTS_SPEED_KEY;
+    static const std::string OPT_PIPELINE_KEY;
+    static const std::string OPT_SERVER_KEY;
     static const ConfigOption OPT_HELP;
     static const ConfigOption OPT_VERSION;
     static const ConfigOption OPT_FREQ_LMT;
     static const ConfigOption OPT_EVENTS_LOG;
+    static const ConfigOption OPT_EVENTS_SEEK;
+    static const ConfigOption OPT_EVENTS_SPEED;
+    static const ConfigOption OPT_PIPELINE;
+    static const ConfigOption OPT_SERVER;
 
     static const std::string UNIT_SFX_SECONDS;
     static const std::string UNIT_SFX_MILLISECONDS;
     static const uint16_t MAX_INTERVAL;
     static const uint16_t DFLT_INTERVAL;
 
-    static const std::string TYPE_RESOURCE;
-    static const std::string TYPE_CONNECTION;
-    static const std::string TYPE_DEVICE;
-    static const std::string TYPE_PEER_DEVICE;
-    static const std::string TYPE_SEPARATOR;
-
-    static const std::string MODE_EXISTS;
-    static const std::string MODE_CREATE;
-    static const std::string MODE_CHANGE;
-    static const std::string MODE_RENAME;
-    static const std::string MODE_DESTROY;
-
     static const size_t MAX_LINE_LENGTH {1024};
 
-    // DrbdMon' normal behavior is to update the display only after
-    // all events have been read and no more events are pending.
-    // If new event lines arrive faster than DrbdMon can read them,
-    // so that there are always events pending, do still update the
-    // display every MAX_EVENT_BUNDLE events
-    static const uint32_t MAX_EVENT_BUNDLE {911};
-
     // @throws std::bad_alloc
     DrbdMon(
         int                         argc,
@@ -93,15 +85,42 @@ class DrbdMon : public DrbdMonCore, public Configurable, public Configurator
 
     virtual void shutdown(const DrbdMonCore::finish_action action) noexcept override;
 
-    // @throws EventMessageException, EventObjectException
-    virtual void tokenize_event_message(GenericDisplay* const display, std::string& event_line, PropsMap& event_props);
+    // @throws std::bad_alloc, EventMessageException
+    virtual bool tokenize_event_message(const StringView& event_line, EventProps& event_props);
+
+    // @throws std::bad_alloc, EventMessageException, EventObjectException
+    virtual void apply_event_message(
+        GenericDisplay* const display,
+        const StringView& event_line,
+        EventProps& event_props,
+        std::string& line_buffer
+    );
+
+    // Applies the event records that the events reader published to the queue and releases them
+    // @return Number of processed event records
+    // @throws std::bad_alloc, EventMessageException, EventObjectException
+    virtual size_t apply_queued_events(
+        GenericDisplay* const display_ptr,
+        EventsQueue& queue,
+        EventProps& parse_props,
+        std::string& line_buffer
+    );
+
+    // Indicates whether the pending event line can be merged into the next event line
+    // for the same object instead of being applied
+    // @throws std::bad_alloc, EventMessageException
+    virtual bool is_coalescable(
+        const StringView& pending_line,
+        EventProps& pending_props,
+        EventProps& next_props
+    );
 
     // @throws EventMessageException, EventObjectException
     virtual void process_event_message(
         GenericDisplay* const display,
-        std::string& mode,
-        std::string& type,
-        PropsMap& event_props,
+        EventKeywords::keyword mode,
+        EventKeywords::keyword type,
+        EventProps& event_props,
         std::string& event_line
     );
     // Returns the action requested to be taken upon return from this class' run() method.
@@ -123,8 +142,17 @@ class DrbdMon : public DrbdMonCore, public Configurable, public Configurator
     virtual void set_option(const std::string& key, const std::string& value) override;
 
     virtual uint32_t get_problem_count() const noexcept override;
+    virtual uint64_t get_drbd_change_seq() const noexcept override;
+    virtual bool is_resource_changed_since(
+        NameTable::handle   rsc_name_handle,
+        uint64_t            since_seq
+    ) const noexcept override;
+    virtual const RefreshScheduler& get_refresh_scheduler() const noexcept override;
 
     virtual void notify_config_changed() override;
+    // @throws std::bad_alloc
+    virtual void set_resource_filter(std::unique_ptr<ResourceFilter> filter) override;
+    virtual const ResourceFilter* get_resource_filter() const noexcept override;
 
   private:
     typedef struct option_entry_s
@@ -154,22 +182,24 @@ class DrbdMon : public DrbdMonCore, public Configurable, public Configurator
     bool    have_initial_state  {false};
     bool    timer_available     {false};
     bool    timer_armed         {false};
+    // Read and parse events on a separate thread
+    bool    pipeline_mode       {false};
+
+    // Headless mode only, replaces the terminal display
+    StateServer*    state_server    {nullptr};
 
     std::unique_ptr<Configurable*[]> configurables {nullptr};
 
     std::unique_ptr<IntervalTimer> interval_timer_mgr {nullptr};
+    // Time of the most recent display update
     struct timespec prev_timestamp {0, 0};
     struct timespec cur_timestamp {0, 0};
-    bool use_dflt_freq_lmt {true};
 
-    // Loads the event_props map with the properties contained in tokens
-    //
-    // @param: tokens StringTokenizer that returns the 'key:value' tokens from a 'drbdsetup event2' line
-    // @param: event_props Property map to load the key == value mappings into
-    // @throws std::bad_alloc
-    void parse_event_props(StringTokenizer& tokens, PropsMap& event_props, std::string& event_line);
-    // Clears the event_props map and frees all its entries
-    void clear_event_props(PropsMap& event_props);
+    std::unique_ptr<RefreshScheduler> refresh_sched_mgr {nullptr};
+    RefreshScheduler* refresh_sched {nullptr};
+    // Problem resources sequence number at the time of the most recent display update
+    uint64_t displayed_problem_seq {0};
+    bool use_dflt_freq_lmt {true};
 
     // Configures options (command line arguments)
     // configurables is a nullptr-terminated array of pointers to Configurable instances
@@ -182,15 +212,23 @@ class DrbdMon : public DrbdMonCore, public Configurable, public Configurator
     void disable_interval_timer() noexcept;
 
     // @throws TimerException
-    inline bool is_interval_exceeded();
+    inline uint16_t get_remaining_interval();
+
+    inline void cond_display_update(GenericDisplay* const display_ptr);
+    inline void timed_display_update(GenericDisplay* const display_ptr);
+    // @throws TimerException
+    inline void update_display(GenericDisplay* const display_ptr);
 
-    inline void cond_display_update(GenericDisplay* const display);
-    inline void update_timestamp() noexcept;
+    static inline uint64_t timespec_diff_nsecs(const struct timespec& start, const struct timespec& end) noexcept;
+
+    // Adds the event line and missing debug information to an EventMessageException
+    // @throws std::bad_alloc
+    static void complete_event_exception(EventMessageException& event_exc, const StringView& event_line);
 
     // Frees resources
     // @throws std::bad_alloc
     void cleanup(
-        PropsMap*               event_props,
+        EventProps*             event_props,
         EventsIo*               events_io
     );
 };
@@ -3,6 +3,10 @@
 
 #include <default_types.h>
 #include <platform/SystemApi.h>
+#include <RefreshScheduler.h>
+#include <objects/ResourceFilter.h>
+#include <objects/NameTable.h>
+#include <memory>
 
 class DrbdMonCore
 {
@@ -31,7 +35,16 @@ class DrbdMonCore
     virtual SystemApi& get_system_api() const noexcept = 0;
     virtual void shutdown(const finish_action action) noexcept = 0;
     virtual uint32_t get_problem_count() const noexcept = 0;
+    virtual uint64_t get_drbd_change_seq() const noexcept = 0;
+    // Indicates whether the resource with the specified name handle changed since the specified
+    // DRBD change sequence number, see ResourceDirectory::is_resource_changed_since()
+    virtual bool is_resource_changed_since(NameTable::handle rsc_name_handle, uint64_t since_seq) const noexcept = 0;
+    virtual const RefreshScheduler& get_refresh_scheduler() const noexcept = 0;
     virtual void notify_config_changed() = 0;
+    // Sets the filter that selects the resources of the filtered resources map, or removes it if nullptr
+    // @throws std::bad_alloc
+    virtual void set_resource_filter(std::unique_ptr<ResourceFilter> filter) = 0;
+    virtual const ResourceFilter* get_resource_filter() const noexcept = 0;
 };
 
 #endif /* DRBDMONCORE_H */
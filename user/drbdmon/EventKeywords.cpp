@@ -0,0 +1,458 @@
+#include <EventKeywords.h>
+#include <cstring>
+
+// Labels of the keywords, in the same order as the keyword enum
+const char* const EventKeywords::LABELS[] =
+{
+    "name",
+    "new_name",
+    "volume",
+    "minor",
+    "disk",
+    "peer-disk",
+    "replication",
+    "client",
+    "peer-client",
+    "quorum",
+    "done",
+    "role",
+    "connection",
+    "conn-name",
+    "peer-node-id",
+    "sync-state",
+    "exists",
+    "create",
+    "change",
+    "rename",
+    "destroy",
+    "resource",
+    "device",
+    "peer-device",
+    "-",
+    "Diskless",
+    "Attaching",
+    "Detaching",
+    "Failed",
+    "Negotiating",
+    "Inconsistent",
+    "Outdated",
+    "DUnknown",
+    "Consistent",
+    "UpToDate",
+    "Off",
+    "Established",
+    "StartingSyncS",
+    "StartingSyncT",
+    "WFBitMapS",
+    "WFBitMapT",
+    "WFSyncUUID",
+    "SyncSource",
+    "SyncTarget",
+    "PausedSyncS",
+    "PausedSyncT",
+    "VerifyS",
+    "VerifyT",
+    "Ahead",
+    "Behind",
+    "StandAlone",
+    "Disconnecting",
+    "Unconnected",
+    "Timeout",
+    "BrokenPipe",
+    "NetworkFailure",
+    "ProtocolError",
+    "TearDown",
+    "Connecting",
+    "Connected",
+    "Primary",
+    "Secondary",
+    "SplitBrain",
+    "Unrelated",
+    "Unknown",
+    "unknown",
+    "yes",
+    "no",
+    ""
+};
+
+EventKeywords::keyword EventKeywords::lookup(const StringView& text) noexcept
+{
+    keyword result = keyword::NONE;
+    const char* const text_data = text.data();
+    const size_t text_length = text.length();
+    switch (text_length)
+    {
+        case 1:
+            result = match(text, keyword::TYPE_SEPARATOR);
+            break;
+        case 2:
+            result = match(text, keyword::VAL_NO);
+            break;
+        case 3:
+            switch (text_data[0])
+            {
+                case 'O':
+                    result = match(text, keyword::RS_OFF);
+                    break;
+                case 'y':
+                    result = match(text, keyword::VAL_YES);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case 4:
+            switch (text_data[0])
+            {
+                case 'd':
+                    switch (text_data[text_length - 1])
+                    {
+                        case 'e':
+                            result = match(text, keyword::KEY_DONE);
+                            break;
+                        case 'k':
+                            result = match(text, keyword::KEY_DISK);
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                case 'n':
+                    result = match(text, keyword::KEY_NAME);
+                    break;
+                case 'r':
+                    result = match(text, keyword::KEY_ROLE);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case 5:
+            switch (text_data[0])
+            {
+                case 'A':
+                    result = match(text, keyword::RS_AHEAD);
+                    break;
+                case 'm':
+                    result = match(text, keyword::KEY_MINOR);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case 6:
+            switch (text_data[0])
+            {
+                case 'B':
+                    result = match(text, keyword::RS_BEHIND);
+                    break;
+                case 'F':
+                    result = match(text, keyword::DS_FAILED);
+                    break;
+                case 'c':
+                    switch (text_data[1])
+                    {
+                        case 'h':
+                            result = match(text, keyword::MODE_CHANGE);
+                            break;
+                        case 'l':
+                            result = match(text, keyword::KEY_CLIENT);
+                            break;
+                        case 'r':
+                            result = match(text, keyword::MODE_CREATE);
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                case 'd':
+                    result = match(text, keyword::TYPE_DEVICE);
+                    break;
+                case 'e':
+                    result = match(text, keyword::MODE_EXISTS);
+                    break;
+                case 'q':
+                    result = match(text, keyword::KEY_QUORUM);
+                    break;
+                case 'r':
+                    result = match(text, keyword::MODE_RENAME);
+                    break;
+                case 'v':
+                    result = match(text, keyword::KEY_VOLUME);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case 7:
+            switch (text_data[0])
+            {
+                case 'P':
+                    result = match(text, keyword::ROLE_PRIMARY);
+                    break;
+                case 'T':
+                    result = match(text, keyword::CS_TIMEOUT);
+                    break;
+                case 'U':
+                    result = match(text, keyword::VAL_UNKNOWN);
+                    break;
+                case 'V':
+                    switch (text_data[text_length - 1])
+                    {
+                        case 'S':
+                            result = match(text, keyword::RS_VERIFY_SOURCE);
+                            break;
+                        case 'T':
+                            result = match(text, keyword::RS_VERIFY_TARGET);
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                case 'd':
+                    result = match(text, keyword::MODE_DESTROY);
+                    break;
+                case 'u':
+                    result = match(text, keyword::VAL_LC_UNKNOWN);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case 8:
+            switch (text_data[0])
+            {
+                case 'D':
+                    switch (text_data[text_length - 1])
+                    {
+                        case 'n':
+                            result = match(text, keyword::DS_UNKNOWN);
+                            break;
+                        case 's':
+                            result = match(text, keyword::DS_DISKLESS);
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                case 'O':
+                    result = match(text, keyword::DS_OUTDATED);
+                    break;
+                case 'T':
+                    result = match(text, keyword::CS_TEAR_DOWN);
+                    break;
+                case 'U':
+                    result = match(text, keyword::DS_UP_TO_DATE);
+                    break;
+                case 'n':
+                    result = match(text, keyword::KEY_NEW_NAME);
+                    break;
+                case 'r':
+                    result = match(text, keyword::TYPE_RESOURCE);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case 9:
+            switch (text_data[0])
+            {
+                case 'A':
+                    result = match(text, keyword::DS_ATTACHING);
+                    break;
+                case 'C':
+                    result = match(text, keyword::CS_CONNECTED);
+                    break;
+                case 'D':
+                    result = match(text, keyword::DS_DETACHING);
+                    break;
+                case 'S':
+                    result = match(text, keyword::ROLE_SECONDARY);
+                    break;
+                case 'U':
+                    result = match(text, keyword::SS_UNRELATED);
+                    break;
+                case 'W':
+                    switch (text_data[text_length - 1])
+                    {
+                        case 'S':
+                            result = match(text, keyword::RS_WF_BITMAP_SOURCE);
+                            break;
+                        case 'T':
+                            result = match(text, keyword::RS_WF_BITMAP_TARGET);
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                case 'c':
+                    result = match(text, keyword::KEY_CONN_NAME);
+                    break;
+                case 'p':
+                    result = match(text, keyword::KEY_PEER_DISK);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case 10:
+            switch (text_data[0])
+            {
+                case 'B':
+                    result = match(text, keyword::CS_BROKEN_PIPE);
+                    break;
+                case 'C':
+                    switch (text_data[text_length - 1])
+                    {
+                        case 'g':
+                            result = match(text, keyword::CS_CONNECTING);
+                            break;
+                        case 't':
+                            result = match(text, keyword::DS_CONSISTENT);
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                case 'S':
+                    switch (text_data[4])
+                    {
+                        case 'S':
+                            result = match(text, keyword::RS_SYNC_SOURCE);
+                            break;
+                        case 'T':
+                            result = match(text, keyword::RS_SYNC_TARGET);
+                            break;
+                        case 'd':
+                            result = match(text, keyword::CS_STANDALONE);
+                            break;
+                        case 't':
+                            result = match(text, keyword::SS_SPLIT);
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                case 'W':
+                    result = match(text, keyword::RS_WF_SYNC_UUID);
+                    break;
+                case 'c':
+                    result = match(text, keyword::KEY_CONNECTION);
+                    break;
+                case 's':
+                    result = match(text, keyword::KEY_SYNC_STATE);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case 11:
+            switch (text_data[0])
+            {
+                case 'E':
+                    result = match(text, keyword::RS_ESTABLISHED);
+                    break;
+                case 'N':
+                    result = match(text, keyword::DS_NEGOTIATING);
+                    break;
+                case 'P':
+                    switch (text_data[text_length - 1])
+                    {
+                        case 'S':
+                            result = match(text, keyword::RS_PAUSED_SYNC_SOURCE);
+                            break;
+                        case 'T':
+                            result = match(text, keyword::RS_PAUSED_SYNC_TARGET);
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                case 'U':
+                    result = match(text, keyword::CS_UNCONNECTED);
+                    break;
+                case 'p':
+                    switch (text_data[text_length - 1])
+                    {
+                        case 'e':
+                            result = match(text, keyword::TYPE_PEER_DEVICE);
+                            break;
+                        case 't':
+                            result = match(text, keyword::KEY_PEER_CLIENT);
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                case 'r':
+                    result = match(text, keyword::KEY_REPLICATION);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case 12:
+            switch (text_data[0])
+            {
+                case 'I':
+                    result = match(text, keyword::DS_INCONSISTENT);
+                    break;
+                case 'p':
+                    result = match(text, keyword::KEY_PEER_NODE_ID);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case 13:
+            switch (text_data[0])
+            {
+                case 'D':
+                    result = match(text, keyword::CS_DISCONNECTING);
+                    break;
+                case 'P':
+                    result = match(text, keyword::CS_PROTOCOL_ERROR);
+                    break;
+                case 'S':
+                    switch (text_data[text_length - 1])
+                    {
+                        case 'S':
+                            result = match(text, keyword::RS_STARTING_SYNC_SOURCE);
+                            break;
+                        case 'T':
+                            result = match(text, keyword::RS_STARTING_SYNC_TARGET);
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case 14:
+            result = match(text, keyword::CS_NETWORK_FAILURE);
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
+const char* EventKeywords::get_label(const keyword entry) noexcept
+{
+    return LABELS[static_cast<size_t>(entry)];
+}
+
+bool EventKeywords::is_prop_key(const keyword entry) noexcept
+{
+    return static_cast<size_t>(entry) < PROP_KEY_COUNT;
+}
+
+// Compares the text against the candidate keyword's label
+// The caller guarantees that the text's length matches the length of the label
+EventKeywords::keyword EventKeywords::match(const StringView& text, const keyword candidate) noexcept
+{
+    return std::memcmp(text.data(), LABELS[static_cast<size_t>(candidate)], text.length()) == 0 ?
+        candidate : keyword::NONE;
+}
@@ -0,0 +1,138 @@
+#ifndef EVENTKEYWORDS_H
+#define EVENTKEYWORDS_H
+
+#include <default_types.h>
+#include <StringView.h>
+
+// Keywords of 'drbdsetup events2' lines
+//
+// Maps the property keys, event modes, object types and state labels that occur
+// on events lines to integer identifiers, so that the event line parser and the
+// state parsers of the DRBD objects can dispatch on an identifier instead of
+// comparing the text against each of the known labels.
+//
+// The lookup selects the candidate keyword by the length, the first character and,
+// if required, one further distinguishing character of the text, and then verifies
+// the candidate by comparing the text against the keyword's label.
+class EventKeywords
+{
+  public:
+    enum class keyword : uint8_t
+    {
+        // Event line property keys, also used as indices into the properties table of EventProps
+        KEY_NAME,
+        KEY_NEW_NAME,
+        KEY_VOLUME,
+        KEY_MINOR,
+        KEY_DISK,
+        KEY_PEER_DISK,
+        KEY_REPLICATION,
+        KEY_CLIENT,
+        KEY_PEER_CLIENT,
+        KEY_QUORUM,
+        KEY_DONE,
+        KEY_ROLE,
+        KEY_CONNECTION,
+        KEY_CONN_NAME,
+        KEY_PEER_NODE_ID,
+        KEY_SYNC_STATE,
+        // Event modes
+        MODE_EXISTS,
+        MODE_CREATE,
+        MODE_CHANGE,
+        MODE_RENAME,
+        MODE_DESTROY,
+        // Object types
+        TYPE_RESOURCE,
+        TYPE_DEVICE,
+        TYPE_PEER_DEVICE,
+        TYPE_SEPARATOR,
+        // Disk states
+        DS_DISKLESS,
+        DS_ATTACHING,
+        DS_DETACHING,
+        DS_FAILED,
+        DS_NEGOTIATING,
+        DS_INCONSISTENT,
+        DS_OUTDATED,
+        DS_UNKNOWN,
+        DS_CONSISTENT,
+        DS_UP_TO_DATE,
+        // Replication states
+        RS_OFF,
+        RS_ESTABLISHED,
+        RS_STARTING_SYNC_SOURCE,
+        RS_STARTING_SYNC_TARGET,
+        RS_WF_BITMAP_SOURCE,
+        RS_WF_BITMAP_TARGET,
+        RS_WF_SYNC_UUID,
+        RS_SYNC_SOURCE,
+        RS_SYNC_TARGET,
+        RS_PAUSED_SYNC_SOURCE,
+        RS_PAUSED_SYNC_TARGET,
+        RS_VERIFY_SOURCE,
+        RS_VERIFY_TARGET,
+        RS_AHEAD,
+        RS_BEHIND,
+        // Connection states
+        CS_STANDALONE,
+        CS_DISCONNECTING,
+        CS_UNCONNECTED,
+        CS_TIMEOUT,
+        CS_BROKEN_PIPE,
+        CS_NETWORK_FAILURE,
+        CS_PROTOCOL_ERROR,
+        CS_TEAR_DOWN,
+        CS_CONNECTING,
+        CS_CONNECTED,
+        // Roles
+        ROLE_PRIMARY,
+        ROLE_SECONDARY,
+        // Peer device sync states
+        SS_SPLIT,
+        SS_UNRELATED,
+        // Values shared by several properties
+        VAL_UNKNOWN,
+        VAL_LC_UNKNOWN,
+        VAL_YES,
+        VAL_NO,
+        // Unrecognized text, also the number of recognized keywords
+        NONE,
+        // Aliases for keywords that share the same text
+        TYPE_CONNECTION = KEY_CONNECTION,
+        RS_UNKNOWN = VAL_UNKNOWN,
+        CS_UNKNOWN = VAL_UNKNOWN,
+        ROLE_UNKNOWN = VAL_UNKNOWN,
+        CLIENT_ENABLED = VAL_YES,
+        CLIENT_DISABLED = VAL_NO,
+        CLIENT_UNKNOWN = VAL_LC_UNKNOWN,
+        QUORUM_PRESENT = VAL_YES,
+        QUORUM_LOST = VAL_NO
+    };
+
+    // Number of property keys, the property keys are the first entries of the keyword enum
+    static const size_t PROP_KEY_COUNT = static_cast<size_t>(keyword::KEY_SYNC_STATE) + 1;
+
+    // Returns the keyword that matches the specified text, or keyword::NONE
+    // if the text is not a known keyword
+    static keyword lookup(const StringView& text) noexcept;
+
+    // Returns the label of the specified keyword
+    static const char* get_label(keyword entry) noexcept;
+
+    static bool is_prop_key(keyword entry) noexcept;
+
+    EventKeywords() = delete;
+    EventKeywords(const EventKeywords& orig) = delete;
+    EventKeywords& operator=(const EventKeywords& orig) = delete;
+    EventKeywords(EventKeywords&& orig) = delete;
+    EventKeywords& operator=(EventKeywords&& orig) = delete;
+    ~EventKeywords() noexcept = delete;
+
+  private:
+    static const char* const LABELS[];
+
+    static keyword match(const StringView& text, keyword candidate) noexcept;
+};
+
+#endif /* EVENTKEYWORDS_H */
@@ -0,0 +1,183 @@
+#include <EventProps.h>
+#include <exceptions.h>
+
+const char EventProps::TOKEN_DELIMITER      = ' ';
+const char EventProps::KEY_VALUE_SEPARATOR  = ':';
+
+const uint32_t EventProps::IDENTITY_KEYS_MASK =
+    EventProps::key_bit(EventKeywords::keyword::KEY_NAME) |
+    EventProps::key_bit(EventKeywords::keyword::KEY_CONN_NAME) |
+    EventProps::key_bit(EventKeywords::keyword::KEY_VOLUME);
+
+EventProps::EventProps()
+{
+}
+
+EventProps::~EventProps() noexcept
+{
+}
+
+// @throws std::bad_alloc, EventMessageException
+bool EventProps::parse(const StringView& event_line)
+{
+    clear();
+
+    const char* const line_data = event_line.data();
+    const size_t line_length = event_line.length();
+
+    size_t token_count = 0;
+    size_t index = 0;
+    while (index < line_length)
+    {
+        // Skip delimiters
+        while (index < line_length && line_data[index] == TOKEN_DELIMITER)
+        {
+            ++index;
+        }
+        if (index >= line_length)
+        {
+            break;
+        }
+
+        const size_t token_offset = index;
+        size_t split_index = line_length;
+        while (index < line_length && line_data[index] != TOKEN_DELIMITER)
+        {
+            if (split_index == line_length && line_data[index] == KEY_VALUE_SEPARATOR)
+            {
+                split_index = index;
+            }
+            ++index;
+        }
+
+        const StringView token(&(line_data[token_offset]), index - token_offset);
+        if (token_count == 0)
+        {
+            mode = token;
+            mode_id = EventKeywords::lookup(token);
+        }
+        else
+        if (token_count == 1)
+        {
+            type = token;
+            type_id = EventKeywords::lookup(token);
+        }
+        else
+        if (split_index != line_length)
+        {
+            const size_t key_length = split_index - token_offset;
+            const size_t value_offset = split_index + 1;
+            add_prop(
+                StringView(&(line_data[token_offset]), key_length),
+                StringView(&(line_data[value_offset]), index - value_offset),
+                event_line
+            );
+        }
+        // Tokens without a key/value separator are skipped
+        ++token_count;
+    }
+
+    return token_count >= 2;
+}
+
+const StringView& EventProps::get_mode() const noexcept
+{
+    return mode;
+}
+
+const StringView& EventProps::get_type() const noexcept
+{
+    return type;
+}
+
+EventKeywords::keyword EventProps::get_mode_id() const noexcept
+{
+    return mode_id;
+}
+
+EventKeywords::keyword EventProps::get_type_id() const noexcept
+{
+    return type_id;
+}
+
+const StringView* EventProps::get(const EventKeywords::keyword key) const noexcept
+{
+    const StringView* value = nullptr;
+    if (EventKeywords::is_prop_key(key))
+    {
+        if ((present_mask & key_bit(key)) != 0)
+        {
+            value = &(values[static_cast<size_t>(key)]);
+        }
+    }
+    return value;
+}
+
+bool EventProps::is_same_object_change(const EventProps& other) const noexcept
+{
+    const uint32_t identity_mask = present_mask & IDENTITY_KEYS_MASK;
+    bool result = mode_id == EventKeywords::keyword::MODE_CHANGE &&
+        other.mode_id == EventKeywords::keyword::MODE_CHANGE &&
+        type_id == other.type_id && type_id != EventKeywords::keyword::NONE &&
+        identity_mask == (other.present_mask & IDENTITY_KEYS_MASK);
+    for (size_t key_index = 0; key_index < EventKeywords::PROP_KEY_COUNT && result; ++key_index)
+    {
+        if ((identity_mask & (static_cast<uint32_t>(1) << key_index)) != 0)
+        {
+            result = values[key_index].equals(other.values[key_index]);
+        }
+    }
+    return result;
+}
+
+void EventProps::merge_preceding(const EventProps& preceding) noexcept
+{
+    const uint32_t merge_mask = preceding.present_mask & ~present_mask;
+    for (size_t key_index = 0; key_index < EventKeywords::PROP_KEY_COUNT; ++key_index)
+    {
+        if ((merge_mask & (static_cast<uint32_t>(1) << key_index)) != 0)
+        {
+            values[key_index] = preceding.values[key_index];
+        }
+    }
+    present_mask |= merge_mask;
+}
+
+void EventProps::clear() noexcept
+{
+    present_mask = 0;
+    mode = StringView();
+    type = StringView();
+    mode_id = EventKeywords::keyword::NONE;
+    type_id = EventKeywords::keyword::NONE;
+}
+
+// @throws std::bad_alloc, EventMessageException
+void EventProps::add_prop(const StringView& key, const StringView& value, const StringView& event_line)
+{
+    const EventKeywords::keyword key_id = EventKeywords::lookup(key);
+    if (EventKeywords::is_prop_key(key_id))
+    {
+        const size_t key_index = static_cast<size_t>(key_id);
+        const uint32_t prop_bit = key_bit(key_id);
+        if ((present_mask & prop_bit) != 0)
+        {
+            // Duplicate key, malformed event line
+            std::string error_msg("Received an events line with a duplicate key");
+
+            std::string debug_info("Duplicate key ");
+            debug_info.append(key.data(), key.length());
+            debug_info += " on event line";
+
+            const std::string event_line_copy(event_line.to_string());
+            throw EventMessageException(&error_msg, &debug_info, &event_line_copy);
+        }
+        values[key_index] = value;
+        present_mask |= prop_bit;
+    }
+}
+
+uint32_t EventProps::key_bit(const EventKeywords::keyword key) noexcept
+{
+    return static_cast<uint32_t>(1) << static_cast<size_t>(key);
+}
@@ -0,0 +1,82 @@
+#ifndef EVENTPROPS_H
+#define EVENTPROPS_H
+
+#include <default_types.h>
+#include <string>
+#include <StringView.h>
+#include <EventKeywords.h>
+
+// Parsed 'drbdsetup events2' line
+//
+// The event line is tokenized in place, without copying any of its characters.
+// The event mode, the object type and the 'key:value' properties are stored as
+// StringView instances that refer to the event line's buffer, therefore, the
+// parsed information remains valid only for as long as the event line's buffer
+// is neither modified nor deallocated.
+// The values of known property keys are stored in a table that is indexed by the
+// property key's EventKeywords identifier, so that reading a property does not
+// require any string comparisons. Properties with unknown keys are ignored.
+class EventProps
+{
+  public:
+    static const char TOKEN_DELIMITER;
+    static const char KEY_VALUE_SEPARATOR;
+
+    EventProps();
+    EventProps(const EventProps& orig) = delete;
+    EventProps& operator=(const EventProps& orig) = delete;
+    EventProps(EventProps&& orig) = default;
+    EventProps& operator=(EventProps&& orig) = default;
+    virtual ~EventProps() noexcept;
+
+    // Tokenizes the specified event line
+    //
+    // @param event_line The 'drbdsetup events2' line to parse
+    // @return true if the line contains an event mode and an object type, false otherwise
+    // @throws std::bad_alloc, EventMessageException
+    virtual bool parse(const StringView& event_line);
+
+    virtual const StringView& get_mode() const noexcept;
+    virtual const StringView& get_type() const noexcept;
+
+    // Identifiers of the event mode and the object type,
+    // EventKeywords::keyword::NONE if the mode or type is unknown
+    virtual EventKeywords::keyword get_mode_id() const noexcept;
+    virtual EventKeywords::keyword get_type_id() const noexcept;
+
+    // Returns the value of the property with the specified key,
+    // or nullptr if the event line does not contain such a property
+    virtual const StringView* get(EventKeywords::keyword key) const noexcept;
+
+    // Indicates whether this event line and the specified other event line are both
+    // 'change' events for the same object
+    virtual bool is_same_object_change(const EventProps& other) const noexcept;
+
+    // Adds the properties of a preceding 'change' event line for the same object that this
+    // event line does not contain, so that applying this event line has the same effect as
+    // applying both event lines, with the values of this event line taking precedence.
+    // The added values refer to the preceding event line's buffer.
+    virtual void merge_preceding(const EventProps& preceding) noexcept;
+
+    virtual void clear() noexcept;
+
+  private:
+    // Bits of the property keys that identify the object that an event line refers to
+    static const uint32_t IDENTITY_KEYS_MASK;
+
+    StringView values[EventKeywords::PROP_KEY_COUNT];
+    // Bit n is set if the value of the property key with the identifier n is present
+    uint32_t present_mask {0};
+
+    StringView mode;
+    StringView type;
+    EventKeywords::keyword mode_id {EventKeywords::keyword::NONE};
+    EventKeywords::keyword type_id {EventKeywords::keyword::NONE};
+
+    // @throws std::bad_alloc, EventMessageException
+    void add_prop(const StringView& key, const StringView& value, const StringView& event_line);
+
+    static uint32_t key_bit(EventKeywords::keyword key) noexcept;
+};
+
+#endif /* EVENTPROPS_H */
@@ -0,0 +1,78 @@
+#include <EventsQueue.h>
+
+// @throws std::bad_alloc
+EventsQueue::EventsQueue(const size_t queue_capacity):
+    capacity(queue_capacity),
+    index_mask(queue_capacity - 1),
+    records(new event_record[queue_capacity])
+{
+}
+
+EventsQueue::~EventsQueue() noexcept
+{
+}
+
+EventsQueue::event_record* EventsQueue::acquire_slot()
+{
+    event_record* slot = nullptr;
+    const size_t tail_value = tail.load(std::memory_order_relaxed);
+    if (tail_value - head.load(std::memory_order_acquire) >= capacity)
+    {
+        std::unique_lock<std::mutex> lock(wait_lock);
+        producer_waiting.store(true);
+        while (tail_value - head.load() >= capacity && !closed.load())
+        {
+            wait_cond.wait(lock);
+        }
+        producer_waiting.store(false);
+    }
+    if (!closed.load(std::memory_order_relaxed))
+    {
+        slot = &(records[tail_value & index_mask]);
+    }
+    return slot;
+}
+
+bool EventsQueue::publish() noexcept
+{
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    return !signal_pending.exchange(true);
+}
+
+void EventsQueue::begin_drain() noexcept
+{
+    signal_pending.store(false);
+}
+
+size_t EventsQueue::get_available() const noexcept
+{
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_relaxed);
+}
+
+EventsQueue::event_record& EventsQueue::peek(const size_t offset) noexcept
+{
+    return records[(head.load(std::memory_order_relaxed) + offset) & index_mask];
+}
+
+void EventsQueue::release(const size_t count) noexcept
+{
+    head.store(head.load(std::memory_order_relaxed) + count);
+    if (producer_waiting.load())
+    {
+        // Lock to avoid a lost wakeup between the producer's check and its wait
+        std::unique_lock<std::mutex> lock(wait_lock);
+        wait_cond.notify_one();
+    }
+}
+
+void EventsQueue::close() noexcept
+{
+    std::unique_lock<std::mutex> lock(wait_lock);
+    closed.store(true);
+    wait_cond.notify_one();
+}
+
+size_t EventsQueue::get_capacity() const noexcept
+{
+    return capacity;
+}
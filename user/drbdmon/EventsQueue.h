@@ -0,0 +1,99 @@
+#ifndef EVENTSQUEUE_H
+#define EVENTSQUEUE_H
+
+#include <default_types.h>
+#include <new>
+#include <memory>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <EventProps.h>
+
+// Single-producer/single-consumer ring of pre-parsed 'drbdsetup events2' lines
+//
+// The producer (the events reader thread) acquires a slot, stores an event line and its parsed
+// properties in the slot's record and publishes the record. The consumer (the DrbdMon main loop)
+// processes published records in order and releases them afterwards.
+// Publishing and releasing records does not require any locks. Only if the ring is full, the
+// producer waits for the consumer to release records, so that a consumer that falls behind
+// back-pressures the events source instead of causing unbounded memory allocation.
+//
+// Records are reused; the event line buffers keep their capacity, so that the steady state
+// does not require any memory allocations.
+class EventsQueue
+{
+  public:
+    typedef struct event_record_s
+    {
+        std::string event_line;
+        // Refers to event_line
+        EventProps  event_props;
+        // Set if the event line contains an event mode and an object type
+        bool        have_event      {false};
+        // Set if parsing the event line failed, the consumer must parse the event line again
+        // to obtain the error information
+        bool        parse_failed    {false};
+    }
+    event_record;
+
+    // Default number of records, must be a power of 2
+    static const size_t DFLT_CAPACITY {4096};
+
+    // @throws std::bad_alloc
+    explicit EventsQueue(size_t queue_capacity = DFLT_CAPACITY);
+    virtual ~EventsQueue() noexcept;
+
+    EventsQueue(const EventsQueue& orig) = delete;
+    EventsQueue& operator=(const EventsQueue& orig) = delete;
+    EventsQueue(EventsQueue&& orig) = delete;
+    EventsQueue& operator=(EventsQueue&& orig) = delete;
+
+    // Producer: Returns the next free record, waiting for the consumer to release records
+    // if the ring is full.
+    // @return Pointer to the next free record, or nullptr if the queue was closed
+    virtual event_record* acquire_slot();
+
+    // Producer: Publishes the record returned by the last call of acquire_slot()
+    // @return true if the consumer must be signaled, false if a signal is pending already
+    virtual bool publish() noexcept;
+
+    // Consumer: Resets the pending signal
+    // Must be called before processing the available records, so that records that are
+    // published afterwards cause another signal
+    virtual void begin_drain() noexcept;
+
+    // Consumer: Returns the number of published records that have not been released yet
+    virtual size_t get_available() const noexcept;
+
+    // Consumer: Returns the published record at the specified offset from the oldest record
+    // The offset must be less than the number of available records
+    virtual event_record& peek(size_t offset) noexcept;
+
+    // Consumer: Releases the specified number of the oldest records
+    virtual void release(size_t count) noexcept;
+
+    // Causes acquire_slot() to return nullptr instead of waiting for free records
+    virtual void close() noexcept;
+
+    virtual size_t get_capacity() const noexcept;
+
+  private:
+    const size_t capacity;
+    const size_t index_mask;
+    const std::unique_ptr<event_record[]> records;
+
+    // Number of records published by the producer
+    std::atomic<size_t> tail        {0};
+    // Number of records released by the consumer
+    std::atomic<size_t> head        {0};
+
+    std::atomic<bool> signal_pending    {false};
+    std::atomic<bool> producer_waiting  {false};
+    std::atomic<bool> closed            {false};
+
+    std::mutex              wait_lock;
+    std::condition_variable wait_cond;
+};
+
+#endif /* EVENTSQUEUE_H */
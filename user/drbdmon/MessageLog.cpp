@@ -1,11 +1,19 @@
 #include <MessageLog.h>
 
 #include <iostream>
-#include <comparators.h>
+#include <thread>
 #include <stdexcept>
 
+extern "C"
+{
+    #include <sys/time.h>
+    #include <time.h>
+}
+
 const uint64_t MessageLog::ID_NONE    = ~static_cast<uint64_t> (0);
 
+const size_t MessageLog::PENDING_CAPACITY = 64;
+
 const char* MessageLog::MESSAGES_HEADER = "\x1B[0;30;42m MESSAGES \x1B[0m";
 
 const char* MessageLog::F_ALERT_MARK = "\x1B[1;33;41m ALERT \x1B[0m";
@@ -18,7 +26,7 @@ const char* MessageLog::F_RESET      = "\x1B[0m";
 
 const std::string MessageLog::CAPACITY_ERROR = "MessageLog(): Illegal capacity (entries < 1)";
 
-const size_t MessageLog::DATE_BUFFER_SIZE = 24;
+constexpr size_t MessageLog::DATE_BUFFER_SIZE;
 const char*  MessageLog::DATE_FORMAT = "%FT%TZ ";
 const size_t MessageLog::DATE_LENGTH = 21;
 
@@ -31,22 +39,31 @@ MessageLog::MessageLog(const size_t entries):
         throw std::out_of_range(CAPACITY_ERROR);
     }
 
-    msg_queue   = std::unique_ptr<Queue>(new Queue(comparators::compare<uint64_t>));
-    date_buffer = std::unique_ptr<char[]>(new char[DATE_BUFFER_SIZE]);
+    ring = std::unique_ptr<Entry[]>(new Entry[capacity]);
+    pending = std::unique_ptr<pending_entry[]>(new pending_entry[PENDING_CAPACITY]);
+    for (size_t idx = 0; idx < PENDING_CAPACITY; ++idx)
+    {
+        pending_entry& slot = pending[idx];
+        slot.ready.store(false);
+        slot.discarded = false;
+        slot.level = log_level::ALERT;
+        slot.utc_secs = -1;
+    }
 }
 
 MessageLog::~MessageLog() noexcept
 {
-    clear_impl();
 }
 
 bool MessageLog::has_entries() const
 {
     std::unique_lock<std::recursive_mutex> lock(queue_lock);
 
-    return msg_queue->get_size() >= 1;
+    // Entries that are still pending are not counted in entry_count yet
+    return entry_count >= 1 || claim_id.load() != published_id.load();
 }
 
+// @throws std::bad_alloc
 uint64_t MessageLog::add_entry(const log_level level, const std::string& message)
 {
     return add_entry(level, message.c_str());
@@ -55,159 +72,175 @@ uint64_t MessageLog::add_entry(const log_level level, const std::string& message
 // @throws std::bad_alloc
 uint64_t MessageLog::add_entry(const log_level level, const char* const message)
 {
-    std::unique_lock<std::recursive_mutex> lock(queue_lock);
-
-    if (msg_queue->get_size() >= capacity)
+    int64_t utc_secs = -1;
+    struct timeval utc_time;
+    if (gettimeofday(&utc_time, NULL) == 0)
     {
-        Queue::Node* first_node = msg_queue->get_first_node();
-        if (first_node != nullptr)
-        {
-            Entry* const first_entry = first_node->get_value();
-            delete first_entry;
-            msg_queue->remove_node(first_node);
-        }
+        utc_secs = static_cast<int64_t> (utc_time.tv_sec);
     }
 
-    const char* date_ptr = nullptr;
-    if (format_date())
+    const uint64_t entry_id = claim_id.fetch_add(1);
+
+    // If the pending slot is still occupied by an older entry, publish pending entries
+    // until the slot is available. Pending entries can only be published in the order
+    // of their IDs, therefore this waits until older concurrent writers have finished.
+    while (entry_id - published_id.load(std::memory_order_acquire) >= PENDING_CAPACITY)
     {
-        date_ptr = date_buffer.get();
+        {
+            std::unique_lock<std::recursive_mutex> lock(queue_lock);
+            publish_pending();
+        }
+        std::this_thread::yield();
     }
 
-    const uint64_t entry_id = next_id;
-    std::unique_ptr<Entry> log_entry = std::unique_ptr<Entry>(new Entry(entry_id, level, date_ptr, message));
-    ++next_id;
-
+    pending_entry& slot = pending[entry_id % PENDING_CAPACITY];
     try
     {
-        msg_queue->insert(&log_entry->get_id(), log_entry.get());
+        if (message != nullptr)
+        {
+            slot.message.assign(message);
+        }
+        else
+        {
+            slot.message.assign("<Attempt to log an entry with log_message == nullptr>");
+        }
+        slot.discarded = false;
     }
-    catch (dsaext::DuplicateInsertException&)
+    catch (std::bad_alloc&)
     {
-        // Not supposed to happen
-        throw std::logic_error("DuplicateInsertException for a key that is supposed to be unique");
+        // The ID is consumed even if the entry cannot be stored,
+        // so that the publication of subsequent entries is not blocked
+        slot.discarded = true;
+        slot.ready.store(true, std::memory_order_release);
+        throw;
     }
-    log_entry.release();
+    slot.level = level;
+    slot.utc_secs = utc_secs;
+    slot.ready.store(true, std::memory_order_release);
 
-    if (observer != nullptr)
+    // If some other thread holds the lock, the entry is published by the next reader of the log
     {
-        observer->notify_log_changed();
+        std::unique_lock<std::recursive_mutex> lock(queue_lock, std::try_to_lock);
+        if (lock.owns_lock())
+        {
+            publish_pending();
+        }
     }
 
+    notify_observer();
+
     return entry_id;
 }
 
 bool MessageLog::delete_entry(const uint64_t entry_id)
 {
-    std::unique_lock<std::recursive_mutex> lock(queue_lock);
-
-    Queue::Node* const log_entry_node = msg_queue->get_node(&entry_id);
-    if (log_entry_node != nullptr)
+    bool deleted = false;
     {
-        Entry* const log_entry = log_entry_node->get_value();
-        delete log_entry;
-        msg_queue->remove_node(log_entry_node);
-    }
+        std::unique_lock<std::recursive_mutex> lock(queue_lock);
 
-    if (observer != nullptr)
-    {
-        observer->notify_log_changed();
+        publish_pending();
+        Entry* const log_entry = find_entry(entry_id);
+        if (log_entry != nullptr)
+        {
+            log_entry->deleted = true;
+            log_entry->message.clear();
+            --entry_count;
+            deleted = true;
+        }
     }
 
-    return log_entry_node != nullptr;
+    notify_observer();
+
+    return deleted;
 }
 
 MessageLog::Entry* MessageLog::get_previous_entry(const uint64_t entry_id)
 {
     std::unique_lock<std::recursive_mutex> lock(queue_lock);
 
-    return msg_queue->get_less_value(&entry_id);
+    publish_pending();
+    return entry_id >= 1 ? find_floor_entry(entry_id - 1) : nullptr;
 }
 
 MessageLog::Entry* MessageLog::get_entry(const uint64_t entry_id)
 {
     std::unique_lock<std::recursive_mutex> lock(queue_lock);
 
-    return msg_queue->get(&entry_id);
+    publish_pending();
+    return find_entry(entry_id);
 }
 
 MessageLog::Entry* MessageLog::get_next_entry(const uint64_t entry_id)
 {
     std::unique_lock<std::recursive_mutex> lock(queue_lock);
 
-    return msg_queue->get_greater_value(&entry_id);
+    publish_pending();
+    return entry_id != ID_NONE ? find_ceiling_entry(entry_id + 1) : nullptr;
 }
 
 MessageLog::Entry* MessageLog::get_entry_near(const uint64_t entry_id)
 {
-    Entry* near_entry = nullptr;
-
     std::unique_lock<std::recursive_mutex> lock(queue_lock);
 
-    Queue::Node* node = msg_queue->get_ceiling_node(&entry_id);
-    if (node != nullptr)
-    {
-        near_entry = node->get_value();
-    }
-    else
+    publish_pending();
+    Entry* near_entry = find_ceiling_entry(entry_id);
+    if (near_entry == nullptr)
     {
-        node = msg_queue->get_floor_node(&entry_id);
-        if (node != nullptr)
-        {
-            near_entry = node->get_value();
-        }
+        near_entry = find_floor_entry(entry_id);
     }
 
     return near_entry;
 }
 
 // Caller must hold queue_lock while working with an iterator
-MessageLog::Queue::ValuesIterator MessageLog::iterator()
+MessageLog::EntriesIterator MessageLog::iterator()
 {
-    return Queue::ValuesIterator(*msg_queue);
+    publish_pending();
+    return EntriesIterator(*this, find_ceiling_entry(base_id));
 }
 
 // Caller must hold queue_lock while working with an iterator
-MessageLog::Queue::ValuesIterator MessageLog::iterator(const uint64_t entry_id)
+MessageLog::EntriesIterator MessageLog::iterator(const uint64_t entry_id)
 {
-    Queue& queue_ref = *msg_queue;
-    Queue::Node* const start_node = msg_queue->get_node(&entry_id);
-    return start_node != nullptr ? Queue::ValuesIterator(queue_ref, *start_node) : Queue::ValuesIterator(queue_ref);
+    publish_pending();
+    Entry* start_entry = find_entry(entry_id);
+    if (start_entry == nullptr)
+    {
+        start_entry = find_ceiling_entry(base_id);
+    }
+    return EntriesIterator(*this, start_entry);
 }
 
 void MessageLog::clear()
 {
-    std::unique_lock<std::recursive_mutex> lock(queue_lock);
+    {
+        std::unique_lock<std::recursive_mutex> lock(queue_lock);
 
-    clear_impl();
-    next_id = 0;
+        // Entry IDs are not reused, so that IDs that are still referenced,
+        // e.g. by selections, do not refer to new entries
+        publish_pending();
+        base_id = published_id.load();
+        entry_count = 0;
 
-    if (observer != nullptr)
-    {
-        observer->notify_log_changed();
+        entries_index.clear();
+        indexed_id = base_id;
+        index_min_id = base_id;
     }
-}
 
-void MessageLog::clear_impl() noexcept
-{
-    Queue::ValuesIterator iter(*msg_queue);
-    while (iter.has_next())
-    {
-        Entry* const cur_entry = iter.next();
-        delete cur_entry;
-    }
-    msg_queue->clear();
+    notify_observer();
 }
 
-void MessageLog::display_messages(std::ostream& out) const
+void MessageLog::display_messages(std::ostream& out)
 {
+    std::unique_lock<std::recursive_mutex> lock(queue_lock);
+
     out.clear();
 
-    if (msg_queue->get_size() >= 1)
+    EntriesIterator iter = iterator();
+    if (iter.get_size() >= 1)
     {
         out << MESSAGES_HEADER << '\n';
 
-        Queue::ValuesIterator iter(*msg_queue);
         const size_t count = iter.get_size();
         for (size_t slot = 0; slot < count; ++slot)
         {
@@ -239,57 +272,185 @@ void MessageLog::display_messages(std::ostream& out) const
     }
 }
 
+// Caller must hold queue_lock
+// @throws std::bad_alloc
+bool MessageLog::find_entries(const std::string& query, TextIndex::Matches& matches)
+{
+    publish_pending();
+    update_index();
+    const bool have_words = entries_index.find(query, matches);
+    // Deleted entries and evicted entries that were not removed from the index yet
+    matches.retain(
+        [this](uint64_t entry_id) -> bool
+        {
+            return find_entry(entry_id) != nullptr;
+        }
+    );
+    return have_words;
+}
+
 void MessageLog::set_observer(MessageLogObserver* const new_observer)
 {
-    std::unique_lock<std::recursive_mutex> lock(queue_lock);
+    std::unique_lock<std::mutex> lock(observer_lock);
 
     observer = new_observer;
 }
 
 void MessageLog::cancel_observer() noexcept
 {
-    std::unique_lock<std::recursive_mutex> lock(queue_lock);
+    std::unique_lock<std::mutex> lock(observer_lock);
 
     observer = nullptr;
 }
 
-bool MessageLog::format_date() noexcept
+void MessageLog::notify_observer() noexcept
 {
-    bool rc = false;
-    if (gettimeofday(&utc_time, NULL) == 0)
+    std::unique_lock<std::mutex> lock(observer_lock);
+
+    if (observer != nullptr)
     {
-        if (gmtime_r(&(utc_time.tv_sec), &time_fields) != nullptr)
+        observer->notify_log_changed();
+    }
+}
+
+// Caller must hold queue_lock
+void MessageLog::publish_pending() noexcept
+{
+    uint64_t entry_id = published_id.load(std::memory_order_relaxed);
+    const uint64_t end_id = claim_id.load();
+    bool publishing = true;
+    while (entry_id < end_id && publishing)
+    {
+        pending_entry& slot = pending[entry_id % PENDING_CAPACITY];
+        publishing = slot.ready.load(std::memory_order_acquire);
+        if (publishing)
         {
-            if (strftime(date_buffer.get(), DATE_BUFFER_SIZE, DATE_FORMAT, &time_fields) == DATE_LENGTH)
+            if (entry_id - base_id >= capacity)
+            {
+                // Evict the oldest entry
+                Entry& oldest_entry = ring[base_id % capacity];
+                if (!oldest_entry.deleted)
+                {
+                    --entry_count;
+                }
+                ++base_id;
+            }
+
+            Entry& log_entry = ring[entry_id % capacity];
+            log_entry.id = entry_id;
+            log_entry.level = slot.level;
+            log_entry.utc_secs = slot.utc_secs;
+            // Swapping the strings retains the allocated buffers of both the ring and the pending slots
+            log_entry.message.swap(slot.message);
+            log_entry.deleted = slot.discarded;
+            if (!slot.discarded)
             {
-                rc = true;
+                ++entry_count;
             }
+
+            slot.ready.store(false, std::memory_order_relaxed);
+            ++entry_id;
         }
     }
-    return rc;
+    // Makes the pending slots available to writers again
+    published_id.store(entry_id, std::memory_order_release);
 }
 
-MessageLog::Entry::Entry(
-    const uint64_t      entry_id,
-    const log_level     entry_level,
-    const char* const   date_buffer,
-    const char* const   log_message
-)
+// Caller must hold queue_lock
+// @throws std::bad_alloc
+void MessageLog::update_index()
 {
-    id          = entry_id;
-    level       = entry_level;
-    if (date_buffer != nullptr)
+    // Remove evicted entries once the index contains at least as many evicted entries as the log's capacity,
+    // so that the cost of the removal is spread across the indexed entries
+    if (base_id - index_min_id >= capacity)
+    {
+        entries_index.remove_below(base_id);
+        index_min_id = base_id;
+    }
+
+    if (indexed_id < base_id)
+    {
+        indexed_id = base_id;
+    }
+
+    const uint64_t end_id = published_id.load(std::memory_order_relaxed);
+    char date_buffer[DATE_BUFFER_SIZE];
+    std::string date_word;
+    while (indexed_id < end_id)
     {
-        date_label.append(date_buffer);
+        const Entry* const log_entry = find_entry(indexed_id);
+        if (log_entry != nullptr)
+        {
+            entries_index.add_text(indexed_id, log_entry->message);
+            if (log_entry->utc_secs >= 0)
+            {
+                const time_t entry_time = static_cast<time_t> (log_entry->utc_secs);
+                struct tm time_fields;
+                if (gmtime_r(&entry_time, &time_fields) != nullptr)
+                {
+                    const char* const word_formats[] = {"%F", "%R", "%T"};
+                    for (const char* const word_format : word_formats)
+                    {
+                        if (strftime(date_buffer, DATE_BUFFER_SIZE, word_format, &time_fields) > 0)
+                        {
+                            date_word.assign(date_buffer);
+                            entries_index.add_word(indexed_id, date_word);
+                        }
+                    }
+                }
+            }
+        }
+        ++indexed_id;
     }
-    if (log_message != nullptr)
+}
+
+// Caller must hold queue_lock
+MessageLog::Entry* MessageLog::find_entry(const uint64_t entry_id) noexcept
+{
+    Entry* log_entry = nullptr;
+    if (entry_id >= base_id && entry_id < published_id.load(std::memory_order_relaxed))
     {
-        message.append(log_message);
+        Entry& slot_entry = ring[entry_id % capacity];
+        if (!slot_entry.deleted)
+        {
+            log_entry = &slot_entry;
+        }
     }
-    else
+    return log_entry;
+}
+
+// Caller must hold queue_lock
+MessageLog::Entry* MessageLog::find_ceiling_entry(const uint64_t entry_id) noexcept
+{
+    Entry* log_entry = nullptr;
+    const uint64_t end_id = published_id.load(std::memory_order_relaxed);
+    for (uint64_t cur_id = entry_id >= base_id ? entry_id : base_id; cur_id < end_id && log_entry == nullptr; ++cur_id)
     {
-        message.append("<Attempt to log an entry with log_message == nullptr>");
+        log_entry = find_entry(cur_id);
     }
+    return log_entry;
+}
+
+// Caller must hold queue_lock
+MessageLog::Entry* MessageLog::find_floor_entry(const uint64_t entry_id) noexcept
+{
+    Entry* log_entry = nullptr;
+    const uint64_t end_id = published_id.load(std::memory_order_relaxed);
+    if (end_id > base_id && entry_id >= base_id)
+    {
+        uint64_t cur_id = entry_id < end_id ? entry_id : end_id - 1;
+        log_entry = find_entry(cur_id);
+        while (log_entry == nullptr && cur_id > base_id)
+        {
+            --cur_id;
+            log_entry = find_entry(cur_id);
+        }
+    }
+    return log_entry;
+}
+
+MessageLog::Entry::Entry()
+{
 }
 
 MessageLog::Entry::~Entry() noexcept
@@ -311,7 +472,52 @@ const std::string& MessageLog::Entry::get_message() const noexcept
     return message;
 }
 
-const std::string& MessageLog::Entry::get_date_label() const noexcept
+// @throws std::bad_alloc
+std::string MessageLog::Entry::get_date_label() const
 {
+    std::string date_label;
+    if (utc_secs >= 0)
+    {
+        const time_t entry_time = static_cast<time_t> (utc_secs);
+        struct tm time_fields;
+        char date_buffer[DATE_BUFFER_SIZE];
+        if (gmtime_r(&entry_time, &time_fields) != nullptr)
+        {
+            if (strftime(date_buffer, DATE_BUFFER_SIZE, DATE_FORMAT, &time_fields) == DATE_LENGTH)
+            {
+                date_label.append(date_buffer);
+            }
+        }
+    }
     return date_label;
 }
+
+MessageLog::EntriesIterator::EntriesIterator(MessageLog& log_ref, Entry* const start_entry):
+    log(log_ref),
+    next_entry(start_entry)
+{
+}
+
+MessageLog::EntriesIterator::~EntriesIterator() noexcept
+{
+}
+
+MessageLog::Entry* MessageLog::EntriesIterator::next()
+{
+    Entry* const cur_entry = next_entry;
+    if (cur_entry != nullptr)
+    {
+        next_entry = cur_entry->id != ID_NONE ? log.find_ceiling_entry(cur_entry->id + 1) : nullptr;
+    }
+    return cur_entry;
+}
+
+bool MessageLog::EntriesIterator::has_next() const
+{
+    return next_entry != nullptr;
+}
+
+size_t MessageLog::EntriesIterator::get_size() const
+{
+    return log.entry_count;
+}
@@ -6,24 +6,23 @@
 #include <memory>
 #include <string>
 #include <mutex>
+#include <atomic>
 #include <stdexcept>
 
 #include <MessageLogObserver.h>
+#include <TextIndex.h>
 // https://github.com/raltnoeder/cppdsaext
 #include <dsaext.h>
-#include <QTree.h>
-
-extern "C"
-{
-    #include <sys/time.h>
-    #include <time.h>
-}
 
 class MessageLog
 {
   public:
     static const uint64_t   ID_NONE;
 
+    // Number of entries that can be appended concurrently before they are
+    // published to the log's ring buffer
+    static const size_t     PENDING_CAPACITY;
+
     mutable std::recursive_mutex    queue_lock;
 
     enum class log_level : uint32_t
@@ -35,28 +34,44 @@ class MessageLog
 
     class Entry
     {
+        friend class MessageLog;
+
       public:
-        Entry(
-            const uint64_t      entry_id,
-            const log_level     entry_level,
-            const char* const   date_buffer,
-            const char* const   log_message
-        );
+        Entry();
         virtual ~Entry() noexcept;
 
         virtual log_level get_log_level() const noexcept;
         virtual const uint64_t& get_id() const noexcept;
         virtual const std::string& get_message() const noexcept;
-        virtual const std::string& get_date_label() const noexcept;
+        // @throws std::bad_alloc
+        virtual std::string get_date_label() const;
 
       private:
-        uint64_t    id      {0};
-        log_level   level   {log_level::ALERT};
-        std::string date_label;
+        uint64_t    id          {0};
+        log_level   level       {log_level::ALERT};
+        // UTC time in seconds since the epoch, or -1 if the time is unknown
+        int64_t     utc_secs    {-1};
+        bool        deleted     {true};
         std::string message;
     };
 
-    using Queue = QTree<uint64_t, Entry>;
+    // Iterates over the entries of the log in ascending order of their IDs
+    // Caller must hold queue_lock while working with an iterator
+    class EntriesIterator : public dsaext::QIterator<Entry>
+    {
+      public:
+        EntriesIterator(MessageLog& log_ref, Entry* const start_entry);
+        virtual ~EntriesIterator() noexcept;
+
+        virtual Entry* next() override;
+        virtual bool has_next() const override;
+        // Returns the number of entries in the log
+        virtual size_t get_size() const override;
+
+      private:
+        MessageLog& log;
+        Entry*      next_entry  {nullptr};
+    };
 
     static const char* MESSAGES_HEADER;
 
@@ -68,7 +83,7 @@ class MessageLog
     static const char* F_INFO;
     static const char* F_RESET;
 
-    static const size_t DATE_BUFFER_SIZE;
+    static constexpr size_t DATE_BUFFER_SIZE = 24;
     static const char*  DATE_FORMAT;
     static const size_t DATE_LENGTH;
 
@@ -78,16 +93,18 @@ class MessageLog
     explicit MessageLog(const size_t entries);
     MessageLog(const MessageLog& orig) = delete;
     MessageLog& operator=(const MessageLog& orig) = delete;
-    MessageLog(MessageLog&& orig) = default;
+    MessageLog(MessageLog&& orig) = delete;
     MessageLog& operator=(MessageLog&& orig) = delete;
     virtual ~MessageLog() noexcept;
 
-    virtual Queue::ValuesIterator iterator();
-    virtual Queue::ValuesIterator iterator(const uint64_t entry_id);
+    virtual EntriesIterator iterator();
+    virtual EntriesIterator iterator(const uint64_t entry_id);
 
-    // @throws std::bad_alloc
     virtual bool has_entries() const;
+    // Appends an entry to the log without waiting for threads that are reading the log
+    // @throws std::bad_alloc
     virtual uint64_t add_entry(log_level level, const std::string& message);
+    // @throws std::bad_alloc
     virtual uint64_t add_entry(log_level level, const char* message);
     virtual bool delete_entry(const uint64_t entry_id);
     virtual Entry* get_previous_entry(const uint64_t entry_id);
@@ -95,25 +112,72 @@ class MessageLog
     virtual Entry* get_next_entry(const uint64_t entry_id);
     virtual Entry* get_entry_near(const uint64_t entry_id);
     virtual void clear();
-    virtual void display_messages(std::ostream& out) const;
+    virtual void display_messages(std::ostream& out);
+
+    // Finds the entries that contain all words of the query in their message, their date or their time
+    // (formatted as YYYY-MM-DD, HH:MM or HH:MM:SS). Entries added since the last query are indexed first.
+    // The matches are only valid until queue_lock is released.
+    // Caller must hold queue_lock
+    // @return False if the query does not contain any words, true otherwise
+    // @throws std::bad_alloc
+    virtual bool find_entries(const std::string& query, TextIndex::Matches& matches);
 
     virtual void set_observer(MessageLogObserver* const new_observer);
     virtual void cancel_observer() noexcept;
 
   private:
-    size_t capacity     {0};
-    uint64_t next_id    {0};
-
-    struct timeval  utc_time;
-    struct tm       time_fields;
-
-    std::unique_ptr<Queue>  msg_queue;
-    std::unique_ptr<char[]> date_buffer;
+    // Entry that was appended, but not published to the ring buffer yet
+    typedef struct pending_entry_s
+    {
+        std::atomic<bool>   ready;
+        bool                discarded;
+        log_level           level;
+        int64_t             utc_secs;
+        std::string         message;
+    }
+    pending_entry;
 
-    MessageLogObserver*     observer;
+    size_t capacity     {0};
 
-    void clear_impl() noexcept;
-    bool format_date() noexcept;
+    // Ring buffer of entries, the entry with ID n is stored at index n % capacity
+    std::unique_ptr<Entry[]>            ring;
+    // ID of the oldest entry in the ring buffer, protected by queue_lock
+    uint64_t                            base_id         {0};
+    // Number of entries in the ring buffer that have not been deleted, protected by queue_lock
+    size_t                              entry_count     {0};
+
+    // The entry with ID n is pending at index n % PENDING_CAPACITY
+    std::unique_ptr<pending_entry[]>    pending;
+    // Next ID to assign to an appended entry
+    std::atomic<uint64_t>               claim_id        {0};
+    // Next ID to publish to the ring buffer, only changed while holding queue_lock
+    std::atomic<uint64_t>               published_id    {0};
+
+    // Index of the words contained in the entries, protected by queue_lock
+    TextIndex               entries_index;
+    // Next ID to add to the index
+    uint64_t                indexed_id      {0};
+    // IDs less than this ID were removed from the index
+    uint64_t                index_min_id    {0};
+
+    std::mutex              observer_lock;
+    MessageLogObserver*     observer    {nullptr};
+
+    void notify_observer() noexcept;
+    // Caller must hold queue_lock
+    void publish_pending() noexcept;
+    // Adds published entries that are not indexed yet to the index
+    // Caller must hold queue_lock
+    // @throws std::bad_alloc
+    void update_index();
+    // Caller must hold queue_lock
+    Entry* find_entry(const uint64_t entry_id) noexcept;
+    // Returns the entry with the lowest ID that is greater than or equal to entry_id
+    // Caller must hold queue_lock
+    Entry* find_ceiling_entry(const uint64_t entry_id) noexcept;
+    // Returns the entry with the greatest ID that is less than or equal to entry_id
+    // Caller must hold queue_lock
+    Entry* find_floor_entry(const uint64_t entry_id) noexcept;
 };
 
 #endif    /* MESSAGELOG_H */
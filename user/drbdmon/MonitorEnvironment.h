@@ -21,6 +21,13 @@ class MonitorEnvironment
     std::string                     node_name;
     std::string                     config_file_path;
     std::string                     events_file_path;
+    // Time of the saved DRBD state, and speed factor for replaying the saved DRBD events
+    std::string                     events_seek_time;
+    std::string                     events_replay_speed;
+    // Path of the socket that serves the DRBD state to local clients, if DrbdMon runs without a terminal
+    std::string                     server_socket_path;
+    // Set if DrbdMon runs without a terminal
+    bool                            headless                {false};
 };
 
 #endif /* MONITORENVIRONMENT_H */
@@ -0,0 +1,143 @@
+#include <RefreshScheduler.h>
+#include <bounds.h>
+
+const uint64_t RefreshScheduler::RENDER_LOAD_DIVISOR    = 4;
+const uint64_t RefreshScheduler::STORM_EVENT_COUNT      = 911;
+const uint16_t RefreshScheduler::MIN_STORM_INTERVAL     = 100;
+const uint16_t RefreshScheduler::MAX_STORM_INTERVAL     = 1000;
+
+RefreshScheduler::RefreshScheduler(const uint16_t max_interval_msecs):
+    max_interval(max_interval_msecs)
+{
+}
+
+RefreshScheduler::~RefreshScheduler() noexcept
+{
+}
+
+void RefreshScheduler::set_frame_budget(const uint16_t budget_msecs) noexcept
+{
+    frame_budget = budget_msecs;
+    update_interval();
+}
+
+uint16_t RefreshScheduler::get_frame_budget() const noexcept
+{
+    return frame_budget;
+}
+
+uint16_t RefreshScheduler::get_interval() const noexcept
+{
+    return interval;
+}
+
+void RefreshScheduler::events_applied(const uint64_t event_count) noexcept
+{
+    pending_events += event_count;
+}
+
+void RefreshScheduler::update_deferred() noexcept
+{
+    ++deferred_count;
+}
+
+void RefreshScheduler::frame_rendered(const uint64_t render_nsecs) noexcept
+{
+    ++frame_count;
+    last_render_nsecs = render_nsecs;
+    if (render_nsecs > max_render_nsecs)
+    {
+        max_render_nsecs = render_nsecs;
+    }
+    if (frame_count > 1)
+    {
+        // Weight of the new sample is 1/8
+        avg_render_nsecs = avg_render_nsecs - (avg_render_nsecs / 8) + (render_nsecs / 8);
+    }
+    else
+    {
+        avg_render_nsecs = render_nsecs;
+    }
+
+    last_frame_events = pending_events;
+    if (pending_events > max_frame_events)
+    {
+        max_frame_events = pending_events;
+    }
+
+    // Extend the interval while an event storm continues, shorten it again afterwards
+    if (pending_events >= STORM_EVENT_COUNT)
+    {
+        const uint16_t min_interval = frame_budget > MIN_STORM_INTERVAL ? frame_budget : MIN_STORM_INTERVAL;
+        storm_interval = storm_interval >= min_interval ? storm_interval * 2 : min_interval;
+        if (storm_interval > MAX_STORM_INTERVAL)
+        {
+            storm_interval = MAX_STORM_INTERVAL;
+        }
+    }
+    else
+    {
+        storm_interval /= 2;
+    }
+    pending_events = 0;
+
+    update_interval();
+}
+
+void RefreshScheduler::frame_unchanged() noexcept
+{
+    pending_events = 0;
+}
+
+uint64_t RefreshScheduler::get_frame_count() const noexcept
+{
+    return frame_count;
+}
+
+uint64_t RefreshScheduler::get_deferred_count() const noexcept
+{
+    return deferred_count;
+}
+
+uint64_t RefreshScheduler::get_last_render_usecs() const noexcept
+{
+    return last_render_nsecs / 1000;
+}
+
+uint64_t RefreshScheduler::get_avg_render_usecs() const noexcept
+{
+    return avg_render_nsecs / 1000;
+}
+
+uint64_t RefreshScheduler::get_max_render_usecs() const noexcept
+{
+    return max_render_nsecs / 1000;
+}
+
+uint64_t RefreshScheduler::get_last_frame_events() const noexcept
+{
+    return last_frame_events;
+}
+
+uint64_t RefreshScheduler::get_max_frame_events() const noexcept
+{
+    return max_frame_events;
+}
+
+void RefreshScheduler::update_interval() noexcept
+{
+    uint64_t new_interval = frame_budget;
+    if (frame_budget > 0)
+    {
+        const uint64_t load_interval = (avg_render_nsecs * RENDER_LOAD_DIVISOR) / 1000000;
+        if (load_interval > new_interval)
+        {
+            new_interval = load_interval;
+        }
+        if (storm_interval > new_interval)
+        {
+            new_interval = storm_interval;
+        }
+    }
+    interval = static_cast<uint16_t> (bounds<uint64_t>(0, new_interval, max_interval));
+}
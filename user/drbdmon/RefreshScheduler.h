@@ -0,0 +1,78 @@
+#ifndef REFRESHSCHEDULER_H
+#define REFRESHSCHEDULER_H
+
+#include <default_types.h>
+
+// Determines the interval between display updates that are caused by DRBD events
+//
+// The interval is the configured frame budget, unless rendering the display takes longer than
+// a certain share of the frame budget, or unless a storm of events is being received, in which
+// case the interval is extended to reduce the time spent on rendering.
+// Also collects statistics about display updates.
+class RefreshScheduler
+{
+  public:
+    // Rendering may use up to 1 / RENDER_LOAD_DIVISOR of the time between display updates
+    static const uint64_t RENDER_LOAD_DIVISOR;
+    // Number of events per display update that is considered to be an event storm
+    static const uint64_t STORM_EVENT_COUNT;
+    // Minimum interval during event storms
+    static const uint16_t MIN_STORM_INTERVAL;
+    // Maximum interval during event storms
+    static const uint16_t MAX_STORM_INTERVAL;
+
+    // @param max_interval_msecs Upper limit for the interval between display updates
+    explicit RefreshScheduler(uint16_t max_interval_msecs);
+    virtual ~RefreshScheduler() noexcept;
+
+    RefreshScheduler(const RefreshScheduler& orig) = delete;
+    RefreshScheduler& operator=(const RefreshScheduler& orig) = delete;
+    RefreshScheduler(RefreshScheduler&& orig) = delete;
+    RefreshScheduler& operator=(RefreshScheduler&& orig) = delete;
+
+    // Sets the minimum interval between display updates in milliseconds
+    virtual void set_frame_budget(uint16_t budget_msecs) noexcept;
+    virtual uint16_t get_frame_budget() const noexcept;
+
+    // @return Current interval between display updates in milliseconds
+    virtual uint16_t get_interval() const noexcept;
+
+    // Records events that were applied since the last display update
+    virtual void events_applied(uint64_t event_count) noexcept;
+    // Records a display update that was deferred, because the current interval had not elapsed yet
+    virtual void update_deferred() noexcept;
+    // Records a display update and adjusts the current interval
+    virtual void frame_rendered(uint64_t render_nsecs) noexcept;
+    // Records a display update that was not rendered, because the display did not change
+    virtual void frame_unchanged() noexcept;
+
+    virtual uint64_t get_frame_count() const noexcept;
+    virtual uint64_t get_deferred_count() const noexcept;
+    virtual uint64_t get_last_render_usecs() const noexcept;
+    virtual uint64_t get_avg_render_usecs() const noexcept;
+    virtual uint64_t get_max_render_usecs() const noexcept;
+    virtual uint64_t get_last_frame_events() const noexcept;
+    virtual uint64_t get_max_frame_events() const noexcept;
+
+  private:
+    const uint16_t max_interval;
+
+    uint16_t    frame_budget        {0};
+    uint16_t    interval            {0};
+    uint16_t    storm_interval      {0};
+
+    uint64_t    pending_events      {0};
+
+    uint64_t    frame_count         {0};
+    uint64_t    deferred_count      {0};
+    // Exponentially weighted moving average
+    uint64_t    avg_render_nsecs    {0};
+    uint64_t    last_render_nsecs   {0};
+    uint64_t    max_render_nsecs    {0};
+    uint64_t    last_frame_events   {0};
+    uint64_t    max_frame_events    {0};
+
+    void update_interval() noexcept;
+};
+
+#endif /* REFRESHSCHEDULER_H */
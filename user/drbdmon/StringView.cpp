@@ -0,0 +1,74 @@
+#include <StringView.h>
+#include <cstring>
+
+StringView::StringView(const char* const text_ptr, const size_t text_length) noexcept:
+    view_data(text_ptr),
+    view_length(text_length)
+{
+}
+
+StringView::StringView(const std::string& text) noexcept:
+    view_data(text.data()),
+    view_length(text.length())
+{
+}
+
+bool StringView::equals(const StringView& other) const noexcept
+{
+    return view_length == other.view_length &&
+        (view_length == 0 || std::memcmp(view_data, other.view_data, view_length) == 0);
+}
+
+bool StringView::equals(const std::string& other) const noexcept
+{
+    return view_length == other.length() &&
+        (view_length == 0 || std::memcmp(view_data, other.data(), view_length) == 0);
+}
+
+bool StringView::equals(const char* const other) const noexcept
+{
+    size_t index = 0;
+    while (index < view_length && other[index] != '\0' && view_data[index] == other[index])
+    {
+        ++index;
+    }
+    return index == view_length && other[index] == '\0';
+}
+
+size_t StringView::find(const char find_char, const size_t start_index) const noexcept
+{
+    size_t result = std::string::npos;
+    for (size_t index = start_index; index < view_length; ++index)
+    {
+        if (view_data[index] == find_char)
+        {
+            result = index;
+            break;
+        }
+    }
+    return result;
+}
+
+StringView StringView::substr(const size_t start_index, const size_t sub_length) const noexcept
+{
+    StringView result;
+    if (start_index < view_length)
+    {
+        const size_t max_length = view_length - start_index;
+        result.view_data = view_data + start_index;
+        result.view_length = sub_length < max_length ? sub_length : max_length;
+    }
+    return result;
+}
+
+// @throws std::bad_alloc
+std::string StringView::to_string() const
+{
+    return std::string(view_data, view_length);
+}
+
+// @throws std::bad_alloc
+void StringView::assign_to(std::string& dst) const
+{
+    dst.assign(view_data, view_length);
+}
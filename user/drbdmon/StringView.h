@@ -0,0 +1,65 @@
+#ifndef STRINGVIEW_H
+#define STRINGVIEW_H
+
+#include <default_types.h>
+#include <string>
+
+// Non-owning reference to a sequence of characters
+//
+// The referenced characters are not required to be null-terminated.
+// A StringView remains valid only for as long as the buffer that it refers to
+// is neither modified nor deallocated.
+class StringView
+{
+  public:
+    StringView() = default;
+    StringView(const char* text_ptr, size_t text_length) noexcept;
+    StringView(const std::string& text) noexcept;
+    StringView(const StringView& orig) = default;
+    StringView& operator=(const StringView& orig) = default;
+    StringView(StringView&& orig) = default;
+    StringView& operator=(StringView&& orig) = default;
+    ~StringView() noexcept
+    {
+    }
+
+    const char* data() const noexcept
+    {
+        return view_data;
+    }
+
+    size_t length() const noexcept
+    {
+        return view_length;
+    }
+
+    bool empty() const noexcept
+    {
+        return view_length == 0;
+    }
+
+    bool equals(const StringView& other) const noexcept;
+    bool equals(const std::string& other) const noexcept;
+    // Compares to a null-terminated string
+    bool equals(const char* other) const noexcept;
+
+    // Returns the index of the first occurrence of the specified character,
+    // or std::string::npos if the character is not contained in the view
+    size_t find(char find_char, size_t start_index) const noexcept;
+
+    StringView substr(size_t start_index, size_t sub_length) const noexcept;
+
+    // @throws std::bad_alloc
+    std::string to_string() const;
+
+    // Assigns the view's characters to an existing string
+    // Reusing the same string avoids allocations if its capacity is sufficient
+    // @throws std::bad_alloc
+    void assign_to(std::string& dst) const;
+
+  private:
+    const char* view_data   {""};
+    size_t      view_length {0};
+};
+
+#endif /* STRINGVIEW_H */
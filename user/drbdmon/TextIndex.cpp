@@ -0,0 +1,363 @@
+#include <TextIndex.h>
+#include <comparators.h>
+#include <cstring>
+
+const size_t TextIndex::MAX_WORD_LENGTH         = 64;
+const size_t TextIndex::MAX_QUERY_WORDS         = 8;
+const size_t TextIndex::MIN_POSTINGS_CAPACITY   = 4;
+
+TextIndex::TextIndex()
+{
+    words_map = std::unique_ptr<WordsMap>(new WordsMap(&comparators::compare_string));
+}
+
+TextIndex::~TextIndex() noexcept
+{
+    clear_impl();
+}
+
+// @throws std::bad_alloc
+void TextIndex::add_text(const uint64_t item_id, const std::string& text)
+{
+    std::string word;
+    size_t offset = 0;
+    while (next_word(text, offset, word))
+    {
+        add_lowercase_word(item_id, word);
+    }
+}
+
+// @throws std::bad_alloc
+void TextIndex::add_word(const uint64_t item_id, const std::string& word)
+{
+    if (!word.empty())
+    {
+        std::string lowercase_word = word.substr(0, MAX_WORD_LENGTH);
+        for (char& word_char : lowercase_word)
+        {
+            if (word_char >= 'A' && word_char <= 'Z')
+            {
+                word_char = static_cast<char> (word_char - 'A' + 'a');
+            }
+        }
+        add_lowercase_word(item_id, lowercase_word);
+    }
+}
+
+void TextIndex::remove_below(const uint64_t min_id) noexcept
+{
+    WordsMap::Node* node = words_map->get_first_node();
+    while (node != nullptr)
+    {
+        WordsMap::Node* const next_node = node->successor();
+        Postings* const postings = node->get_value();
+        postings->remove_below(min_id);
+        if (postings->get_count() == 0)
+        {
+            words_map->remove_node(node);
+            delete postings;
+        }
+        node = next_node;
+    }
+}
+
+void TextIndex::clear() noexcept
+{
+    clear_impl();
+}
+
+bool TextIndex::is_empty() const noexcept
+{
+    return words_map->get_size() == 0;
+}
+
+// @throws std::bad_alloc
+bool TextIndex::find(const std::string& query, Matches& matches) const
+{
+    matches.clear();
+
+    const Postings* query_postings[MAX_QUERY_WORDS];
+    size_t query_word_count = 0;
+    bool have_postings = true;
+
+    std::string word;
+    size_t offset = 0;
+    while (query_word_count < MAX_QUERY_WORDS && next_word(query, offset, word))
+    {
+        query_postings[query_word_count] = words_map->get(&word);
+        if (query_postings[query_word_count] == nullptr)
+        {
+            have_postings = false;
+        }
+        ++query_word_count;
+    }
+
+    if (have_postings && query_word_count >= 1)
+    {
+        // Check the IDs of the least frequent word against the IDs of the other words
+        size_t least_idx = 0;
+        for (size_t idx = 1; idx < query_word_count; ++idx)
+        {
+            if (query_postings[idx]->get_count() < query_postings[least_idx]->get_count())
+            {
+                least_idx = idx;
+            }
+        }
+        const Postings* const least_postings = query_postings[least_idx];
+
+        const size_t max_count = least_postings->get_count();
+        if (matches.capacity < max_count)
+        {
+            matches.ids = std::unique_ptr<uint64_t[]>(new uint64_t[max_count]);
+            matches.capacity = max_count;
+        }
+
+        for (size_t id_idx = least_postings->start; id_idx < least_postings->end; ++id_idx)
+        {
+            const uint64_t item_id = least_postings->ids[id_idx];
+            bool is_match = true;
+            for (size_t idx = 0; idx < query_word_count && is_match; ++idx)
+            {
+                if (idx != least_idx)
+                {
+                    is_match = query_postings[idx]->contains(item_id);
+                }
+            }
+            if (is_match)
+            {
+                matches.ids[matches.count] = item_id;
+                ++matches.count;
+            }
+        }
+    }
+
+    return query_word_count >= 1;
+}
+
+// @throws std::bad_alloc
+void TextIndex::add_lowercase_word(const uint64_t item_id, const std::string& word)
+{
+    Postings* postings = words_map->get(&word);
+    if (postings == nullptr)
+    {
+        std::unique_ptr<Postings> new_postings(new Postings(word));
+        new_postings->append(item_id);
+        words_map->insert(&(new_postings->word), new_postings.get());
+        postings = new_postings.release();
+    }
+    else
+    if (postings->end == postings->start || postings->ids[postings->end - 1] != item_id)
+    {
+        // Items that contain the same word multiple times are added only once
+        postings->append(item_id);
+    }
+}
+
+void TextIndex::clear_impl() noexcept
+{
+    WordsMap::ValuesIterator postings_iter(*words_map);
+    while (postings_iter.has_next())
+    {
+        Postings* const postings = postings_iter.next();
+        delete postings;
+    }
+    words_map->clear();
+}
+
+// @throws std::bad_alloc
+bool TextIndex::next_word(const std::string& text, size_t& offset, std::string& word)
+{
+    word.clear();
+    const size_t text_length = text.length();
+    while (offset < text_length && word.empty())
+    {
+        const char text_char = text[offset];
+        if (text_char == '\x1B')
+        {
+            // Skip escape sequences
+            ++offset;
+            if (offset < text_length && text[offset] == '[')
+            {
+                ++offset;
+                while (offset < text_length && (text[offset] < '@' || text[offset] > '~'))
+                {
+                    ++offset;
+                }
+            }
+            ++offset;
+        }
+        else
+        if (is_word_char(text_char))
+        {
+            const size_t word_start = offset;
+            while (offset < text_length && is_word_char(text[offset]))
+            {
+                ++offset;
+            }
+            size_t trim_start = word_start;
+            size_t trim_end = offset;
+            while (trim_start < trim_end && is_trim_char(text[trim_start]))
+            {
+                ++trim_start;
+            }
+            while (trim_end > trim_start && is_trim_char(text[trim_end - 1]))
+            {
+                --trim_end;
+            }
+
+            const size_t word_length = trim_end - trim_start;
+            word.append(text, trim_start, word_length < MAX_WORD_LENGTH ? word_length : MAX_WORD_LENGTH);
+            for (char& word_char : word)
+            {
+                if (word_char >= 'A' && word_char <= 'Z')
+                {
+                    word_char = static_cast<char> (word_char - 'A' + 'a');
+                }
+            }
+        }
+        else
+        {
+            ++offset;
+        }
+    }
+    return !word.empty();
+}
+
+bool TextIndex::is_word_char(const char text_char) noexcept
+{
+    return (text_char >= 'a' && text_char <= 'z') || (text_char >= 'A' && text_char <= 'Z') ||
+        (text_char >= '0' && text_char <= '9') || text_char == '-' || text_char == '_' || is_trim_char(text_char);
+}
+
+bool TextIndex::is_trim_char(const char text_char) noexcept
+{
+    return text_char == '.' || text_char == ':';
+}
+
+size_t TextIndex::find_ceiling_index(
+    const uint64_t* const   ids,
+    size_t                  start,
+    size_t                  end,
+    const uint64_t          item_id
+) noexcept
+{
+    while (start < end)
+    {
+        const size_t mid = start + (end - start) / 2;
+        if (ids[mid] < item_id)
+        {
+            start = mid + 1;
+        }
+        else
+        {
+            end = mid;
+        }
+    }
+    return start;
+}
+
+TextIndex::Matches::Matches()
+{
+}
+
+TextIndex::Matches::~Matches() noexcept
+{
+}
+
+size_t TextIndex::Matches::get_count() const noexcept
+{
+    return count;
+}
+
+uint64_t TextIndex::Matches::get_id(const size_t idx) const noexcept
+{
+    return ids[idx];
+}
+
+bool TextIndex::Matches::contains(const uint64_t item_id) const noexcept
+{
+    const size_t idx = find_ceiling(item_id);
+    return idx < count && ids[idx] == item_id;
+}
+
+size_t TextIndex::Matches::find_ceiling(const uint64_t item_id) const noexcept
+{
+    return find_ceiling_index(ids.get(), 0, count, item_id);
+}
+
+void TextIndex::Matches::retain(const std::function<bool(uint64_t)>& keep_func)
+{
+    size_t keep_count = 0;
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        if (keep_func(ids[idx]))
+        {
+            ids[keep_count] = ids[idx];
+            ++keep_count;
+        }
+    }
+    count = keep_count;
+}
+
+void TextIndex::Matches::clear() noexcept
+{
+    count = 0;
+}
+
+TextIndex::Postings::Postings(const std::string& word_ref):
+    word(word_ref)
+{
+}
+
+TextIndex::Postings::~Postings() noexcept
+{
+}
+
+// @throws std::bad_alloc
+void TextIndex::Postings::append(const uint64_t item_id)
+{
+    if (end >= capacity)
+    {
+        const size_t count = end - start;
+        // Compact the array instead of growing it if at least half of it is unused
+        size_t new_capacity = capacity;
+        if (count >= capacity / 2)
+        {
+            new_capacity = capacity >= MIN_POSTINGS_CAPACITY ? capacity * 2 : MIN_POSTINGS_CAPACITY;
+        }
+        if (new_capacity != capacity)
+        {
+            std::unique_ptr<uint64_t[]> new_ids(new uint64_t[new_capacity]);
+            if (count >= 1)
+            {
+                std::memcpy(new_ids.get(), &(ids[start]), count * sizeof (uint64_t));
+            }
+            ids = std::move(new_ids);
+            capacity = new_capacity;
+        }
+        else
+        {
+            std::memmove(ids.get(), &(ids[start]), count * sizeof (uint64_t));
+        }
+        start = 0;
+        end = count;
+    }
+    ids[end] = item_id;
+    ++end;
+}
+
+void TextIndex::Postings::remove_below(const uint64_t min_id) noexcept
+{
+    start = find_ceiling_index(ids.get(), start, end, min_id);
+}
+
+size_t TextIndex::Postings::get_count() const noexcept
+{
+    return end - start;
+}
+
+bool TextIndex::Postings::contains(const uint64_t item_id) const noexcept
+{
+    const size_t idx = find_ceiling_index(ids.get(), start, end, item_id);
+    return idx < end && ids[idx] == item_id;
+}
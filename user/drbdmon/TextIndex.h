@@ -0,0 +1,123 @@
+#ifndef TEXTINDEX_H
+#define TEXTINDEX_H
+
+#include <default_types.h>
+#include <new>
+#include <memory>
+#include <string>
+#include <functional>
+#include <QTree.h>
+
+// Inverted index that maps the words contained in text items to the IDs of those items
+//
+// Words consist of letters, digits and the characters '-', '_', '.' and ':', where '.' and ':'
+// are removed from the start and the end of a word. Words are compared case-insensitively.
+// Escape sequences, e.g. terminal color codes, are not indexed.
+class TextIndex
+{
+  public:
+    static const size_t MAX_WORD_LENGTH;
+    static const size_t MAX_QUERY_WORDS;
+    static const size_t MIN_POSTINGS_CAPACITY;
+
+    // IDs of the items that matched a query, in ascending order
+    class Matches
+    {
+        friend class TextIndex;
+
+      public:
+        Matches();
+        virtual ~Matches() noexcept;
+        Matches(const Matches& orig) = delete;
+        Matches& operator=(const Matches& orig) = delete;
+        Matches(Matches&& orig) = delete;
+        Matches& operator=(Matches&& orig) = delete;
+
+        virtual size_t get_count() const noexcept;
+        virtual uint64_t get_id(const size_t idx) const noexcept;
+        virtual bool contains(const uint64_t item_id) const noexcept;
+        // Returns the index of the first ID that is greater than or equal to item_id,
+        // or the number of IDs if there is no such ID
+        virtual size_t find_ceiling(const uint64_t item_id) const noexcept;
+        // Removes the IDs for which keep_func returns false
+        virtual void retain(const std::function<bool(uint64_t)>& keep_func);
+        virtual void clear() noexcept;
+
+      private:
+        std::unique_ptr<uint64_t[]> ids;
+        size_t  capacity    {0};
+        size_t  count       {0};
+    };
+
+    TextIndex();
+    virtual ~TextIndex() noexcept;
+    TextIndex(const TextIndex& orig) = delete;
+    TextIndex& operator=(const TextIndex& orig) = delete;
+    TextIndex(TextIndex&& orig) = delete;
+    TextIndex& operator=(TextIndex&& orig) = delete;
+
+    // Adds the words contained in the text to the index
+    // The IDs of subsequently added items must be greater than or equal to the IDs of previously added items.
+    // @throws std::bad_alloc
+    virtual void add_text(const uint64_t item_id, const std::string& text);
+    // Adds a single word to the index, without splitting it into multiple words
+    // @throws std::bad_alloc
+    virtual void add_word(const uint64_t item_id, const std::string& word);
+    // Removes the IDs of all items with an ID less than min_id from the index
+    virtual void remove_below(const uint64_t min_id) noexcept;
+    virtual void clear() noexcept;
+    virtual bool is_empty() const noexcept;
+
+    // Finds the items that contain all words of the query
+    // Words after the first MAX_QUERY_WORDS words of the query are ignored.
+    // @return False if the query does not contain any words, true otherwise
+    // @throws std::bad_alloc
+    virtual bool find(const std::string& query, Matches& matches) const;
+
+  private:
+    // IDs of the items that contain a word, in ascending order
+    // The word is the key of the map of postings.
+    class Postings
+    {
+      public:
+        explicit Postings(const std::string& word_ref);
+        virtual ~Postings() noexcept;
+
+        std::string                 word;
+        std::unique_ptr<uint64_t[]> ids;
+        size_t                      capacity    {0};
+        // Index of the first valid ID; IDs that were removed from the start remain in the
+        // array until it is compacted
+        size_t                      start       {0};
+        size_t                      end         {0};
+
+        // @throws std::bad_alloc
+        void append(const uint64_t item_id);
+        void remove_below(const uint64_t min_id) noexcept;
+        size_t get_count() const noexcept;
+        bool contains(const uint64_t item_id) const noexcept;
+    };
+
+    using WordsMap = QTree<std::string, Postings>;
+
+    std::unique_ptr<WordsMap>   words_map;
+
+    // @throws std::bad_alloc
+    void add_lowercase_word(const uint64_t item_id, const std::string& word);
+    void clear_impl() noexcept;
+
+    // Extracts the next word from the text, starting at offset
+    // @return True if a word was extracted, false if the end of the text was reached
+    // @throws std::bad_alloc
+    static bool next_word(const std::string& text, size_t& offset, std::string& word);
+    static bool is_word_char(const char text_char) noexcept;
+    static bool is_trim_char(const char text_char) noexcept;
+    static size_t find_ceiling_index(
+        const uint64_t* const   ids,
+        size_t                  start,
+        size_t                  end,
+        const uint64_t          item_id
+    ) noexcept;
+};
+
+#endif /* TEXTINDEX_H */
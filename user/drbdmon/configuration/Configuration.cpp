@@ -5,18 +5,22 @@
 const bool          Configuration::DFLT_DISCARD_SUCC_TASKS  {true};
 const bool          Configuration::DFLT_DISCARD_FAIL_TASKS  {false};
 const bool          Configuration::DFLT_SUSPEND_NEW_TASKS   {false};
+const bool          Configuration::DFLT_BATCH_COMMANDS      {true};
 const bool          Configuration::DFLT_ENABLE_MOUSE_NAV    {true};
 const uint16_t      Configuration::DFLT_DSP_INTERVAL        {200};
 const uint16_t      Configuration::DFLT_COLOR_SCHEME        {0};
 const uint16_t      Configuration::DFLT_CHARACTER_SET       {0};
+const uint16_t      Configuration::DFLT_MAX_ACTIVE_TASKS    {8};
 
 const std::string   Configuration::KEY_DISCARD_SUCC_TASKS   = "DiscardOkTasks";
 const std::string   Configuration::KEY_DISCARD_FAIL_TASKS   = "DiscardFailedTasks";
 const std::string   Configuration::KEY_SUSPEND_NEW_TASKS    = "SuspendNewTasks";
+const std::string   Configuration::KEY_BATCH_COMMANDS       = "BatchCommands";
 const std::string   Configuration::KEY_ENABLE_MOUSE_NAV     = "EnableMouseNav";
 const std::string   Configuration::KEY_DSP_INTERVAL         = "DisplayInterval";
 const std::string   Configuration::KEY_COLOR_SCHEME         = "ColorScheme";
 const std::string   Configuration::KEY_CHARACTER_SET        = "CharacterSet";
+const std::string   Configuration::KEY_MAX_ACTIVE_TASKS     = "MaxActiveTasks";
 
 Configuration::Configuration()
 {
@@ -31,6 +35,8 @@ void Configuration::reset()
     discard_succ_tasks  = DFLT_DISCARD_SUCC_TASKS;
     discard_fail_tasks  = DFLT_DISCARD_FAIL_TASKS;
     suspend_new_tasks   = DFLT_SUSPEND_NEW_TASKS;
+    max_active_tasks    = DFLT_MAX_ACTIVE_TASKS;
+    batch_commands      = DFLT_BATCH_COMMANDS;
     enable_mouse_nav    = DFLT_ENABLE_MOUSE_NAV;
     dsp_interval        = DFLT_DSP_INTERVAL;
     color_scheme        = DFLT_COLOR_SCHEME;
@@ -42,6 +48,8 @@ void Configuration::save_to(CfgEntryStore& config)
     set_entry(config, new CfgEntryBoolean(KEY_DISCARD_SUCC_TASKS, discard_succ_tasks));
     set_entry(config, new CfgEntryBoolean(KEY_DISCARD_FAIL_TASKS, discard_fail_tasks));
     set_entry(config, new CfgEntryBoolean(KEY_SUSPEND_NEW_TASKS, suspend_new_tasks));
+    set_entry(config, new CfgEntryUnsgInt16(KEY_MAX_ACTIVE_TASKS, max_active_tasks));
+    set_entry(config, new CfgEntryBoolean(KEY_BATCH_COMMANDS, batch_commands));
     set_entry(config, new CfgEntryBoolean(KEY_ENABLE_MOUSE_NAV, enable_mouse_nav));
     set_entry(config, new CfgEntryUnsgInt16(KEY_DSP_INTERVAL, dsp_interval));
     set_entry(config, new CfgEntryUnsgInt16(KEY_COLOR_SCHEME, color_scheme));
@@ -53,6 +61,8 @@ void Configuration::load_from(const CfgEntryStore& config)
     discard_succ_tasks  = config.get_boolean(KEY_DISCARD_SUCC_TASKS, DFLT_DISCARD_SUCC_TASKS);
     discard_fail_tasks  = config.get_boolean(KEY_DISCARD_FAIL_TASKS, DFLT_DISCARD_FAIL_TASKS);
     suspend_new_tasks   = config.get_boolean(KEY_SUSPEND_NEW_TASKS, DFLT_SUSPEND_NEW_TASKS);
+    max_active_tasks    = config.get_unsgint16(KEY_MAX_ACTIVE_TASKS, DFLT_MAX_ACTIVE_TASKS);
+    batch_commands      = config.get_boolean(KEY_BATCH_COMMANDS, DFLT_BATCH_COMMANDS);
     enable_mouse_nav    = config.get_boolean(KEY_ENABLE_MOUSE_NAV, DFLT_ENABLE_MOUSE_NAV);
     dsp_interval        = config.get_unsgint16(KEY_DSP_INTERVAL, DFLT_DSP_INTERVAL);
     color_scheme        = config.get_unsgint16(KEY_COLOR_SCHEME, DFLT_COLOR_SCHEME);
@@ -12,22 +12,30 @@ class Configuration
     static const bool           DFLT_DISCARD_SUCC_TASKS;
     static const bool           DFLT_DISCARD_FAIL_TASKS;
     static const bool           DFLT_SUSPEND_NEW_TASKS;
+    static const bool           DFLT_BATCH_COMMANDS;
     static const bool           DFLT_ENABLE_MOUSE_NAV;
     static const uint16_t       DFLT_DSP_INTERVAL;
     static const uint16_t       DFLT_COLOR_SCHEME;
     static const uint16_t       DFLT_CHARACTER_SET;
+    static const uint16_t       DFLT_MAX_ACTIVE_TASKS;
 
     static const std::string    KEY_DISCARD_SUCC_TASKS;
     static const std::string    KEY_DISCARD_FAIL_TASKS;
     static const std::string    KEY_SUSPEND_NEW_TASKS;
+    static const std::string    KEY_BATCH_COMMANDS;
     static const std::string    KEY_ENABLE_MOUSE_NAV;
     static const std::string    KEY_DSP_INTERVAL;
     static const std::string    KEY_COLOR_SCHEME;
     static const std::string    KEY_CHARACTER_SET;
+    static const std::string    KEY_MAX_ACTIVE_TASKS;
 
     bool        discard_succ_tasks      {DFLT_DISCARD_SUCC_TASKS};
     bool        discard_fail_tasks      {DFLT_DISCARD_FAIL_TASKS};
     bool        suspend_new_tasks       {DFLT_SUSPEND_NEW_TASKS};
+    // Maximum number of concurrently executed tasks
+    uint16_t    max_active_tasks        {DFLT_MAX_ACTIVE_TASKS};
+    // Execute commands for multiple selected resources as a single drbdadm command
+    bool        batch_commands          {DFLT_BATCH_COMMANDS};
 
     bool        enable_mouse_nav        {DFLT_ENABLE_MOUSE_NAV};
 
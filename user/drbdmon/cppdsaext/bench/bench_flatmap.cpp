@@ -0,0 +1,180 @@
+/**
+ * Microbenchmark comparing FlatMap and QTree
+ *
+ * Measures lookups, in-order iteration and removing and reinserting entries for maps
+ * with std::string keys of different sizes and reports the time per operation.
+ *
+ * Usage: bench-flatmap [ iterations ]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <QTree.h>
+#include <FlatMap.h>
+
+namespace
+{
+    const size_t DFLT_ITERATIONS {1000000};
+    const size_t MAP_SIZES[] {10, 1000, 10000};
+
+    struct bench_result
+    {
+        double lookup_ns    {0};
+        double iterate_ns   {0};
+        double reinsert_ns  {0};
+    };
+
+    int compare_key(const std::string* key_ptr, const std::string* other_ptr)
+    {
+        return key_ptr->compare(*other_ptr);
+    }
+
+    double elapsed_ns(
+        const std::chrono::steady_clock::time_point& start,
+        const std::chrono::steady_clock::time_point& end,
+        const size_t operations
+    )
+    {
+        const std::chrono::nanoseconds duration =
+            std::chrono::duration_cast<std::chrono::nanoseconds> (end - start);
+        return static_cast<double> (duration.count()) / static_cast<double> (operations);
+    }
+
+    // Prevents the compiler from discarding the results of the measured operations
+    volatile uint64_t result_sink {0};
+
+    // @throws std::bad_alloc
+    template<typename M>
+    bench_result run_bench(
+        const std::vector<std::string>& keys,
+        const std::vector<uint64_t>&    values,
+        const std::vector<size_t>&      access_order,
+        const size_t                    iterations
+    )
+    {
+        bench_result result;
+        M map(&compare_key);
+        const size_t map_size = keys.size();
+        for (size_t idx = 0; idx < map_size; ++idx)
+        {
+            map.insert(&(keys[idx]), &(values[idx]));
+        }
+
+        uint64_t sum {0};
+        {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (size_t count = 0; count < iterations; ++count)
+            {
+                const uint64_t* const value = map.get(&(keys[access_order[count % map_size]]));
+                sum += *value;
+            }
+            const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            result.lookup_ns = elapsed_ns(start, end, iterations);
+        }
+
+        {
+            const size_t rounds = std::max(iterations / map_size, static_cast<size_t> (1));
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (size_t round = 0; round < rounds; ++round)
+            {
+                typename M::ValuesIterator iter(map);
+                while (iter.has_next())
+                {
+                    sum += *(iter.next());
+                }
+            }
+            const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            result.iterate_ns = elapsed_ns(start, end, rounds * map_size);
+        }
+
+        {
+            const size_t reinsert_iterations = std::max(iterations / 10, static_cast<size_t> (1));
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (size_t count = 0; count < reinsert_iterations; ++count)
+            {
+                const size_t idx = access_order[count % map_size];
+                map.remove(&(keys[idx]));
+                map.insert(&(keys[idx]), &(values[idx]));
+            }
+            const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            result.reinsert_ns = elapsed_ns(start, end, reinsert_iterations);
+        }
+
+        result_sink = result_sink + sum;
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t iterations = DFLT_ITERATIONS;
+    if (argc >= 2)
+    {
+        iterations = static_cast<size_t> (std::strtoul(argv[1], nullptr, 10));
+        if (iterations == 0)
+        {
+            std::fprintf(stderr, "Usage: %s [ iterations ]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    try
+    {
+        std::fputs("FlatMap / QTree, std::string keys, ns per operation\n\n", stdout);
+        std::fputs("entries      QTree lookup  FlatMap lookup  QTree iterate  FlatMap iterate  "
+                   "QTree reinsert  FlatMap reinsert\n", stdout);
+
+        std::mt19937 random_gen(1);
+        for (const size_t map_size : MAP_SIZES)
+        {
+            std::vector<std::string> keys;
+            std::vector<uint64_t> values;
+            std::vector<size_t> access_order;
+            keys.reserve(map_size);
+            values.reserve(map_size);
+            access_order.reserve(map_size);
+            for (size_t idx = 0; idx < map_size; ++idx)
+            {
+                keys.push_back("resource-" + std::to_string(random_gen()));
+                values.push_back(idx);
+                access_order.push_back(idx);
+            }
+            std::sort(keys.begin(), keys.end());
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+            values.resize(keys.size());
+            access_order.resize(keys.size());
+            std::shuffle(access_order.begin(), access_order.end(), random_gen);
+
+            const bench_result qtree_result = run_bench<QTree<std::string, uint64_t>>(
+                keys, values, access_order, iterations
+            );
+            const bench_result flatmap_result = run_bench<FlatMap<std::string, uint64_t>>(
+                keys, values, access_order, iterations
+            );
+
+            std::printf(
+                "%7lu  %16.1f  %14.1f  %13.1f  %15.1f  %14.1f  %16.1f\n",
+                static_cast<unsigned long> (keys.size()),
+                qtree_result.lookup_ns, flatmap_result.lookup_ns,
+                qtree_result.iterate_ns, flatmap_result.iterate_ns,
+                qtree_result.reinsert_ns, flatmap_result.reinsert_ns
+            );
+        }
+    }
+    catch (std::bad_alloc&)
+    {
+        std::fputs("Out of memory\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
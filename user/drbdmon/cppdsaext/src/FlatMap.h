@@ -0,0 +1,538 @@
+/**
+ * Ordered map, implemented as a sorted array
+ *
+ * Entries are stored in a contiguous array that is sorted by key, lookups are binary searches.
+ * Compared to QTree, lookups and in-order iteration touch fewer cache lines, while inserting
+ * and removing entries requires moving the entries that follow the insertion or removal point.
+ *
+ * Inserting or removing entries invalidates all Node pointers and all iterators of the map.
+ */
+#ifndef FLATMAP_H
+#define FLATMAP_H
+
+#include <cstddef>
+#include <new>
+
+#include <dsaext.h>
+
+template<typename K, typename V>
+class FlatMap : public dsaext::Map<K, V>
+{
+  public:
+    typedef int (*compare_func)(const K* key, const K* other);
+
+    // Initial capacity of the entries array
+    static const size_t INITIAL_CAPACITY {4};
+
+    class Node
+    {
+        friend class FlatMap;
+
+      private:
+        const K*    key     {nullptr};
+        const V*    value   {nullptr};
+
+      public:
+        Node() = default;
+
+        Node(const K* key_ptr, const V* value_ptr):
+            key(key_ptr),
+            value(value_ptr)
+        {
+        }
+
+        Node(const Node& orig) = default;
+        Node& operator=(const Node& orig) = default;
+        Node(Node&& orig) = default;
+        Node& operator=(Node&& orig) = default;
+        ~Node() = default;
+
+        K* get_key() const
+        {
+            return const_cast<K*> (key);
+        }
+
+        V* get_value() const
+        {
+            return const_cast<V*> (value);
+        }
+    };
+
+  protected:
+    template<typename T>
+    class BaseIterator : public dsaext::QIterator<T>
+    {
+      public:
+        BaseIterator(FlatMap<K, V>& map_ref):
+            map_obj(&map_ref)
+        {
+        }
+
+        BaseIterator(FlatMap<K, V>& map_ref, Node& start_node):
+            map_obj(&map_ref),
+            iter_index(static_cast<size_t> (&start_node - map_ref.entries))
+        {
+        }
+
+        BaseIterator(const BaseIterator& orig) = default;
+        BaseIterator& operator=(const BaseIterator& orig) = default;
+        BaseIterator(BaseIterator&& orig) = default;
+        BaseIterator& operator=(BaseIterator&& orig) = default;
+
+        virtual ~BaseIterator()
+        {
+        }
+
+        virtual T* next() = 0;
+
+        virtual bool has_next() const
+        {
+            return iter_index < map_obj->size;
+        }
+
+        virtual size_t get_size() const
+        {
+            return map_obj->size;
+        }
+
+      protected:
+        virtual Node* next_node()
+        {
+            Node* ret_node = nullptr;
+            if (iter_index < map_obj->size)
+            {
+                ret_node = &(map_obj->entries[iter_index]);
+                ++iter_index;
+            }
+            return ret_node;
+        }
+
+      private:
+        const FlatMap* map_obj;
+        size_t iter_index {0};
+    };
+
+    template<typename T>
+    class BaseReverseIterator : public dsaext::QIterator<T>
+    {
+      public:
+        BaseReverseIterator(FlatMap<K, V>& map_ref):
+            map_obj(&map_ref),
+            iter_count(map_ref.size)
+        {
+        }
+
+        BaseReverseIterator(FlatMap<K, V>& map_ref, Node& start_node):
+            map_obj(&map_ref),
+            iter_count(static_cast<size_t> (&start_node - map_ref.entries) + 1)
+        {
+        }
+
+        BaseReverseIterator(const BaseReverseIterator& orig) = default;
+        BaseReverseIterator& operator=(const BaseReverseIterator& orig) = default;
+        BaseReverseIterator(BaseReverseIterator&& orig) = default;
+        BaseReverseIterator& operator=(BaseReverseIterator&& orig) = default;
+
+        virtual ~BaseReverseIterator()
+        {
+        }
+
+        virtual T* next() = 0;
+
+        virtual bool has_next() const
+        {
+            return iter_count > 0;
+        }
+
+        virtual size_t get_size() const
+        {
+            return map_obj->size;
+        }
+
+      protected:
+        virtual Node* next_node()
+        {
+            Node* ret_node = nullptr;
+            if (iter_count > 0)
+            {
+                --iter_count;
+                ret_node = &(map_obj->entries[iter_count]);
+            }
+            return ret_node;
+        }
+
+      private:
+        const FlatMap* map_obj;
+        // Index of the next node + 1
+        size_t iter_count {0};
+    };
+
+  public:
+    class KeysIterator : public BaseIterator<K>
+    {
+      public:
+        KeysIterator(FlatMap<K, V>& map_ref):
+            BaseIterator<K>::BaseIterator(map_ref)
+        {
+        }
+
+        KeysIterator(FlatMap<K, V>& map_ref, Node& start_node):
+            BaseIterator<K>::BaseIterator(map_ref, start_node)
+        {
+        }
+
+        virtual ~KeysIterator()
+        {
+        }
+
+        virtual K* next()
+        {
+            const K* iter_key {nullptr};
+            Node* node = BaseIterator<K>::next_node();
+            if (node != nullptr)
+            {
+                iter_key = node->key;
+            }
+            return const_cast<K*> (iter_key);
+        }
+    };
+
+    class KeysReverseIterator : public BaseReverseIterator<K>
+    {
+      public:
+        KeysReverseIterator(FlatMap<K, V>& map_ref):
+            BaseReverseIterator<K>::BaseReverseIterator(map_ref)
+        {
+        }
+
+        KeysReverseIterator(FlatMap<K, V>& map_ref, Node& start_node):
+            BaseReverseIterator<K>::BaseReverseIterator(map_ref, start_node)
+        {
+        }
+
+        virtual ~KeysReverseIterator()
+        {
+        }
+
+        virtual K* next()
+        {
+            const K* iter_key {nullptr};
+            Node* node = BaseReverseIterator<K>::next_node();
+            if (node != nullptr)
+            {
+                iter_key = node->key;
+            }
+            return const_cast<K*> (iter_key);
+        }
+    };
+
+    class ValuesIterator : public BaseIterator<V>
+    {
+      public:
+        ValuesIterator(FlatMap<K, V>& map_ref):
+            BaseIterator<V>::BaseIterator(map_ref)
+        {
+        }
+
+        ValuesIterator(FlatMap<K, V>& map_ref, Node& start_node):
+            BaseIterator<V>::BaseIterator(map_ref, start_node)
+        {
+        }
+
+        virtual ~ValuesIterator()
+        {
+        }
+
+        virtual V* next()
+        {
+            const V* iter_value {nullptr};
+            Node* node = BaseIterator<V>::next_node();
+            if (node != nullptr)
+            {
+                iter_value = node->value;
+            }
+            return const_cast<V*> (iter_value);
+        }
+    };
+
+    class ValuesReverseIterator : public BaseReverseIterator<V>
+    {
+      public:
+        ValuesReverseIterator(FlatMap<K, V>& map_ref):
+            BaseReverseIterator<V>::BaseReverseIterator(map_ref)
+        {
+        }
+
+        ValuesReverseIterator(FlatMap<K, V>& map_ref, Node& start_node):
+            BaseReverseIterator<V>::BaseReverseIterator(map_ref, start_node)
+        {
+        }
+
+        virtual ~ValuesReverseIterator()
+        {
+        }
+
+        virtual V* next()
+        {
+            const V* iter_value {nullptr};
+            Node* node = BaseReverseIterator<V>::next_node();
+            if (node != nullptr)
+            {
+                iter_value = node->value;
+            }
+            return const_cast<V*> (iter_value);
+        }
+    };
+
+    class NodesIterator : public BaseIterator<Node>
+    {
+      public:
+        NodesIterator(FlatMap<K, V>& map_ref):
+            BaseIterator<Node>::BaseIterator(map_ref)
+        {
+        }
+
+        NodesIterator(FlatMap<K, V>& map_ref, Node& start_node):
+            BaseIterator<Node>::BaseIterator(map_ref, start_node)
+        {
+        }
+
+        virtual ~NodesIterator()
+        {
+        }
+
+        virtual Node* next()
+        {
+            return BaseIterator<Node>::next_node();
+        }
+    };
+
+    class NodesReverseIterator : public BaseReverseIterator<Node>
+    {
+      public:
+        NodesReverseIterator(FlatMap<K, V>& map_ref):
+            BaseReverseIterator<Node>::BaseReverseIterator(map_ref)
+        {
+        }
+
+        NodesReverseIterator(FlatMap<K, V>& map_ref, Node& start_node):
+            BaseReverseIterator<Node>::BaseReverseIterator(map_ref, start_node)
+        {
+        }
+
+        virtual ~NodesReverseIterator()
+        {
+        }
+
+        virtual Node* next()
+        {
+            return BaseReverseIterator<Node>::next_node();
+        }
+    };
+
+    FlatMap(const compare_func compare_fn):
+        compare(compare_fn)
+    {
+    }
+
+    FlatMap(const FlatMap& orig) = delete;
+    FlatMap& operator=(const FlatMap& orig) = delete;
+    FlatMap(FlatMap&& orig) = delete;
+    FlatMap& operator=(FlatMap&& orig) = delete;
+
+    virtual ~FlatMap()
+    {
+        delete[] entries;
+    }
+
+    virtual V* get(const K* key) const
+    {
+        const V* value {nullptr};
+        const Node* const node = find_node(key);
+        if (node != nullptr)
+        {
+            value = node->value;
+        }
+        return const_cast<V*> (value);
+    }
+
+    virtual typename dsaext::Map<K, V>::entry get_entry(const K* key) const
+    {
+        typename dsaext::Map<K, V>::entry map_entry {nullptr, nullptr};
+        const Node* const node = find_node(key);
+        if (node != nullptr)
+        {
+            map_entry.key = node->key;
+            map_entry.value = node->value;
+        }
+        return map_entry;
+    }
+
+    virtual Node* get_node(const K* key) const
+    {
+        return find_node(key);
+    }
+
+    virtual Node* get_first_node() const
+    {
+        return size > 0 ? &(entries[0]) : nullptr;
+    }
+
+    virtual Node* get_last_node() const
+    {
+        return size > 0 ? &(entries[size - 1]) : nullptr;
+    }
+
+    // Returns the node with the specified key, or with the next greater key
+    virtual Node* get_ceiling_node(const K* key) const
+    {
+        size_t index = 0;
+        static_cast<void> (find_index(key, index));
+        return index < size ? &(entries[index]) : nullptr;
+    }
+
+    // Returns the node with the specified key, or with the next smaller key
+    virtual Node* get_floor_node(const K* key) const
+    {
+        Node* node = nullptr;
+        size_t index = 0;
+        if (find_index(key, index))
+        {
+            node = &(entries[index]);
+        }
+        else
+        if (index > 0)
+        {
+            node = &(entries[index - 1]);
+        }
+        return node;
+    }
+
+    // Returns the node at the specified index in key order, or nullptr if the index is out of range
+    virtual Node* get_node_at_index(const size_t index) const
+    {
+        return index < size ? &(entries[index]) : nullptr;
+    }
+
+    // Returns the index in key order of a node of this map
+    virtual size_t get_node_index(const Node* node) const
+    {
+        return static_cast<size_t> (node - entries);
+    }
+
+    // @throws std::bad_alloc, dsaext::DuplicateInsertException
+    virtual void insert(const K* key, const V* value)
+    {
+        size_t index = 0;
+        if (find_index(key, index))
+        {
+            throw dsaext::DuplicateInsertException();
+        }
+
+        if (size >= capacity)
+        {
+            grow();
+        }
+
+        for (size_t move_index = size; move_index > index; --move_index)
+        {
+            entries[move_index] = entries[move_index - 1];
+        }
+        entries[index] = Node(key, value);
+        ++size;
+    }
+
+    virtual void remove(const K* key)
+    {
+        Node* const node = find_node(key);
+        if (node != nullptr)
+        {
+            remove_node(node);
+        }
+    }
+
+    virtual void remove_node(Node* node)
+    {
+        const size_t index = static_cast<size_t> (node - entries);
+        --size;
+        for (size_t move_index = index; move_index < size; ++move_index)
+        {
+            entries[move_index] = entries[move_index + 1];
+        }
+        entries[size] = Node();
+    }
+
+    virtual void clear()
+    {
+        delete[] entries;
+        entries = nullptr;
+        capacity = 0;
+        size = 0;
+    }
+
+    virtual size_t get_size() const
+    {
+        return size;
+    }
+
+  private:
+    Node*   entries     {nullptr};
+    size_t  capacity    {0};
+    size_t  size        {0};
+
+    const compare_func compare;
+
+    // Searches for the entry with the specified key
+    // Returns true if an entry with the specified key was found and sets index to the entry's index,
+    // otherwise returns false and sets index to the index of the first entry with a greater key
+    inline bool find_index(const K* const key, size_t& index) const
+    {
+        bool found = false;
+        size_t low_index = 0;
+        size_t high_index = size;
+        while (low_index < high_index)
+        {
+            const size_t mid_index = low_index + (high_index - low_index) / 2;
+            const int cmp_rc = compare(key, entries[mid_index].key);
+            if (cmp_rc > 0)
+            {
+                low_index = mid_index + 1;
+            }
+            else
+            if (cmp_rc < 0)
+            {
+                high_index = mid_index;
+            }
+            else
+            {
+                low_index = mid_index;
+                found = true;
+                break;
+            }
+        }
+        index = low_index;
+        return found;
+    }
+
+    inline Node* find_node(const K* const key) const
+    {
+        size_t index = 0;
+        return find_index(key, index) ? &(entries[index]) : nullptr;
+    }
+
+    // @throws std::bad_alloc
+    inline void grow()
+    {
+        const size_t new_capacity = capacity > 0 ? capacity * 2 : INITIAL_CAPACITY;
+        Node* const new_entries = new Node[new_capacity];
+        for (size_t index = 0; index < size; ++index)
+        {
+            new_entries[index] = entries[index];
+        }
+        delete[] entries;
+        entries = new_entries;
+        capacity = new_capacity;
+    }
+};
+
+#endif /* FLATMAP_H */
@@ -16,6 +16,7 @@
 #include <new>
 
 #include <dsaext.h>
+#include <SlabPool.h>
 
 template<typename K, typename V>
 class QTree : public dsaext::Map<K, V>
@@ -41,6 +42,8 @@ class QTree : public dsaext::Map<K, V>
         Node*       greater {nullptr};
         Node*       parent  {nullptr};
         int         balance {0};
+        // Number of nodes in the subtree that starts at this node
+        size_t      count   {1};
 
       public:
         Node(const K* key_ptr, const V* value_ptr)
@@ -159,6 +162,7 @@ class QTree : public dsaext::Map<K, V>
             greater = nullptr;
             parent  = nullptr;
             balance = 0;
+            count   = 1;
         }
     };
 
@@ -517,7 +521,10 @@ class QTree : public dsaext::Map<K, V>
     };
 
   public:
-    QTree(const compare_func compare_fn):
+    // If a node pool is specified, the tree's nodes are allocated from that pool,
+    // otherwise the nodes are allocated using the global operator new
+    QTree(const compare_func compare_fn, SlabPool* const node_pool_ref = nullptr):
+        node_pool(node_pool_ref),
         compare(compare_fn)
     {
     }
@@ -794,6 +801,46 @@ class QTree : public dsaext::Map<K, V>
         return find_less_node_impl(key);
     }
 
+    // Returns the node at the specified index in key order, or nullptr if the index is out of range
+    virtual Node* get_node_at_index(size_t index) const
+    {
+        Node* node = root;
+        while (node != nullptr)
+        {
+            const size_t less_count = subtree_count(node->less);
+            if (index < less_count)
+            {
+                node = node->less;
+            }
+            else
+            if (index > less_count)
+            {
+                index -= less_count + 1;
+                node = node->greater;
+            }
+            else
+            {
+                break;
+            }
+        }
+        return node;
+    }
+
+    // Returns the index in key order of a node of this tree
+    virtual size_t get_node_index(const Node* node) const
+    {
+        size_t index = subtree_count(node->less);
+        while (node->parent != nullptr)
+        {
+            if (node->parent->greater == node)
+            {
+                index += subtree_count(node->parent->less) + 1;
+            }
+            node = node->parent;
+        }
+        return index;
+    }
+
     // @throws std::bad_alloc, dsaext::DuplicateInsertionException
     virtual void insert(const K* key, const V* value)
     {
@@ -906,9 +953,11 @@ class QTree : public dsaext::Map<K, V>
         return const_cast<V*> (prev_value);
     }
 
+    // If the tree has a node pool, the node must have been allocated from that pool
     // @throws std::bad_alloc, dsaext::DuplicateInsertionException
     virtual void insert_node(Node* node)
     {
+        node->count = 1;
         if (root == nullptr)
         {
             root = node;
@@ -927,6 +976,7 @@ class QTree : public dsaext::Map<K, V>
                         parent_node->less = node;
                         node->parent = parent_node;
                         ++size;
+                        increment_path_count(parent_node);
                         rebalance_insert(node, parent_node);
                         break;
                     }
@@ -943,6 +993,7 @@ class QTree : public dsaext::Map<K, V>
                         parent_node->greater = node;
                         node->parent = parent_node;
                         ++size;
+                        increment_path_count(parent_node);
                         rebalance_insert(node, parent_node);
                         break;
                     }
@@ -1020,11 +1071,40 @@ class QTree : public dsaext::Map<K, V>
                         node->greater = nullptr;
                     }
                 }
-                delete leaf;
+                free_node(leaf);
             }
         }
     }
 
+    // @throws std::bad_alloc
+    inline Node* allocate_node(const K* const key, const V* const value)
+    {
+        Node* node = nullptr;
+        if (node_pool != nullptr)
+        {
+            void* const node_mem = node_pool->allocate(sizeof (Node));
+            node = new (node_mem) Node(key, value);
+        }
+        else
+        {
+            node = new Node(key, value);
+        }
+        return node;
+    }
+
+    inline void free_node(Node* const node)
+    {
+        if (node_pool != nullptr)
+        {
+            node->~Node();
+            node_pool->deallocate(static_cast<void*> (node), sizeof (Node));
+        }
+        else
+        {
+            delete node;
+        }
+    }
+
     inline Node* find_node(const K* key) const
     {
         Node* node = root;
@@ -1236,7 +1316,7 @@ class QTree : public dsaext::Map<K, V>
     inline void remove_node_impl(Node* rm_node)
     {
         unlink_node_impl(rm_node);
-        delete rm_node;
+        free_node(rm_node);
     }
 
     // @throws std::bad_alloc
@@ -1247,16 +1327,46 @@ class QTree : public dsaext::Map<K, V>
         const V* const value
     )
     {
-        Node* ins_node = new Node(key, value);
+        Node* ins_node = allocate_node(key, value);
         *ref_ins_node = ins_node;
         ins_node->parent = parent_node;
         ++size;
         if (parent_node != nullptr)
         {
+            increment_path_count(parent_node);
             rebalance_insert(ins_node, parent_node);
         }
     }
 
+    static inline size_t subtree_count(const Node* const node)
+    {
+        return node != nullptr ? node->count : 0;
+    }
+
+    // Recalculates the node count of a node whose subtrees were changed by a rotation
+    static inline void update_count(Node* const node)
+    {
+        node->count = subtree_count(node->less) + subtree_count(node->greater) + 1;
+    }
+
+    static inline void increment_path_count(Node* node)
+    {
+        while (node != nullptr)
+        {
+            ++(node->count);
+            node = node->parent;
+        }
+    }
+
+    static inline void decrement_path_count(Node* node)
+    {
+        while (node != nullptr)
+        {
+            --(node->count);
+            node = node->parent;
+        }
+    }
+
     inline void unlink_node_impl(Node* rm_node)
     {
         --size;
@@ -1273,6 +1383,7 @@ class QTree : public dsaext::Map<K, V>
             {
                 // non-root node leaf
                 Node* rot_node = rm_node->parent;
+                decrement_path_count(rot_node);
 
                 QTree::qtree_dir dir;
                 if (rot_node->less == rm_node)
@@ -1319,6 +1430,8 @@ class QTree : public dsaext::Map<K, V>
                 }
             }
             Node* rot_node = replace_node->parent;
+            // The path from the replacement node's parent to the root includes the node to remove
+            decrement_path_count(rot_node);
 
             QTree::qtree_dir dir;
             if (rot_node->less == replace_node)
@@ -1405,6 +1518,7 @@ class QTree : public dsaext::Map<K, V>
             replace_node->less    = rm_node->less;
             replace_node->greater = rm_node->greater;
             replace_node->balance = rm_node->balance;
+            replace_node->count   = rm_node->count;
 
             if (rot_node == rm_node)
             {
@@ -1470,6 +1584,8 @@ class QTree : public dsaext::Map<K, V>
 
                     sub_node->greater = rot_node;
                     rot_node->parent = sub_node;
+                    update_count(rot_node);
+                    update_count(sub_node);
                 }
                 else
                 {
@@ -1524,6 +1640,9 @@ class QTree : public dsaext::Map<K, V>
 
                     rot_node->parent          = sub_node->parent;
                     sub_node->parent->greater = rot_node;
+                    update_count(rot_node);
+                    update_count(sub_node);
+                    update_count(rot_node->parent);
                 }
                 break;
             }
@@ -1561,6 +1680,8 @@ class QTree : public dsaext::Map<K, V>
 
                     sub_node->less = rot_node;
                     rot_node->parent = sub_node;
+                    update_count(rot_node);
+                    update_count(sub_node);
                 }
                 else
                 {
@@ -1615,6 +1736,9 @@ class QTree : public dsaext::Map<K, V>
 
                     rot_node->parent       = sub_node->parent;
                     sub_node->parent->less = rot_node;
+                    update_count(rot_node);
+                    update_count(sub_node);
+                    update_count(rot_node->parent);
                 }
                 break;
             }
@@ -1694,6 +1818,8 @@ class QTree : public dsaext::Map<K, V>
 
                     sub_node->greater = rot_node;
                     rot_node->parent  = sub_node;
+                    update_count(rot_node);
+                    update_count(sub_node);
 
                     if (sub_node->balance == 0)
                     {
@@ -1760,6 +1886,9 @@ class QTree : public dsaext::Map<K, V>
 
                     rot_node->parent          = sub_node->parent;
                     sub_node->parent->greater = rot_node;
+                    update_count(rot_node);
+                    update_count(sub_node);
+                    update_count(rot_node->parent);
                 }
                 rot_node = rot_node->parent;
                 // end of R / LR rotations
@@ -1797,6 +1926,8 @@ class QTree : public dsaext::Map<K, V>
 
                     sub_node->less   = rot_node;
                     rot_node->parent = sub_node;
+                    update_count(rot_node);
+                    update_count(sub_node);
                     if (sub_node->balance == 0)
                     {
                         rot_node->balance = 1;
@@ -1862,6 +1993,9 @@ class QTree : public dsaext::Map<K, V>
 
                     rot_node->parent       = sub_node->parent;
                     sub_node->parent->less = rot_node;
+                    update_count(rot_node);
+                    update_count(sub_node);
+                    update_count(rot_node->parent);
                 }
                 rot_node = rot_node->parent;
                 // end of L / RL rotations
@@ -1874,6 +2008,8 @@ class QTree : public dsaext::Map<K, V>
     Node*  root {nullptr};
     size_t size {0};
 
+    SlabPool* node_pool {nullptr};
+
     const compare_func compare;
 };
 
@@ -0,0 +1,128 @@
+/**
+ * Fixed size block allocator
+ */
+#include <SlabPool.h>
+
+const size_t SlabPool::DFLT_SLAB_BLOCKS = 64;
+
+SlabPool::SlabPool(const size_t pool_block_size, const size_t pool_slab_blocks):
+    block_size(align_size(pool_block_size < sizeof (free_block) ? sizeof (free_block) : pool_block_size)),
+    slab_blocks(pool_slab_blocks > 0 ? pool_slab_blocks : 1),
+    slab_size(align_size(sizeof (slab_header)) + block_size * slab_blocks)
+{
+}
+
+SlabPool::~SlabPool() noexcept
+{
+    free_slabs();
+}
+
+// @throws std::bad_alloc
+void* SlabPool::allocate(const size_t size)
+{
+    void* block = nullptr;
+    if (size <= block_size)
+    {
+        if (free_list == nullptr)
+        {
+            add_slab();
+        }
+        block = static_cast<void*> (free_list);
+        free_list = free_list->next;
+        ++blocks_in_use;
+    }
+    else
+    {
+        block = ::operator new(size);
+    }
+    return block;
+}
+
+void SlabPool::deallocate(void* const block, const size_t size) noexcept
+{
+    if (block != nullptr)
+    {
+        if (size <= block_size)
+        {
+            free_block* const returned_block = static_cast<free_block*> (block);
+            returned_block->next = free_list;
+            free_list = returned_block;
+            --blocks_in_use;
+        }
+        else
+        {
+            ::operator delete(block);
+        }
+    }
+}
+
+bool SlabPool::release_unused() noexcept
+{
+    const bool empty = blocks_in_use == 0;
+    if (empty)
+    {
+        free_slabs();
+    }
+    return empty;
+}
+
+size_t SlabPool::get_block_size() const noexcept
+{
+    return block_size;
+}
+
+size_t SlabPool::get_blocks_in_use() const noexcept
+{
+    return blocks_in_use;
+}
+
+size_t SlabPool::get_slab_count() const noexcept
+{
+    return slab_count;
+}
+
+size_t SlabPool::get_footprint() const noexcept
+{
+    return slab_count * slab_size;
+}
+
+// @throws std::bad_alloc
+void SlabPool::add_slab()
+{
+    // The global operator new returns memory that is suitably aligned for any object type
+    char* const slab_data = static_cast<char*> (::operator new(slab_size));
+
+    slab_header* const slab = reinterpret_cast<slab_header*> (slab_data);
+    slab->next = slab_list;
+    slab_list = slab;
+    ++slab_count;
+
+    // Add the slab's blocks to the free list in address order
+    char* const blocks_data = slab_data + align_size(sizeof (slab_header));
+    for (size_t idx = slab_blocks; idx > 0; --idx)
+    {
+        free_block* const block = reinterpret_cast<free_block*> (blocks_data + (idx - 1) * block_size);
+        block->next = free_list;
+        free_list = block;
+    }
+}
+
+void SlabPool::free_slabs() noexcept
+{
+    slab_header* slab = slab_list;
+    while (slab != nullptr)
+    {
+        slab_header* const next_slab = slab->next;
+        ::operator delete(static_cast<void*> (slab));
+        slab = next_slab;
+    }
+    slab_list = nullptr;
+    free_list = nullptr;
+    slab_count = 0;
+}
+
+size_t SlabPool::align_size(const size_t size) noexcept
+{
+    const size_t alignment = alignof (std::max_align_t);
+    return ((size + alignment - 1) / alignment) * alignment;
+}
@@ -0,0 +1,79 @@
+/**
+ * Fixed size block allocator
+ *
+ * Allocates blocks of a fixed size from slabs that contain multiple blocks.
+ * Deallocated blocks are kept on a free list and are reused by subsequent allocations.
+ * Slabs are only returned to the system by release_unused() if no blocks are in use,
+ * or if the pool is destroyed.
+ *
+ * Instances are not thread-safe.
+ */
+#ifndef SLABPOOL_H
+#define SLABPOOL_H
+
+#include <cstddef>
+#include <new>
+
+class SlabPool
+{
+  public:
+    // Default number of blocks per slab
+    static const size_t DFLT_SLAB_BLOCKS;
+
+    SlabPool(size_t pool_block_size, size_t pool_slab_blocks = DFLT_SLAB_BLOCKS);
+    SlabPool(const SlabPool& orig) = delete;
+    SlabPool& operator=(const SlabPool& orig) = delete;
+    SlabPool(SlabPool&& orig) = delete;
+    SlabPool& operator=(SlabPool&& orig) = delete;
+    virtual ~SlabPool() noexcept;
+
+    // Allocates a block from the pool
+    // Requests for more than the pool's block size are forwarded to the global operator new
+    // @throws std::bad_alloc
+    void* allocate(size_t size);
+
+    // Returns a block to the pool
+    // size must be the same value that was used to allocate the block
+    void deallocate(void* block, size_t size) noexcept;
+
+    // Frees all slabs if no blocks are in use
+    // @return true if the pool is empty, false otherwise
+    bool release_unused() noexcept;
+
+    size_t get_block_size() const noexcept;
+    size_t get_blocks_in_use() const noexcept;
+    size_t get_slab_count() const noexcept;
+
+    // Number of bytes allocated for slabs
+    size_t get_footprint() const noexcept;
+
+  private:
+    typedef struct free_block_s
+    {
+        struct free_block_s* next;
+    }
+    free_block;
+
+    typedef struct slab_header_s
+    {
+        struct slab_header_s* next;
+    }
+    slab_header;
+
+    const size_t block_size;
+    const size_t slab_blocks;
+    const size_t slab_size;
+
+    slab_header*    slab_list       {nullptr};
+    free_block*     free_list       {nullptr};
+    size_t          blocks_in_use   {0};
+    size_t          slab_count      {0};
+
+    // @throws std::bad_alloc
+    void add_slab();
+    void free_slabs() noexcept;
+
+    static size_t align_size(size_t size) noexcept;
+};
+
+#endif /* SLABPOOL_H */
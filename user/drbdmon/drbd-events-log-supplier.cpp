@@ -1,15 +1,24 @@
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <map>
+
+#include <timestamps.h>
 
 extern "C"
 {
     #include <unistd.h>
+    #include <time.h>
+    #include <errno.h>
 }
 
 constexpr int ERR_OUT_OF_MEMORY     = 2;
 constexpr int ERR_IO                = 3;
+constexpr int ERR_ARGS              = 4;
 
 const std::string EVENT_EXISTS("exists");
 const std::string EVENT_CREATE("create");
@@ -26,13 +35,73 @@ const std::string* const EVENT_TYPES[] =
 const std::string INIT_STATE_SEPA("exists -");
 const size_t      INIT_STATE_SEPA_LENGTH = INIT_STATE_SEPA.length();
 
+const std::string OBJ_RESOURCE("resource");
+const std::string OBJ_CONNECTION("connection");
+const std::string OBJ_DEVICE("device");
+const std::string OBJ_PEER_DEVICE("peer-device");
+const std::string OBJ_PATH("path");
+
+const std::string PROP_NAME("name");
+const std::string PROP_PEER_NODE_ID("peer-node-id");
+const std::string PROP_VOLUME("volume");
+const std::string PROP_LOCAL("local");
+const std::string PROP_PEER("peer");
+
+const std::string OPT_SEEK("--seek");
+const std::string OPT_SPEED("--speed");
+const std::string OPT_BUILD_INDEX("--build-index");
+
+const std::string INDEX_SUFFIX(".idx");
+const std::string INDEX_HEADER("drbd-events-log-index 1");
+const std::string INDEX_LOG_SIZE("log-size");
+const std::string INDEX_CHECKPOINT("checkpoint");
+
+// Separates the components of the keys in the state map
+constexpr char    KEY_SEPA              = '\x1F';
+
+// Amount of event log data between two full-state snapshots in the index file
+constexpr uint64_t CHECKPOINT_INTERVAL  = 32ULL << 20;
+
+// Longest delay between two replayed events, so that long idle periods
+// of the cluster do not stop the replay for hours
+constexpr int64_t MAX_REPLAY_DELAY      = 5000000;
+
+// Maps the key of each DRBD object to the properties of the object
+// The keys sort objects of a resource after the resource, and peer devices after connections and devices,
+// so that the objects are emitted in an order that allows DRBDmon to create them.
+typedef std::map<std::string, std::string> StateMap;
+
 int process_events(const std::string& path);
+int replay_events(const std::string& path, const int64_t* const seek_usecs_ptr, const double speed);
+int build_index(const std::string& path);
 bool is_init_state_sepa(const std::string& event_line);
 static inline void process_event_line(
     const bool skip_timestamp,
     bool& have_init_state_sepa,
     std::string& event_line
 );
+static bool has_timestamps(std::ifstream& in_file);
+static bool read_event_line(
+    std::ifstream& in_file,
+    std::string& event_line,
+    std::string& timestamp,
+    std::string& event,
+    uint64_t& offset
+);
+static bool is_before(const std::string& timestamp, const int64_t seek_usecs);
+static void apply_event(StateMap& state, const std::string& event);
+static void emit_state(const StateMap& state);
+static bool load_checkpoint(
+    const std::string& path,
+    const int64_t seek_usecs,
+    StateMap& state,
+    uint64_t& offset
+);
+static std::string get_prop(const std::string& props, const std::string& key);
+static void merge_props(std::string& props, const std::string& update);
+static void erase_prefix(StateMap& state, const std::string& prefix);
+static uint64_t get_file_size(const std::string& path);
+static void replay_delay(const int64_t usecs);
 
 /**
  * DRBD events log file supplier for DRBDmon
@@ -43,15 +112,73 @@ int main(int argc, char* argv[])
 
     try
     {
-        if (argc == 2)
+        int64_t seek_usecs = 0;
+        bool have_seek_time = false;
+        double speed = 0;
+        bool index_mode = false;
+        bool args_valid = argc >= 2;
+
+        int arg_idx = 1;
+        while (args_valid && arg_idx < argc - 1)
+        {
+            const std::string option(argv[arg_idx]);
+            if (option == OPT_BUILD_INDEX)
+            {
+                index_mode = true;
+                ++arg_idx;
+            }
+            else
+            if (option == OPT_SEEK && arg_idx + 2 < argc)
+            {
+                have_seek_time = true;
+                args_valid = timestamps::parse_timestamp(argv[arg_idx + 1], seek_usecs);
+                arg_idx += 2;
+            }
+            else
+            if (option == OPT_SPEED && arg_idx + 2 < argc)
+            {
+                char* parse_end = nullptr;
+                speed = std::strtod(argv[arg_idx + 1], &parse_end);
+                args_valid = parse_end != argv[arg_idx + 1] && *parse_end == '\0' && speed > 0;
+                arg_idx += 2;
+            }
+            else
+            {
+                args_valid = false;
+            }
+        }
+
+        if (args_valid)
         {
-            std::string path(argv[1]);
-            exit_code = process_events(path);
+            std::string path(argv[argc - 1]);
+            if (index_mode)
+            {
+                exit_code = build_index(path);
+            }
+            else
+            if (have_seek_time || speed > 0)
+            {
+                exit_code = replay_events(path, have_seek_time ? &seek_usecs : nullptr, speed);
+            }
+            else
+            {
+                exit_code = process_events(path);
+            }
         }
         else
         {
             std::cerr << "DRBD Events Log File Supplier | Arguments:\n" <<
-                "    path .......... Path to a file containing DBRD event lines\n";
+                "    [ --seek <time> ] [ --speed <factor> ] path\n" <<
+                "    --build-index path\n" <<
+                "    path .......... Path to a file containing DBRD event lines\n" <<
+                "    --seek ........ Emit the DRBD state at the specified time, e.g. 2024-03-01T14:20,\n" <<
+                "                    2024-03-01T14:20:05+01:00 or 2024-03-01, without an UTC offset\n" <<
+                "                    in local time\n" <<
+                "    --speed ....... Replay the events following the initial state, or following the\n" <<
+                "                    time specified by --seek, faster by the specified factor\n" <<
+                "    --build-index . Create an index of state snapshots for fast seeking in path" <<
+                INDEX_SUFFIX << '\n';
+            exit_code = ERR_ARGS;
         }
     }
     catch (std::bad_alloc&)
@@ -181,6 +308,207 @@ int process_events(const std::string& path)
     return rc;
 }
 
+/**
+ * Emits the DRBD state at the specified time as the initial state, and optionally replays
+ * the events following that time with the delays between the events scaled by 1 / speed.
+ *
+ * If an index file created by build_index() is present, the state is restored from the
+ * closest snapshot before the specified time, and only the remaining events are read from
+ * the events log file.
+ *
+ * Like process_events(), this method suspends indefinitely after emitting all events.
+ */
+int replay_events(const std::string& path, const int64_t* const seek_usecs_ptr, const double speed)
+{
+    int rc = ERR_IO;
+
+    // Internal pipe used for suspending execution
+    int pipe_fd[2];
+    int pipe_rc = pipe(pipe_fd);
+    std::ifstream in_file(path);
+    if (pipe_rc != 0)
+    {
+        // Cannot create the pipe used for suspending.
+        // Typically a resource exhaustion problem, e.g. the OS being out of memory.
+        std::cerr << "I/O error, pipe creation failed\n";
+    }
+    else
+    if (in_file.good())
+    {
+        if (has_timestamps(in_file))
+        {
+            StateMap state;
+            uint64_t offset = 0;
+            if (seek_usecs_ptr != nullptr && load_checkpoint(path, *seek_usecs_ptr, state, offset))
+            {
+                in_file.seekg(static_cast<std::streamoff> (offset));
+            }
+
+            std::string event_line;
+            std::string timestamp;
+            std::string event;
+
+            // Collect the state up to the specified time, or the initial state if no time was specified
+            bool have_event = false;
+            bool collecting = true;
+            while (collecting && read_event_line(in_file, event_line, timestamp, event, offset))
+            {
+                const bool is_exists_event = event.compare(0, EVENT_EXISTS.length(), EVENT_EXISTS) == 0;
+                if (seek_usecs_ptr == nullptr ? is_exists_event : is_before(timestamp, *seek_usecs_ptr))
+                {
+                    apply_event(state, event);
+                }
+                else
+                {
+                    collecting = false;
+                    have_event = true;
+                }
+            }
+
+            emit_state(state);
+
+            if (speed > 0)
+            {
+                int64_t prev_usecs = 0;
+                bool have_prev_usecs = false;
+                while (have_event)
+                {
+                    // 'exists' events after the initial state, e.g. in concatenated event logs,
+                    // would be rejected by DRBDmon
+                    const bool is_exists_event = event.compare(0, EVENT_EXISTS.length(), EVENT_EXISTS) == 0;
+                    if (!is_exists_event && !event.empty())
+                    {
+                        int64_t event_usecs = 0;
+                        if (timestamps::parse_timestamp(timestamp, event_usecs))
+                        {
+                            if (have_prev_usecs && event_usecs > prev_usecs)
+                            {
+                                std::cout << std::flush;
+                                replay_delay(static_cast<int64_t> ((event_usecs - prev_usecs) / speed));
+                            }
+                            prev_usecs = event_usecs;
+                            have_prev_usecs = true;
+                        }
+                        std::cout << event << '\n';
+                    }
+                    have_event = read_event_line(in_file, event_line, timestamp, event, offset);
+                }
+            }
+
+            if (in_file.eof() || speed <= 0)
+            {
+                std::cout << std::flush;
+
+                rc = EXIT_SUCCESS;
+
+                // Suspend execution indefinitely. DRBDmon will terminate this process when it exits.
+                char in_char = 0;
+                const ssize_t read_count = read(pipe_fd[0], &in_char, 1);
+                // Nothing to do with that result...
+                static_cast<void> (read_count);
+            }
+            else
+            {
+                std::cerr << "I/O error while reading DRBD events file \"" << path << "\"\n";
+            }
+        }
+        else
+        {
+            std::cerr << "The DRBD events file \"" << path << "\" does not contain timestamps\n";
+            rc = ERR_ARGS;
+        }
+    }
+    else
+    {
+        std::cerr << "I/O error, cannot read DRBD events file \"" << path << "\"\n";
+    }
+
+    return rc;
+}
+
+/**
+ * Creates the index file for an events log file
+ *
+ * The index file contains the size of the events log file and a sequence of checkpoints.
+ * Each checkpoint consists of a line with the offset of the next event in the events log file,
+ * the timestamp of the last event before that offset and the number of lines in the
+ * snapshot, followed by a snapshot of the DRBD state at that offset in the form of
+ * 'exists' events.
+ */
+int build_index(const std::string& path)
+{
+    int rc = ERR_IO;
+
+    std::ifstream in_file(path);
+    if (in_file.good())
+    {
+        if (has_timestamps(in_file))
+        {
+            const std::string index_path(path + INDEX_SUFFIX);
+            std::ofstream index_file(index_path, std::ios::out | std::ios::trunc);
+            if (index_file.good())
+            {
+                index_file << INDEX_HEADER << '\n';
+                index_file << INDEX_LOG_SIZE << ' ' << get_file_size(path) << '\n';
+
+                StateMap state;
+                uint64_t offset = 0;
+                uint64_t checkpoint_offset = 0;
+                bool have_init_state_sepa = false;
+
+                std::string event_line;
+                std::string timestamp;
+                std::string event;
+                while (read_event_line(in_file, event_line, timestamp, event, offset))
+                {
+                    apply_event(state, event);
+                    if (is_init_state_sepa(event))
+                    {
+                        have_init_state_sepa = true;
+                    }
+
+                    // A checkpoint is only useful once the state is complete
+                    if (have_init_state_sepa && !timestamp.empty() && offset - checkpoint_offset >= CHECKPOINT_INTERVAL)
+                    {
+                        index_file << INDEX_CHECKPOINT << ' ' << offset << ' ' << timestamp << ' ' <<
+                            state.size() << '\n';
+                        for (StateMap::const_iterator obj_iter = state.begin(); obj_iter != state.end(); ++obj_iter)
+                        {
+                            index_file << EVENT_EXISTS << ' ' << obj_iter->second << '\n';
+                        }
+                        checkpoint_offset = offset;
+                    }
+                }
+
+                index_file << std::flush;
+                if (in_file.eof() && index_file.good())
+                {
+                    rc = EXIT_SUCCESS;
+                }
+                else
+                {
+                    std::cerr << "I/O error while creating the index file \"" << index_path << "\"\n";
+                }
+            }
+            else
+            {
+                std::cerr << "I/O error, cannot create the index file \"" << index_path << "\"\n";
+            }
+        }
+        else
+        {
+            std::cerr << "The DRBD events file \"" << path << "\" does not contain timestamps\n";
+            rc = ERR_ARGS;
+        }
+    }
+    else
+    {
+        std::cerr << "I/O error, cannot read DRBD events file \"" << path << "\"\n";
+    }
+
+    return rc;
+}
+
 /**
  * Checks whether an events line is the initial state separator
  */
@@ -198,3 +526,366 @@ bool is_init_state_sepa(const std::string& event_line)
     }
     return result;
 }
+
+/**
+ * Checks whether the first line of the file has a timestamp before the event type,
+ * and rewinds the file
+ */
+static bool has_timestamps(std::ifstream& in_file)
+{
+    std::string event_line;
+    std::getline(in_file, event_line);
+    const size_t event_pos = event_line.find(EVENT_EXISTS);
+    in_file.clear();
+    in_file.seekg(0);
+    return event_pos != std::string::npos && event_pos != 0;
+}
+
+/**
+ * Reads the next line from an events log file with timestamps and splits it into the timestamp and the event
+ *
+ * Offset is advanced to the start of the next line.
+ */
+static bool read_event_line(
+    std::ifstream& in_file,
+    std::string& event_line,
+    std::string& timestamp,
+    std::string& event,
+    uint64_t& offset
+)
+{
+    event_line.clear();
+    timestamp.clear();
+    event.clear();
+
+    std::getline(in_file, event_line);
+    const bool have_line = !in_file.fail();
+    if (have_line)
+    {
+        offset += event_line.length() + (in_file.eof() ? 0 : 1);
+
+        // The timestamp precedes the event
+        const size_t timestamp_end = event_line.find(' ');
+        if (timestamp_end != std::string::npos)
+        {
+            timestamp = event_line.substr(0, timestamp_end);
+            event = event_line.substr(timestamp_end + 1);
+        }
+    }
+    return have_line;
+}
+
+/**
+ * Checks whether a timestamp is before the seek time
+ *
+ * The timestamp is compared as a point in time, so that the UTC offset of the events log,
+ * which may change at daylight saving time transitions, does not matter.
+ * Lines without a valid timestamp do not end the state before the seek time.
+ */
+static bool is_before(const std::string& timestamp, const int64_t seek_usecs)
+{
+    int64_t usecs = 0;
+    return !timestamps::parse_timestamp(timestamp, usecs) || usecs < seek_usecs;
+}
+
+/**
+ * Applies an event to the state of the DRBD objects
+ */
+static void apply_event(StateMap& state, const std::string& event)
+{
+    const size_t type_pos = event.find(' ');
+    if (type_pos != std::string::npos)
+    {
+        const size_t props_pos = event.find(' ', type_pos + 1);
+        const std::string mode(event, 0, type_pos);
+        const std::string type(
+            event, type_pos + 1, props_pos == std::string::npos ? std::string::npos : props_pos - type_pos - 1
+        );
+        const std::string props(props_pos == std::string::npos ? "" : event.substr(props_pos + 1));
+
+        const std::string rsc_name(get_prop(props, PROP_NAME));
+        std::string key;
+        if (type == OBJ_RESOURCE)
+        {
+            key = rsc_name + KEY_SEPA + '0';
+        }
+        else
+        if (type == OBJ_CONNECTION)
+        {
+            key = rsc_name + KEY_SEPA + '1' + KEY_SEPA + get_prop(props, PROP_PEER_NODE_ID);
+        }
+        else
+        if (type == OBJ_DEVICE)
+        {
+            key = rsc_name + KEY_SEPA + '2' + KEY_SEPA + get_prop(props, PROP_VOLUME);
+        }
+        else
+        if (type == OBJ_PEER_DEVICE)
+        {
+            key = rsc_name + KEY_SEPA + '3' + KEY_SEPA + get_prop(props, PROP_PEER_NODE_ID) + KEY_SEPA +
+                get_prop(props, PROP_VOLUME);
+        }
+        else
+        if (type == OBJ_PATH)
+        {
+            key = rsc_name + KEY_SEPA + '4' + KEY_SEPA + get_prop(props, PROP_PEER_NODE_ID) + KEY_SEPA +
+                get_prop(props, PROP_LOCAL) + KEY_SEPA + get_prop(props, PROP_PEER);
+        }
+
+        // Other events, e.g. helper calls, do not change the state
+        if (!key.empty() && !rsc_name.empty())
+        {
+            if (mode == EVENT_DESTROY)
+            {
+                if (type == OBJ_RESOURCE)
+                {
+                    erase_prefix(state, rsc_name + KEY_SEPA);
+                }
+                else
+                if (type == OBJ_CONNECTION)
+                {
+                    const std::string peer_node_id(get_prop(props, PROP_PEER_NODE_ID));
+                    state.erase(key);
+                    erase_prefix(state, rsc_name + KEY_SEPA + '3' + KEY_SEPA + peer_node_id + KEY_SEPA);
+                    erase_prefix(state, rsc_name + KEY_SEPA + '4' + KEY_SEPA + peer_node_id + KEY_SEPA);
+                }
+                else
+                if (type == OBJ_DEVICE)
+                {
+                    const std::string peer_dev_suffix(KEY_SEPA + get_prop(props, PROP_VOLUME));
+                    const std::string peer_dev_prefix(rsc_name + KEY_SEPA + '3' + KEY_SEPA);
+                    state.erase(key);
+
+                    StateMap::iterator obj_iter = state.lower_bound(peer_dev_prefix);
+                    while (obj_iter != state.end() && obj_iter->first.compare(
+                        0, peer_dev_prefix.length(), peer_dev_prefix) == 0)
+                    {
+                        const std::string& obj_key = obj_iter->first;
+                        const bool volume_match = obj_key.length() >= peer_dev_suffix.length() &&
+                            obj_key.compare(
+                                obj_key.length() - peer_dev_suffix.length(), std::string::npos, peer_dev_suffix
+                            ) == 0;
+                        if (volume_match)
+                        {
+                            obj_iter = state.erase(obj_iter);
+                        }
+                        else
+                        {
+                            ++obj_iter;
+                        }
+                    }
+                }
+                else
+                {
+                    state.erase(key);
+                }
+            }
+            else
+            {
+                std::string& obj_props = state[key];
+                if (obj_props.empty())
+                {
+                    obj_props = type;
+                }
+                merge_props(obj_props, props);
+            }
+        }
+    }
+}
+
+/**
+ * Emits the state as 'exists' events, followed by the initial state separator
+ */
+static void emit_state(const StateMap& state)
+{
+    for (StateMap::const_iterator obj_iter = state.begin(); obj_iter != state.end(); ++obj_iter)
+    {
+        std::cout << EVENT_EXISTS << ' ' << obj_iter->second << '\n';
+    }
+    std::cout << INIT_STATE_SEPA << '\n';
+}
+
+/**
+ * Restores the state from the last checkpoint in the index file that is before the seek time
+ *
+ * @return True if a checkpoint was loaded, false if the index file does not exist,
+ *         is outdated, or does not contain a checkpoint before the seek time
+ */
+static bool load_checkpoint(
+    const std::string& path,
+    const int64_t seek_usecs,
+    StateMap& state,
+    uint64_t& offset
+)
+{
+    bool loaded = false;
+
+    const std::string index_path(path + INDEX_SUFFIX);
+    std::ifstream index_file(index_path);
+    if (index_file.good())
+    {
+        std::string index_line;
+        std::getline(index_file, index_line);
+        if (index_line == INDEX_HEADER)
+        {
+            std::string size_key;
+            uint64_t log_size = 0;
+            index_file >> size_key >> log_size;
+            std::getline(index_file, index_line);
+
+            // An events log file that has been appended to can still use the index,
+            // a smaller file is probably a different file
+            if (size_key == INDEX_LOG_SIZE && log_size <= get_file_size(path))
+            {
+                // Find the last checkpoint before the seek time and skip the snapshots of earlier checkpoints
+                std::streampos snapshot_pos = 0;
+                uint64_t snapshot_lines = 0;
+                bool searching = true;
+                while (searching && index_file.good())
+                {
+                    std::string checkpoint_key;
+                    std::string timestamp;
+                    uint64_t checkpoint_offset = 0;
+                    uint64_t line_count = 0;
+                    int64_t checkpoint_usecs = 0;
+                    index_file >> checkpoint_key >> checkpoint_offset >> timestamp >> line_count;
+                    std::getline(index_file, index_line);
+                    if (index_file.good() && checkpoint_key == INDEX_CHECKPOINT &&
+                        timestamps::parse_timestamp(timestamp, checkpoint_usecs) && checkpoint_usecs < seek_usecs)
+                    {
+                        snapshot_pos = index_file.tellg();
+                        snapshot_lines = line_count;
+                        offset = checkpoint_offset;
+                        loaded = true;
+
+                        for (uint64_t idx = 0; idx < line_count && index_file.good(); ++idx)
+                        {
+                            std::getline(index_file, index_line);
+                        }
+                    }
+                    else
+                    {
+                        searching = false;
+                    }
+                }
+
+                if (loaded)
+                {
+                    index_file.clear();
+                    index_file.seekg(snapshot_pos);
+                    for (uint64_t idx = 0; idx < snapshot_lines && index_file.good(); ++idx)
+                    {
+                        std::getline(index_file, index_line);
+                        apply_event(state, index_line);
+                    }
+                    if (index_file.fail())
+                    {
+                        std::cerr << "I/O error while reading the index file \"" << index_path << "\"\n";
+                        state.clear();
+                        offset = 0;
+                        loaded = false;
+                    }
+                }
+            }
+            else
+            {
+                std::cerr << "Ignoring outdated index file \"" << index_path << "\"\n";
+            }
+        }
+    }
+
+    return loaded;
+}
+
+/**
+ * Returns the value of a property from a space separated list of key:value properties
+ */
+static std::string get_prop(const std::string& props, const std::string& key)
+{
+    std::string value;
+    size_t prop_pos = 0;
+    bool searching = true;
+    while (searching && prop_pos < props.length())
+    {
+        size_t prop_end = props.find(' ', prop_pos);
+        if (prop_end == std::string::npos)
+        {
+            prop_end = props.length();
+        }
+        if (prop_end - prop_pos > key.length() && props[prop_pos + key.length()] == ':' &&
+            props.compare(prop_pos, key.length(), key) == 0)
+        {
+            const size_t value_pos = prop_pos + key.length() + 1;
+            value = props.substr(value_pos, prop_end - value_pos);
+            searching = false;
+        }
+        prop_pos = prop_end + 1;
+    }
+    return value;
+}
+
+/**
+ * Updates the properties of an object with the properties from an event
+ * Properties that are not contained in the update keep their current value.
+ */
+static void merge_props(std::string& props, const std::string& update)
+{
+    size_t prop_pos = 0;
+    while (prop_pos < update.length())
+    {
+        size_t prop_end = update.find(' ', prop_pos);
+        if (prop_end == std::string::npos)
+        {
+            prop_end = update.length();
+        }
+        const size_t key_end = update.find(':', prop_pos);
+        if (key_end != std::string::npos && key_end < prop_end)
+        {
+            const std::string prop_key(' ' + update.substr(prop_pos, key_end - prop_pos + 1));
+            const size_t cur_pos = props.find(prop_key);
+            if (cur_pos != std::string::npos)
+            {
+                size_t cur_end = props.find(' ', cur_pos + 1);
+                if (cur_end == std::string::npos)
+                {
+                    cur_end = props.length();
+                }
+                props.replace(cur_pos + 1, cur_end - cur_pos - 1, update, prop_pos, prop_end - prop_pos);
+            }
+            else
+            {
+                props.append(1, ' ');
+                props.append(update, prop_pos, prop_end - prop_pos);
+            }
+        }
+        prop_pos = prop_end + 1;
+    }
+}
+
+static void erase_prefix(StateMap& state, const std::string& prefix)
+{
+    StateMap::iterator obj_iter = state.lower_bound(prefix);
+    while (obj_iter != state.end() && obj_iter->first.compare(0, prefix.length(), prefix) == 0)
+    {
+        obj_iter = state.erase(obj_iter);
+    }
+}
+
+static uint64_t get_file_size(const std::string& path)
+{
+    std::ifstream size_file(path, std::ios::in | std::ios::ate);
+    const std::streamoff file_size = size_file.good() ? static_cast<std::streamoff> (size_file.tellg()) : 0;
+    return file_size > 0 ? static_cast<uint64_t> (file_size) : 0;
+}
+
+static void replay_delay(const int64_t usecs)
+{
+    const int64_t delay_usecs = usecs < MAX_REPLAY_DELAY ? usecs : MAX_REPLAY_DELAY;
+    struct timespec delay;
+    delay.tv_sec = static_cast<time_t> (delay_usecs / 1000000);
+    delay.tv_nsec = static_cast<long> ((delay_usecs % 1000000) * 1000);
+    while (nanosleep(&delay, &delay) != 0 && errno == EINTR)
+    {
+        // Continue sleeping for the remaining time
+    }
+}
@@ -74,6 +74,8 @@ namespace drbdmon
 int main(int argc, char* argv[])
 {
     int exit_code = 0;
+    // Cleared if DrbdMon runs without a terminal
+    bool use_terminal = true;
     std::ios_base::sync_with_stdio(true);
 
     try
@@ -155,6 +157,17 @@ int main(int argc, char* argv[])
                     mon_env.log->add_entry(MessageLog::log_level::ALERT, error_message);
                 }
 
+                // Headless mode must be known before anything is written to the terminal
+                const std::string server_arg = std::string("--") + DrbdMon::OPT_SERVER_KEY;
+                for (int arg_idx = 1; arg_idx + 1 < argc; ++arg_idx)
+                {
+                    if (server_arg == argv[arg_idx])
+                    {
+                        mon_env.headless = true;
+                        use_terminal = false;
+                    }
+                }
+
                 drbdmon::monitor_loop(argc, argv, mon_env);
             }
             else
@@ -182,7 +195,10 @@ int main(int argc, char* argv[])
         exit_code = drbdmon::EXIT_ERR_SYNTAX;
     }
 
-    drbdmon::clear_window_title();
+    if (use_terminal)
+    {
+        drbdmon::clear_window_title();
+    }
 
     std::fflush(stdout);
     std::fflush(stderr);
@@ -210,7 +226,10 @@ static void drbdmon::monitor_loop(
             {
                 system_api::init_node_name(mon_env.node_name);
             }
-            drbdmon::set_window_title(mon_env.node_name);
+            if (!mon_env.headless)
+            {
+                drbdmon::set_window_title(mon_env.node_name);
+            }
 
             const std::unique_ptr<DrbdMon> dm_instance(new DrbdMon(argc, argv, mon_env));
             dm_instance->run();
@@ -219,14 +238,17 @@ static void drbdmon::monitor_loop(
                 // Always terminate if the events source is a file, except for out of memory
                 mon_env.fin_action = DrbdMon::finish_action::TERMINATE;
             }
-            if (mon_env.fin_action != DrbdMon::finish_action::TERMINATE_NO_CLEAR)
+            if (mon_env.fin_action != DrbdMon::finish_action::TERMINATE_NO_CLEAR && !mon_env.headless)
             {
                 drbdmon::clear_screen();
             }
         }
         catch (std::bad_alloc& out_of_memory_exc)
         {
-            drbdmon::clear_screen();
+            if (!mon_env.headless)
+            {
+                drbdmon::clear_screen();
+            }
             mon_env.fin_action = DrbdMon::finish_action::RESTART_DELAYED;
             mon_env.fail_data = DrbdMon::fail_info::OUT_OF_MEMORY;
         }
@@ -0,0 +1,306 @@
+#include <json_state.h>
+#include <EventKeywords.h>
+#include <objects/StateFlags.h>
+#include <cstdio>
+
+namespace json_state
+{
+    const char* const   MODE_EXISTS         = "exists";
+
+    static const char* const    TYPE_SEPARATOR  = "-";
+    static const size_t         FORMAT_BFR_SIZE = 24;
+
+    static void begin_record(std::string& out, const StringView& mode, const char* const type);
+    static void end_record(std::string& out);
+    static void append_text(std::string& out, const char* const key, const char* const value);
+    static void append_text(std::string& out, const char* const key, const std::string& value);
+    static void append_text(std::string& out, const char* const key, const StringView& value);
+    static void append_number(std::string& out, const char* const key, const uint64_t value);
+    static void append_state(std::string& out, const StateFlags::state obj_state);
+    static void append_quoted(std::string& out, const char* const text, const size_t length);
+    static void append_event_key(
+        std::string&                    out,
+        EventProps&                     event_props,
+        const EventKeywords::keyword    key,
+        const bool                      numeric
+    );
+}
+
+// @throws std::bad_alloc
+void json_state::write_resource_tree(std::string& out, DrbdResource& rsc)
+{
+    const StringView mode(MODE_EXISTS, std::char_traits<char>::length(MODE_EXISTS));
+    write_resource(out, mode, rsc);
+
+    DrbdResource::ConnectionsIterator conn_iter = rsc.connections_iterator();
+    while (conn_iter.has_next())
+    {
+        write_connection(out, mode, rsc, *(conn_iter.next()));
+    }
+
+    VolumesContainer::VolumesIterator vol_iter = rsc.volumes_iterator();
+    while (vol_iter.has_next())
+    {
+        write_device(out, mode, rsc, *(vol_iter.next()));
+    }
+
+    DrbdResource::ConnectionsIterator peer_conn_iter = rsc.connections_iterator();
+    while (peer_conn_iter.has_next())
+    {
+        DrbdConnection* const conn = peer_conn_iter.next();
+        VolumesContainer::VolumesIterator peer_vol_iter = conn->volumes_iterator();
+        while (peer_vol_iter.has_next())
+        {
+            write_peer_device(out, mode, rsc, *conn, *(peer_vol_iter.next()));
+        }
+    }
+}
+
+// @throws std::bad_alloc
+void json_state::write_resource(std::string& out, const StringView& mode, DrbdResource& rsc)
+{
+    begin_record(out, mode, EventKeywords::get_label(EventKeywords::keyword::TYPE_RESOURCE));
+    append_text(out, EventKeywords::get_label(EventKeywords::keyword::KEY_NAME), rsc.get_name());
+    append_text(out, EventKeywords::get_label(EventKeywords::keyword::KEY_ROLE), rsc.get_role_label());
+    append_state(out, rsc.get_state());
+    end_record(out);
+}
+
+// @throws std::bad_alloc
+void json_state::write_connection(std::string& out, const StringView& mode, DrbdResource& rsc, DrbdConnection& conn)
+{
+    begin_record(out, mode, EventKeywords::get_label(EventKeywords::keyword::TYPE_CONNECTION));
+    append_text(out, EventKeywords::get_label(EventKeywords::keyword::KEY_NAME), rsc.get_name());
+    append_number(out, EventKeywords::get_label(EventKeywords::keyword::KEY_PEER_NODE_ID), conn.get_node_id());
+    append_text(out, EventKeywords::get_label(EventKeywords::keyword::KEY_CONN_NAME), conn.get_name());
+    append_text(
+        out,
+        EventKeywords::get_label(EventKeywords::keyword::KEY_CONNECTION),
+        conn.get_connection_state_label()
+    );
+    append_text(out, EventKeywords::get_label(EventKeywords::keyword::KEY_ROLE), conn.get_role_label());
+    append_state(out, conn.get_state());
+    end_record(out);
+}
+
+// @throws std::bad_alloc
+void json_state::write_device(std::string& out, const StringView& mode, DrbdResource& rsc, DrbdVolume& vol)
+{
+    begin_record(out, mode, EventKeywords::get_label(EventKeywords::keyword::TYPE_DEVICE));
+    append_text(out, EventKeywords::get_label(EventKeywords::keyword::KEY_NAME), rsc.get_name());
+    append_number(out, EventKeywords::get_label(EventKeywords::keyword::KEY_VOLUME), vol.get_volume_nr());
+    const int32_t minor_nr = vol.get_minor_nr();
+    if (minor_nr >= 0)
+    {
+        append_number(
+            out, EventKeywords::get_label(EventKeywords::keyword::KEY_MINOR), static_cast<uint64_t> (minor_nr)
+        );
+    }
+    append_text(out, EventKeywords::get_label(EventKeywords::keyword::KEY_DISK), vol.get_disk_state_label());
+    append_text(
+        out,
+        EventKeywords::get_label(EventKeywords::keyword::KEY_QUORUM),
+        vol.has_quorum_alert() ?
+            EventKeywords::get_label(EventKeywords::keyword::QUORUM_LOST) :
+            EventKeywords::get_label(EventKeywords::keyword::QUORUM_PRESENT)
+    );
+    append_state(out, vol.get_state());
+    end_record(out);
+}
+
+// @throws std::bad_alloc
+void json_state::write_peer_device(
+    std::string&        out,
+    const StringView&   mode,
+    DrbdResource&       rsc,
+    DrbdConnection&     conn,
+    DrbdVolume&         vol
+)
+{
+    begin_record(out, mode, EventKeywords::get_label(EventKeywords::keyword::TYPE_PEER_DEVICE));
+    append_text(out, EventKeywords::get_label(EventKeywords::keyword::KEY_NAME), rsc.get_name());
+    append_number(out, EventKeywords::get_label(EventKeywords::keyword::KEY_PEER_NODE_ID), conn.get_node_id());
+    append_text(out, EventKeywords::get_label(EventKeywords::keyword::KEY_CONN_NAME), conn.get_name());
+    append_number(out, EventKeywords::get_label(EventKeywords::keyword::KEY_VOLUME), vol.get_volume_nr());
+    append_text(
+        out,
+        EventKeywords::get_label(EventKeywords::keyword::KEY_REPLICATION),
+        vol.get_replication_state_label()
+    );
+    append_text(out, EventKeywords::get_label(EventKeywords::keyword::KEY_PEER_DISK), vol.get_disk_state_label());
+    if (DrbdVolume::is_resyncing(vol.get_replication_state()))
+    {
+        // Resynchronization progress, the value is in 1/100 percent
+        const uint16_t sync_perc = vol.get_sync_perc();
+        char format_bfr[FORMAT_BFR_SIZE];
+        std::snprintf(
+            format_bfr, sizeof (format_bfr), "%u.%02u",
+            static_cast<unsigned int> (sync_perc / 100),
+            static_cast<unsigned int> (sync_perc % 100)
+        );
+        out += ",\"";
+        out += EventKeywords::get_label(EventKeywords::keyword::KEY_DONE);
+        out += "\":";
+        out += format_bfr;
+    }
+    append_state(out, vol.get_state());
+    end_record(out);
+}
+
+// @throws std::bad_alloc
+void json_state::write_event_keys(std::string& out, EventProps& event_props)
+{
+    begin_record(out, event_props.get_mode(), EventKeywords::get_label(event_props.get_type_id()));
+    append_event_key(out, event_props, EventKeywords::keyword::KEY_NAME, false);
+    append_event_key(out, event_props, EventKeywords::keyword::KEY_NEW_NAME, false);
+    append_event_key(out, event_props, EventKeywords::keyword::KEY_PEER_NODE_ID, true);
+    append_event_key(out, event_props, EventKeywords::keyword::KEY_CONN_NAME, false);
+    append_event_key(out, event_props, EventKeywords::keyword::KEY_VOLUME, true);
+    end_record(out);
+}
+
+// @throws std::bad_alloc
+void json_state::write_end_of_snapshot(std::string& out, const uint64_t change_seq)
+{
+    const StringView mode(MODE_EXISTS, std::char_traits<char>::length(MODE_EXISTS));
+    begin_record(out, mode, TYPE_SEPARATOR);
+    append_number(out, "seq", change_seq);
+    end_record(out);
+}
+
+// @throws std::bad_alloc
+static void json_state::begin_record(std::string& out, const StringView& mode, const char* const type)
+{
+    out += "{\"mode\":";
+    append_quoted(out, mode.data(), mode.length());
+    out += ",\"type\":";
+    append_quoted(out, type, std::char_traits<char>::length(type));
+}
+
+// @throws std::bad_alloc
+static void json_state::end_record(std::string& out)
+{
+    out += "}\n";
+}
+
+// @throws std::bad_alloc
+static void json_state::append_text(std::string& out, const char* const key, const char* const value)
+{
+    out += ",\"";
+    out += key;
+    out += "\":";
+    append_quoted(out, value, std::char_traits<char>::length(value));
+}
+
+// @throws std::bad_alloc
+static void json_state::append_text(std::string& out, const char* const key, const std::string& value)
+{
+    out += ",\"";
+    out += key;
+    out += "\":";
+    append_quoted(out, value.data(), value.length());
+}
+
+// @throws std::bad_alloc
+static void json_state::append_text(std::string& out, const char* const key, const StringView& value)
+{
+    out += ",\"";
+    out += key;
+    out += "\":";
+    append_quoted(out, value.data(), value.length());
+}
+
+// @throws std::bad_alloc
+static void json_state::append_number(std::string& out, const char* const key, const uint64_t value)
+{
+    out += ",\"";
+    out += key;
+    out += "\":";
+    out += std::to_string(value);
+}
+
+// @throws std::bad_alloc
+static void json_state::append_state(std::string& out, const StateFlags::state obj_state)
+{
+    const char* state_label = "norm";
+    switch (obj_state)
+    {
+        case StateFlags::state::MARK:
+            state_label = "mark";
+            break;
+        case StateFlags::state::WARN:
+            state_label = "warn";
+            break;
+        case StateFlags::state::ALERT:
+            state_label = "alert";
+            break;
+        case StateFlags::state::NORM:
+            // fall-through
+        default:
+            break;
+    }
+    append_text(out, "state", state_label);
+}
+
+// Appends the text as a JSON string, escaping quotes, backslashes and control characters
+// @throws std::bad_alloc
+static void json_state::append_quoted(std::string& out, const char* const text, const size_t length)
+{
+    out += '\"';
+    for (size_t idx = 0; idx < length; ++idx)
+    {
+        const unsigned char text_char = static_cast<unsigned char> (text[idx]);
+        if (text_char == '\"' || text_char == '\\')
+        {
+            out += '\\';
+            out += static_cast<char> (text_char);
+        }
+        else
+        if (text_char < 0x20)
+        {
+            char format_bfr[FORMAT_BFR_SIZE];
+            std::snprintf(format_bfr, sizeof (format_bfr), "\\u%04x", static_cast<unsigned int> (text_char));
+            out += format_bfr;
+        }
+        else
+        {
+            out += static_cast<char> (text_char);
+        }
+    }
+    out += '\"';
+}
+
+// Appends a property of an event line, numeric properties are appended as a JSON number
+// if the property's value consists of decimal digits only
+// @throws std::bad_alloc
+static void json_state::append_event_key(
+    std::string&                    out,
+    EventProps&                     event_props,
+    const EventKeywords::keyword    key,
+    const bool                      numeric
+)
+{
+    const StringView* const value = event_props.get(key);
+    if (value != nullptr)
+    {
+        bool is_number = numeric && !value->empty();
+        const char* const value_data = value->data();
+        const size_t value_length = value->length();
+        for (size_t idx = 0; idx < value_length && is_number; ++idx)
+        {
+            is_number = value_data[idx] >= '0' && value_data[idx] <= '9';
+        }
+
+        if (is_number)
+        {
+            out += ",\"";
+            out += EventKeywords::get_label(key);
+            out += "\":";
+            out.append(value_data, value_length);
+        }
+        else
+        {
+            append_text(out, EventKeywords::get_label(key), *value);
+        }
+    }
+}
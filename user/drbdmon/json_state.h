@@ -0,0 +1,50 @@
+#ifndef JSON_STATE_H
+#define JSON_STATE_H
+
+#include <default_types.h>
+#include <string>
+#include <objects/DrbdResource.h>
+#include <objects/DrbdConnection.h>
+#include <objects/DrbdVolume.h>
+#include <EventProps.h>
+#include <StringView.h>
+
+// JSON lines representation of the DRBD objects
+//
+// Each record is a single line that contains a JSON object. The "mode" and "type" members
+// use the same names as the modes and object types of 'drbdsetup events2' lines, and each
+// record for an existing object contains all of the object's state properties.
+namespace json_state
+{
+    extern const char* const    MODE_EXISTS;
+
+    // Appends records for the resource and all of its connections, volumes and peer volumes
+    // @throws std::bad_alloc
+    void write_resource_tree(std::string& out, DrbdResource& rsc);
+
+    // @throws std::bad_alloc
+    void write_resource(std::string& out, const StringView& mode, DrbdResource& rsc);
+    // @throws std::bad_alloc
+    void write_connection(std::string& out, const StringView& mode, DrbdResource& rsc, DrbdConnection& conn);
+    // @throws std::bad_alloc
+    void write_device(std::string& out, const StringView& mode, DrbdResource& rsc, DrbdVolume& vol);
+    // @throws std::bad_alloc
+    void write_peer_device(
+        std::string&        out,
+        const StringView&   mode,
+        DrbdResource&       rsc,
+        DrbdConnection&     conn,
+        DrbdVolume&         vol
+    );
+
+    // Appends a record that only contains the properties of an event line that identify the object,
+    // used for events that destroy or rename objects
+    // @throws std::bad_alloc
+    void write_event_keys(std::string& out, EventProps& event_props);
+
+    // Appends the record that finishes the state snapshot
+    // @throws std::bad_alloc
+    void write_end_of_snapshot(std::string& out, const uint64_t change_seq);
+}
+
+#endif /* JSON_STATE_H */
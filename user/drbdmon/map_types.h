@@ -6,6 +6,7 @@
 
 // https://github.com/raltnoeder/cppdsaext
 #include <QTree.h>
+#include <FlatMap.h>
 #include <VMap.h>
 #include <VList.h>
 
@@ -19,14 +20,12 @@ class DrbdVolume;
 using ResourcesMap      = QTree<std::string, DrbdResource>;
 
 // Map of connection names => DrbdConnection objects
-using ConnectionsMap    = QTree<std::string, DrbdConnection>;
+// Resources have few connections, which are iterated frequently, therefore, a flat map is used
+using ConnectionsMap    = FlatMap<std::string, DrbdConnection>;
 
 // Map of volume number => DrbdVolume objects
-using VolumesMap        = QTree<uint16_t, DrbdVolume>;
-
-// Map of strings, key => value
-// Used for the parameters listed in 'drbdsetup events2' lines
-using PropsMap          = QTree<std::string, std::string>;
+// Resources and connections have few volumes, which are iterated frequently, therefore, a flat map is used
+using VolumesMap        = FlatMap<uint16_t, DrbdVolume>;
 
 // Map of characters => function description
 using HotkeysMap        = VMap<const char, const std::string>;
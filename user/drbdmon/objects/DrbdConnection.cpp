@@ -1,10 +1,11 @@
 #include <objects/DrbdConnection.h>
+#include <objects/ObjectPools.h>
 #include <integerparse.h>
 
-const std::string DrbdConnection::PROP_KEY_CONNECTION = "connection";
-const std::string DrbdConnection::PROP_KEY_CONN_NAME = "conn-name";
-const std::string DrbdConnection::PROP_KEY_PEER_NODE_ID = "peer-node-id";
-const std::string DrbdConnection::PROP_KEY_SYNC_STATE = "sync-state";
+const EventKeywords::keyword DrbdConnection::PROP_KEY_CONNECTION = EventKeywords::keyword::KEY_CONNECTION;
+const EventKeywords::keyword DrbdConnection::PROP_KEY_CONN_NAME = EventKeywords::keyword::KEY_CONN_NAME;
+const EventKeywords::keyword DrbdConnection::PROP_KEY_PEER_NODE_ID = EventKeywords::keyword::KEY_PEER_NODE_ID;
+const EventKeywords::keyword DrbdConnection::PROP_KEY_SYNC_STATE = EventKeywords::keyword::KEY_SYNC_STATE;
 
 const char* DrbdConnection::CS_LABEL_STANDALONE             = "StandAlone";
 const char* DrbdConnection::CS_LABEL_DISCONNECTING          = "Disconnecting";
@@ -22,23 +23,49 @@ const char* DrbdConnection::SS_LABEL_SPLIT                  = "SplitBrain";
 const char* DrbdConnection::SS_LABEL_UNRELATED              = "Unrelated";
 
 // @throws std::bad_alloc
-DrbdConnection::DrbdConnection(std::string& connection_name, uint8_t peer_node_id):
-    name(connection_name),
+DrbdConnection::DrbdConnection(NameTable& conn_names_ref, const StringView& connection_name, uint8_t peer_node_id):
+    conn_names(conn_names_ref),
+    name_handle(conn_names_ref.acquire(connection_name)),
     node_id(peer_node_id)
 {
 }
 
+DrbdConnection::~DrbdConnection() noexcept
+{
+    conn_names.release(name_handle);
+}
+
+// @throws std::bad_alloc
+void* DrbdConnection::operator new(const size_t size)
+{
+    return ObjectPools::connection_pool.allocate(size);
+}
+
+void DrbdConnection::operator delete(void* const obj_ptr, const size_t size) noexcept
+{
+    ObjectPools::connection_pool.deallocate(obj_ptr, size);
+}
+
 const std::string& DrbdConnection::get_name() const
 {
-    return name;
+    return conn_names.get_name(name_handle);
+}
+
+NameTable::handle DrbdConnection::get_name_handle() const
+{
+    return name_handle;
 }
 
 // @throws std::bad_alloc, EventMessageException
-void DrbdConnection::update(PropsMap& event_props)
+bool DrbdConnection::update(EventProps& event_props)
 {
-    std::string* role_prop = event_props.get(&PROP_KEY_ROLE);
-    std::string* conn_prop = event_props.get(&PROP_KEY_CONNECTION);
-    std::string* sync_state_prop = event_props.get(&PROP_KEY_SYNC_STATE);
+    const resource_role last_role = role;
+    const state last_conn_state = conn_state;
+    const sync_state_type last_sync_state = sync_state;
+
+    const StringView* role_prop = event_props.get(PROP_KEY_ROLE);
+    const StringView* conn_prop = event_props.get(PROP_KEY_CONNECTION);
+    const StringView* sync_state_prop = event_props.get(PROP_KEY_SYNC_STATE);
 
     if (role_prop != nullptr)
     {
@@ -59,6 +86,8 @@ void DrbdConnection::update(PropsMap& event_props)
     {
         sync_state = DrbdConnection::sync_state_type::RESYNCABLE;
     }
+
+    return role != last_role || conn_state != last_conn_state || sync_state != last_sync_state;
 }
 
 const uint8_t DrbdConnection::get_node_id() const
@@ -230,62 +259,73 @@ StateFlags::state DrbdConnection::child_state_flags_changed()
     return obj_state;
 }
 
+// Event lines without a sync state reset the sync state if the connection is in the Connected state
+bool DrbdConnection::has_transition_effects(EventProps& pending_props, EventProps& next_props)
+{
+    // An event line without a sync state resets the sync state depending on the connection state,
+    // which would discard the pending event line's sync state, or the sync state that the pending
+    // event line's connection state reset
+    return next_props.get(PROP_KEY_SYNC_STATE) == nullptr &&
+        (pending_props.get(PROP_KEY_SYNC_STATE) != nullptr || next_props.get(PROP_KEY_CONNECTION) != nullptr);
+}
+
 // @throws std::bad_alloc, EventMessageException
-DrbdConnection::state DrbdConnection::parse_state(std::string& state_name)
+DrbdConnection::state DrbdConnection::parse_state(const StringView& state_name)
 {
+    const EventKeywords::keyword state_id = EventKeywords::lookup(state_name);
     DrbdConnection::state state = DrbdConnection::state::UNKNOWN;
 
-    if (state_name == CS_LABEL_STANDALONE)
+    if (state_id == EventKeywords::keyword::CS_STANDALONE)
     {
         state = DrbdConnection::state::STANDALONE;
     }
     else
-    if (state_name == CS_LABEL_CONNECTING)
+    if (state_id == EventKeywords::keyword::CS_CONNECTING)
     {
         state = DrbdConnection::state::CONNECTING;
     }
     else
-    if (state_name == CS_LABEL_DISCONNECTING)
+    if (state_id == EventKeywords::keyword::CS_DISCONNECTING)
     {
         state = DrbdConnection::state::DISCONNECTING;
     }
     else
-    if (state_name == CS_LABEL_UNCONNECTED)
+    if (state_id == EventKeywords::keyword::CS_UNCONNECTED)
     {
         state = DrbdConnection::state::UNCONNECTED;
     }
     else
-    if (state_name == CS_LABEL_TIMEOUT)
+    if (state_id == EventKeywords::keyword::CS_TIMEOUT)
     {
         state = DrbdConnection::state::TIMEOUT;
     }
     else
-    if (state_name == CS_LABEL_BROKEN_PIPE)
+    if (state_id == EventKeywords::keyword::CS_BROKEN_PIPE)
     {
         state = DrbdConnection::state::BROKEN_PIPE;
     }
     else
-    if (state_name == CS_LABEL_NETWORK_FAILURE)
+    if (state_id == EventKeywords::keyword::CS_NETWORK_FAILURE)
     {
         state = DrbdConnection::state::NETWORK_FAILURE;
     }
     else
-    if (state_name == CS_LABEL_PROTOCOL_ERROR)
+    if (state_id == EventKeywords::keyword::CS_PROTOCOL_ERROR)
     {
         state = DrbdConnection::state::PROTOCOL_ERROR;
     }
     else
-    if (state_name == CS_LABEL_TEAR_DOWN)
+    if (state_id == EventKeywords::keyword::CS_TEAR_DOWN)
     {
         state = DrbdConnection::state::TEAR_DOWN;
     }
     else
-    if (state_name == CS_LABEL_CONNECTED)
+    if (state_id == EventKeywords::keyword::CS_CONNECTED)
     {
         state = DrbdConnection::state::CONNECTED;
     }
     else
-    if (state_name != CS_LABEL_UNKNOWN)
+    if (state_id != EventKeywords::keyword::CS_UNKNOWN)
     {
         std::string error_msg("Invalid DRBD event: Invalid connection state");
         std::string debug_info("Invalid connection state value");
@@ -296,15 +336,16 @@ DrbdConnection::state DrbdConnection::parse_state(std::string& state_name)
 }
 
 // @throws std::bad_alloc, EventMessageException
-DrbdConnection::sync_state_type DrbdConnection::parse_sync_state(std::string& sync_state_name)
+DrbdConnection::sync_state_type DrbdConnection::parse_sync_state(const StringView& sync_state_name)
 {
+    const EventKeywords::keyword sync_state_id = EventKeywords::lookup(sync_state_name);
     sync_state_type parsed_state = sync_state_type::RESYNCABLE;
-    if (sync_state_name == SS_LABEL_SPLIT)
+    if (sync_state_id == EventKeywords::keyword::SS_SPLIT)
     {
         parsed_state = sync_state_type::SPLIT;
     }
     else
-    if (sync_state_name == SS_LABEL_UNRELATED)
+    if (sync_state_id == EventKeywords::keyword::SS_UNRELATED)
     {
         parsed_state = sync_state_type::UNRELATED;
     }
@@ -317,22 +358,23 @@ DrbdConnection::sync_state_type DrbdConnection::parse_sync_state(std::string& sy
     return parsed_state;
 }
 
-// Creates (allocates and initializes) a new DrbdConnection object from a map of properties
+// Creates (allocates and initializes) a new DrbdConnection object from the properties of an event line
 //
-// @param event_props Reference to the map of properties from a 'drbdsetup events2' line
+// @param event_props Reference to the parsed properties of a 'drbdsetup events2' line
+// @param conn_names_ref Table of interned connection names
 // @return Pointer to a newly created DrbdConnection object
 // @throws std::bad_alloc, EventMessageException
-DrbdConnection* DrbdConnection::new_from_props(PropsMap& event_props)
+DrbdConnection* DrbdConnection::new_from_props(EventProps& event_props, NameTable& conn_names_ref)
 {
     DrbdConnection* new_conn {nullptr};
-    std::string* conn_name = event_props.get(&PROP_KEY_CONN_NAME);
-    std::string* node_id_str = event_props.get(&PROP_KEY_PEER_NODE_ID);
+    const StringView* conn_name = event_props.get(PROP_KEY_CONN_NAME);
+    const StringView* node_id_str = event_props.get(PROP_KEY_PEER_NODE_ID);
     if (conn_name != nullptr && node_id_str != nullptr)
     {
         try
         {
-            uint8_t new_node_id = dsaext::parse_unsigned_int8(*node_id_str);
-            new_conn = new DrbdConnection(*conn_name, new_node_id);
+            uint8_t new_node_id = dsaext::parse_unsigned_int8_c_str(node_id_str->data(), node_id_str->length());
+            new_conn = new DrbdConnection(conn_names_ref, *conn_name, new_node_id);
         }
         catch (dsaext::NumberFormatException&)
         {
@@ -8,8 +8,12 @@
 #include <objects/VolumesContainer.h>
 #include <objects/DrbdRole.h>
 #include <objects/StateFlags.h>
+#include <objects/NameTable.h>
 
 #include <map_types.h>
+#include <EventProps.h>
+#include <StringView.h>
+#include <EventKeywords.h>
 // https://github.com/raltnoeder/cppdsaext
 #include <dsaext.h>
 #include <utils.h>
@@ -40,10 +44,10 @@ class DrbdConnection : public VolumesContainer, public DrbdRole, private StateFl
         UNRELATED
     };
 
-    static const std::string PROP_KEY_CONNECTION;
-    static const std::string PROP_KEY_CONN_NAME;
-    static const std::string PROP_KEY_PEER_NODE_ID;
-    static const std::string PROP_KEY_SYNC_STATE;
+    static const EventKeywords::keyword PROP_KEY_CONNECTION;
+    static const EventKeywords::keyword PROP_KEY_CONN_NAME;
+    static const EventKeywords::keyword PROP_KEY_PEER_NODE_ID;
+    static const EventKeywords::keyword PROP_KEY_SYNC_STATE;
 
     static const char* CS_LABEL_STANDALONE;
     static const char* CS_LABEL_DISCONNECTING;
@@ -61,20 +65,25 @@ class DrbdConnection : public VolumesContainer, public DrbdRole, private StateFl
     static const char* SS_LABEL_UNRELATED;
 
     // @throws std::bad_alloc
-    DrbdConnection(std::string& connection_name, uint8_t node_id);
+    DrbdConnection(NameTable& conn_names_ref, const StringView& connection_name, uint8_t node_id);
     DrbdConnection(const DrbdConnection& orig) = delete;
     DrbdConnection& operator=(const DrbdConnection& orig) = delete;
     DrbdConnection(DrbdConnection&& orig) = delete;
     DrbdConnection& operator=(DrbdConnection&& orig) = delete;
-    virtual ~DrbdConnection() noexcept override
-    {
-    }
+    virtual ~DrbdConnection() noexcept override;
+
+    // Allocated from ObjectPools::connection_pool
+    // @throws std::bad_alloc
+    static void* operator new(size_t size);
+    static void operator delete(void* obj_ptr, size_t size) noexcept;
 
     virtual const std::string& get_name() const;
+    virtual NameTable::handle get_name_handle() const;
     virtual const uint8_t get_node_id() const;
 
+    // @return true if any of the object's properties changed, false otherwise
     // @throws std::bad_alloc, EventMessageException
-    virtual void update(PropsMap& event_props);
+    virtual bool update(EventProps& event_props);
 
     virtual state get_connection_state() const;
     virtual const char* get_connection_state_label() const;
@@ -93,21 +102,28 @@ class DrbdConnection : public VolumesContainer, public DrbdRole, private StateFl
     virtual bool has_connection_alert();
     virtual bool has_role_alert();
 
-    // Creates (allocates and initializes) a new DrbdConnection object from a map of properties
+    // Creates (allocates and initializes) a new DrbdConnection object from the properties of an event line
     //
-    // @param event_props Reference to the map of properties from a 'drbdsetup events2' line
+    // @param event_props Reference to the parsed properties of a 'drbdsetup events2' line
+    // @param conn_names_ref Table of interned connection names
     // @return Pointer to a newly created DrbdConnection object
     // @throws std::bad_alloc, EventMessageException
-    static DrbdConnection* new_from_props(PropsMap& event_props);
+    static DrbdConnection* new_from_props(EventProps& event_props, NameTable& conn_names_ref);
+
+    // Indicates whether applying the properties of an event line and then those of the next event
+    // line for the same connection has an effect that applying the merged properties of both event
+    // lines does not reproduce, which prevents coalescing the two event lines
+    static bool has_transition_effects(EventProps& pending_props, EventProps& next_props);
 
     // @throws std::bad_alloc, EventMessageException
-    static state parse_state(std::string& state_name);
+    static state parse_state(const StringView& state_name);
 
     // @throws std::bad_alloc, EventMessageException
-    static sync_state_type parse_sync_state(std::string& sync_state_name);
+    static sync_state_type parse_sync_state(const StringView& sync_state_name);
 
   private:
-    const std::string   name;
+    NameTable&              conn_names;
+    const NameTable::handle name_handle;
     const uint8_t       node_id         {0xFF};
     state               conn_state      {state::UNKNOWN};
     sync_state_type     sync_state      {sync_state_type::RESYNCABLE};
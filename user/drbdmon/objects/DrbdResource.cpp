@@ -1,67 +1,90 @@
 #include <objects/DrbdResource.h>
+#include <objects/ObjectPools.h>
 #include <comparators.h>
 
-const std::string DrbdResource::PROP_KEY_RES_NAME = "name";
-const std::string DrbdResource::PROP_KEY_NEW_NAME = "new_name";
+const EventKeywords::keyword DrbdResource::PROP_KEY_RES_NAME = EventKeywords::keyword::KEY_NAME;
+const EventKeywords::keyword DrbdResource::PROP_KEY_NEW_NAME = EventKeywords::keyword::KEY_NEW_NAME;
 
 // @throws std::bad_alloc
-DrbdResource::DrbdResource(std::string& resource_name):
-    name(resource_name),
-    conn_list(new ConnectionsMap(&comparators::compare_string))
+DrbdResource::DrbdResource(NameTable& rsc_names_ref, const StringView& resource_name):
+    conn_list(new ConnectionsMap(&comparators::compare_string)),
+    rsc_names(rsc_names_ref),
+    name_handle(rsc_names_ref.acquire(resource_name))
 {
 }
 
+// @throws std::bad_alloc
+void* DrbdResource::operator new(const size_t size)
+{
+    return ObjectPools::resource_pool.allocate(size);
+}
+
+void DrbdResource::operator delete(void* const obj_ptr, const size_t size) noexcept
+{
+    ObjectPools::resource_pool.deallocate(obj_ptr, size);
+}
+
 DrbdResource::~DrbdResource() noexcept
 {
     ConnectionsMap::NodesIterator dtor_iter(*conn_list);
     while (dtor_iter.has_next())
     {
         ConnectionsMap::Node* node = dtor_iter.next();
-        delete node->get_key();
         delete node->get_value();
     }
     conn_list->clear();
+    rsc_names.release(name_handle);
 }
 
 const std::string& DrbdResource::get_name() const
 {
-    return name;
+    return rsc_names.get_name(name_handle);
+}
+
+NameTable::handle DrbdResource::get_name_handle() const
+{
+    return name_handle;
 }
 
 // @throws std::bad_alloc, EventMessageException
-void DrbdResource::update(PropsMap& event_props)
+bool DrbdResource::update(EventProps& event_props)
 {
-    std::string* prop_role = event_props.get(&PROP_KEY_ROLE);
+    bool changed = false;
+    const StringView* prop_role = event_props.get(PROP_KEY_ROLE);
     if (prop_role != nullptr)
     {
-        role = parse_role(*prop_role);
+        const resource_role new_role = parse_role(*prop_role);
+        changed = new_role != role;
+        role = new_role;
     }
+    return changed;
 }
 
 // @throws std::bad_alloc, EventMessageException
-void DrbdResource::rename(PropsMap& event_props)
+void DrbdResource::rename(EventProps& event_props)
 {
-    const std::string* new_name = event_props.get(&PROP_KEY_NEW_NAME);
+    const StringView* const new_name = event_props.get(PROP_KEY_NEW_NAME);
     if (new_name != nullptr)
     {
-        name = *new_name;
+        const NameTable::handle new_name_handle = rsc_names.acquire(*new_name);
+        rsc_names.release(name_handle);
+        name_handle = new_name_handle;
     }
     else
     {
         std::string error_msg("Invalid DRBD rename event: New resource name not present in event line");
         std::string debug_msg("Missing resource ");
-        debug_msg += PROP_KEY_NEW_NAME;
+        debug_msg += EventKeywords::get_label(PROP_KEY_NEW_NAME);
         debug_msg += " field:";
         throw EventMessageException(&error_msg, &debug_msg, nullptr);
     }
 }
 
+// The connection's interned name is used as the key of the connections map
 // @throws std::bad_alloc, dsaext::DuplicateInsertException
 void DrbdResource::add_connection(DrbdConnection* connection)
 {
-    std::unique_ptr<std::string> conn_name(new std::string(connection->get_name()));
-    conn_list->insert(conn_name.get(), connection);
-    static_cast<void> (conn_name.release());
+    conn_list->insert(&(connection->get_name()), connection);
 }
 
 DrbdConnection* DrbdResource::get_connection(const std::string& connection_name) const
@@ -70,6 +93,24 @@ DrbdConnection* DrbdResource::get_connection(const std::string& connection_name)
     return connection;
 }
 
+// Resources have few connections, a linear search that compares handles is
+// faster than a binary search that compares names
+DrbdConnection* DrbdResource::get_connection(const NameTable::handle conn_name_handle) const
+{
+    DrbdConnection* connection = nullptr;
+    ConnectionsMap::ValuesIterator conn_iter(*conn_list);
+    while (conn_iter.has_next())
+    {
+        DrbdConnection* const cur_conn = conn_iter.next();
+        if (cur_conn->get_name_handle() == conn_name_handle)
+        {
+            connection = cur_conn;
+            break;
+        }
+    }
+    return connection;
+}
+
 uint8_t DrbdResource::get_connection_count() const
 {
     return static_cast<uint8_t> (conn_list->get_size());
@@ -80,9 +121,9 @@ void DrbdResource::remove_connection(const std::string& connection_name)
     ConnectionsMap::Node* node = conn_list->get_node(&connection_name);
     if (node != nullptr)
     {
-        delete node->get_key();
-        delete node->get_value();
+        DrbdConnection* const connection = node->get_value();
         conn_list->remove_node(node);
+        delete connection;
     }
 }
 
@@ -190,18 +231,19 @@ StateFlags::state DrbdResource::child_state_flags_changed()
     return obj_state;
 }
 
-// Creates (allocates and initializes) a new DrbdResource object from a map of properties
+// Creates (allocates and initializes) a new DrbdResource object from the properties of an event line
 //
-// @param event_props Reference to the map of properties from a 'drbdsetup events2' line
+// @param event_props Reference to the parsed properties of a 'drbdsetup events2' line
+// @param rsc_names_ref Table of interned resource names
 // @return Pointer to a newly created DrbdResource object
 // @throws std::bad_alloc, dsaext::DuplicateInsertException
-DrbdResource* DrbdResource::new_from_props(PropsMap& event_props)
+DrbdResource* DrbdResource::new_from_props(EventProps& event_props, NameTable& rsc_names_ref)
 {
     DrbdResource* new_res {nullptr};
-    std::string* res_name = event_props.get(&PROP_KEY_RES_NAME);
+    const StringView* res_name = event_props.get(PROP_KEY_RES_NAME);
     if (res_name != nullptr)
     {
-        new_res = new DrbdResource(*res_name);
+        new_res = new DrbdResource(rsc_names_ref, *res_name);
     }
     if (new_res == nullptr)
     {
@@ -11,8 +11,12 @@
 #include <objects/DrbdVolume.h>
 #include <objects/DrbdRole.h>
 #include <objects/StateFlags.h>
+#include <objects/NameTable.h>
 
 #include <map_types.h>
+#include <EventProps.h>
+#include <StringView.h>
+#include <EventKeywords.h>
 // https://github.com/raltnoeder/cppdsaext
 #include <dsaext.h>
 #include <utils.h>
@@ -21,8 +25,8 @@
 class DrbdResource : public VolumesContainer, public DrbdRole, private StateFlags
 {
   public:
-    static const std::string PROP_KEY_RES_NAME;
-    static const std::string PROP_KEY_NEW_NAME;
+    static const EventKeywords::keyword PROP_KEY_RES_NAME;
+    static const EventKeywords::keyword PROP_KEY_NEW_NAME;
 
     class ConnectionsIterator : public ConnectionsMap::ValuesIterator
     {
@@ -48,24 +52,32 @@ class DrbdResource : public VolumesContainer, public DrbdRole, private StateFlag
     };
 
     // @throws std::bad_alloc
-    DrbdResource(std::string& resource_name);
+    DrbdResource(NameTable& rsc_names_ref, const StringView& resource_name);
     DrbdResource(const DrbdResource& orig) = delete;
     DrbdResource& operator=(const DrbdResource& orig) = delete;
     DrbdResource(DrbdResource&& orig) = delete;
     DrbdResource& operator=(DrbdResource&& orig) = delete;
     virtual ~DrbdResource() noexcept override;
+
+    // Allocated from ObjectPools::resource_pool
+    // @throws std::bad_alloc
+    static void* operator new(size_t size);
+    static void operator delete(void* obj_ptr, size_t size) noexcept;
     virtual const std::string& get_name() const;
+    virtual NameTable::handle get_name_handle() const;
 
     // @throws std::bad_alloc, dsaext::DuplicateInsertException
     virtual void add_connection(DrbdConnection* conn);
     virtual DrbdConnection* get_connection(const std::string& connection_name) const;
+    virtual DrbdConnection* get_connection(NameTable::handle conn_name_handle) const;
     virtual uint8_t get_connection_count() const;
     virtual void remove_connection(const std::string& connection_name);
 
+    // @return true if any of the object's properties changed, false otherwise
     // @throws std::bad_alloc, EventMessageException
-    virtual void update(PropsMap& event_props);
+    virtual bool update(EventProps& event_props);
     // @throws std::bad_alloc, EventMessageException
-    virtual void rename(PropsMap& event_props);
+    virtual void rename(EventProps& event_props);
     virtual ConnectionsIterator connections_iterator();
     virtual ConnectionsIterator connections_iterator(const std::string& connection_name);
 
@@ -82,16 +94,18 @@ class DrbdResource : public VolumesContainer, public DrbdRole, private StateFlag
     virtual bool has_role_alert() const;
     virtual bool has_quorum_alert() const;
 
-    // Creates (allocates and initializes) a new DrbdResource object from a map of properties
+    // Creates (allocates and initializes) a new DrbdResource object from the properties of an event line
     //
-    // @param event_props Reference to the map of properties from a 'drbdsetup events2' line
+    // @param event_props Reference to the parsed properties of a 'drbdsetup events2' line
+    // @param rsc_names_ref Table of interned resource names
     // @return Pointer to a newly created DrbdResource object
     // @throws std::bad_alloc, EventMessageException
-    static DrbdResource* new_from_props(PropsMap& event_props);
+    static DrbdResource* new_from_props(EventProps& event_props, NameTable& rsc_names_ref);
 
   private:
-    std::string name;
     const std::unique_ptr<ConnectionsMap> conn_list;
+    NameTable&          rsc_names;
+    NameTable::handle   name_handle;
     bool role_alert     {false};
     bool quorum_alert   {false};
 };
@@ -1,6 +1,6 @@
 #include <objects/DrbdRole.h>
 
-const std::string DrbdRole::PROP_KEY_ROLE = "role";
+const EventKeywords::keyword DrbdRole::PROP_KEY_ROLE = EventKeywords::keyword::KEY_ROLE;
 
 const char* DrbdRole::ROLE_LABEL_PRIMARY   = "Primary";
 const char* DrbdRole::ROLE_LABEL_SECONDARY = "Secondary";
@@ -31,21 +31,22 @@ const char* DrbdRole::get_role_label() const
 }
 
 // @throws std::bad_alloc, EventMessageException
-DrbdRole::resource_role DrbdRole::parse_role(std::string& role_name)
+DrbdRole::resource_role DrbdRole::parse_role(const StringView& role_name)
 {
+    const EventKeywords::keyword role_id = EventKeywords::lookup(role_name);
     DrbdRole::resource_role role = DrbdRole::resource_role::UNKNOWN;
 
-    if (role_name == ROLE_LABEL_PRIMARY)
+    if (role_id == EventKeywords::keyword::ROLE_PRIMARY)
     {
         role = DrbdRole::resource_role::PRIMARY;
     }
     else
-    if (role_name == ROLE_LABEL_SECONDARY)
+    if (role_id == EventKeywords::keyword::ROLE_SECONDARY)
     {
         role = DrbdRole::resource_role::SECONDARY;
     }
     else
-    if (role_name != ROLE_LABEL_UNKNOWN)
+    if (role_id != EventKeywords::keyword::ROLE_UNKNOWN)
     {
         std::string error_msg("Invalid DRBD event: Invalid DRBD role");
         std::string debug_info("Invalid DRBD role");
@@ -4,6 +4,8 @@
 #include <default_types.h>
 #include <string>
 #include <exceptions.h>
+#include <StringView.h>
+#include <EventKeywords.h>
 
 class DrbdRole
 {
@@ -15,7 +17,7 @@ class DrbdRole
         UNKNOWN
     };
 
-    static const std::string PROP_KEY_ROLE;
+    static const EventKeywords::keyword PROP_KEY_ROLE;
 
     static const char* ROLE_LABEL_PRIMARY;
     static const char* ROLE_LABEL_SECONDARY;
@@ -34,7 +36,7 @@ class DrbdRole
     virtual const char* get_role_label() const;
 
     // @throws EventMessageException
-    static resource_role parse_role(std::string& role_name);
+    static resource_role parse_role(const StringView& role_name);
 
   protected:
     resource_role role  {resource_role::UNKNOWN};
@@ -1,17 +1,19 @@
 #include <objects/DrbdVolume.h>
+#include <objects/ObjectPools.h>
 #include <objects/DrbdConnection.h>
+#include <objects/VolumeHistory.h>
 #include <utils.h>
 #include <integerparse.h>
 
-const std::string DrbdVolume::PROP_KEY_VOL_NR      = "volume";
-const std::string DrbdVolume::PROP_KEY_MINOR       = "minor";
-const std::string DrbdVolume::PROP_KEY_DISK        = "disk";
-const std::string DrbdVolume::PROP_KEY_PEER_DISK   = "peer-disk";
-const std::string DrbdVolume::PROP_KEY_REPLICATION = "replication";
-const std::string DrbdVolume::PROP_KEY_CLIENT      = "client";
-const std::string DrbdVolume::PROP_KEY_PEER_CLIENT = "peer-client";
-const std::string DrbdVolume::PROP_KEY_QUORUM      = "quorum";
-const std::string DrbdVolume::PROP_KEY_SYNC_PERC   = "done";
+const EventKeywords::keyword DrbdVolume::PROP_KEY_VOL_NR      = EventKeywords::keyword::KEY_VOLUME;
+const EventKeywords::keyword DrbdVolume::PROP_KEY_MINOR       = EventKeywords::keyword::KEY_MINOR;
+const EventKeywords::keyword DrbdVolume::PROP_KEY_DISK        = EventKeywords::keyword::KEY_DISK;
+const EventKeywords::keyword DrbdVolume::PROP_KEY_PEER_DISK   = EventKeywords::keyword::KEY_PEER_DISK;
+const EventKeywords::keyword DrbdVolume::PROP_KEY_REPLICATION = EventKeywords::keyword::KEY_REPLICATION;
+const EventKeywords::keyword DrbdVolume::PROP_KEY_CLIENT      = EventKeywords::keyword::KEY_CLIENT;
+const EventKeywords::keyword DrbdVolume::PROP_KEY_PEER_CLIENT = EventKeywords::keyword::KEY_PEER_CLIENT;
+const EventKeywords::keyword DrbdVolume::PROP_KEY_QUORUM      = EventKeywords::keyword::KEY_QUORUM;
+const EventKeywords::keyword DrbdVolume::PROP_KEY_SYNC_PERC   = EventKeywords::keyword::KEY_DONE;
 
 const char* DrbdVolume::DS_LABEL_DISKLESS     = "Diskless";
 const char* DrbdVolume::DS_LABEL_ATTACHING    = "Attaching";
@@ -69,6 +71,21 @@ DrbdVolume::DrbdVolume(uint16_t volume_nr) :
     vol_client_state = DrbdVolume::client_state::UNKNOWN;
 }
 
+DrbdVolume::~DrbdVolume() noexcept
+{
+}
+
+// @throws std::bad_alloc
+void* DrbdVolume::operator new(const size_t size)
+{
+    return ObjectPools::volume_pool.allocate(size);
+}
+
+void DrbdVolume::operator delete(void* const obj_ptr, const size_t size) noexcept
+{
+    ObjectPools::volume_pool.deallocate(obj_ptr, size);
+}
+
 const uint16_t DrbdVolume::get_volume_nr() const
 {
     return vol_nr;
@@ -84,13 +101,35 @@ uint16_t DrbdVolume::get_sync_perc() const
     return sync_perc;
 }
 
+// @throws std::bad_alloc
+void DrbdVolume::record_history(const uint64_t time_secs)
+{
+    if (history == nullptr)
+    {
+        history = std::unique_ptr<VolumeHistory>(new VolumeHistory());
+    }
+    history->record(time_secs, sync_perc, vol_disk_state, vol_repl_state);
+}
+
+const VolumeHistory* DrbdVolume::get_history() const noexcept
+{
+    return history.get();
+}
+
 // @throws std::bad_alloc, EventMessageException
-void DrbdVolume::update(PropsMap& event_props)
+bool DrbdVolume::update(EventProps& event_props)
 {
-    std::string* prop_disk = event_props.get(&PROP_KEY_DISK);
+    const int32_t last_minor_nr = minor_nr;
+    const uint16_t last_sync_perc = sync_perc;
+    const disk_state last_disk_state = vol_disk_state;
+    const repl_state last_repl_state = vol_repl_state;
+    const client_state last_client_state = vol_client_state;
+    const bool last_quorum_alert = quorum_alert;
+
+    const StringView* prop_disk = event_props.get(PROP_KEY_DISK);
     if (prop_disk == nullptr)
     {
-        prop_disk = event_props.get(&PROP_KEY_PEER_DISK);
+        prop_disk = event_props.get(PROP_KEY_PEER_DISK);
     }
 
     if (prop_disk != nullptr)
@@ -98,13 +137,13 @@ void DrbdVolume::update(PropsMap& event_props)
         vol_disk_state = parse_disk_state(*prop_disk);
     }
 
-    std::string* prop_replication = event_props.get(&PROP_KEY_REPLICATION);
+    const StringView* prop_replication = event_props.get(PROP_KEY_REPLICATION);
     if (prop_replication != nullptr)
     {
         vol_repl_state = parse_repl_state(*prop_replication);
     }
 
-    std::string* minor_nr_str = event_props.get(&PROP_KEY_MINOR);
+    const StringView* minor_nr_str = event_props.get(PROP_KEY_MINOR);
     if (minor_nr_str != nullptr)
     {
         try
@@ -119,10 +158,10 @@ void DrbdVolume::update(PropsMap& event_props)
         }
     }
 
-    std::string* prop_client = event_props.get(&PROP_KEY_CLIENT);
+    const StringView* prop_client = event_props.get(PROP_KEY_CLIENT);
     if (prop_client == nullptr)
     {
-        prop_client = event_props.get(&PROP_KEY_PEER_CLIENT);
+        prop_client = event_props.get(PROP_KEY_PEER_CLIENT);
     }
 
     if (prop_client != nullptr)
@@ -130,74 +169,41 @@ void DrbdVolume::update(PropsMap& event_props)
         vol_client_state = parse_client_state(*prop_client);
     }
 
-    std::string* prop_quorum = event_props.get(&PROP_KEY_QUORUM);
+    const StringView* prop_quorum = event_props.get(PROP_KEY_QUORUM);
     if (prop_quorum != nullptr)
     {
         quorum_alert = !parse_quorum_state(*prop_quorum);
     }
 
+    if (vol_repl_state == DrbdVolume::repl_state::ESTABLISHED)
     {
-        bool is_resyncing {false};
-        switch (vol_repl_state)
-        {
-            case DrbdVolume::repl_state::OFF:
-                // fall-through
-            case DrbdVolume::repl_state::BEHIND:
-                // fall-through
-            case DrbdVolume::repl_state::STARTING_SYNC_TARGET:
-                // fall-through
-            case DrbdVolume::repl_state::SYNC_TARGET:
-                // fall-through
-            case DrbdVolume::repl_state::PAUSED_SYNC_TARGET:
-                // fall-through
-            case DrbdVolume::repl_state::VERIFY_TARGET:
-                is_resyncing = true;
-                break;
-            case DrbdVolume::repl_state::ESTABLISHED:
-                // Whenever the replication state returns to ESTABLISHED, reset
-                // the sync percentage, because the drbdsetup events commonly
-                // skips reporting 100 percent sync percentage
-                sync_perc = MAX_SYNC_PERC;
-                break;
-            case DrbdVolume::repl_state::AHEAD:
-                // fall-through
-            case DrbdVolume::repl_state::PAUSED_SYNC_SOURCE:
-                // fall-through
-            case DrbdVolume::repl_state::STARTING_SYNC_SOURCE:
-                // fall-through
-            case DrbdVolume::repl_state::SYNC_SOURCE:
-                // fall-through
-            case DrbdVolume::repl_state::VERIFY_SOURCE:
-                // fall-through
-            case DrbdVolume::repl_state::WF_BITMAP_SOURCE:
-                // fall-through
-            case DrbdVolume::repl_state::WF_BITMAP_TARGET:
-                // fall-through
-            case DrbdVolume::repl_state::WF_SYNC_UUID:
-                // fall-through
-            case DrbdVolume::repl_state::UNKNOWN:
-                // fall-through
-            default:
-                break;
-        }
-        if (is_resyncing)
+        // Whenever the replication state returns to ESTABLISHED, reset
+        // the sync percentage, because the drbdsetup events commonly
+        // skips reporting 100 percent sync percentage
+        sync_perc = MAX_SYNC_PERC;
+    }
+    else
+    if (is_resyncing(vol_repl_state))
+    {
+        const StringView* prop_sync_perc = event_props.get(PROP_KEY_SYNC_PERC);
+        if (prop_sync_perc != nullptr)
         {
-            std::string* prop_sync_perc = event_props.get(&PROP_KEY_SYNC_PERC);
-            if (prop_sync_perc != nullptr)
+            try
             {
-                try
-                {
-                    sync_perc = parse_sync_perc(*prop_sync_perc);
-                }
-                catch (dsaext::NumberFormatException&)
-                {
-                    std::string error_msg("Invalid DRBD event: Invalid sync percentage value");
-                    std::string debug_info("Invalid sync percentage value");
-                    throw EventMessageException(&error_msg, &debug_info, nullptr);
-                }
+                sync_perc = parse_sync_perc(*prop_sync_perc);
+            }
+            catch (dsaext::NumberFormatException&)
+            {
+                std::string error_msg("Invalid DRBD event: Invalid sync percentage value");
+                std::string debug_info("Invalid sync percentage value");
+                throw EventMessageException(&error_msg, &debug_info, nullptr);
             }
         }
     }
+
+    return minor_nr != last_minor_nr || sync_perc != last_sync_perc || vol_disk_state != last_disk_state ||
+        vol_repl_state != last_repl_state || vol_client_state != last_client_state ||
+        quorum_alert != last_quorum_alert;
 }
 
 int32_t DrbdVolume::get_minor_nr() const
@@ -226,9 +232,14 @@ DrbdVolume::disk_state DrbdVolume::get_disk_state() const
 }
 
 const char* DrbdVolume::get_disk_state_label() const
+{
+    return disk_state_to_label(vol_disk_state);
+}
+
+const char* DrbdVolume::disk_state_to_label(const disk_state state)
 {
     const char* label = DS_LABEL_UNKNOWN;
-    switch (vol_disk_state)
+    switch (state)
     {
         case DrbdVolume::disk_state::ATTACHING:
             label = DS_LABEL_ATTACHING;
@@ -271,9 +282,14 @@ DrbdVolume::repl_state DrbdVolume::get_replication_state() const
 }
 
 const char* DrbdVolume::get_replication_state_label() const
+{
+    return repl_state_to_label(vol_repl_state);
+}
+
+const char* DrbdVolume::repl_state_to_label(const repl_state state)
 {
     const char* label = RS_LABEL_UNKNOWN;
-    switch (vol_repl_state)
+    switch (state)
     {
         case DrbdVolume::repl_state::AHEAD:
             label = RS_LABEL_AHEAD;
@@ -498,57 +514,124 @@ StateFlags::state DrbdVolume::child_state_flags_changed()
     return StateFlags::state::NORM;
 }
 
+// Entering the Established replication state resets the sync percentage, and the
+// sync percentage is applied only if the replication state is a resynchronization state
+// @throws std::bad_alloc, EventMessageException
+bool DrbdVolume::has_transition_effects(EventProps& pending_props, EventProps& next_props)
+{
+    // The replication state decides whether the sync percentage is applied or reset, therefore,
+    // a change of the replication state by the next event line would discard the pending event
+    // line's sync percentage, or the sync percentage reset by the pending event line
+    bool effects = false;
+    if (next_props.get(PROP_KEY_REPLICATION) != nullptr)
+    {
+        effects = pending_props.get(PROP_KEY_SYNC_PERC) != nullptr;
+        const StringView* const prop_replication = pending_props.get(PROP_KEY_REPLICATION);
+        if (!effects && prop_replication != nullptr)
+        {
+            effects = parse_repl_state(*prop_replication) == DrbdVolume::repl_state::ESTABLISHED;
+        }
+    }
+    return effects;
+}
+
+// Indicates whether the sync percentage is tracked in the specified replication state
+bool DrbdVolume::is_resyncing(const DrbdVolume::repl_state state)
+{
+    bool resyncing {false};
+    switch (state)
+    {
+        case DrbdVolume::repl_state::OFF:
+            // fall-through
+        case DrbdVolume::repl_state::BEHIND:
+            // fall-through
+        case DrbdVolume::repl_state::STARTING_SYNC_TARGET:
+            // fall-through
+        case DrbdVolume::repl_state::SYNC_TARGET:
+            // fall-through
+        case DrbdVolume::repl_state::PAUSED_SYNC_TARGET:
+            // fall-through
+        case DrbdVolume::repl_state::VERIFY_TARGET:
+            resyncing = true;
+            break;
+        case DrbdVolume::repl_state::ESTABLISHED:
+            // fall-through
+        case DrbdVolume::repl_state::AHEAD:
+            // fall-through
+        case DrbdVolume::repl_state::PAUSED_SYNC_SOURCE:
+            // fall-through
+        case DrbdVolume::repl_state::STARTING_SYNC_SOURCE:
+            // fall-through
+        case DrbdVolume::repl_state::SYNC_SOURCE:
+            // fall-through
+        case DrbdVolume::repl_state::VERIFY_SOURCE:
+            // fall-through
+        case DrbdVolume::repl_state::WF_BITMAP_SOURCE:
+            // fall-through
+        case DrbdVolume::repl_state::WF_BITMAP_TARGET:
+            // fall-through
+        case DrbdVolume::repl_state::WF_SYNC_UUID:
+            // fall-through
+        case DrbdVolume::repl_state::UNKNOWN:
+            // fall-through
+        default:
+            break;
+    }
+    return resyncing;
+}
+
 // @throws std::bad_alloc, EventMessageException
-DrbdVolume::disk_state DrbdVolume::parse_disk_state(std::string& state_name)
+DrbdVolume::disk_state DrbdVolume::parse_disk_state(const StringView& state_name)
 {
+    const EventKeywords::keyword state_id = EventKeywords::lookup(state_name);
     DrbdVolume::disk_state state = DrbdVolume::disk_state::UNKNOWN;
 
-    if (state_name == DS_LABEL_DISKLESS)
+    if (state_id == EventKeywords::keyword::DS_DISKLESS)
     {
         state = DrbdVolume::disk_state::DISKLESS;
     }
     else
-    if (state_name == DS_LABEL_ATTACHING)
+    if (state_id == EventKeywords::keyword::DS_ATTACHING)
     {
         state = DrbdVolume::disk_state::ATTACHING;
     }
     else
-    if (state_name == DS_LABEL_DETACHING)
+    if (state_id == EventKeywords::keyword::DS_DETACHING)
     {
         state = DrbdVolume::disk_state::DETACHING;
     }
     else
-    if (state_name == DS_LABEL_FAILED)
+    if (state_id == EventKeywords::keyword::DS_FAILED)
     {
         state = DrbdVolume::disk_state::FAILED;
     }
     else
-    if (state_name == DS_LABEL_NEGOTIATING)
+    if (state_id == EventKeywords::keyword::DS_NEGOTIATING)
     {
         state = DrbdVolume::disk_state::NEGOTIATING;
     }
     else
-    if (state_name == DS_LABEL_INCONSISTENT)
+    if (state_id == EventKeywords::keyword::DS_INCONSISTENT)
     {
         state = DrbdVolume::disk_state::INCONSISTENT;
     }
     else
-    if (state_name == DS_LABEL_OUTDATED)
+    if (state_id == EventKeywords::keyword::DS_OUTDATED)
     {
         state = DrbdVolume::disk_state::OUTDATED;
     }
     else
-    if (state_name == DS_LABEL_CONSISTENT)
+    if (state_id == EventKeywords::keyword::DS_CONSISTENT)
     {
         state = DrbdVolume::disk_state::CONSISTENT;
     }
     else
-    if (state_name == DS_LABEL_UP_TO_DATE)
+    if (state_id == EventKeywords::keyword::DS_UP_TO_DATE)
     {
         state = DrbdVolume::disk_state::UP_TO_DATE;
     }
     else
-    if (state_name != DS_LABEL_UNKNOWN)
+    if (state_id != EventKeywords::keyword::DS_UNKNOWN)
     {
         std::string error_msg("Invalid DRBD event: Invalid disk state");
         std::string debug_info("Invalid disk state");
@@ -559,86 +642,87 @@ DrbdVolume::disk_state DrbdVolume::parse_disk_state(std::string& state_name)
 }
 
 // @throws std::bad_alloc, EventMessageException
-DrbdVolume::repl_state DrbdVolume::parse_repl_state(std::string& state_name)
+DrbdVolume::repl_state DrbdVolume::parse_repl_state(const StringView& state_name)
 {
+    const EventKeywords::keyword state_id = EventKeywords::lookup(state_name);
     DrbdVolume::repl_state state = DrbdVolume::repl_state::UNKNOWN;
 
-    if (state_name == RS_LABEL_AHEAD)
+    if (state_id == EventKeywords::keyword::RS_AHEAD)
     {
         state = DrbdVolume::repl_state::AHEAD;
     }
     else
-    if (state_name == RS_LABEL_BEHIND)
+    if (state_id == EventKeywords::keyword::RS_BEHIND)
     {
         state = DrbdVolume::repl_state::BEHIND;
     }
     else
-    if (state_name == RS_LABEL_ESTABLISHED)
+    if (state_id == EventKeywords::keyword::RS_ESTABLISHED)
     {
         state = DrbdVolume::repl_state::ESTABLISHED;
     }
     else
-    if (state_name == RS_LABEL_OFF)
+    if (state_id == EventKeywords::keyword::RS_OFF)
     {
         state = DrbdVolume::repl_state::OFF;
     }
     else
-    if (state_name == RS_LABEL_PAUSED_SYNC_SOURCE)
+    if (state_id == EventKeywords::keyword::RS_PAUSED_SYNC_SOURCE)
     {
         state = DrbdVolume::repl_state::PAUSED_SYNC_SOURCE;
     }
     else
-    if (state_name == RS_LABEL_PAUSED_SYNC_TARGET)
+    if (state_id == EventKeywords::keyword::RS_PAUSED_SYNC_TARGET)
     {
         state = DrbdVolume::repl_state::PAUSED_SYNC_TARGET;
     }
     else
-    if (state_name == RS_LABEL_STARTING_SYNC_SOURCE)
+    if (state_id == EventKeywords::keyword::RS_STARTING_SYNC_SOURCE)
     {
         state = DrbdVolume::repl_state::STARTING_SYNC_SOURCE;
     }
     else
-    if (state_name == RS_LABEL_STARTING_SYNC_TARGET)
+    if (state_id == EventKeywords::keyword::RS_STARTING_SYNC_TARGET)
     {
         state = DrbdVolume::repl_state::STARTING_SYNC_TARGET;
     }
     else
-    if (state_name == RS_LABEL_SYNC_SOURCE)
+    if (state_id == EventKeywords::keyword::RS_SYNC_SOURCE)
     {
         state = DrbdVolume::repl_state::SYNC_SOURCE;
     }
     else
-    if (state_name == RS_LABEL_SYNC_TARGET)
+    if (state_id == EventKeywords::keyword::RS_SYNC_TARGET)
     {
         state = DrbdVolume::repl_state::SYNC_TARGET;
     }
     else
-    if (state_name == RS_LABEL_VERIFY_SOURCE)
+    if (state_id == EventKeywords::keyword::RS_VERIFY_SOURCE)
     {
         state = DrbdVolume::repl_state::VERIFY_SOURCE;
     }
     else
-    if (state_name == RS_LABEL_VERIFY_TARGET)
+    if (state_id == EventKeywords::keyword::RS_VERIFY_TARGET)
     {
         state = DrbdVolume::repl_state::VERIFY_TARGET;
     }
     else
-    if (state_name == RS_LABEL_WF_BITMAP_SOURCE)
+    if (state_id == EventKeywords::keyword::RS_WF_BITMAP_SOURCE)
     {
         state = DrbdVolume::repl_state::WF_BITMAP_SOURCE;
     }
     else
-    if (state_name == RS_LABEL_WF_BITMAP_TARGET)
+    if (state_id == EventKeywords::keyword::RS_WF_BITMAP_TARGET)
     {
         state = DrbdVolume::repl_state::WF_BITMAP_TARGET;
     }
     else
-    if (state_name == RS_LABEL_WF_SYNC_UUID)
+    if (state_id == EventKeywords::keyword::RS_WF_SYNC_UUID)
     {
         state = DrbdVolume::repl_state::WF_SYNC_UUID;
     }
     else
-    if (state_name != RS_LABEL_UNKNOWN)
+    if (state_id != EventKeywords::keyword::RS_UNKNOWN)
     {
         std::string error_msg("Invalid DRBD event: Invalid replication state");
         std::string debug_info("Invalid replication state");
@@ -649,21 +733,22 @@ DrbdVolume::repl_state DrbdVolume::parse_repl_state(std::string& state_name)
 }
 
 // @throws std::bad_alloc, EventMessageException
-DrbdVolume::client_state DrbdVolume::parse_client_state(std::string& value_str)
+DrbdVolume::client_state DrbdVolume::parse_client_state(const StringView& value_str)
 {
+    const EventKeywords::keyword value_id = EventKeywords::lookup(value_str);
     DrbdVolume::client_state state = DrbdVolume::client_state::UNKNOWN;
 
-    if (value_str == CS_LABEL_DISABLED)
+    if (value_id == EventKeywords::keyword::CLIENT_DISABLED)
     {
         state = DrbdVolume::client_state::DISABLED;
     }
     else
-    if (value_str == CS_LABEL_ENABLED)
+    if (value_id == EventKeywords::keyword::CLIENT_ENABLED)
     {
         state = DrbdVolume::client_state::ENABLED;
     }
     else
-    if (value_str != CS_LABEL_UNKNOWN)
+    if (value_id != EventKeywords::keyword::CLIENT_UNKNOWN)
     {
         std::string error_msg("Invalid DRBD event: Invalid client (diskless) mode");
         std::string debug_info("Invalid client mode value");
@@ -674,16 +759,17 @@ DrbdVolume::client_state DrbdVolume::parse_client_state(std::string& value_str)
 }
 
 // @throws std::bad_alloc, EventMessageException
-bool DrbdVolume::parse_quorum_state(std::string& value_str)
+bool DrbdVolume::parse_quorum_state(const StringView& value_str)
 {
+    const EventKeywords::keyword value_id = EventKeywords::lookup(value_str);
     bool quorum_present {false};
 
-    if (value_str == QU_LABEL_PRESENT)
+    if (value_id == EventKeywords::keyword::QUORUM_PRESENT)
     {
         quorum_present = true;
     }
     else
-    if (value_str != QU_LABEL_LOST)
+    if (value_id != EventKeywords::keyword::QUORUM_LOST)
     {
         std::string error_msg("Invalid DRBD event: Invalid quorum state");
         std::string debug_info("Invalid quorum state");
@@ -695,33 +781,33 @@ bool DrbdVolume::parse_quorum_state(std::string& value_str)
 
 
 // @throws NumberFormatException
-uint16_t DrbdVolume::parse_volume_nr(std::string& value_str)
+uint16_t DrbdVolume::parse_volume_nr(const StringView& value_str)
 {
-    return dsaext::parse_unsigned_int16(value_str);
+    return dsaext::parse_unsigned_int16_c_str(value_str.data(), value_str.length());
 }
 
 // @throws NumberFormatException
-int32_t DrbdVolume::parse_minor_nr(std::string& value_str)
+int32_t DrbdVolume::parse_minor_nr(const StringView& value_str)
 {
-    return dsaext::parse_signed_int32(value_str);
+    return dsaext::parse_signed_int32_c_str(value_str.data(), value_str.length());
 }
 
 // @throws NumberFormatException
-uint16_t DrbdVolume::parse_sync_perc(std::string& value_str)
+uint16_t DrbdVolume::parse_sync_perc(const StringView& value_str)
 {
     uint16_t result {0};
-    size_t split_idx = value_str.find(FRACT_SEPA, 0);
+    size_t split_idx = value_str.find(FRACT_SEPA[0], 0);
     if (split_idx != std::string::npos)
     {
-        std::string perc_value_str = value_str.substr(0, split_idx);
-        std::string perc_fract_str = value_str.substr(split_idx + 1);
+        const StringView perc_value_str = value_str.substr(0, split_idx);
+        const StringView perc_fract_str = value_str.substr(split_idx + 1, value_str.length());
 
-        uint16_t value = dsaext::parse_unsigned_int16(perc_value_str);
+        uint16_t value = dsaext::parse_unsigned_int16_c_str(perc_value_str.data(), perc_value_str.length());
         if (value > MAX_PERC)
         {
             throw dsaext::NumberFormatException();
         }
-        uint16_t fract = dsaext::parse_unsigned_int16(perc_fract_str);
+        uint16_t fract = dsaext::parse_unsigned_int16_c_str(perc_fract_str.data(), perc_fract_str.length());
         if (fract > MAX_FRACT)
         {
             throw dsaext::NumberFormatException();
@@ -735,20 +821,20 @@ uint16_t DrbdVolume::parse_sync_perc(std::string& value_str)
     return result;
 }
 
-// Creates (allocates and initializes) a new DrbdVolume object from a map of properties
+// Creates (allocates and initializes) a new DrbdVolume object from the properties of an event line
 //
-// @param event_props Reference to the map of properties from a 'drbdsetup events2' line
+// @param event_props Reference to the parsed properties of a 'drbdsetup events2' line
 // @return Pointer to a newly created DrbdVolume object
 // @throws std::bad_alloc, EventMessageException
-DrbdVolume* DrbdVolume::new_from_props(PropsMap& event_props)
+DrbdVolume* DrbdVolume::new_from_props(EventProps& event_props)
 {
     DrbdVolume* vol {nullptr};
-    std::string* number_str = event_props.get(&PROP_KEY_VOL_NR);
+    const StringView* number_str = event_props.get(PROP_KEY_VOL_NR);
     if (number_str != nullptr)
     {
         try
         {
-            uint16_t vol_nr = dsaext::parse_unsigned_int16(*number_str);
+            uint16_t vol_nr = parse_volume_nr(*number_str);
             vol = new DrbdVolume(vol_nr);
         }
         catch (dsaext::NumberFormatException&)
@@ -3,17 +3,22 @@
 
 #include <default_types.h>
 #include <new>
+#include <memory>
 #include <string>
 
 #include <objects/StateFlags.h>
 
 #include <map_types.h>
+#include <EventProps.h>
+#include <StringView.h>
+#include <EventKeywords.h>
 // https://github.com/raltnoeder/cppdsaext
 #include <dsaext.h>
 #include <utils.h>
 #include <exceptions.h>
 
 class DrbdConnection;
+class VolumeHistory;
 
 class DrbdVolume : private StateFlags
 {
@@ -59,15 +64,15 @@ class DrbdVolume : private StateFlags
         UNKNOWN
     };
 
-    static const std::string PROP_KEY_VOL_NR;
-    static const std::string PROP_KEY_MINOR;
-    static const std::string PROP_KEY_DISK;
-    static const std::string PROP_KEY_PEER_DISK;
-    static const std::string PROP_KEY_REPLICATION;
-    static const std::string PROP_KEY_CLIENT;
-    static const std::string PROP_KEY_PEER_CLIENT;
-    static const std::string PROP_KEY_QUORUM;
-    static const std::string PROP_KEY_SYNC_PERC;
+    static const EventKeywords::keyword PROP_KEY_VOL_NR;
+    static const EventKeywords::keyword PROP_KEY_MINOR;
+    static const EventKeywords::keyword PROP_KEY_DISK;
+    static const EventKeywords::keyword PROP_KEY_PEER_DISK;
+    static const EventKeywords::keyword PROP_KEY_REPLICATION;
+    static const EventKeywords::keyword PROP_KEY_CLIENT;
+    static const EventKeywords::keyword PROP_KEY_PEER_CLIENT;
+    static const EventKeywords::keyword PROP_KEY_QUORUM;
+    static const EventKeywords::keyword PROP_KEY_SYNC_PERC;
 
     static const char* DS_LABEL_DISKLESS;
     static const char* DS_LABEL_ATTACHING;
@@ -122,9 +127,12 @@ class DrbdVolume : private StateFlags
     DrbdVolume& operator=(const DrbdVolume& orig) = delete;
     DrbdVolume(DrbdVolume&& orig) = delete;
     DrbdVolume& operator=(DrbdVolume&& orig) = delete;
-    virtual ~DrbdVolume() noexcept override
-    {
-    }
+    virtual ~DrbdVolume() noexcept override;
+
+    // Allocated from ObjectPools::volume_pool
+    // @throws std::bad_alloc
+    static void* operator new(size_t size);
+    static void operator delete(void* obj_ptr, size_t size) noexcept;
 
     virtual const uint16_t get_volume_nr() const;
     virtual const uint16_t& get_volume_nr_ref() const;
@@ -134,8 +142,9 @@ class DrbdVolume : private StateFlags
     // @throws std::bad_alloc, EventMessageException
     virtual void set_minor_nr(int32_t value);
 
+    // @return true if any of the object's properties changed, false otherwise
     // @throws std::bad_alloc, EventMessageException
-    virtual void update(PropsMap& event_props);
+    virtual bool update(EventProps& event_props);
 
     virtual disk_state get_disk_state() const;
     virtual const char* get_disk_state_label() const;
@@ -143,6 +152,12 @@ class DrbdVolume : private StateFlags
     virtual const char* get_replication_state_label() const;
     virtual void set_connection(DrbdConnection* conn);
 
+    // Records the current disk state, replication state and resynchronization progress in the volume's history
+    // @throws std::bad_alloc
+    virtual void record_history(const uint64_t time_secs);
+    // @return History of the volume, or nullptr if nothing was recorded yet
+    virtual const VolumeHistory* get_history() const noexcept;
+
     using StateFlags::has_mark_state;
     using StateFlags::has_warn_state;
     using StateFlags::has_alert_state;
@@ -158,33 +173,44 @@ class DrbdVolume : private StateFlags
     virtual bool has_replication_alert();
     virtual bool has_quorum_alert();
 
-    // Creates (allocates and initializes) a new DrbdVolume object from a map of properties
+    // Creates (allocates and initializes) a new DrbdVolume object from the properties of an event line
     //
-    // @param event_props Reference to the map of properties from a 'drbdsetup events2' line
+    // @param event_props Reference to the parsed properties of a 'drbdsetup events2' line
     // @return Pointer to a newly created DrbdVolume object
     // @throws std::bad_alloc, EventMessageException
-    static DrbdVolume* new_from_props(PropsMap& event_props);
+    static DrbdVolume* new_from_props(EventProps& event_props);
+
+    // Indicates whether applying the properties of an event line and then those of the next event
+    // line for the same volume has an effect that applying the merged properties of both event
+    // lines does not reproduce, which prevents coalescing the two event lines
+    // @throws std::bad_alloc, EventMessageException
+    static bool has_transition_effects(EventProps& pending_props, EventProps& next_props);
+
+    static bool is_resyncing(repl_state state);
+
+    static const char* disk_state_to_label(const disk_state state);
+    static const char* repl_state_to_label(const repl_state state);
 
     // @throws std::bad_alloc, EventMessageException
-    static disk_state parse_disk_state(std::string& state_name);
+    static disk_state parse_disk_state(const StringView& state_name);
 
     // @throws std::bad_alloc, EventMessageException
-    static repl_state parse_repl_state(std::string& state_name);
+    static repl_state parse_repl_state(const StringView& state_name);
 
     // @throws NumberFormatException
-    static uint16_t parse_volume_nr(std::string& value_str);
+    static uint16_t parse_volume_nr(const StringView& value_str);
 
     // @throws NumberFormatException
-    static int32_t parse_minor_nr(std::string& value_str);
+    static int32_t parse_minor_nr(const StringView& value_str);
 
     // @throws std::bad_alloc, EventMessageException
-    static client_state parse_client_state(std::string& value_str);
+    static client_state parse_client_state(const StringView& value_str);
 
     // @throws std::bad_alloc, EventMessageException
-    static bool parse_quorum_state(std::string& value_str);
+    static bool parse_quorum_state(const StringView& value_str);
 
     // @throws NumberFormatException
-    static uint16_t parse_sync_perc(std::string& value_str);
+    static uint16_t parse_sync_perc(const StringView& value_str);
 
   private:
     const uint16_t vol_nr           {static_cast<uint16_t> (0xFFFF)};
@@ -194,6 +220,7 @@ class DrbdVolume : private StateFlags
     repl_state vol_repl_state       {repl_state::UNKNOWN};
     client_state vol_client_state   {client_state::UNKNOWN};
     DrbdConnection* connection      {nullptr};
+    std::unique_ptr<VolumeHistory> history;
     bool disk_alert                 {false};
     bool repl_warn                  {false};
     bool repl_alert                 {false};
@@ -0,0 +1,208 @@
+#include <objects/NameTable.h>
+#include <cstring>
+
+const NameTable::handle NameTable::INVALID_HANDLE = 0xFFFFFFFFUL;
+
+const size_t NameTable::INITIAL_CAPACITY = 16;
+
+NameTable::NameTable()
+{
+}
+
+NameTable::~NameTable() noexcept
+{
+    for (size_t idx = 0; idx < entries_used; ++idx)
+    {
+        delete entries[idx].name;
+    }
+    delete[] entries;
+    delete[] slots;
+}
+
+// @throws std::bad_alloc
+NameTable::handle NameTable::acquire(const StringView& name)
+{
+    handle name_handle = INVALID_HANDLE;
+    const uint32_t hash = hash_name(name);
+    size_t slot_idx = slots_capacity > 0 ? find_slot(name, hash) : 0;
+    if (slots_capacity > 0 && slots[slot_idx] != INVALID_HANDLE)
+    {
+        name_handle = slots[slot_idx];
+        ++(entries[name_handle].ref_count);
+    }
+    else
+    {
+        // Allocate everything that is required before changing the table's state
+        if ((name_count + 1) * 2 > slots_capacity)
+        {
+            grow_slots();
+            slot_idx = find_slot(name, hash);
+        }
+        if (free_list == INVALID_HANDLE && entries_used >= entries_capacity)
+        {
+            grow_entries();
+        }
+        std::string* const name_str = new std::string(name.data(), name.length());
+
+        if (free_list != INVALID_HANDLE)
+        {
+            name_handle = free_list;
+            free_list = entries[name_handle].next_free;
+        }
+        else
+        {
+            name_handle = static_cast<handle> (entries_used);
+            ++entries_used;
+        }
+
+        name_entry& entry = entries[name_handle];
+        entry.name = name_str;
+        entry.hash = hash;
+        entry.ref_count = 1;
+        entry.next_free = INVALID_HANDLE;
+
+        slots[slot_idx] = name_handle;
+        ++name_count;
+    }
+    return name_handle;
+}
+
+void NameTable::acquire(const handle name_handle) noexcept
+{
+    ++(entries[name_handle].ref_count);
+}
+
+void NameTable::release(const handle name_handle) noexcept
+{
+    name_entry& entry = entries[name_handle];
+    --(entry.ref_count);
+    if (entry.ref_count == 0)
+    {
+        // Remove the handle from the hash index, then move entries that follow in the
+        // same probe sequence backwards, so that no lookup ends at the vacated slot
+        const size_t mask = slots_capacity - 1;
+        size_t slot_idx = entry.hash & mask;
+        while (slots[slot_idx] != name_handle)
+        {
+            slot_idx = (slot_idx + 1) & mask;
+        }
+        size_t next_idx = (slot_idx + 1) & mask;
+        while (slots[next_idx] != INVALID_HANDLE)
+        {
+            const size_t home_idx = entries[slots[next_idx]].hash & mask;
+            if (((next_idx - home_idx) & mask) >= ((next_idx - slot_idx) & mask))
+            {
+                slots[slot_idx] = slots[next_idx];
+                slot_idx = next_idx;
+            }
+            next_idx = (next_idx + 1) & mask;
+        }
+        slots[slot_idx] = INVALID_HANDLE;
+
+        delete entry.name;
+        entry.name = nullptr;
+        entry.next_free = free_list;
+        free_list = name_handle;
+        --name_count;
+    }
+}
+
+NameTable::handle NameTable::find(const StringView& name) const noexcept
+{
+    handle name_handle = INVALID_HANDLE;
+    if (slots_capacity > 0)
+    {
+        name_handle = slots[find_slot(name, hash_name(name))];
+    }
+    return name_handle;
+}
+
+const std::string& NameTable::get_name(const handle name_handle) const noexcept
+{
+    return *(entries[name_handle].name);
+}
+
+size_t NameTable::get_size() const noexcept
+{
+    return name_count;
+}
+
+size_t NameTable::get_handle_limit() const noexcept
+{
+    return entries_used;
+}
+
+size_t NameTable::find_slot(const StringView& name, const uint32_t hash) const noexcept
+{
+    const size_t mask = slots_capacity - 1;
+    size_t slot_idx = hash & mask;
+    while (slots[slot_idx] != INVALID_HANDLE)
+    {
+        const name_entry& entry = entries[slots[slot_idx]];
+        if (entry.hash == hash && name.equals(*(entry.name)))
+        {
+            break;
+        }
+        slot_idx = (slot_idx + 1) & mask;
+    }
+    return slot_idx;
+}
+
+// @throws std::bad_alloc
+void NameTable::grow_slots()
+{
+    const size_t new_capacity = slots_capacity > 0 ? slots_capacity * 2 : INITIAL_CAPACITY;
+    handle* const new_slots = new handle[new_capacity];
+    for (size_t idx = 0; idx < new_capacity; ++idx)
+    {
+        new_slots[idx] = INVALID_HANDLE;
+    }
+
+    const size_t mask = new_capacity - 1;
+    for (size_t idx = 0; idx < slots_capacity; ++idx)
+    {
+        const handle name_handle = slots[idx];
+        if (name_handle != INVALID_HANDLE)
+        {
+            size_t new_idx = entries[name_handle].hash & mask;
+            while (new_slots[new_idx] != INVALID_HANDLE)
+            {
+                new_idx = (new_idx + 1) & mask;
+            }
+            new_slots[new_idx] = name_handle;
+        }
+    }
+
+    delete[] slots;
+    slots = new_slots;
+    slots_capacity = new_capacity;
+}
+
+// @throws std::bad_alloc
+void NameTable::grow_entries()
+{
+    const size_t new_capacity = entries_capacity > 0 ? entries_capacity * 2 : INITIAL_CAPACITY;
+    name_entry* const new_entries = new name_entry[new_capacity];
+    if (entries_used > 0)
+    {
+        std::memcpy(new_entries, entries, entries_used * sizeof (name_entry));
+    }
+
+    delete[] entries;
+    entries = new_entries;
+    entries_capacity = new_capacity;
+}
+
+// FNV-1a
+uint32_t NameTable::hash_name(const StringView& name) noexcept
+{
+    uint32_t hash = 2166136261UL;
+    const char* const name_data = name.data();
+    const size_t name_length = name.length();
+    for (size_t idx = 0; idx < name_length; ++idx)
+    {
+        hash ^= static_cast<unsigned char> (name_data[idx]);
+        hash *= 16777619UL;
+    }
+    return hash;
+}
@@ -0,0 +1,94 @@
+#ifndef NAMETABLE_H
+#define NAMETABLE_H
+
+#include <default_types.h>
+#include <new>
+#include <string>
+#include <StringView.h>
+
+// Table of interned names
+//
+// Each distinct name is stored once and is identified by a small integer handle.
+// Handles are reference counted; a name is removed from the table when the last
+// reference is released, and its handle may then be reused for another name.
+// Handles are allocated densely, so they can be used as indexes into arrays.
+//
+// The string instance of an interned name is never moved, therefore references
+// to it remain valid for as long as the name's handle is referenced.
+//
+// Instances are not thread-safe.
+class NameTable
+{
+  public:
+    typedef uint32_t handle;
+
+    static const handle INVALID_HANDLE;
+
+    NameTable();
+    virtual ~NameTable() noexcept;
+
+    NameTable(const NameTable& orig) = delete;
+    NameTable& operator=(const NameTable& orig) = delete;
+    NameTable(NameTable&& orig) = delete;
+    NameTable& operator=(NameTable&& orig) = delete;
+
+    // Returns the handle of the specified name, adding the name to the table if it is not present yet
+    // Each call must be matched by a call of release() for the returned handle
+    // @throws std::bad_alloc
+    virtual handle acquire(const StringView& name);
+
+    // Adds a reference to an interned name
+    virtual void acquire(handle name_handle) noexcept;
+
+    // Releases a reference to an interned name
+    virtual void release(handle name_handle) noexcept;
+
+    // @return Handle of the specified name, or INVALID_HANDLE if the name is not present in the table
+    virtual handle find(const StringView& name) const noexcept;
+
+    virtual const std::string& get_name(handle name_handle) const noexcept;
+
+    // Number of names in the table
+    virtual size_t get_size() const noexcept;
+
+    // All handles are smaller than the handle limit
+    virtual size_t get_handle_limit() const noexcept;
+
+  private:
+    typedef struct name_entry_s
+    {
+        std::string*    name;
+        uint32_t        hash;
+        uint32_t        ref_count;
+        // Next entry on the free list, valid only while ref_count == 0
+        handle          next_free;
+    }
+    name_entry;
+
+    static const size_t INITIAL_CAPACITY;
+
+    // Entries indexed by handle
+    name_entry* entries             {nullptr};
+    size_t      entries_capacity    {0};
+    // Number of entries that were ever in use, including those on the free list
+    size_t      entries_used        {0};
+    handle      free_list           {INVALID_HANDLE};
+    size_t      name_count          {0};
+
+    // Open addressing hash index of the entries, linear probing, capacity is a power of 2
+    handle*     slots               {nullptr};
+    size_t      slots_capacity      {0};
+
+    // Returns the index of the slot that contains the handle of the specified name, or of
+    // the empty slot where the name's handle is to be inserted
+    size_t find_slot(const StringView& name, uint32_t hash) const noexcept;
+
+    // @throws std::bad_alloc
+    void grow_slots();
+    // @throws std::bad_alloc
+    void grow_entries();
+
+    static uint32_t hash_name(const StringView& name) noexcept;
+};
+
+#endif /* NAMETABLE_H */
@@ -0,0 +1,46 @@
+#include <objects/ObjectPools.h>
+#include <map_types.h>
+#include <objects/DrbdResource.h>
+#include <objects/DrbdConnection.h>
+#include <objects/DrbdVolume.h>
+
+SlabPool ObjectPools::resource_pool(sizeof (DrbdResource));
+SlabPool ObjectPools::connection_pool(sizeof (DrbdConnection));
+SlabPool ObjectPools::volume_pool(sizeof (DrbdVolume));
+SlabPool ObjectPools::map_node_pool(sizeof (ResourcesMap::Node));
+
+const size_t ObjectPools::POOL_COUNT = 4;
+
+const SlabPool* const ObjectPools::POOLS[] =
+{
+    &resource_pool,
+    &connection_pool,
+    &volume_pool,
+    &map_node_pool
+};
+
+const char* const ObjectPools::POOL_LABELS[] =
+{
+    "Resources",
+    "Connections",
+    "Volumes",
+    "Resources map nodes"
+};
+
+void ObjectPools::release_unused() noexcept
+{
+    static_cast<void> (resource_pool.release_unused());
+    static_cast<void> (connection_pool.release_unused());
+    static_cast<void> (volume_pool.release_unused());
+    static_cast<void> (map_node_pool.release_unused());
+}
+
+size_t ObjectPools::get_footprint() noexcept
+{
+    size_t footprint = 0;
+    for (size_t idx = 0; idx < POOL_COUNT; ++idx)
+    {
+        footprint += POOLS[idx]->get_footprint();
+    }
+    return footprint;
+}
@@ -0,0 +1,34 @@
+#ifndef OBJECTPOOLS_H
+#define OBJECTPOOLS_H
+
+#include <default_types.h>
+// https://github.com/raltnoeder/cppdsaext
+#include <SlabPool.h>
+
+// Memory pools of the DRBD objects layer
+//
+// DrbdResource, DrbdConnection and DrbdVolume objects and the nodes of the resources maps
+// are allocated from per-type slab pools, so that building and tearing down the
+// object graph does not allocate and free each object individually.
+// The pools are used only by the thread that runs DrbdMon.
+class ObjectPools
+{
+  public:
+    static SlabPool resource_pool;
+    static SlabPool connection_pool;
+    static SlabPool volume_pool;
+    static SlabPool map_node_pool;
+
+    // Pools and labels for displaying memory usage information
+    static const size_t             POOL_COUNT;
+    static const SlabPool* const    POOLS[];
+    static const char* const        POOL_LABELS[];
+
+    // Returns the slabs of all pools that have no blocks in use to the system
+    static void release_unused() noexcept;
+
+    // Total number of bytes allocated for slabs by all pools
+    static size_t get_footprint() noexcept;
+};
+
+#endif /* OBJECTPOOLS_H */
@@ -1,8 +1,12 @@
 #include <objects/ResourceDirectory.h>
+#include <objects/ObjectPools.h>
+#include <objects/VolumeHistory.h>
 
 #include <comparators.h>
 #include <exceptions.h>
 
+const size_t ResourceDirectory::CHANGE_JOURNAL_SIZE = 256;
+
 // @throws std::bad_alloc
 ResourceDirectory::ResourceDirectory(
     MessageLog& log_ref,
@@ -11,8 +15,19 @@ ResourceDirectory::ResourceDirectory(
     log(log_ref),
     debug_log(debug_log_ref)
 {
-    rsc_map     = std::unique_ptr<ResourcesMap>(new ResourcesMap(&comparators::compare_string));
-    prb_rsc_map = std::unique_ptr<ResourcesMap>(new ResourcesMap(&comparators::compare_string));
+    rsc_map     = std::unique_ptr<ResourcesMap>(
+        new ResourcesMap(&comparators::compare_string, &ObjectPools::map_node_pool)
+    );
+    prb_rsc_map = std::unique_ptr<ResourcesMap>(
+        new ResourcesMap(&comparators::compare_string, &ObjectPools::map_node_pool)
+    );
+    flt_rsc_map = std::unique_ptr<ResourcesMap>(
+        new ResourcesMap(&comparators::compare_string, &ObjectPools::map_node_pool)
+    );
+    upd_rsc_map = std::unique_ptr<ResourcesMap>(
+        new ResourcesMap(&comparators::compare_string, &ObjectPools::map_node_pool)
+    );
+    change_journal = new NameTable::handle[CHANGE_JOURNAL_SIZE];
 }
 
 ResourceDirectory::~ResourceDirectory() noexcept
@@ -22,14 +37,20 @@ ResourceDirectory::~ResourceDirectory() noexcept
         ResourcesMap::NodesIterator dtor_iter(*rsc_map);
         // Free all DrbdResource mappings
         prb_rsc_map->clear();
+        flt_rsc_map->clear();
+        upd_rsc_map->clear();
         while (dtor_iter.has_next())
         {
             ResourcesMap::Node* node = dtor_iter.next();
-            delete node->get_key();
             delete node->get_value();
         }
         rsc_map->clear();
     }
+    delete[] rsc_index;
+    delete[] change_journal;
+
+    // All objects have been returned to the pools, free the pools' slabs
+    ObjectPools::release_unused();
 }
 
 ResourcesMap& ResourceDirectory::get_resources_map() noexcept
@@ -42,23 +63,51 @@ ResourcesMap& ResourceDirectory::get_problem_resources_map() noexcept
     return *prb_rsc_map;
 }
 
+ResourcesMap& ResourceDirectory::get_filtered_resources_map() noexcept
+{
+    return *flt_rsc_map;
+}
+
+// @throws std::bad_alloc
+void ResourceDirectory::set_resource_filter(std::unique_ptr<ResourceFilter> filter)
+{
+    flt_rsc_map->clear();
+    rsc_filter = std::move(filter);
+    if (rsc_filter != nullptr)
+    {
+        ResourcesMap::NodesIterator rsc_iter(*rsc_map);
+        while (rsc_iter.has_next())
+        {
+            ResourcesMap::Node* const node = rsc_iter.next();
+            DrbdResource* const rsc = node->get_value();
+            if (rsc_filter->matches(*rsc))
+            {
+                flt_rsc_map->insert(node->get_key(), rsc);
+            }
+        }
+    }
+}
+
+const ResourceFilter* ResourceDirectory::get_resource_filter() const noexcept
+{
+    return rsc_filter.get();
+}
+
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::create_connection(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::create_connection(EventProps& event_props, const std::string& event_line)
 {
     try
     {
-        ResourcesMap::Node& rsc_node = get_resource_node(event_props, event_line);
-        std::string& rsc_key = *(rsc_node.get_key());
-        DrbdResource& rsc = *(rsc_node.get_value());
+        DrbdResource& rsc = get_resource(event_props, event_line);
 
-        std::unique_ptr<DrbdConnection> conn(DrbdConnection::new_from_props(event_props));
-        conn->update(event_props);
+        std::unique_ptr<DrbdConnection> conn(DrbdConnection::new_from_props(event_props, conn_names));
+        static_cast<void> (conn->update(event_props));
         static_cast<void> (conn->update_state_flags());
         rsc.add_connection(conn.get());
-        StateFlags::state rsc_last_state = rsc.get_state();
-        StateFlags::state rsc_new_state = rsc.child_state_flags_changed();
-        problem_resources_update(rsc_key, rsc, rsc_last_state, rsc_new_state);
+        static_cast<void> (rsc.child_state_flags_changed());
         static_cast<void> (conn.release());
+        record_change(rsc);
+        mark_resource_changed(rsc);
     }
     catch (dsaext::DuplicateInsertException& dup_exc)
     {
@@ -69,22 +118,21 @@ void ResourceDirectory::create_connection(PropsMap& event_props, const std::stri
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::create_device(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::create_device(EventProps& event_props, const std::string& event_line)
 {
     try
     {
-        ResourcesMap::Node& rsc_node = get_resource_node(event_props, event_line);
-        std::string& rsc_key = *(rsc_node.get_key());
-        DrbdResource& rsc = *(rsc_node.get_value());
+        DrbdResource& rsc = get_resource(event_props, event_line);
 
         std::unique_ptr<DrbdVolume> vol(DrbdVolume::new_from_props(event_props));
-        vol->update(event_props);
+        static_cast<void> (vol->update(event_props));
+        vol->record_history(VolumeHistory::get_current_time());
         static_cast<void> (vol->update_state_flags());
         rsc.add_volume(vol.get());
-        StateFlags::state rsc_last_state = rsc.get_state();
-        StateFlags::state rsc_new_state = rsc.child_state_flags_changed();
-        problem_resources_update(rsc_key, rsc, rsc_last_state, rsc_new_state);
+        static_cast<void> (rsc.child_state_flags_changed());
         static_cast<void> (vol.release());
+        record_change(rsc);
+        mark_resource_changed(rsc);
     }
     catch (dsaext::DuplicateInsertException& dup_exc)
     {
@@ -95,25 +143,24 @@ void ResourceDirectory::create_device(PropsMap& event_props, const std::string&
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::create_peer_device(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::create_peer_device(EventProps& event_props, const std::string& event_line)
 {
     try
     {
-        ResourcesMap::Node& rsc_node = get_resource_node(event_props, event_line);
-        std::string& rsc_key = *(rsc_node.get_key());
-        DrbdResource& rsc = *(rsc_node.get_value());
+        DrbdResource& rsc = get_resource(event_props, event_line);
         DrbdConnection& conn = get_connection(rsc, event_props, event_line);
 
         std::unique_ptr<DrbdVolume> vol(DrbdVolume::new_from_props(event_props));
-        vol->update(event_props);
+        static_cast<void> (vol->update(event_props));
+        vol->record_history(VolumeHistory::get_current_time());
         vol->set_connection(&conn);
         static_cast<void> (vol->update_state_flags());
         conn.add_volume(vol.get());
         static_cast<void> (conn.child_state_flags_changed());
-        StateFlags::state rsc_last_state = rsc.get_state();
-        StateFlags::state rsc_new_state = rsc.child_state_flags_changed();
-        problem_resources_update(rsc_key, rsc, rsc_last_state, rsc_new_state);
+        static_cast<void> (rsc.child_state_flags_changed());
         static_cast<void> (vol.release());
+        record_change(rsc);
+        mark_resource_changed(rsc);
     }
     catch (dsaext::DuplicateInsertException& dup_exc)
     {
@@ -124,26 +171,26 @@ void ResourceDirectory::create_peer_device(PropsMap& event_props, const std::str
 }
 
 // @throws std::bad_alloc, EventMessageException
-void ResourceDirectory::create_resource(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::create_resource(EventProps& event_props, const std::string& event_line)
 {
     try
     {
-        std::unique_ptr<DrbdResource> rsc_mgr(DrbdResource::new_from_props(event_props));
+        std::unique_ptr<DrbdResource> rsc_mgr(DrbdResource::new_from_props(event_props, rsc_names));
         DrbdResource* const rsc = rsc_mgr.get();
 
-        rsc->update(event_props);
+        static_cast<void> (rsc->update(event_props));
         static_cast<void> (rsc->update_state_flags());
 
-        std::unique_ptr<std::string> rsc_name_mgr(new std::string(rsc->get_name()));
-        const std::string* const rsc_key = rsc_name_mgr.get();
+        const NameTable::handle rsc_name_handle = rsc->get_name_handle();
+        reserve_rsc_index(rsc_name_handle);
 
+        // The resource's interned name is the lookup key
+        const std::string* const rsc_key = &(rsc->get_name());
         rsc_map->insert(rsc_key, rsc);
-        if (rsc->has_mark_state() && prb_rsc_map->get(rsc_key) == nullptr)
-        {
-            prb_rsc_map->insert(rsc_key, rsc);
-        }
+        rsc_index[rsc_name_handle] = rsc;
         static_cast<void> (rsc_mgr.release());
-        static_cast<void> (rsc_name_mgr.release());
+        record_global_change();
+        mark_resource_changed(*rsc);
     }
     catch (dsaext::DuplicateInsertException& dup_exc)
     {
@@ -154,122 +201,118 @@ void ResourceDirectory::create_resource(PropsMap& event_props, const std::string
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::update_connection(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::update_connection(EventProps& event_props, const std::string& event_line)
 {
-    ResourcesMap::Node& rsc_node = get_resource_node(event_props, event_line);
-    std::string& rsc_key = *(rsc_node.get_key());
-    DrbdResource& rsc = *(rsc_node.get_value());
+    DrbdResource& rsc = get_resource(event_props, event_line);
     DrbdConnection& conn = get_connection(rsc, event_props, event_line);
 
-    conn.update(event_props);
-
-    // Adjust connection state flags
-    StateFlags::state conn_last_state = conn.get_state();
-    StateFlags::state conn_new_state = conn.update_state_flags();
-    if (conn_last_state != conn_new_state &&
-        (conn_last_state == StateFlags::state::NORM || conn_new_state == StateFlags::state::NORM))
+    if (conn.update(event_props))
     {
-        // Connection state flags changed, adjust resource state flags
-        StateFlags::state rsc_last_state = rsc.get_state();
-        StateFlags::state rsc_new_state = rsc.child_state_flags_changed();
-        problem_resources_update(rsc_key, rsc, rsc_last_state, rsc_new_state);
+        // Adjust connection state flags
+        StateFlags::state conn_last_state = conn.get_state();
+        StateFlags::state conn_new_state = conn.update_state_flags();
+        if (conn_last_state != conn_new_state &&
+            (conn_last_state == StateFlags::state::NORM || conn_new_state == StateFlags::state::NORM))
+        {
+            // Connection state flags changed, adjust resource state flags
+            static_cast<void> (rsc.child_state_flags_changed());
+        }
+        record_change(rsc);
+        mark_resource_changed(rsc);
     }
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::update_device(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::update_device(EventProps& event_props, const std::string& event_line)
 {
-    ResourcesMap::Node& rsc_node = get_resource_node(event_props, event_line);
-    std::string& rsc_key = *(rsc_node.get_key());
-    DrbdResource& rsc = *(rsc_node.get_value());
+    DrbdResource& rsc = get_resource(event_props, event_line);
     DrbdVolume& vol = get_device(dynamic_cast<VolumesContainer&> (rsc), event_props, event_line);
 
-    vol.update(event_props);
-
-    // Adjust volume state flags
-    static_cast<void> (vol.update_state_flags());
+    const StateFlags::state vol_last_state = vol.get_state();
+    const bool vol_last_quorum_alert = vol.has_quorum_alert();
+    if (vol.update(event_props))
+    {
+        vol.record_history(VolumeHistory::get_current_time());
+        // Adjust volume state flags
+        const StateFlags::state vol_new_state = vol.update_state_flags();
 
-    // Volume state flags changed, adjust resource state flags
-    StateFlags::state rsc_last_state = rsc.get_state();
-    StateFlags::state rsc_new_state = rsc.child_state_flags_changed();
-    problem_resources_update(rsc_key, rsc, rsc_last_state, rsc_new_state);
+        // The resource's state flags only depend on whether its volumes are in the normal state,
+        // and on the volumes' quorum alerts
+        if ((vol_last_state == StateFlags::state::NORM) != (vol_new_state == StateFlags::state::NORM) ||
+            vol_last_quorum_alert != vol.has_quorum_alert())
+        {
+            // Volume state flags changed, adjust resource state flags
+            static_cast<void> (rsc.child_state_flags_changed());
+        }
+        record_change(rsc);
+        mark_resource_changed(rsc);
+    }
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::update_peer_device(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::update_peer_device(EventProps& event_props, const std::string& event_line)
 {
-    ResourcesMap::Node& rsc_node = get_resource_node(event_props, event_line);
-    std::string& rsc_key = *(rsc_node.get_key());
-    DrbdResource& rsc = *(rsc_node.get_value());
+    DrbdResource& rsc = get_resource(event_props, event_line);
     DrbdConnection& conn = get_connection(rsc, event_props, event_line);
     DrbdVolume& vol = get_device(dynamic_cast<VolumesContainer&> (conn), event_props, event_line);
 
-    vol.update(event_props);
-
-    // Adjust volume state flags
-    StateFlags::state vol_last_state = vol.get_state();
-    StateFlags::state vol_new_state = vol.update_state_flags();
-    if (vol_last_state != vol_new_state &&
-        (vol_last_state == StateFlags::state::NORM || vol_new_state == StateFlags::state::NORM))
+    if (vol.update(event_props))
     {
-        // Volume state flags changed, adjust connection state flags
-        StateFlags::state conn_last_state = conn.get_state();
-        StateFlags::state conn_new_state = conn.child_state_flags_changed();
-        if (conn_last_state != conn_new_state &&
-            (conn_last_state == StateFlags::state::NORM || conn_new_state == StateFlags::state::NORM))
+        vol.record_history(VolumeHistory::get_current_time());
+        // Adjust volume state flags
+        StateFlags::state vol_last_state = vol.get_state();
+        StateFlags::state vol_new_state = vol.update_state_flags();
+        if (vol_last_state != vol_new_state &&
+            (vol_last_state == StateFlags::state::NORM || vol_new_state == StateFlags::state::NORM))
         {
-            // Connection state flags changed, adjust resource state flags
-            StateFlags::state rsc_last_state = rsc.get_state();
-            StateFlags::state rsc_new_state = rsc.child_state_flags_changed();
-            problem_resources_update(rsc_key, rsc, rsc_last_state, rsc_new_state);
+            // Volume state flags changed, adjust connection state flags
+            StateFlags::state conn_last_state = conn.get_state();
+            StateFlags::state conn_new_state = conn.child_state_flags_changed();
+            if (conn_last_state != conn_new_state &&
+                (conn_last_state == StateFlags::state::NORM || conn_new_state == StateFlags::state::NORM))
+            {
+                // Connection state flags changed, adjust resource state flags
+                static_cast<void> (rsc.child_state_flags_changed());
+            }
         }
+        record_change(rsc);
+        mark_resource_changed(rsc);
     }
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::update_resource(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::update_resource(EventProps& event_props, const std::string& event_line)
 {
-    ResourcesMap::Node& rsc_node = get_resource_node(event_props, event_line);
-    std::string& rsc_key = *(rsc_node.get_key());
-    DrbdResource& rsc = *(rsc_node.get_value());
-
-    rsc.update(event_props);
+    DrbdResource& rsc = get_resource(event_props, event_line);
 
-    StateFlags::state rsc_last_state = rsc.get_state();
-    StateFlags::state rsc_new_state = rsc.update_state_flags();
-    problem_resources_update(rsc_key, rsc, rsc_last_state, rsc_new_state);
+    if (rsc.update(event_props))
+    {
+        static_cast<void> (rsc.update_state_flags());
+        record_change(rsc);
+        mark_resource_changed(rsc);
+    }
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::rename_resource(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::rename_resource(EventProps& event_props, const std::string& event_line)
 {
     bool is_problem_resource = false;
     std::unique_ptr<DrbdResource> rsc_obj;
     {
-        const std::string& evt_rsc_name = lookup_resource_name(event_props, event_line);
-        ResourcesMap::Node* const node = rsc_map->get_node(&evt_rsc_name);
-        if (node == nullptr)
+        const StringView& evt_rsc_name = lookup_resource_name(event_props, event_line);
+        DrbdResource* const rsc = find_resource(evt_rsc_name);
+        if (rsc == nullptr)
         {
             std::string error_msg("Non-existent resource referenced by the DRBD events source");
             std::string debug_info("Received a DRBD rename event for a non-existent resource");
             throw EventObjectException(&error_msg, &debug_info, &event_line);
         }
 
-        // Get the lookup key for the resources and problem resources maps
-        const std::string* const rsc_key = node->get_key();
-        ResourcesMap::Node* const prb_node = prb_rsc_map->get_node(rsc_key);
-        if (prb_node != nullptr)
-        {
-            is_problem_resource = true;
-            prb_rsc_map->remove_node(prb_node);
-        }
-        prb_rsc_map->remove(rsc_key);
+        is_problem_resource = prb_rsc_map->get(&(rsc->get_name())) != nullptr;
         // Extract the resource object
-        rsc_obj = std::unique_ptr<DrbdResource>(node->get_value());
-        // Remove the entry for that resource
-        rsc_map->remove_node(node);
-        // Deallocate the lookup key (the resource's name)
-        delete rsc_key;
+        rsc_obj = std::unique_ptr<DrbdResource>(rsc);
+        // Remove the entries for that resource, which are keyed by the resource's current name
+        unlink_resource(*rsc);
     }
 
     try
@@ -277,19 +320,29 @@ void ResourceDirectory::rename_resource(PropsMap& event_props, const std::string
         // Change the resource's name
         rsc_obj->rename(event_props);
 
-        // Allocate a new lookup key with resource's new name
-        std::unique_ptr<std::string> new_rsc_name(new std::string(rsc_obj->get_name()));
-        // Reinsert the entries for that resource
-        const std::string* const new_rsc_name_ptr = new_rsc_name.get();
+        // Reinsert the entries for that resource with the resource's new name as the lookup key
         DrbdResource* const rsc_obj_ptr = rsc_obj.get();
+        const NameTable::handle new_rsc_name_handle = rsc_obj_ptr->get_name_handle();
+        reserve_rsc_index(new_rsc_name_handle);
+        const std::string* const new_rsc_name_ptr = &(rsc_obj_ptr->get_name());
         rsc_map->insert(new_rsc_name_ptr, rsc_obj_ptr);
         if (is_problem_resource)
         {
-            prb_rsc_map->insert(new_rsc_name_ptr, rsc_obj_ptr);
+            try
+            {
+                prb_rsc_map->insert(new_rsc_name_ptr, rsc_obj_ptr);
+            }
+            catch (std::bad_alloc&)
+            {
+                rsc_map->remove(new_rsc_name_ptr);
+                throw;
+            }
         }
+        rsc_index[new_rsc_name_handle] = rsc_obj_ptr;
 
-        new_rsc_name.release();
         rsc_obj.release();
+        record_global_change();
+        mark_resource_changed(*rsc_obj_ptr);
     }
     catch (dsaext::DuplicateInsertException& dup_exc)
     {
@@ -300,11 +353,9 @@ void ResourceDirectory::rename_resource(PropsMap& event_props, const std::string
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::destroy_connection(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::destroy_connection(EventProps& event_props, const std::string& event_line)
 {
-    ResourcesMap::Node& rsc_node = get_resource_node(event_props, event_line);
-    std::string& rsc_key = *(rsc_node.get_key());
-    DrbdResource& rsc = *(rsc_node.get_value());
+    DrbdResource& rsc = get_resource(event_props, event_line);
 
     bool conn_marked = false;
     {
@@ -312,21 +363,19 @@ void ResourceDirectory::destroy_connection(PropsMap& event_props, const std::str
         conn_marked = conn.has_mark_state();
         rsc.remove_connection(conn.get_name());
     }
+    record_change(rsc);
+    mark_resource_changed(rsc);
 
     if (conn_marked)
     {
-        StateFlags::state rsc_last_state = rsc.get_state();
-        StateFlags::state rsc_new_state = rsc.child_state_flags_changed();
-        problem_resources_update(rsc_key, rsc, rsc_last_state, rsc_new_state);
+        static_cast<void> (rsc.child_state_flags_changed());
     }
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::destroy_device(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::destroy_device(EventProps& event_props, const std::string& event_line)
 {
-    ResourcesMap::Node& rsc_node = get_resource_node(event_props, event_line);
-    std::string& rsc_key = *(rsc_node.get_key());
-    DrbdResource& rsc = *(rsc_node.get_value());
+    DrbdResource& rsc = get_resource(event_props, event_line);
 
     bool vol_marked = false;
     {
@@ -334,21 +383,19 @@ void ResourceDirectory::destroy_device(PropsMap& event_props, const std::string&
         vol_marked = vol.has_mark_state();
         rsc.remove_volume(vol.get_volume_nr());
     }
+    record_change(rsc);
+    mark_resource_changed(rsc);
 
     if (vol_marked)
     {
-        StateFlags::state rsc_last_state = rsc.get_state();
-        StateFlags::state rsc_new_state = rsc.child_state_flags_changed();
-        problem_resources_update(rsc_key, rsc, rsc_last_state, rsc_new_state);
+        static_cast<void> (rsc.child_state_flags_changed());
     }
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::destroy_peer_device(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::destroy_peer_device(EventProps& event_props, const std::string& event_line)
 {
-    ResourcesMap::Node& rsc_node = get_resource_node(event_props, event_line);
-    std::string& rsc_key = *(rsc_node.get_key());
-    DrbdResource& rsc = *(rsc_node.get_value());
+    DrbdResource& rsc = get_resource(event_props, event_line);
 
     DrbdConnection& conn = get_connection(rsc, event_props, event_line);
     bool peer_vol_marked = false;
@@ -358,19 +405,19 @@ void ResourceDirectory::destroy_peer_device(PropsMap& event_props, const std::st
         peer_vol_marked = peer_vol.has_mark_state();
     }
 
-    std::string* vol_nr_str = event_props.get(&DrbdVolume::PROP_KEY_VOL_NR);
+    const StringView* const vol_nr_str = event_props.get(DrbdVolume::PROP_KEY_VOL_NR);
     if (vol_nr_str != nullptr)
     {
         try
         {
             uint16_t vol_nr = DrbdVolume::parse_volume_nr(*vol_nr_str);
             conn.remove_volume(vol_nr);
+            record_change(rsc);
+            mark_resource_changed(rsc);
             if (peer_vol_marked)
             {
                 static_cast<void> (conn.child_state_flags_changed());
-                StateFlags::state rsc_last_state = rsc.get_state();
-                StateFlags::state rsc_new_state = rsc.child_state_flags_changed();
-                problem_resources_update(rsc_key, rsc, rsc_last_state, rsc_new_state);
+                static_cast<void> (rsc.child_state_flags_changed());
             }
         }
         catch (dsaext::NumberFormatException&)
@@ -389,18 +436,17 @@ void ResourceDirectory::destroy_peer_device(PropsMap& event_props, const std::st
 }
 
 // @throws std::bad_alloc, EventMessageException, EventObjectException
-void ResourceDirectory::destroy_resource(PropsMap& event_props, const std::string& event_line)
+void ResourceDirectory::destroy_resource(EventProps& event_props, const std::string& event_line)
 {
-    std::string* const rsc_name = event_props.get(&DrbdResource::PROP_KEY_RES_NAME);
+    const StringView* const rsc_name = event_props.get(DrbdResource::PROP_KEY_RES_NAME);
     if (rsc_name != nullptr)
     {
-        ResourcesMap::Node* node = rsc_map->get_node(rsc_name);
-        if (node != nullptr)
+        DrbdResource* const rsc = find_resource(*rsc_name);
+        if (rsc != nullptr)
         {
-            prb_rsc_map->remove(rsc_name);
-            delete node->get_key();
-            delete node->get_value();
-            rsc_map->remove_node(node);
+            unlink_resource(*rsc);
+            delete rsc;
+            record_global_change();
         }
         else
         {
@@ -420,15 +466,19 @@ void ResourceDirectory::destroy_resource(PropsMap& event_props, const std::strin
 // @throws std::bad_alloc, EventMessageException, EventObjectException
 DrbdConnection& ResourceDirectory::get_connection(
     DrbdResource&       rsc,
-    PropsMap&           event_props,
+    EventProps&         event_props,
     const std::string&  event_line
 )
 {
     DrbdConnection* conn {nullptr};
-    std::string* conn_name = event_props.get(&DrbdConnection::PROP_KEY_CONN_NAME);
+    const StringView* const conn_name = event_props.get(DrbdConnection::PROP_KEY_CONN_NAME);
     if (conn_name != nullptr)
     {
-        conn = rsc.get_connection(*conn_name);
+        const NameTable::handle conn_name_handle = conn_names.find(*conn_name);
+        if (conn_name_handle != NameTable::INVALID_HANDLE)
+        {
+            conn = rsc.get_connection(conn_name_handle);
+        }
     }
     else
     {
@@ -448,12 +498,12 @@ DrbdConnection& ResourceDirectory::get_connection(
 // @throws std::bad_alloc, EventMessageException, EventObjectException
 DrbdVolume& ResourceDirectory::get_device(
     VolumesContainer&   vol_con,
-    PropsMap&           event_props,
+    EventProps&         event_props,
     const std::string&  event_line
 )
 {
     DrbdVolume* vol {nullptr};
-    std::string* vol_nr_str = event_props.get(&DrbdVolume::PROP_KEY_VOL_NR);
+    const StringView* const vol_nr_str = event_props.get(DrbdVolume::PROP_KEY_VOL_NR);
     if (vol_nr_str != nullptr)
     {
         try
@@ -483,24 +533,24 @@ DrbdVolume& ResourceDirectory::get_device(
     return *vol;
 }
 
-// @throws std::bad_alloc, EventMessageException, EventObjectException
-ResourcesMap::Node& ResourceDirectory::get_resource_node(PropsMap& event_props, const std::string& event_line)
+// @throws EventMessageException, EventObjectException
+DrbdResource& ResourceDirectory::get_resource(EventProps& event_props, const std::string& event_line)
 {
-    const std::string& rsc_name = lookup_resource_name(event_props, event_line);
-    ResourcesMap::Node* const rsc_node = rsc_map->get_node(&rsc_name);
-    if (rsc_node == nullptr)
+    const StringView& rsc_name = lookup_resource_name(event_props, event_line);
+    DrbdResource* const rsc = find_resource(rsc_name);
+    if (rsc == nullptr)
     {
         std::string error_msg("Non-existent resource referenced by the DRBD events source");
         std::string debug_info("DRBD event line references a non-existent resource");
         throw EventObjectException(&error_msg, &debug_info, &event_line);
     }
-    return *rsc_node;
+    return *rsc;
 }
 
 // @throws EventMessageException
-const std::string& ResourceDirectory::lookup_resource_name(PropsMap& event_props, const std::string& event_line)
+const StringView& ResourceDirectory::lookup_resource_name(EventProps& event_props, const std::string& event_line)
 {
-    const std::string* const rsc_name = event_props.get(&DrbdResource::PROP_KEY_RES_NAME);
+    const StringView* const rsc_name = event_props.get(DrbdResource::PROP_KEY_RES_NAME);
     if (rsc_name == nullptr)
     {
         std::string error_msg("Received DRBD event line does not contain a resource name");
@@ -511,24 +561,80 @@ const std::string& ResourceDirectory::lookup_resource_name(PropsMap& event_props
 }
 
 // @throws std::bad_alloc
-void ResourceDirectory::problem_resources_update(
-    std::string&        rsc_key,
-    DrbdResource&       rsc,
-    StateFlags::state   rsc_last_state,
-    StateFlags::state   rsc_new_state
-)
+void ResourceDirectory::update_resource_maps()
+{
+    ResourcesMap::ValuesIterator upd_iter(*upd_rsc_map);
+    bool maps_changed = false;
+    while (upd_iter.has_next())
+    {
+        DrbdResource* const rsc = upd_iter.next();
+        maps_changed |= problem_resources_update(*rsc);
+        maps_changed |= filtered_resources_update(*rsc);
+    }
+    upd_rsc_map->clear();
+    if (maps_changed)
+    {
+        record_global_change();
+    }
+}
+
+// @throws std::bad_alloc
+bool ResourceDirectory::problem_resources_update(DrbdResource& rsc)
 {
-    if (rsc_last_state == StateFlags::state::NORM && rsc_new_state != StateFlags::state::NORM)
+    bool changed = false;
+    const std::string* const rsc_key = &(rsc.get_name());
+    const bool is_listed = prb_rsc_map->get(rsc_key) != nullptr;
+    if (rsc.has_mark_state())
     {
-        if (prb_rsc_map->get(&rsc_key) == nullptr)
+        if (!is_listed)
         {
-            prb_rsc_map->insert(&rsc_key, &rsc);
+            prb_rsc_map->insert(rsc_key, &rsc);
+            ++problem_entry_seq;
+            changed = true;
         }
     }
     else
-    if (rsc_last_state != StateFlags::state::NORM && rsc_new_state == StateFlags::state::NORM)
+    if (is_listed)
+    {
+        prb_rsc_map->remove(rsc_key);
+        changed = true;
+    }
+    return changed;
+}
+
+// @throws std::bad_alloc
+bool ResourceDirectory::filtered_resources_update(DrbdResource& rsc)
+{
+    bool changed = false;
+    if (rsc_filter != nullptr)
+    {
+        const std::string* const rsc_key = &(rsc.get_name());
+        const bool is_listed = flt_rsc_map->get(rsc_key) != nullptr;
+        if (rsc_filter->matches(rsc))
+        {
+            if (!is_listed)
+            {
+                flt_rsc_map->insert(rsc_key, &rsc);
+                changed = true;
+            }
+        }
+        else
+        if (is_listed)
+        {
+            flt_rsc_map->remove(rsc_key);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// @throws std::bad_alloc
+void ResourceDirectory::mark_resource_changed(DrbdResource& rsc)
+{
+    const std::string* const rsc_key = &(rsc.get_name());
+    if (upd_rsc_map->get(rsc_key) == nullptr)
     {
-        prb_rsc_map->remove(&rsc_key);
+        upd_rsc_map->insert(rsc_key, &rsc);
     }
 }
 
@@ -536,3 +642,86 @@ uint32_t ResourceDirectory::get_problem_count() const
 {
     return static_cast<uint32_t> (prb_rsc_map->get_size());
 }
+
+uint64_t ResourceDirectory::get_change_seq() const noexcept
+{
+    return change_seq;
+}
+
+uint64_t ResourceDirectory::get_problem_entry_seq() const noexcept
+{
+    return problem_entry_seq;
+}
+
+bool ResourceDirectory::is_resource_changed_since(
+    const NameTable::handle rsc_name_handle,
+    const uint64_t          since_seq
+) const noexcept
+{
+    // Changes that are no longer recorded in the journal count as changes of every resource
+    bool changed = true;
+    if (since_seq <= change_seq && change_seq - since_seq <= CHANGE_JOURNAL_SIZE)
+    {
+        changed = false;
+        for (uint64_t entry_seq = since_seq + 1; entry_seq <= change_seq && !changed; ++entry_seq)
+        {
+            const NameTable::handle entry_handle = change_journal[entry_seq % CHANGE_JOURNAL_SIZE];
+            changed = entry_handle == rsc_name_handle || entry_handle == NameTable::INVALID_HANDLE;
+        }
+    }
+    return changed;
+}
+
+DrbdResource* ResourceDirectory::find_resource(const StringView& rsc_name) const noexcept
+{
+    DrbdResource* rsc = nullptr;
+    const NameTable::handle rsc_name_handle = rsc_names.find(rsc_name);
+    if (rsc_name_handle < rsc_index_capacity)
+    {
+        rsc = rsc_index[rsc_name_handle];
+    }
+    return rsc;
+}
+
+// @throws std::bad_alloc
+void ResourceDirectory::reserve_rsc_index(const NameTable::handle rsc_name_handle)
+{
+    if (rsc_name_handle >= rsc_index_capacity)
+    {
+        size_t new_capacity = rsc_index_capacity > 0 ? rsc_index_capacity : 16;
+        while (rsc_name_handle >= new_capacity)
+        {
+            new_capacity *= 2;
+        }
+        DrbdResource** const new_index = new DrbdResource*[new_capacity];
+        for (size_t idx = 0; idx < new_capacity; ++idx)
+        {
+            new_index[idx] = idx < rsc_index_capacity ? rsc_index[idx] : nullptr;
+        }
+        delete[] rsc_index;
+        rsc_index = new_index;
+        rsc_index_capacity = new_capacity;
+    }
+}
+
+void ResourceDirectory::record_change(const DrbdResource& rsc) noexcept
+{
+    ++change_seq;
+    change_journal[change_seq % CHANGE_JOURNAL_SIZE] = rsc.get_name_handle();
+}
+
+void ResourceDirectory::record_global_change() noexcept
+{
+    ++change_seq;
+    change_journal[change_seq % CHANGE_JOURNAL_SIZE] = NameTable::INVALID_HANDLE;
+}
+
+void ResourceDirectory::unlink_resource(DrbdResource& rsc) noexcept
+{
+    const std::string* const rsc_key = &(rsc.get_name());
+    prb_rsc_map->remove(rsc_key);
+    flt_rsc_map->remove(rsc_key);
+    upd_rsc_map->remove(rsc_key);
+    rsc_map->remove(rsc_key);
+    rsc_index[rsc.get_name_handle()] = nullptr;
+}
@@ -11,73 +11,151 @@
 #include <objects/DrbdConnection.h>
 #include <objects/DrbdVolume.h>
 #include <objects/VolumesContainer.h>
-#include <StringTokenizer.h>
+#include <objects/NameTable.h>
+#include <objects/ResourceFilter.h>
+#include <EventProps.h>
+#include <StringView.h>
 #include <MessageLog.h>
 
 class ResourceDirectory
 {
   public:
+    // Number of the most recent changes that are recorded in the change journal
+    static const size_t CHANGE_JOURNAL_SIZE;
+
     // @throws std::bad_alloc
     ResourceDirectory(MessageLog& log_ref, MessageLog& debug_log_ref);
     virtual ~ResourceDirectory() noexcept;
 
     ResourcesMap& get_resources_map() noexcept;
     ResourcesMap& get_problem_resources_map() noexcept;
+    ResourcesMap& get_filtered_resources_map() noexcept;
+
+    // Replaces the resource filter and rebuilds the map of filtered resources
+    // The filtered resources map is subsequently kept up to date by update_resource_maps().
+    // If filter is nullptr, the filter is removed and the filtered resources map is cleared.
+    // @throws std::bad_alloc
+    void set_resource_filter(std::unique_ptr<ResourceFilter> filter);
+    // @return Active resource filter, or nullptr if no filter is set
+    const ResourceFilter* get_resource_filter() const noexcept;
 
     // @throws std::bad_alloc, EventMessageException
-    void create_connection(PropsMap& event_props, const std::string& event_line);
+    void create_connection(EventProps& event_props, const std::string& event_line);
     // @throws std::bad_alloc, EventMessageException
-    void create_device(PropsMap& event_props, const std::string& event_line);
+    void create_device(EventProps& event_props, const std::string& event_line);
     // @throws std::bad_alloc, EventMessageException
-    void create_peer_device(PropsMap& event_props, const std::string& event_line);
+    void create_peer_device(EventProps& event_props, const std::string& event_line);
     // @throws std::bad_alloc, EventMessageException
-    void create_resource(PropsMap& event_props, const std::string& event_line);
+    void create_resource(EventProps& event_props, const std::string& event_line);
 
     // @throws EventMessageException, EventObjectException
-    void update_connection(PropsMap& event_props, const std::string& event_line);
+    void update_connection(EventProps& event_props, const std::string& event_line);
     // @throws EventMessageException, EventObjectException
-    void update_device(PropsMap& event_props, const std::string& event_line);
+    void update_device(EventProps& event_props, const std::string& event_line);
     // @throws EventMessageException, EventObjectException
-    void update_peer_device(PropsMap& event_props, const std::string& event_line);
+    void update_peer_device(EventProps& event_props, const std::string& event_line);
     // @throws EventMessageException, EventObjectException
-    void update_resource(PropsMap& event_props, const std::string& event_line);
+    void update_resource(EventProps& event_props, const std::string& event_line);
 
     // @throws std::bad_alloc, EventMessageException, EventObjectException
-    void rename_resource(PropsMap& event_props, const std::string& event_line);
+    void rename_resource(EventProps& event_props, const std::string& event_line);
 
     // @throws EventMessageException
-    void destroy_connection(PropsMap& event_props, const std::string& event_line);
+    void destroy_connection(EventProps& event_props, const std::string& event_line);
     // @throws EventMessageException
-    void destroy_device(PropsMap& event_props, const std::string& event_line);
+    void destroy_device(EventProps& event_props, const std::string& event_line);
     // @throws EventMessageException
-    void destroy_peer_device(PropsMap& event_props, const std::string& event_line);
+    void destroy_peer_device(EventProps& event_props, const std::string& event_line);
     // @throws EventMessageException
-    void destroy_resource(PropsMap& event_props, const std::string& event_line);
+    void destroy_resource(EventProps& event_props, const std::string& event_line);
 
     // @throws EventMessageException, EventObjectException
-    DrbdConnection& get_connection(DrbdResource& res, PropsMap& event_props, const std::string& event_line);
-    // @throws EventMessageException, EventObjectException
-    DrbdVolume& get_device(VolumesContainer& vol_con, PropsMap& event_props, const std::string& event_line);
+    DrbdConnection& get_connection(DrbdResource& res, EventProps& event_props, const std::string& event_line);
     // @throws EventMessageException, EventObjectException
-    DrbdResource& get_resource(PropsMap& event_props, const std::string& event_line);
+    DrbdVolume& get_device(VolumesContainer& vol_con, EventProps& event_props, const std::string& event_line);
     // @throws EventMessageException, EventObjectException
-    ResourcesMap::Node& get_resource_node(PropsMap& event_props, const std::string& event_line);
+    DrbdResource& get_resource(EventProps& event_props, const std::string& event_line);
     // @throws EventMessageException
-    const std::string& lookup_resource_name(PropsMap& event_props, const std::string& event_line);
+    const StringView& lookup_resource_name(EventProps& event_props, const std::string& event_line);
+    // Updates the entries in the problem resources map and in the filtered resources map
+    // for all resources that were changed by events since the last call
+    // Events only record which resources they changed, so that a batch of events updates
+    // each of those maps once per resource.
     // @throws std::bad_alloc
-    void problem_resources_update(
-        std::string&        res_key,
-        DrbdResource&       res,
-        StateFlags::state   res_last_state,
-        StateFlags::state   res_new_state
-    );
+    void update_resource_maps();
+    // Updates the resource's entry in the map of problem resources
+    // @return true if the entry was added or removed, otherwise false
+    // @throws std::bad_alloc
+    bool problem_resources_update(DrbdResource& rsc);
+    // Updates the resource's entry in the map of filtered resources
+    // @return true if the entry was added or removed, otherwise false
+    // @throws std::bad_alloc
+    bool filtered_resources_update(DrbdResource& rsc);
     uint32_t get_problem_count() const;
 
+    // Sequence number of the last change of the DRBD objects in the directory
+    // The number is incremented by each event that creates, destroys or renames an object, and by each
+    // event that changes any of an object's properties. Events that do not change anything leave it unchanged.
+    // The number is also incremented when resources are added to or removed from the problem resources map
+    // or the filtered resources map.
+    uint64_t get_change_seq() const noexcept;
+
+    // Indicates whether the resource with the specified name handle, or any of its connections or volumes,
+    // changed since the specified change sequence number
+    // Creating, renaming or destroying a resource and changing the problem resources map or the filtered
+    // resources map count as changes of every resource. If rsc_name_handle is NameTable::INVALID_HANDLE,
+    // only those changes are reported.
+    // If the specified sequence number precedes the most recent CHANGE_JOURNAL_SIZE changes,
+    // every resource counts as changed.
+    bool is_resource_changed_since(NameTable::handle rsc_name_handle, uint64_t since_seq) const noexcept;
+
+    // Sequence number that is incremented each time a resource is added to the problem resources map
+    uint64_t get_problem_entry_seq() const noexcept;
+
   private:
+    // Interned names of resources and connections
+    // Events reference resources and connections by name; looking up a name's handle avoids
+    // allocating a key string and comparing names on each level of the resources tree.
+    // The interned name strings are also used as the keys of the resources and connections maps.
+    NameTable rsc_names;
+    NameTable conn_names;
+
     // Map of all resources
     std::unique_ptr<ResourcesMap> rsc_map;
     // Map of resources that have some problem
     std::unique_ptr<ResourcesMap> prb_rsc_map;
+    // Map of resources that match the resource filter, empty if no filter is set
+    std::unique_ptr<ResourcesMap> flt_rsc_map;
+    std::unique_ptr<ResourceFilter> rsc_filter;
+    // Map of resources that were changed since the last update of the problem and filtered resources maps
+    std::unique_ptr<ResourcesMap> upd_rsc_map;
+
+    // Resources indexed by the handle of their name, entries are nullptr for unused handles
+    DrbdResource**  rsc_index           {nullptr};
+    size_t          rsc_index_capacity  {0};
+
+    uint64_t        change_seq          {0};
+    uint64_t        problem_entry_seq   {0};
+
+    // Name handles of the resources changed by the most recent changes, indexed by the change's
+    // sequence number modulo CHANGE_JOURNAL_SIZE. NameTable::INVALID_HANDLE marks changes that
+    // count as changes of every resource.
+    NameTable::handle*  change_journal  {nullptr};
+
+    // @return Resource with the specified name, or nullptr if there is no such resource
+    DrbdResource* find_resource(const StringView& rsc_name) const noexcept;
+    // Ensures that the resources index has an entry for the specified handle
+    // @throws std::bad_alloc
+    void reserve_rsc_index(NameTable::handle rsc_name_handle);
+    // Increments the change sequence number and records the change of the resource in the change journal
+    void record_change(const DrbdResource& rsc) noexcept;
+    // Increments the change sequence number and records a change of every resource in the change journal
+    void record_global_change() noexcept;
+    // Records that the resource was changed, see update_resource_maps()
+    // @throws std::bad_alloc
+    void mark_resource_changed(DrbdResource& rsc);
+    // Removes a resource from all maps and from the resources index
+    void unlink_resource(DrbdResource& rsc) noexcept;
 
     MessageLog& log;
     MessageLog& debug_log;
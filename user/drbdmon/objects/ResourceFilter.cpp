@@ -0,0 +1,300 @@
+#include <objects/ResourceFilter.h>
+#include <StringTokenizer.h>
+
+const std::string   ResourceFilter::KEY_ROLE        = "role";
+const std::string   ResourceFilter::KEY_PEER_ROLE   = "peer-role";
+const std::string   ResourceFilter::KEY_DISK        = "disk";
+const std::string   ResourceFilter::KEY_PEER_DISK   = "peer-disk";
+const std::string   ResourceFilter::KEY_REPL        = "repl";
+const std::string   ResourceFilter::KEY_CONN        = "conn";
+
+// @throws std::bad_alloc, string_matching::PatternLimitException, ResourceFilter::SyntaxException
+ResourceFilter::ResourceFilter(const std::string& filter_expr)
+{
+    const std::string delimiter(" ");
+    StringTokenizer tokenizer(filter_expr, delimiter);
+    while (tokenizer.has_next())
+    {
+        const std::string term = tokenizer.next();
+        compile_term(term);
+        if (!expression.empty())
+        {
+            expression += ' ';
+        }
+        expression += term;
+    }
+}
+
+ResourceFilter::~ResourceFilter() noexcept
+{
+}
+
+bool ResourceFilter::matches(DrbdResource& rsc) const
+{
+    bool rsc_matches = matches_name(rsc.get_name());
+    if (rsc_matches && role_mask != 0)
+    {
+        rsc_matches = (role_mask & (static_cast<state_mask> (1) << rsc.get_role())) != 0;
+    }
+    if (rsc_matches && disk_mask != 0)
+    {
+        rsc_matches = matches_volumes(rsc, disk_mask, 0);
+    }
+    if (rsc_matches && (peer_role_mask != 0 || peer_disk_mask != 0 || repl_mask != 0 || conn_mask != 0))
+    {
+        // Each of the peer keys may be matched by a different connection
+        bool peer_role_matches = peer_role_mask == 0;
+        bool peer_vol_matches = peer_disk_mask == 0 && repl_mask == 0;
+        bool conn_matches = conn_mask == 0;
+
+        DrbdResource::ConnectionsIterator conn_iter = rsc.connections_iterator();
+        while (conn_iter.has_next() && !(peer_role_matches && peer_vol_matches && conn_matches))
+        {
+            DrbdConnection* const conn = conn_iter.next();
+            if (!peer_role_matches)
+            {
+                peer_role_matches = (peer_role_mask & (static_cast<state_mask> (1) << conn->get_role())) != 0;
+            }
+            if (!conn_matches)
+            {
+                const state_mask conn_state_bit =
+                    static_cast<state_mask> (1) << static_cast<uint16_t> (conn->get_connection_state());
+                conn_matches = (conn_mask & conn_state_bit) != 0;
+            }
+            if (!peer_vol_matches)
+            {
+                peer_vol_matches = matches_volumes(*conn, peer_disk_mask, repl_mask);
+            }
+        }
+        rsc_matches = peer_role_matches && peer_vol_matches && conn_matches;
+    }
+    return rsc_matches;
+}
+
+const std::string& ResourceFilter::get_expression() const noexcept
+{
+    return expression;
+}
+
+bool ResourceFilter::matches_name(const std::string& rsc_name) const
+{
+    bool name_matches = name_patterns == nullptr;
+    const NamePattern* name_item = name_patterns.get();
+    while (name_item != nullptr && !name_matches)
+    {
+        name_matches = string_matching::match_text(rsc_name, name_item->pattern.get());
+        name_item = name_item->next.get();
+    }
+    return name_matches;
+}
+
+// Checks whether any of the volumes matches both the disk state mask and the replication state mask
+bool ResourceFilter::matches_volumes(
+    VolumesContainer&   vol_con,
+    const state_mask    vol_disk_mask,
+    const state_mask    vol_repl_mask
+) const
+{
+    bool vol_matches = false;
+    VolumesContainer::VolumesIterator vol_iter = vol_con.volumes_iterator();
+    while (vol_iter.has_next() && !vol_matches)
+    {
+        DrbdVolume* const vol = vol_iter.next();
+        vol_matches = vol_disk_mask == 0 ||
+            (vol_disk_mask & (static_cast<state_mask> (1) << static_cast<uint16_t> (vol->get_disk_state()))) != 0;
+        if (vol_matches && vol_repl_mask != 0)
+        {
+            const state_mask repl_state_bit =
+                static_cast<state_mask> (1) << static_cast<uint16_t> (vol->get_replication_state());
+            vol_matches = (vol_repl_mask & repl_state_bit) != 0;
+        }
+    }
+    return vol_matches;
+}
+
+// @throws std::bad_alloc, string_matching::PatternLimitException, ResourceFilter::SyntaxException
+void ResourceFilter::compile_term(const std::string& term)
+{
+    const size_t split_idx = term.find('=');
+    if (split_idx == std::string::npos)
+    {
+        std::unique_ptr<NamePattern> name_item(new NamePattern());
+        string_matching::process_pattern(term, name_item->pattern);
+        name_item->next = std::move(name_patterns);
+        name_patterns = std::move(name_item);
+    }
+    else
+    {
+        std::string key = term.substr(0, split_idx);
+        const std::string values = term.substr(split_idx + 1);
+        to_lowercase(key);
+
+        // Labels in the order of the values of the corresponding enums
+        const char* const role_labels[] =
+        {
+            DrbdRole::ROLE_LABEL_PRIMARY,
+            DrbdRole::ROLE_LABEL_SECONDARY,
+            DrbdRole::ROLE_LABEL_UNKNOWN
+        };
+        const char* const disk_labels[] =
+        {
+            DrbdVolume::DS_LABEL_DISKLESS,
+            DrbdVolume::DS_LABEL_ATTACHING,
+            DrbdVolume::DS_LABEL_DETACHING,
+            DrbdVolume::DS_LABEL_FAILED,
+            DrbdVolume::DS_LABEL_NEGOTIATING,
+            DrbdVolume::DS_LABEL_INCONSISTENT,
+            DrbdVolume::DS_LABEL_OUTDATED,
+            DrbdVolume::DS_LABEL_UNKNOWN,
+            DrbdVolume::DS_LABEL_CONSISTENT,
+            DrbdVolume::DS_LABEL_UP_TO_DATE
+        };
+        const char* const repl_labels[] =
+        {
+            DrbdVolume::RS_LABEL_OFF,
+            DrbdVolume::RS_LABEL_ESTABLISHED,
+            DrbdVolume::RS_LABEL_STARTING_SYNC_SOURCE,
+            DrbdVolume::RS_LABEL_STARTING_SYNC_TARGET,
+            DrbdVolume::RS_LABEL_WF_BITMAP_SOURCE,
+            DrbdVolume::RS_LABEL_WF_BITMAP_TARGET,
+            DrbdVolume::RS_LABEL_WF_SYNC_UUID,
+            DrbdVolume::RS_LABEL_SYNC_SOURCE,
+            DrbdVolume::RS_LABEL_SYNC_TARGET,
+            DrbdVolume::RS_LABEL_PAUSED_SYNC_SOURCE,
+            DrbdVolume::RS_LABEL_PAUSED_SYNC_TARGET,
+            DrbdVolume::RS_LABEL_VERIFY_SOURCE,
+            DrbdVolume::RS_LABEL_VERIFY_TARGET,
+            DrbdVolume::RS_LABEL_AHEAD,
+            DrbdVolume::RS_LABEL_BEHIND,
+            DrbdVolume::RS_LABEL_UNKNOWN
+        };
+        const char* const conn_labels[] =
+        {
+            DrbdConnection::CS_LABEL_STANDALONE,
+            DrbdConnection::CS_LABEL_DISCONNECTING,
+            DrbdConnection::CS_LABEL_UNCONNECTED,
+            DrbdConnection::CS_LABEL_TIMEOUT,
+            DrbdConnection::CS_LABEL_BROKEN_PIPE,
+            DrbdConnection::CS_LABEL_NETWORK_FAILURE,
+            DrbdConnection::CS_LABEL_PROTOCOL_ERROR,
+            DrbdConnection::CS_LABEL_TEAR_DOWN,
+            DrbdConnection::CS_LABEL_CONNECTING,
+            DrbdConnection::CS_LABEL_CONNECTED,
+            DrbdConnection::CS_LABEL_UNKNOWN
+        };
+
+        if (key == KEY_ROLE)
+        {
+            role_mask |= compile_states(term, values, role_labels, sizeof (role_labels) / sizeof (role_labels[0]));
+        }
+        else
+        if (key == KEY_PEER_ROLE)
+        {
+            peer_role_mask |= compile_states(
+                term, values, role_labels, sizeof (role_labels) / sizeof (role_labels[0])
+            );
+        }
+        else
+        if (key == KEY_DISK)
+        {
+            disk_mask |= compile_states(term, values, disk_labels, sizeof (disk_labels) / sizeof (disk_labels[0]));
+        }
+        else
+        if (key == KEY_PEER_DISK)
+        {
+            peer_disk_mask |= compile_states(
+                term, values, disk_labels, sizeof (disk_labels) / sizeof (disk_labels[0])
+            );
+        }
+        else
+        if (key == KEY_REPL)
+        {
+            repl_mask |= compile_states(term, values, repl_labels, sizeof (repl_labels) / sizeof (repl_labels[0]));
+        }
+        else
+        if (key == KEY_CONN)
+        {
+            conn_mask |= compile_states(term, values, conn_labels, sizeof (conn_labels) / sizeof (conn_labels[0]));
+        }
+        else
+        {
+            throw SyntaxException("Unknown filter key '" + key + "'");
+        }
+    }
+}
+
+// @throws std::bad_alloc, string_matching::PatternLimitException, ResourceFilter::SyntaxException
+ResourceFilter::state_mask ResourceFilter::compile_states(
+    const std::string&  term,
+    const std::string&  values,
+    const char* const   labels[],
+    const size_t        labels_count
+)
+{
+    state_mask mask = 0;
+    const std::string delimiter(",");
+    StringTokenizer tokenizer(values, delimiter);
+    if (!tokenizer.has_next())
+    {
+        throw SyntaxException("Filter term '" + term + "' does not specify any states");
+    }
+    while (tokenizer.has_next())
+    {
+        std::string value = tokenizer.next();
+        to_lowercase(value);
+
+        std::unique_ptr<string_matching::PatternItem> pattern;
+        string_matching::process_pattern(value, pattern);
+
+        state_mask value_mask = 0;
+        for (size_t idx = 0; idx < labels_count; ++idx)
+        {
+            std::string label(labels[idx]);
+            to_lowercase(label);
+            if (string_matching::match_text(label, pattern.get()))
+            {
+                value_mask |= static_cast<state_mask> (1) << idx;
+            }
+        }
+        if (value_mask == 0)
+        {
+            throw SyntaxException("Filter term '" + term + "': No state matches '" + value + "'");
+        }
+        mask |= value_mask;
+    }
+    return mask;
+}
+
+void ResourceFilter::to_lowercase(std::string& text) noexcept
+{
+    for (char& text_char : text)
+    {
+        if (text_char >= 'A' && text_char <= 'Z')
+        {
+            text_char = static_cast<char> (text_char - 'A' + 'a');
+        }
+    }
+}
+
+ResourceFilter::NamePattern::NamePattern()
+{
+}
+
+ResourceFilter::NamePattern::~NamePattern() noexcept
+{
+}
+
+// @throws std::bad_alloc
+ResourceFilter::SyntaxException::SyntaxException(const std::string& error_msg_ref):
+    error_msg(error_msg_ref)
+{
+}
+
+ResourceFilter::SyntaxException::~SyntaxException() noexcept
+{
+}
+
+const std::string& ResourceFilter::SyntaxException::get_error_msg() const noexcept
+{
+    return error_msg;
+}
@@ -0,0 +1,111 @@
+#ifndef RESOURCEFILTER_H
+#define RESOURCEFILTER_H
+
+#include <default_types.h>
+#include <new>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <objects/DrbdResource.h>
+#include <objects/DrbdConnection.h>
+#include <objects/DrbdVolume.h>
+#include <string_matching.h>
+
+// Precompiled matcher for resource filter expressions
+//
+// A filter expression consists of terms separated by spaces. A term of the form key=values
+// selects resources by state, any other term is a resource name pattern.
+// The values of a term are separated by commas and may contain '*' wildcard characters.
+// State values are matched case-insensitively. Supported keys are:
+//   role       Role of the resource
+//   peer-role  Role of any of the peers
+//   disk       Disk state of any of the local volumes
+//   peer-disk  Disk state of any of the peer volumes
+//   repl       Replication state of any of the peer volumes
+//   conn       State of any of the connections
+// A resource matches if its name matches any of the name patterns, if name patterns were specified,
+// and if it matches each of the keys that were specified. Multiple terms with the same key are combined
+// into a single term that accepts any of the values.
+//
+// Each state term is compiled into a mask of the accepted state values, so that matching a resource only
+// requires comparing the resource's current states against the masks.
+class ResourceFilter
+{
+  public:
+    // Thrown to indicate an invalid filter expression
+    class SyntaxException : public std::exception
+    {
+      public:
+        // @throws std::bad_alloc
+        SyntaxException(const std::string& error_msg_ref);
+        virtual ~SyntaxException() noexcept;
+
+        virtual const std::string& get_error_msg() const noexcept;
+
+      private:
+        std::string error_msg;
+    };
+
+    static const std::string    KEY_ROLE;
+    static const std::string    KEY_PEER_ROLE;
+    static const std::string    KEY_DISK;
+    static const std::string    KEY_PEER_DISK;
+    static const std::string    KEY_REPL;
+    static const std::string    KEY_CONN;
+
+    // @throws std::bad_alloc, string_matching::PatternLimitException, ResourceFilter::SyntaxException
+    explicit ResourceFilter(const std::string& filter_expr);
+    virtual ~ResourceFilter() noexcept;
+    ResourceFilter(const ResourceFilter& orig) = delete;
+    ResourceFilter& operator=(const ResourceFilter& orig) = delete;
+    ResourceFilter(ResourceFilter&& orig) = delete;
+    ResourceFilter& operator=(ResourceFilter&& orig) = delete;
+
+    virtual bool matches(DrbdResource& rsc) const;
+    virtual const std::string& get_expression() const noexcept;
+
+  private:
+    class NamePattern
+    {
+      public:
+        NamePattern();
+        virtual ~NamePattern() noexcept;
+
+        std::unique_ptr<string_matching::PatternItem>   pattern;
+        std::unique_ptr<NamePattern>                    next;
+    };
+
+    // Masks of accepted state values, a mask of 0 accepts all states
+    using state_mask = uint32_t;
+
+    std::string                     expression;
+    std::unique_ptr<NamePattern>    name_patterns;
+
+    state_mask  role_mask       {0};
+    state_mask  peer_role_mask  {0};
+    state_mask  disk_mask       {0};
+    state_mask  peer_disk_mask  {0};
+    state_mask  repl_mask       {0};
+    state_mask  conn_mask       {0};
+
+    bool matches_name(const std::string& rsc_name) const;
+    bool matches_volumes(
+        VolumesContainer&   vol_con,
+        const state_mask    vol_disk_mask,
+        const state_mask    vol_repl_mask
+    ) const;
+
+    // @throws std::bad_alloc, string_matching::PatternLimitException, ResourceFilter::SyntaxException
+    void compile_term(const std::string& term);
+    // Compiles the comma-separated values of a term into a mask of the states with a matching label
+    // @throws std::bad_alloc, string_matching::PatternLimitException, ResourceFilter::SyntaxException
+    static state_mask compile_states(
+        const std::string&  term,
+        const std::string&  values,
+        const char* const   labels[],
+        const size_t        labels_count
+    );
+    static void to_lowercase(std::string& text) noexcept;
+};
+
+#endif /* RESOURCEFILTER_H */
@@ -0,0 +1,241 @@
+#include <objects/VolumeHistory.h>
+
+extern "C"
+{
+    #include <time.h>
+}
+
+const uint16_t  VolumeHistory::MIN_SAMPLES      = 4;
+const uint16_t  VolumeHistory::MAX_SAMPLES      = 64;
+const uint16_t  VolumeHistory::SAMPLE_INTERVAL  = 60;
+const uint16_t  VolumeHistory::ESTIMATE_WINDOW  = 600;
+const uint64_t  VolumeHistory::TIME_UNKNOWN     = ~static_cast<uint64_t> (0);
+
+const uint8_t   VolumeHistory::FLAG_TRANSITION  = 0x1;
+const uint16_t  VolumeHistory::MAX_TIME_DELTA   = 0xFFFF;
+
+size_t VolumeHistory::instance_count    = 0;
+size_t VolumeHistory::footprint         = 0;
+
+// @throws std::bad_alloc
+VolumeHistory::VolumeHistory()
+{
+    ++instance_count;
+    footprint += sizeof (VolumeHistory);
+}
+
+VolumeHistory::~VolumeHistory() noexcept
+{
+    --instance_count;
+    footprint -= sizeof (VolumeHistory) + capacity * sizeof (Entry);
+}
+
+// @throws std::bad_alloc
+void VolumeHistory::record(
+    const uint64_t                  time_secs,
+    const uint16_t                  sync_perc,
+    const DrbdVolume::disk_state    disk,
+    const DrbdVolume::repl_state    repl
+)
+{
+    const uint8_t states = pack_states(disk, repl);
+    uint16_t time_delta = 0;
+    if (count >= 1 && time_secs > last_time)
+    {
+        const uint64_t elapsed = time_secs - last_time;
+        time_delta = elapsed < MAX_TIME_DELTA ? static_cast<uint16_t> (elapsed) : MAX_TIME_DELTA;
+    }
+
+    if (count >= 1 && entry_at(count - 1).states == states)
+    {
+        Entry& last_entry = entry_at(count - 1);
+        if (last_entry.sync_perc != sync_perc)
+        {
+            if (count >= 2 && (last_entry.flags & FLAG_TRANSITION) == 0 && last_entry.time_delta < SAMPLE_INTERVAL)
+            {
+                // Merge with the latest sample
+                const uint32_t merged_delta = static_cast<uint32_t> (last_entry.time_delta) + time_delta;
+                last_entry.time_delta = merged_delta < MAX_TIME_DELTA ?
+                    static_cast<uint16_t> (merged_delta) : MAX_TIME_DELTA;
+                last_entry.sync_perc = sync_perc;
+            }
+            else
+            {
+                append(Entry {time_delta, sync_perc, states, 0});
+            }
+            last_time = time_secs;
+        }
+    }
+    else
+    {
+        append(Entry {time_delta, sync_perc, states, FLAG_TRANSITION});
+        last_time = time_secs;
+    }
+}
+
+uint16_t VolumeHistory::get_sample_count() const noexcept
+{
+    return count;
+}
+
+void VolumeHistory::get_sample(const uint16_t idx, Sample& sample) const noexcept
+{
+    // Calculate the time of the sample backwards from the time of the latest sample
+    uint64_t time_secs = last_time;
+    for (uint16_t later_idx = count - 1; later_idx > idx && time_secs != TIME_UNKNOWN; --later_idx)
+    {
+        const uint16_t time_delta = entry_at(later_idx).time_delta;
+        if (time_delta == MAX_TIME_DELTA || time_secs < time_delta)
+        {
+            time_secs = TIME_UNKNOWN;
+        }
+        else
+        {
+            time_secs -= time_delta;
+        }
+    }
+
+    const Entry& sample_entry = entry_at(idx);
+    sample.time_secs = time_secs;
+    sample.sync_perc = sample_entry.sync_perc;
+    sample.disk = static_cast<DrbdVolume::disk_state> (sample_entry.states >> 4);
+    sample.repl = static_cast<DrbdVolume::repl_state> (sample_entry.states & 0xF);
+    sample.transition = (sample_entry.flags & FLAG_TRANSITION) != 0;
+}
+
+bool VolumeHistory::estimate_sync(
+    const uint64_t  time_secs,
+    uint32_t&       perc_per_min,
+    uint64_t&       eta_secs
+) const noexcept
+{
+    bool have_estimate = false;
+    if (count >= 2)
+    {
+        const Entry& last_entry = entry_at(count - 1);
+        const DrbdVolume::repl_state repl = static_cast<DrbdVolume::repl_state> (last_entry.states & 0xF);
+        if (DrbdVolume::is_resyncing(repl) && last_time != TIME_UNKNOWN)
+        {
+            // Find the oldest sample of the current resynchronization within the estimate window
+            const uint64_t min_time = time_secs > ESTIMATE_WINDOW ? time_secs - ESTIMATE_WINDOW : 0;
+            uint64_t first_time = last_time;
+            uint16_t first_perc = last_entry.sync_perc;
+            uint16_t idx = count - 1;
+            bool scanning = true;
+            while (scanning && idx >= 1)
+            {
+                const uint16_t time_delta = entry_at(idx).time_delta;
+                const Entry& prev_entry = entry_at(idx - 1);
+                scanning = (entry_at(idx).flags & FLAG_TRANSITION) == 0 && prev_entry.states == last_entry.states &&
+                    time_delta != MAX_TIME_DELTA && first_time >= min_time + time_delta;
+                if (scanning)
+                {
+                    first_time -= time_delta;
+                    first_perc = prev_entry.sync_perc;
+                    --idx;
+                }
+            }
+
+            if (first_time < last_time && first_perc < last_entry.sync_perc)
+            {
+                const uint64_t elapsed = last_time - first_time;
+                const uint64_t progress = last_entry.sync_perc - first_perc;
+                const uint64_t remaining = DrbdVolume::MAX_SYNC_PERC - last_entry.sync_perc;
+                perc_per_min = static_cast<uint32_t> (progress * 60 / elapsed);
+                eta_secs = remaining * elapsed / progress;
+                // Account for the time that passed since the latest sample
+                const uint64_t since_last = time_secs > last_time ? time_secs - last_time : 0;
+                eta_secs = eta_secs > since_last ? eta_secs - since_last : 0;
+                have_estimate = true;
+            }
+        }
+    }
+    return have_estimate;
+}
+
+uint64_t VolumeHistory::get_last_transition_time() const noexcept
+{
+    uint64_t transition_time = TIME_UNKNOWN;
+    uint64_t time_secs = last_time;
+    uint16_t idx = count;
+    while (idx >= 1 && transition_time == TIME_UNKNOWN && time_secs != TIME_UNKNOWN)
+    {
+        --idx;
+        const Entry& sample_entry = entry_at(idx);
+        if ((sample_entry.flags & FLAG_TRANSITION) != 0)
+        {
+            transition_time = time_secs;
+        }
+        else
+        if (sample_entry.time_delta == MAX_TIME_DELTA || time_secs < sample_entry.time_delta)
+        {
+            time_secs = TIME_UNKNOWN;
+        }
+        else
+        {
+            time_secs -= sample_entry.time_delta;
+        }
+    }
+    return transition_time;
+}
+
+uint64_t VolumeHistory::get_current_time() noexcept
+{
+    struct timespec now {0, 0};
+    static_cast<void> (clock_gettime(CLOCK_MONOTONIC, &now));
+    return static_cast<uint64_t> (now.tv_sec);
+}
+
+size_t VolumeHistory::get_instance_count() noexcept
+{
+    return instance_count;
+}
+
+size_t VolumeHistory::get_footprint() noexcept
+{
+    return footprint;
+}
+
+// @throws std::bad_alloc
+void VolumeHistory::append(const Entry& new_entry)
+{
+    if (count >= capacity && capacity < MAX_SAMPLES)
+    {
+        const uint16_t new_capacity = capacity >= MIN_SAMPLES ? capacity * 2 : MIN_SAMPLES;
+        std::unique_ptr<Entry[]> new_entries(new Entry[new_capacity]);
+        for (uint16_t idx = 0; idx < count; ++idx)
+        {
+            new_entries[idx] = entry_at(idx);
+        }
+        entries = std::move(new_entries);
+        footprint += (new_capacity - capacity) * sizeof (Entry);
+        capacity = new_capacity;
+        head = 0;
+    }
+
+    if (count < capacity)
+    {
+        ++count;
+    }
+    else
+    {
+        // Overwrite the oldest sample
+        head = (head + 1) % capacity;
+    }
+    entry_at(count - 1) = new_entry;
+}
+
+const VolumeHistory::Entry& VolumeHistory::entry_at(const uint16_t idx) const noexcept
+{
+    return entries[(head + idx) % capacity];
+}
+
+VolumeHistory::Entry& VolumeHistory::entry_at(const uint16_t idx) noexcept
+{
+    return entries[(head + idx) % capacity];
+}
+
+uint8_t VolumeHistory::pack_states(const DrbdVolume::disk_state disk, const DrbdVolume::repl_state repl) noexcept
+{
+    return static_cast<uint8_t> ((static_cast<uint16_t> (disk) << 4) | (static_cast<uint16_t> (repl) & 0xF));
+}
@@ -0,0 +1,114 @@
+#ifndef VOLUMEHISTORY_H
+#define VOLUMEHISTORY_H
+
+#include <default_types.h>
+#include <new>
+#include <memory>
+#include <objects/DrbdVolume.h>
+
+// Bounded history of the resynchronization progress and of the state transitions of a volume
+//
+// Samples are stored in a ring buffer that starts small and grows up to MAX_SAMPLES entries, after which
+// the oldest samples are overwritten. Each sample stores the time passed since the previous sample, so
+// that a sample only requires 6 bytes.
+// Samples that only change the resynchronization progress are merged with the latest sample, unless the
+// latest sample was recorded at least SAMPLE_INTERVAL seconds after the sample before it. The retained
+// progress samples are therefore spaced at least SAMPLE_INTERVAL seconds apart, while the latest sample
+// always reflects the current progress.
+//
+// The histories are used only by the thread that runs DrbdMon.
+class VolumeHistory
+{
+  public:
+    static const uint16_t   MIN_SAMPLES;
+    static const uint16_t   MAX_SAMPLES;
+    // Minimum time in seconds between retained progress samples
+    static const uint16_t   SAMPLE_INTERVAL;
+    // Maximum age in seconds of the samples that are used for estimating the resynchronization rate
+    static const uint16_t   ESTIMATE_WINDOW;
+    static const uint64_t   TIME_UNKNOWN;
+
+    class Sample
+    {
+      public:
+        // Time in seconds, see get_current_time(); TIME_UNKNOWN if the sample is too old to be dated
+        uint64_t                time_secs   {TIME_UNKNOWN};
+        uint16_t                sync_perc   {DrbdVolume::MAX_SYNC_PERC};
+        DrbdVolume::disk_state  disk        {DrbdVolume::disk_state::UNKNOWN};
+        DrbdVolume::repl_state  repl        {DrbdVolume::repl_state::UNKNOWN};
+        // True if the sample records a change of the disk state or of the replication state
+        bool                    transition  {false};
+    };
+
+    // @throws std::bad_alloc
+    VolumeHistory();
+    virtual ~VolumeHistory() noexcept;
+    VolumeHistory(const VolumeHistory& orig) = delete;
+    VolumeHistory& operator=(const VolumeHistory& orig) = delete;
+    VolumeHistory(VolumeHistory&& orig) = delete;
+    VolumeHistory& operator=(VolumeHistory&& orig) = delete;
+
+    // Records the current state of a volume
+    // @throws std::bad_alloc
+    virtual void record(
+        const uint64_t                  time_secs,
+        const uint16_t                  sync_perc,
+        const DrbdVolume::disk_state    disk,
+        const DrbdVolume::repl_state    repl
+    );
+
+    virtual uint16_t get_sample_count() const noexcept;
+    // Decodes the sample at the specified index, where index 0 selects the oldest sample
+    virtual void get_sample(const uint16_t idx, Sample& sample) const noexcept;
+
+    // Estimates the resynchronization rate from the samples of the current resynchronization
+    // that are no older than ESTIMATE_WINDOW seconds
+    // @param perc_per_min Resynchronization rate in 1/100 percent per minute
+    // @param eta_secs Estimated number of seconds until the resynchronization is finished
+    // @return True if an estimate is available, false otherwise
+    virtual bool estimate_sync(const uint64_t time_secs, uint32_t& perc_per_min, uint64_t& eta_secs) const noexcept;
+
+    // @return Time of the latest state transition, or TIME_UNKNOWN
+    virtual uint64_t get_last_transition_time() const noexcept;
+
+    // Monotonic time in seconds that is used to date samples
+    static uint64_t get_current_time() noexcept;
+
+    // Number of histories and number of bytes allocated by all histories
+    static size_t get_instance_count() noexcept;
+    static size_t get_footprint() noexcept;
+
+  private:
+    static const uint8_t    FLAG_TRANSITION;
+    static const uint16_t   MAX_TIME_DELTA;
+
+    class Entry
+    {
+      public:
+        // Seconds since the previous sample, saturated at MAX_TIME_DELTA
+        uint16_t    time_delta;
+        uint16_t    sync_perc;
+        // Disk state in the upper 4 bits, replication state in the lower 4 bits
+        uint8_t     states;
+        uint8_t     flags;
+    };
+
+    static size_t instance_count;
+    static size_t footprint;
+
+    std::unique_ptr<Entry[]>    entries;
+    // Time of the latest sample, the times of all other samples are calculated backwards from this time
+    uint64_t    last_time   {TIME_UNKNOWN};
+    uint16_t    capacity    {0};
+    uint16_t    head        {0};
+    uint16_t    count       {0};
+
+    // @throws std::bad_alloc
+    void append(const Entry& new_entry);
+    const Entry& entry_at(const uint16_t idx) const noexcept;
+    Entry& entry_at(const uint16_t idx) noexcept;
+
+    static uint8_t pack_states(const DrbdVolume::disk_state disk, const DrbdVolume::repl_state repl) noexcept;
+};
+
+#endif /* VOLUMEHISTORY_H */
@@ -0,0 +1,178 @@
+#include <platform/Linux/EventLineBuffer.h>
+#include <cstring>
+#include <string>
+
+extern "C"
+{
+    #include <unistd.h>
+    #include <errno.h>
+}
+
+// @throws std::bad_alloc
+EventLineBuffer::EventLineBuffer(const int events_input_fd, const size_t buffer_size):
+    events_fd(events_input_fd),
+    events_buffer_size(buffer_size),
+    events_buffer(new char[buffer_size]),
+    line_batch(new StringView[MAX_BATCH_LINES])
+{
+}
+
+EventLineBuffer::~EventLineBuffer() noexcept
+{
+}
+
+// @throws std::bad_alloc, EventsIoException
+void EventLineBuffer::read_events()
+{
+    // Lines that have already been processed are discarded to make space
+    // for new data, unless the current batch has not been retrieved yet
+    if (!batch_pending)
+    {
+        compact_events_buffer();
+    }
+
+    // If there is space remaining in the buffer,
+    // read data into the buffer.
+    // If the buffer is full, it must be compacted or emptied by
+    // calls to get_event_lines()
+    if (events_length < events_buffer_size)
+    {
+        size_t length = events_buffer_size - events_length;
+        ssize_t read_count = 0;
+        do
+        {
+            errno = 0;
+            read_count = read(events_fd, &(events_buffer[events_length]), length);
+        }
+        while (read_count == -1 && errno == EINTR);
+        if (read_count == 0)
+        {
+            events_eof = true;
+        }
+        else
+        if (read_count == -1)
+        {
+            if (errno != EAGAIN)
+            {
+                std::string error_msg("Reading from the events channel failed");
+                std::string debug_info("read(events_fd, ...) failed, errno=");
+                debug_info += std::to_string(errno);
+                throw EventsIoException(&error_msg, &debug_info, nullptr);
+            }
+        }
+        else
+        {
+            // Indicate that more data has been made available and
+            // should be checked for complete lines using prepare_batch()
+            data_pending = true;
+            events_length += read_count;
+        }
+    }
+}
+
+// @throws std::bad_alloc, EventsIoException
+const StringView* EventLineBuffer::get_event_lines(size_t& line_count)
+{
+    // Only lines that are already in the buffer are returned; the events channel is
+    // read by read_events() when the caller's poll reports that data is available
+    if (!batch_pending && data_pending)
+    {
+        prepare_batch();
+    }
+
+    line_count = batch_pending ? batch_count : 0;
+    batch_pending = false;
+    return line_batch.get();
+}
+
+// @throws std::bad_alloc, EventsIoException
+bool EventLineBuffer::prepare_batch()
+{
+    if (!batch_pending)
+    {
+        batch_count = 0;
+
+        // Check for new complete lines in the buffer
+        // Data before scan_pos has already been searched for line ends
+        char* const input_data = events_buffer.get();
+        size_t index = scan_pos;
+        while (index < events_length && batch_count < MAX_BATCH_LINES)
+        {
+            if (input_data[index] == '\n')
+            {
+                if (discard_line)
+                {
+                    discard_line = false;
+                }
+                else
+                {
+                    line_batch[batch_count] = StringView(&(input_data[event_begin_pos]), index - event_begin_pos);
+                    ++batch_count;
+                }
+                event_begin_pos = index + 1;
+            }
+            else
+            if (input_data[index] == 0x1B)
+            {
+                input_data[index] = '?';
+            }
+            ++index;
+        }
+        scan_pos = index;
+        batch_pending = batch_count > 0;
+
+        if (index >= events_length)
+        {
+            // Indicate that all available data has been searched for event lines
+            // and more data needs to be read to find another event line
+            data_pending = false;
+
+            if (event_begin_pos == 0 && events_length == events_buffer_size)
+            {
+                // Buffer is full, but no lines were found
+                // Too long line, discard input
+                events_length = 0;
+                scan_pos = 0;
+                discard_line = true;
+
+                // Currently, a too long line is considered an error
+                // If throwing the exception is removed, too long lines
+                // will simply be discarded instead
+                std::string error_msg("Event line exceeded maximum permitted length");
+                throw EventsIoException(&error_msg, nullptr, nullptr);
+            }
+        }
+    }
+
+    return batch_pending;
+}
+
+// Moves the incomplete line at the end of the events buffer to the start of the buffer
+void EventLineBuffer::compact_events_buffer() noexcept
+{
+    if (event_begin_pos > 0)
+    {
+        const size_t remaining_length = events_length - event_begin_pos;
+        if (remaining_length > 0)
+        {
+            static_cast<void> (std::memmove(
+                static_cast<void*> (events_buffer.get()),
+                static_cast<const void*> (&(events_buffer[event_begin_pos])),
+                remaining_length
+            ));
+        }
+        events_length = remaining_length;
+        scan_pos -= event_begin_pos;
+        event_begin_pos = 0;
+    }
+}
+
+bool EventLineBuffer::is_data_pending() const noexcept
+{
+    return data_pending;
+}
+
+bool EventLineBuffer::is_eof() const noexcept
+{
+    return events_eof;
+}
@@ -0,0 +1,76 @@
+#ifndef EVENTLINEBUFFER_H
+#define EVENTLINEBUFFER_H
+
+#include <default_types.h>
+#include <new>
+#include <memory>
+#include <StringView.h>
+
+#include <exceptions.h>
+
+// Buffered reader for the 'drbdsetup events2' channel
+//
+// Reads data from the events channel into a buffer and collects batches of complete
+// event lines from that buffer. The event lines of a batch are StringView instances that
+// refer directly to the buffer.
+// The events channel's file descriptor is not owned by the EventLineBuffer instance.
+class EventLineBuffer
+{
+  public:
+    // Default size of the events buffer, which also limits the maximum length of an event line
+    static const size_t DFLT_BUFFER_SIZE {256 * 1024};
+    // Maximum number of event lines per batch
+    static const size_t MAX_BATCH_LINES {1024};
+
+    // @throws std::bad_alloc
+    EventLineBuffer(int events_input_fd, size_t buffer_size);
+    virtual ~EventLineBuffer() noexcept;
+
+    EventLineBuffer(const EventLineBuffer& orig) = delete;
+    EventLineBuffer& operator=(const EventLineBuffer& orig) = delete;
+    EventLineBuffer(EventLineBuffer&& orig) = delete;
+    EventLineBuffer& operator=(EventLineBuffer&& orig) = delete;
+
+    // Reads the data that is available on the events channel into the buffer
+    // @throws std::bad_alloc, EventsIoException
+    virtual void read_events();
+
+    // Collects up to MAX_BATCH_LINES complete event lines from the buffer
+    // @return true if a batch of event lines is available, false otherwise
+    // @throws std::bad_alloc, EventsIoException
+    virtual bool prepare_batch();
+
+    // Returns the current batch of event lines and sets line_count to the number of lines
+    // in the batch, which is zero if no complete event lines are available.
+    // Does not read from the events channel.
+    // The lines remain valid until the next call of either read_events(), prepare_batch()
+    // or get_event_lines().
+    // @throws std::bad_alloc, EventsIoException
+    virtual const StringView* get_event_lines(size_t& line_count);
+
+    // Indicates whether the buffer contains data that has not been searched for event lines yet
+    virtual bool is_data_pending() const noexcept;
+
+    // Indicates whether the end of the events stream has been reached
+    virtual bool is_eof() const noexcept;
+
+  private:
+    const int events_fd;
+
+    const size_t events_buffer_size;
+    const std::unique_ptr<char[]> events_buffer;
+    const std::unique_ptr<StringView[]> line_batch;
+
+    size_t batch_count     {0};
+    size_t event_begin_pos {0};
+    size_t scan_pos        {0};
+    size_t events_length   {0};
+    bool   events_eof      {false};
+    bool   discard_line    {false};
+    bool   batch_pending   {false};
+    bool   data_pending    {false};
+
+    void compact_events_buffer() noexcept;
+};
+
+#endif /* EVENTLINEBUFFER_H */
@@ -15,19 +15,25 @@ const int EventsIo::ERROR_CTL_INDEX  = 1;
 const int EventsIo::SIG_CTL_INDEX    = 2;
 const int EventsIo::STDIN_CTL_INDEX  = 3;
 const int EventsIo::WAKEUP_CTL_INDEX = 4;
+const int EventsIo::SERVER_CTL_INDEX = 5;
 // Number of epoll_event datastructure slots
-const int EventsIo::CTL_SLOTS_COUNT  = 5;
+const int EventsIo::CTL_SLOTS_COUNT  = 6;
 
 // @throws std::bad_alloc, std::ios_base::failure
-EventsIo::EventsIo(const int events_input_fd, const int events_error_fd):
+EventsIo::EventsIo(
+    const int       events_input_fd,
+    const int       events_error_fd,
+    const bool      monitor_stdin,
+    const size_t    buffer_size
+):
     events_fd(events_input_fd),
     error_fd(events_error_fd),
+    stdin_fd(monitor_stdin ? STDIN_FILENO : -1),
     input_seq_dec(new InputSequenceDecoder()),
     mouse(new MouseEvent()),
     ctl_events(new struct epoll_event[CTL_SLOTS_COUNT]),
     fired_events(new struct epoll_event[CTL_SLOTS_COUNT]),
     signal_buffer(new struct signalfd_siginfo),
-    events_buffer(new char[MAX_LINE_LENGTH]),
     error_buffer(new char[ERROR_BUFFER_SIZE]),
     discard_buffer(new char[DISCARD_BUFFER_SIZE])
 {
@@ -93,10 +99,17 @@ EventsIo::EventsIo(const int events_input_fd, const int events_error_fd):
                                        sizeof (struct epoll_event) * CTL_SLOTS_COUNT));
 
         // Register the epoll() events
-        register_poll(events_fd, &(ctl_events[EVENTS_CTL_INDEX]), EPOLLIN);
+        if (events_fd != -1)
+        {
+            line_buffer = std::unique_ptr<EventLineBuffer>(new EventLineBuffer(events_fd, buffer_size));
+            register_poll(events_fd, &(ctl_events[EVENTS_CTL_INDEX]), EPOLLIN);
+        }
         register_poll(error_fd, &(ctl_events[ERROR_CTL_INDEX]), EPOLLIN);
         register_poll(sig_fd, &(ctl_events[SIG_CTL_INDEX]), EPOLLIN);
-        register_poll(stdin_fd, &(ctl_events[STDIN_CTL_INDEX]), EPOLLIN);
+        if (stdin_fd != -1)
+        {
+            register_poll(stdin_fd, &(ctl_events[STDIN_CTL_INDEX]), EPOLLIN);
+        }
         register_poll(wakeup_fd[posix::PIPE_READ_SIDE], &(ctl_events[WAKEUP_CTL_INDEX]), EPOLLIN);
     }
     catch (EventsIoException&)
@@ -139,6 +152,13 @@ void EventsIo::wakeup_wait() noexcept
     while (rc != 0 && errno == EINTR);
 }
 
+// @throws std::bad_alloc, EventsIoException
+void EventsIo::register_server(const int server_poll_fd)
+{
+    register_poll(server_poll_fd, &(ctl_events[SERVER_CTL_INDEX]), EPOLLIN);
+    server_fd = server_poll_fd;
+}
+
 // @throws std::bad_alloc, EventsIoException
 void EventsIo::register_poll(int fd, struct epoll_event* event_ctl_slot, uint32_t event_mask)
 {
@@ -160,13 +180,13 @@ CoreIo::event EventsIo::wait_event()
     EventsIo::event event_id = EventsIo::event::NONE;
 
     // If data is available in the buffer, look for event lines
-    // This check is turned off by prepare_line() if all the available
+    // This check is turned off by prepare_batch() if all the available
     // data has been searched and more data must be read to find another
     // event lines
     // read_events() turns this check back on if more data was read
-    if (data_pending)
+    if (line_buffer != nullptr && line_buffer->is_data_pending())
     {
-        if (prepare_line())
+        if (line_buffer->prepare_batch())
         {
             event_id = EventsIo::event::EVENT_LINE;
         }
@@ -198,17 +218,17 @@ CoreIo::event EventsIo::wait_event()
         }
 
         int fired_fd = fired_events[current_event].data.fd;
-        if (fired_fd == events_fd)
+        if (fired_fd == events_fd && line_buffer != nullptr)
         {
             // Events source data available
-            if (events_eof)
+            if (line_buffer->is_eof())
             {
                 std::string error_msg("The events stream was closed");
                 throw EventsIoException(&error_msg, nullptr, nullptr);
             }
 
-            read_events();
-            if (prepare_line())
+            line_buffer->read_events();
+            if (line_buffer->prepare_batch())
             {
                 event_id = EventsIo::event::EVENT_LINE;
             }
@@ -233,7 +253,7 @@ CoreIo::event EventsIo::wait_event()
             event_id = EventsIo::event::SIGNAL;
         }
         else
-        if (fired_fd == stdin_fd)
+        if (fired_fd == stdin_fd && stdin_fd != -1)
         {
             // Data available on stdin
             {
@@ -291,6 +311,12 @@ CoreIo::event EventsIo::wait_event()
             event_id = EventsIo::event::WAKEUP;
         }
         else
+        if (fired_fd == server_fd && server_fd != -1)
+        {
+            // Server connections ready for I/O
+            event_id = EventsIo::event::SERVER;
+        }
+        else
         {
             // Unknown data source ready, this is not supposed to happen
             std::string error_msg("Internal error: An unregistered I/O channel became ready");
@@ -404,48 +430,6 @@ void EventsIo::restore_terminal()
     }
 }
 
-// @throws std::bad_alloc, EventsIoException
-void EventsIo::read_events()
-{
-    // If there is space remaining in the buffer,
-    // read data into the buffer.
-    // If the buffer is full, it must be compacted or emptied by
-    // calls to get_event_line()
-    if (events_length < MAX_LINE_LENGTH)
-    {
-        size_t length = MAX_LINE_LENGTH - events_length;
-        ssize_t read_count = 0;
-        do
-        {
-            errno = 0;
-            read_count = read(events_fd, &(events_buffer[events_length]), length);
-        }
-        while (read_count == -1 && errno == EINTR);
-        if (read_count == 0)
-        {
-            events_eof = true;
-        }
-        else
-        if (read_count == -1)
-        {
-            if (errno != EAGAIN)
-            {
-                std::string error_msg("Reading from the events channel failed");
-                std::string debug_info("read(events_fd, ...) failed, errno=");
-                debug_info += std::to_string(errno);
-                throw EventsIoException(&error_msg, &debug_info, nullptr);
-            }
-        }
-        else
-        {
-            // Indicate that more data has been made available and
-            // should be checked for complete lines using prepare_line()
-            data_pending = true;
-            events_length += read_count;
-        }
-    }
-}
-
 // @throws std::bad_alloc, EventsIoException
 void EventsIo::read_errors()
 {
@@ -474,109 +458,18 @@ void EventsIo::read_errors()
 }
 
 // @throws std::bad_alloc, EventsIoException
-std::string* EventsIo::get_event_line()
+const StringView* EventsIo::get_event_lines(size_t& line_count)
 {
-    if (event_line == nullptr)
+    const StringView* lines = nullptr;
+    if (line_buffer != nullptr)
     {
-        if (!data_pending)
-        {
-            read_events();
-        }
-        prepare_line();
+        lines = line_buffer->get_event_lines(line_count);
     }
-
-    line_pending = false;
-    return event_line.get();
-}
-
-void EventsIo::free_event_line()
-{
-    event_line = nullptr;
-}
-
-// @throws std::bad_alloc, EventsIoException
-bool EventsIo::prepare_line()
-{
-    if (!line_pending)
+    else
     {
-        if (event_line != nullptr)
-        {
-            event_line = nullptr;
-        }
-
-        bool have_line = false;
-        size_t event_end_pos = 0;
-        // Check for new complete lines in the buffer
-        char* input_data = events_buffer.get();
-        for (size_t index = event_begin_pos; index < events_length; ++index)
-        {
-            if (input_data[index] == '\n')
-            {
-                have_line = true;
-                event_end_pos = index + 1;
-                break;
-            }
-            else
-            if (input_data[index] == 0x1B)
-            {
-                input_data[index] = '?';
-            }
-        }
-
-        if (have_line)
-        {
-            if (discard_line)
-            {
-                discard_line = false;
-            }
-            else
-            {
-                event_line = std::unique_ptr<std::string>(
-                    new std::string(&(input_data[event_begin_pos]), event_end_pos - event_begin_pos - 1)
-                );
-                line_pending = true;
-            }
-            event_begin_pos = event_end_pos;
-        }
-        else
-        {
-            // Indicate that all available data has been searched for event lines
-            // and more data needs to be read to find another event line
-            data_pending = false;
-
-            if (event_begin_pos > 0)
-            {
-                // No more lines in the buffer, compact buffer
-                size_t src_index = event_begin_pos;
-                size_t dst_index = 0;
-                while (src_index < events_length)
-                {
-                    input_data[dst_index] = input_data[src_index];
-                    ++src_index;
-                    ++dst_index;
-                }
-                events_length = events_length - event_begin_pos;
-                event_begin_pos = 0;
-            }
-            else
-            if (events_length == MAX_LINE_LENGTH)
-            {
-                // Buffer is full, but no lines were found
-                // Too long line, discard input
-                event_begin_pos = 0;
-                events_length = 0;
-                discard_line = true;
-
-                // Currently, a too long line is considered an error
-                // If throwing the exception is removed, too long lines
-                // will simply be discarded instead
-                std::string error_msg("Event line exceeded maximum permitted length");
-                throw EventsIoException(&error_msg, nullptr, nullptr);
-            }
-        }
+        line_count = 0;
     }
-
-    return line_pending;
+    return lines;
 }
 
 // Throws EventsIoException if rc is not equal to 0
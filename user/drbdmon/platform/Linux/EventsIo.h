@@ -6,6 +6,8 @@
 #include <memory>
 #include <stdexcept>
 #include <CoreIo.h>
+#include <StringView.h>
+#include <platform/Linux/EventLineBuffer.h>
 #include <EventsIoWakeup.h>
 #include <terminal/Linux/InputSequenceDecoder.h>
 #include <terminal/KeyCodes.h>
@@ -25,12 +27,20 @@ extern "C"
 class EventsIo : public CoreIo, public EventsIoWakeup
 {
   public:
-    static const size_t MAX_LINE_LENGTH {1024};
     static const size_t ERROR_BUFFER_SIZE {1024};
     static const size_t DISCARD_BUFFER_SIZE {1024};
 
+    // If events_input_fd is -1, the events channel is not monitored, which is the case if
+    // the events are read by an EventsReader instance
+    // If monitor_stdin is false, no terminal input is read, which is the case if DrbdMon
+    // runs without a terminal
     // @throws std::bad_alloc, std::ios_base::failure
-    explicit EventsIo(int events_input_fd, int events_error_fd);
+    explicit EventsIo(
+        int events_input_fd,
+        int events_error_fd,
+        bool monitor_stdin = true,
+        size_t buffer_size = EventLineBuffer::DFLT_BUFFER_SIZE
+    );
     virtual ~EventsIo() noexcept;
 
     EventsIo(const EventsIo& orig) = delete;
@@ -44,14 +54,17 @@ class EventsIo : public CoreIo, public EventsIoWakeup
 
     virtual void wakeup_wait() noexcept override;
 
-    // Returns the current event line
+    // Adds a file descriptor that reports server I/O readiness, e.g. the poll file descriptor
+    // of a StateServer instance; wait_event() returns SERVER when the file descriptor becomes readable
     // @throws std::bad_alloc, EventsIoException
-    virtual std::string* get_event_line() override;
+    virtual void register_server(int server_poll_fd);
 
-    // Can be called optionally to free the current event line
-    // Otherwise, the current event line will be freed whenever the next
-    // event line is prepared, or upon destruction of the EventsIo instance
-    virtual void free_event_line() override;
+    // Returns the current batch of event lines
+    // The lines refer to the events buffer and remain valid until the next call of
+    // either wait_event() or get_event_lines()
+    // If the events channel is not monitored, the batch is always empty
+    // @throws std::bad_alloc, EventsIoException
+    virtual const StringView* get_event_lines(size_t& line_count) override;
 
     // @throws std::bad_alloc, EventsIoException
     virtual CoreIo::signal_type get_signal() override;
@@ -70,6 +83,7 @@ class EventsIo : public CoreIo, public EventsIoWakeup
     static const int SIG_CTL_INDEX;
     static const int STDIN_CTL_INDEX;
     static const int WAKEUP_CTL_INDEX;
+    static const int SERVER_CTL_INDEX;
     // Number of epoll_event datastructure slots
     static const int CTL_SLOTS_COUNT;
 
@@ -81,6 +95,8 @@ class EventsIo : public CoreIo, public EventsIoWakeup
     int sig_fd          {-1};
     int stdin_fd        {STDIN_FILENO};
     int wakeup_fd[2]    {-1, -1};
+    // Not owned by the EventsIo instance
+    int server_fd       {-1};
 
     int  event_count    {0};
     int  current_event  {0};
@@ -95,31 +111,19 @@ class EventsIo : public CoreIo, public EventsIoWakeup
     const std::unique_ptr<signalfd_siginfo> signal_buffer;
 
     // Events processing
-    const std::unique_ptr<char[]> events_buffer;
+    std::unique_ptr<EventLineBuffer> line_buffer;
     const std::unique_ptr<char[]> error_buffer;
     const std::unique_ptr<char[]> discard_buffer;
-    std::unique_ptr<std::string> event_line;
 
-    size_t event_begin_pos {0};
-    size_t events_length   {0};
-    bool   events_eof      {false};
     bool   errors_eof      {false};
-    bool   discard_line    {false};
-    bool   line_pending    {false};
-    bool   data_pending    {false};
 
     bool have_orig_termios {false};
     struct termios orig_termios;
     struct termios adjusted_termios;
 
-    // @throws std::bad_alloc, EventsIoException
-    void read_events();
-
     // @throws std::bad_alloc, EventsIoException
     void read_errors();
 
-    // @throws std::bad_alloc, EventsIoException
-    bool prepare_line();
 
         // @throws std::bad_alloc, EventsIoException
     void register_poll(int fd, struct epoll_event* event_ctl, uint32_t event_mask);
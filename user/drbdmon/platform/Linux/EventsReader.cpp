@@ -0,0 +1,242 @@
+#include <platform/Linux/EventsReader.h>
+#include <utils.h>
+
+extern "C"
+{
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <errno.h>
+}
+
+// @throws std::bad_alloc, EventsIoException
+EventsReader::EventsReader(
+    const int events_input_fd,
+    EventsQueue& queue_ref,
+    EventsIoWakeup* const wakeup_target_ref,
+    const size_t buffer_size
+):
+    events_fd(events_input_fd),
+    queue(queue_ref),
+    wakeup_target(wakeup_target_ref)
+{
+    try
+    {
+        line_buffer = std::unique_ptr<EventLineBuffer>(new EventLineBuffer(events_fd, buffer_size));
+
+        if (pipe2(stop_fd, O_CLOEXEC) != 0)
+        {
+            std::string error_msg("Unable to setup an internal communication pipe");
+            std::string debug_info("pipe2(...) failed, errno=");
+            debug_info += std::to_string(errno);
+            throw EventsIoException(&error_msg, &debug_info, nullptr);
+        }
+    }
+    catch (EventsIoException&)
+    {
+        cleanup();
+        throw;
+    }
+    catch (std::bad_alloc&)
+    {
+        cleanup();
+        throw;
+    }
+}
+
+EventsReader::~EventsReader() noexcept
+{
+    stop();
+    cleanup();
+}
+
+// @throws std::system_error
+void EventsReader::start()
+{
+    reader_thread = std::thread(&EventsReader::run_reader, this);
+}
+
+void EventsReader::stop() noexcept
+{
+    if (reader_thread.joinable())
+    {
+        // Wake up the reader thread if it is waiting for events or for free records
+        int rc = 0;
+        do
+        {
+            char stop_byte = 0;
+            errno = 0;
+            rc = write(stop_fd[posix::PIPE_WRITE_SIDE], static_cast<void*> (&stop_byte), 1);
+        }
+        while (rc == -1 && errno == EINTR);
+        queue.close();
+
+        reader_thread.join();
+    }
+}
+
+bool EventsReader::is_failed() const noexcept
+{
+    return failed.load();
+}
+
+// @throws std::bad_alloc, EventsIoException
+void EventsReader::check_failure()
+{
+    if (failed.load())
+    {
+        std::unique_lock<std::mutex> lock(failure_lock);
+        if (failure_oom)
+        {
+            throw std::bad_alloc();
+        }
+        throw EventsIoException(
+            failure_msg.empty() ? nullptr : &failure_msg,
+            failure_debug_info.empty() ? nullptr : &failure_debug_info,
+            nullptr
+        );
+    }
+}
+
+void EventsReader::run_reader() noexcept
+{
+    try
+    {
+        struct pollfd poll_fds[2];
+        poll_fds[0].fd = events_fd;
+        poll_fds[0].events = POLLIN;
+        poll_fds[1].fd = stop_fd[posix::PIPE_READ_SIDE];
+        poll_fds[1].events = POLLIN;
+
+        bool stop_flag = false;
+        while (!stop_flag)
+        {
+            poll_fds[0].revents = 0;
+            poll_fds[1].revents = 0;
+
+            int rc = 0;
+            do
+            {
+                errno = 0;
+                rc = poll(poll_fds, 2, -1);
+            }
+            while (rc == -1 && errno == EINTR);
+
+            if (rc == -1)
+            {
+                std::string error_msg("I/O channel selection failed");
+                std::string debug_info("poll(...) failed, errno=");
+                debug_info += std::to_string(errno);
+                throw EventsIoException(&error_msg, &debug_info, nullptr);
+            }
+
+            if (poll_fds[1].revents != 0)
+            {
+                stop_flag = true;
+            }
+            else
+            if (poll_fds[0].revents != 0)
+            {
+                line_buffer->read_events();
+                stop_flag = !publish_lines();
+                if (!stop_flag && line_buffer->is_eof())
+                {
+                    std::string error_msg("The events stream was closed");
+                    throw EventsIoException(&error_msg, nullptr, nullptr);
+                }
+            }
+        }
+    }
+    catch (EventsIoException& io_exc)
+    {
+        set_failure(io_exc.get_error_msg(), io_exc.get_debug_info());
+    }
+    catch (std::bad_alloc&)
+    {
+        set_out_of_memory();
+    }
+}
+
+// @throws std::bad_alloc, EventsIoException
+bool EventsReader::publish_lines()
+{
+    bool queue_open = true;
+    size_t line_count {0};
+    const StringView* line_batch = line_buffer->get_event_lines(line_count);
+    while (line_count > 0 && queue_open)
+    {
+        for (size_t line_idx = 0; line_idx < line_count && queue_open; ++line_idx)
+        {
+            EventsQueue::event_record* const record = queue.acquire_slot();
+            if (record != nullptr)
+            {
+                line_batch[line_idx].assign_to(record->event_line);
+                record->parse_failed = false;
+                try
+                {
+                    record->have_event = record->event_props.parse(StringView(record->event_line));
+                }
+                catch (EventMessageException&)
+                {
+                    // The consumer parses the event line again to report the error
+                    record->event_props.clear();
+                    record->have_event = false;
+                    record->parse_failed = true;
+                }
+
+                if (queue.publish())
+                {
+                    wakeup_target->wakeup_wait();
+                }
+            }
+            else
+            {
+                queue_open = false;
+            }
+        }
+        if (queue_open)
+        {
+            line_batch = line_buffer->get_event_lines(line_count);
+        }
+    }
+    return queue_open;
+}
+
+void EventsReader::set_failure(const std::string* const error_msg, const std::string* const debug_info) noexcept
+{
+    try
+    {
+        std::unique_lock<std::mutex> lock(failure_lock);
+        if (error_msg != nullptr)
+        {
+            failure_msg = *error_msg;
+        }
+        if (debug_info != nullptr)
+        {
+            failure_debug_info = *debug_info;
+        }
+    }
+    catch (std::bad_alloc&)
+    {
+        failure_oom = true;
+    }
+    failed.store(true);
+    wakeup_target->wakeup_wait();
+}
+
+void EventsReader::set_out_of_memory() noexcept
+{
+    {
+        std::unique_lock<std::mutex> lock(failure_lock);
+        failure_oom = true;
+    }
+    failed.store(true);
+    wakeup_target->wakeup_wait();
+}
+
+void EventsReader::cleanup() noexcept
+{
+    posix::close_fd(events_fd);
+    posix::close_fd(stop_fd[posix::PIPE_READ_SIDE]);
+    posix::close_fd(stop_fd[posix::PIPE_WRITE_SIDE]);
+}
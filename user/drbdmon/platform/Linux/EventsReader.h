@@ -0,0 +1,89 @@
+#ifndef EVENTSREADER_H
+#define EVENTSREADER_H
+
+#include <default_types.h>
+#include <new>
+#include <memory>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <platform/Linux/EventLineBuffer.h>
+#include <EventsQueue.h>
+#include <EventsIoWakeup.h>
+
+#include <exceptions.h>
+
+// Reads and parses 'drbdsetup events2' lines on a separate thread
+//
+// The reader thread reads the events channel, parses each event line and publishes the
+// parsed event lines through an EventsQueue. The consumer is signaled through the
+// EventsIoWakeup interface whenever records are published while no signal is pending.
+// Errors on the events channel end the reader thread and are reported to the consumer
+// by a signal, and are rethrown on the consumer's thread by check_failure().
+//
+// The EventsReader instance takes ownership of the events channel's file descriptor.
+class EventsReader
+{
+  public:
+    // @throws std::bad_alloc, EventsIoException
+    EventsReader(
+        int events_input_fd,
+        EventsQueue& queue_ref,
+        EventsIoWakeup* wakeup_target_ref,
+        size_t buffer_size = EventLineBuffer::DFLT_BUFFER_SIZE
+    );
+    virtual ~EventsReader() noexcept;
+
+    EventsReader(const EventsReader& orig) = delete;
+    EventsReader& operator=(const EventsReader& orig) = delete;
+    EventsReader(EventsReader&& orig) = delete;
+    EventsReader& operator=(EventsReader&& orig) = delete;
+
+    // Starts the reader thread
+    // Signals that are handled by EventsIo must be blocked before starting the thread,
+    // which is the case once the EventsIo instance has been constructed
+    // @throws std::system_error
+    virtual void start();
+
+    // Stops and joins the reader thread
+    virtual void stop() noexcept;
+
+    // Indicates whether an error ended the reader thread
+    // No more records are published after the reader thread has failed
+    virtual bool is_failed() const noexcept;
+
+    // Rethrows the error that ended the reader thread, if any
+    // @throws std::bad_alloc, EventsIoException
+    virtual void check_failure();
+
+  private:
+    int events_fd;
+    int stop_fd[2] {-1, -1};
+
+    EventsQueue&    queue;
+    EventsIoWakeup* wakeup_target;
+
+    std::unique_ptr<EventLineBuffer> line_buffer;
+
+    std::thread reader_thread;
+
+    std::mutex          failure_lock;
+    std::atomic<bool>   failed          {false};
+    bool                failure_oom     {false};
+    std::string         failure_msg;
+    std::string         failure_debug_info;
+
+    void run_reader() noexcept;
+
+    // @return false if the queue was closed, true otherwise
+    // @throws std::bad_alloc, EventsIoException
+    bool publish_lines();
+
+    void set_failure(const std::string* error_msg, const std::string* debug_info) noexcept;
+    void set_out_of_memory() noexcept;
+
+    void cleanup() noexcept;
+};
+
+#endif /* EVENTSREADER_H */
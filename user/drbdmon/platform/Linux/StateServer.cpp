@@ -0,0 +1,603 @@
+#include <platform/Linux/StateServer.h>
+#include <json_state.h>
+#include <utils.h>
+#include <cstring>
+
+extern "C"
+{
+    #include <unistd.h>
+    #include <errno.h>
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+}
+
+const size_t    StateServer::MAX_CLIENTS            = 64;
+const size_t    StateServer::MAX_CHANGES_BACKLOG    = 4 * 1024 * 1024;
+const size_t    StateServer::IO_BUFFER_SIZE         = 4096;
+const uint64_t  StateServer::LISTEN_SLOT            = ~static_cast<uint64_t> (0);
+// Read/write access for the owner and the group
+const mode_t    StateServer::SOCKET_MODE            = S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP;
+
+// @throws std::bad_alloc, EventsIoException
+StateServer::StateServer(
+    const std::string&  socket_path_ref,
+    ResourceDirectory&  rsc_dir_ref,
+    MessageLog&         log_ref
+):
+    socket_path(socket_path_ref),
+    rsc_dir(rsc_dir_ref),
+    log(log_ref),
+    clients(new std::unique_ptr<Client>[MAX_CLIENTS]),
+    fired_events(new struct epoll_event[MAX_CLIENTS + 1]),
+    io_buffer(new char[IO_BUFFER_SIZE])
+{
+    try
+    {
+        poll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (poll_fd == -1)
+        {
+            std::string error_msg("Server I/O channel selector initialization failed");
+            std::string debug_info("epoll_create1(...) failed, errno=");
+            debug_info += std::to_string(errno);
+            throw EventsIoException(&error_msg, &debug_info, nullptr);
+        }
+
+        bind_socket();
+
+        struct epoll_event listen_event;
+        static_cast<void> (std::memset(static_cast<void*> (&listen_event), 0, sizeof (listen_event)));
+        listen_event.events = EPOLLIN;
+        listen_event.data.u64 = LISTEN_SLOT;
+        if (epoll_ctl(poll_fd, EPOLL_CTL_ADD, listen_fd, &listen_event) != 0)
+        {
+            std::string error_msg("Server socket registration failed");
+            std::string debug_info("epoll_ctl(...) failed, errno=");
+            debug_info += std::to_string(errno);
+            throw EventsIoException(&error_msg, &debug_info, nullptr);
+        }
+    }
+    catch (EventsIoException&)
+    {
+        cleanup();
+        throw;
+    }
+    catch (std::bad_alloc&)
+    {
+        cleanup();
+        throw;
+    }
+}
+
+StateServer::~StateServer() noexcept
+{
+    cleanup();
+}
+
+int StateServer::get_poll_fd() const noexcept
+{
+    return poll_fd;
+}
+
+// @throws std::bad_alloc, EventsIoException
+void StateServer::process_io()
+{
+    int event_count = 0;
+    do
+    {
+        errno = 0;
+        event_count = epoll_wait(poll_fd, fired_events.get(), static_cast<int> (MAX_CLIENTS + 1), 0);
+    }
+    while (event_count == -1 && errno == EINTR);
+    if (event_count == -1)
+    {
+        std::string error_msg("Server I/O channel selection failed");
+        std::string debug_info("epoll_wait(...) failed, errno=");
+        debug_info += std::to_string(errno);
+        throw EventsIoException(&error_msg, &debug_info, nullptr);
+    }
+
+    // New clients are accepted after processing the events of the connected clients,
+    // so that no events of a disconnected client are applied to a new client in the same slot
+    bool accept_pending = false;
+    for (int event_idx = 0; event_idx < event_count; ++event_idx)
+    {
+        const uint64_t slot = fired_events[event_idx].data.u64;
+        const uint32_t event_mask = fired_events[event_idx].events;
+        if (slot == LISTEN_SLOT)
+        {
+            accept_pending = true;
+        }
+        else
+        if (slot < MAX_CLIENTS && clients[slot] != nullptr)
+        {
+            if ((event_mask & (EPOLLERR | EPOLLHUP)) != 0)
+            {
+                disconnect(slot);
+            }
+            else
+            {
+                if ((event_mask & EPOLLIN) != 0)
+                {
+                    receive_data(slot);
+                }
+                if ((event_mask & EPOLLOUT) != 0 && clients[slot] != nullptr)
+                {
+                    send_data(slot);
+                }
+                if (clients[slot] != nullptr)
+                {
+                    update_poll_mask(slot);
+                }
+            }
+        }
+    }
+
+    if (accept_pending)
+    {
+        accept_clients();
+    }
+}
+
+// @throws std::bad_alloc, EventMessageException, EventObjectException
+void StateServer::event_applied(EventProps& event_props, const std::string& event_line)
+{
+    if (client_count > 0 && have_initial_state)
+    {
+        const EventKeywords::keyword event_mode = event_props.get_mode_id();
+        const EventKeywords::keyword event_type = event_props.get_type_id();
+        if (event_type == EventKeywords::keyword::TYPE_RESOURCE ||
+            event_type == EventKeywords::keyword::TYPE_CONNECTION ||
+            event_type == EventKeywords::keyword::TYPE_DEVICE ||
+            event_type == EventKeywords::keyword::TYPE_PEER_DEVICE)
+        {
+            if (event_mode == EventKeywords::keyword::MODE_DESTROY ||
+                event_mode == EventKeywords::keyword::MODE_RENAME)
+            {
+                // The object does not exist anymore under the name that the event refers to
+                json_state::write_event_keys(changes, event_props);
+            }
+            else
+            {
+                const StringView& mode = event_props.get_mode();
+                DrbdResource& rsc = rsc_dir.get_resource(event_props, event_line);
+                if (event_type == EventKeywords::keyword::TYPE_RESOURCE)
+                {
+                    json_state::write_resource(changes, mode, rsc);
+                }
+                else
+                if (event_type == EventKeywords::keyword::TYPE_CONNECTION)
+                {
+                    DrbdConnection& conn = rsc_dir.get_connection(rsc, event_props, event_line);
+                    json_state::write_connection(changes, mode, rsc, conn);
+                }
+                else
+                if (event_type == EventKeywords::keyword::TYPE_DEVICE)
+                {
+                    DrbdVolume& vol = rsc_dir.get_device(rsc, event_props, event_line);
+                    json_state::write_device(changes, mode, rsc, vol);
+                }
+                else
+                {
+                    DrbdConnection& conn = rsc_dir.get_connection(rsc, event_props, event_line);
+                    DrbdVolume& vol = rsc_dir.get_device(conn, event_props, event_line);
+                    json_state::write_peer_device(changes, mode, rsc, conn, vol);
+                }
+            }
+        }
+    }
+}
+
+void StateServer::initialize()
+{
+    // no-op; the server socket is set up by the constructor
+}
+
+void StateServer::enter_initial_display()
+{
+    // no-op
+}
+
+// @throws std::bad_alloc
+void StateServer::exit_initial_display()
+{
+    have_initial_state = true;
+    send_snapshots();
+}
+
+// @throws std::bad_alloc
+bool StateServer::notify_drbd_changed()
+{
+    const bool have_changes = !changes.empty();
+    if (have_changes)
+    {
+        for (size_t slot = 0; slot < MAX_CLIENTS; ++slot)
+        {
+            if (clients[slot] != nullptr && clients[slot]->have_snapshot)
+            {
+                queue_data(slot, changes);
+            }
+        }
+        changes.clear();
+    }
+    return have_changes;
+}
+
+bool StateServer::notify_task_queue_changed()
+{
+    return false;
+}
+
+bool StateServer::notify_message_log_changed()
+{
+    return false;
+}
+
+void StateServer::terminal_size_changed()
+{
+    // no-op
+}
+
+void StateServer::key_pressed(const uint32_t key)
+{
+    // no-op
+}
+
+void StateServer::mouse_action(MouseEvent& mouse)
+{
+    // no-op
+}
+
+// @throws EventsIoException
+void StateServer::bind_socket()
+{
+    struct sockaddr_un socket_addr;
+    static_cast<void> (std::memset(static_cast<void*> (&socket_addr), 0, sizeof (socket_addr)));
+    if (socket_path.empty() || socket_path.length() >= sizeof (socket_addr.sun_path))
+    {
+        std::string error_msg("Invalid server socket path: ");
+        error_msg += socket_path;
+        throw EventsIoException(&error_msg, nullptr, nullptr);
+    }
+    socket_addr.sun_family = AF_UNIX;
+    static_cast<void> (std::memcpy(socket_addr.sun_path, socket_path.c_str(), socket_path.length()));
+    const struct sockaddr* const addr_ptr = reinterpret_cast<const struct sockaddr*> (&socket_addr);
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd == -1)
+    {
+        std::string error_msg("Server socket creation failed");
+        std::string debug_info("socket(...) failed, errno=");
+        debug_info += std::to_string(errno);
+        throw EventsIoException(&error_msg, &debug_info, nullptr);
+    }
+
+    int rc = bind(listen_fd, addr_ptr, sizeof (socket_addr));
+    if (rc != 0 && errno == EADDRINUSE)
+    {
+        // Remove the socket file if it was left behind by a server that is no longer running,
+        // which is indicated by connections being refused
+        struct stat file_info;
+        if (lstat(socket_path.c_str(), &file_info) == 0 && S_ISSOCK(file_info.st_mode))
+        {
+            int probe_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (probe_fd != -1)
+            {
+                const bool stale_socket = connect(probe_fd, addr_ptr, sizeof (socket_addr)) != 0 &&
+                    errno == ECONNREFUSED;
+                posix::close_fd(probe_fd);
+                if (stale_socket && unlink(socket_path.c_str()) == 0)
+                {
+                    rc = bind(listen_fd, addr_ptr, sizeof (socket_addr));
+                }
+                else
+                {
+                    errno = EADDRINUSE;
+                }
+            }
+        }
+        else
+        {
+            errno = EADDRINUSE;
+        }
+    }
+    if (rc != 0)
+    {
+        std::string error_msg("Cannot bind the server socket ");
+        error_msg += socket_path;
+        if (errno == EADDRINUSE)
+        {
+            error_msg += " (address in use)";
+        }
+        std::string debug_info("bind(...) failed, errno=");
+        debug_info += std::to_string(errno);
+        throw EventsIoException(&error_msg, &debug_info, nullptr);
+    }
+    have_socket_file = true;
+
+    if (chmod(socket_path.c_str(), SOCKET_MODE) != 0 || listen(listen_fd, SOMAXCONN) != 0)
+    {
+        std::string error_msg("Server socket initialization failed");
+        std::string debug_info("chmod(...) or listen(...) failed, errno=");
+        debug_info += std::to_string(errno);
+        throw EventsIoException(&error_msg, &debug_info, nullptr);
+    }
+}
+
+// @throws std::bad_alloc
+void StateServer::accept_clients()
+{
+    bool new_clients = false;
+    bool accepting = true;
+    while (accepting)
+    {
+        errno = 0;
+        int client_fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client_fd != -1)
+        {
+            size_t slot = 0;
+            while (slot < MAX_CLIENTS && clients[slot] != nullptr)
+            {
+                ++slot;
+            }
+            if (slot < MAX_CLIENTS)
+            {
+                try
+                {
+                    clients[slot] = std::unique_ptr<Client>(new Client(client_fd));
+                }
+                catch (std::bad_alloc&)
+                {
+                    posix::close_fd(client_fd);
+                    throw;
+                }
+                ++client_count;
+
+                Client& client = *(clients[slot]);
+                struct epoll_event client_event;
+                static_cast<void> (std::memset(static_cast<void*> (&client_event), 0, sizeof (client_event)));
+                client_event.events = EPOLLIN;
+                client_event.data.u64 = slot;
+                if (epoll_ctl(poll_fd, EPOLL_CTL_ADD, client.fd, &client_event) == 0)
+                {
+                    client.poll_mask = EPOLLIN;
+                    new_clients = true;
+                }
+                else
+                {
+                    disconnect(slot);
+                }
+            }
+            else
+            {
+                posix::close_fd(client_fd);
+                log.add_entry(
+                    MessageLog::log_level::WARN,
+                    "State server: Connection refused, the maximum number of clients is connected"
+                );
+            }
+        }
+        else
+        if (errno != EINTR && errno != ECONNABORTED)
+        {
+            // EAGAIN, or an error that is not specific to a single connection, such as
+            // reaching the limit of open file descriptors
+            accepting = false;
+        }
+    }
+
+    if (new_clients && have_initial_state)
+    {
+        send_snapshots();
+    }
+}
+
+// @throws std::bad_alloc
+void StateServer::send_snapshots()
+{
+    // Send the collected changes to the clients that already have a snapshot, because the changes
+    // are already contained in new snapshots
+    static_cast<void> (notify_drbd_changed());
+
+    std::string snapshot;
+    for (size_t slot = 0; slot < MAX_CLIENTS; ++slot)
+    {
+        if (clients[slot] != nullptr && !clients[slot]->have_snapshot)
+        {
+            if (snapshot.empty())
+            {
+                ResourcesMap::ValuesIterator rsc_iter(rsc_dir.get_resources_map());
+                while (rsc_iter.has_next())
+                {
+                    json_state::write_resource_tree(snapshot, *(rsc_iter.next()));
+                }
+                json_state::write_end_of_snapshot(snapshot, rsc_dir.get_change_seq());
+            }
+            Client& client = *(clients[slot]);
+            client.backlog_limit = snapshot.length() + MAX_CHANGES_BACKLOG;
+            client.have_snapshot = true;
+            queue_data(slot, snapshot);
+        }
+    }
+}
+
+// @throws std::bad_alloc
+void StateServer::queue_data(const size_t slot, const std::string& data)
+{
+    Client& client = *(clients[slot]);
+    const size_t backlog = client.out_data.length() - client.out_offset;
+    if (backlog + data.length() <= client.backlog_limit)
+    {
+        // Discard the data that was sent already, if that does not require moving more data
+        // than was discarded
+        if (client.out_offset > 0 && client.out_offset >= backlog)
+        {
+            client.out_data.erase(0, client.out_offset);
+            client.out_offset = 0;
+        }
+        client.out_data += data;
+        send_data(slot);
+        if (clients[slot] != nullptr)
+        {
+            update_poll_mask(slot);
+        }
+    }
+    else
+    {
+        disconnect(slot);
+        log.add_entry(
+            MessageLog::log_level::WARN,
+            "State server: Disconnected a client that did not receive the state changes fast enough"
+        );
+    }
+}
+
+void StateServer::send_data(const size_t slot) noexcept
+{
+    Client& client = *(clients[slot]);
+    bool connected = true;
+    bool sending = true;
+    while (sending && client.out_offset < client.out_data.length())
+    {
+        errno = 0;
+        const ssize_t sent_count = send(
+            client.fd,
+            client.out_data.data() + client.out_offset,
+            client.out_data.length() - client.out_offset,
+            MSG_NOSIGNAL | MSG_DONTWAIT
+        );
+        if (sent_count > 0)
+        {
+            client.out_offset += static_cast<size_t> (sent_count);
+        }
+        else
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            sending = false;
+        }
+        else
+        if (errno != EINTR)
+        {
+            sending = false;
+            connected = false;
+        }
+    }
+
+    if (!connected)
+    {
+        disconnect(slot);
+    }
+    else
+    if (client.out_offset >= client.out_data.length())
+    {
+        // Release the memory of large buffers, such as the buffer that contained the snapshot
+        if (client.out_data.capacity() > IO_BUFFER_SIZE)
+        {
+            std::string().swap(client.out_data);
+        }
+        else
+        {
+            client.out_data.clear();
+        }
+        client.out_offset = 0;
+    }
+}
+
+void StateServer::receive_data(const size_t slot) noexcept
+{
+    Client& client = *(clients[slot]);
+    bool connected = true;
+    bool receiving = true;
+    while (receiving)
+    {
+        errno = 0;
+        const ssize_t read_count = read(client.fd, io_buffer.get(), IO_BUFFER_SIZE);
+        if (read_count == 0)
+        {
+            // The client will not send anything anymore, but may still receive changes
+            client.input_closed = true;
+            receiving = false;
+        }
+        else
+        if (read_count == -1)
+        {
+            if (errno != EINTR)
+            {
+                receiving = false;
+                connected = errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+        }
+        // Any data received from the client is discarded
+    }
+
+    if (!connected)
+    {
+        disconnect(slot);
+    }
+}
+
+void StateServer::update_poll_mask(const size_t slot) noexcept
+{
+    Client& client = *(clients[slot]);
+    uint32_t poll_mask = 0;
+    if (!client.input_closed)
+    {
+        poll_mask |= EPOLLIN;
+    }
+    if (client.out_offset < client.out_data.length())
+    {
+        poll_mask |= EPOLLOUT;
+    }
+    if (poll_mask != client.poll_mask)
+    {
+        struct epoll_event client_event;
+        static_cast<void> (std::memset(static_cast<void*> (&client_event), 0, sizeof (client_event)));
+        client_event.events = poll_mask;
+        client_event.data.u64 = slot;
+        if (epoll_ctl(poll_fd, EPOLL_CTL_MOD, client.fd, &client_event) == 0)
+        {
+            client.poll_mask = poll_mask;
+        }
+        else
+        {
+            disconnect(slot);
+        }
+    }
+}
+
+void StateServer::disconnect(const size_t slot) noexcept
+{
+    static_cast<void> (epoll_ctl(poll_fd, EPOLL_CTL_DEL, clients[slot]->fd, nullptr));
+    clients[slot] = nullptr;
+    --client_count;
+}
+
+void StateServer::cleanup() noexcept
+{
+    if (clients != nullptr)
+    {
+        for (size_t slot = 0; slot < MAX_CLIENTS; ++slot)
+        {
+            clients[slot] = nullptr;
+        }
+    }
+    client_count = 0;
+    posix::close_fd(listen_fd);
+    if (have_socket_file)
+    {
+        static_cast<void> (unlink(socket_path.c_str()));
+        have_socket_file = false;
+    }
+    posix::close_fd(poll_fd);
+}
+
+StateServer::Client::Client(const int client_fd):
+    fd(client_fd)
+{
+}
+
+StateServer::Client::~Client() noexcept
+{
+    posix::close_fd(fd);
+}
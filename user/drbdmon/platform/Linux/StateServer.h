@@ -0,0 +1,148 @@
+#ifndef STATESERVER_H
+#define STATESERVER_H
+
+#include <default_types.h>
+#include <new>
+#include <memory>
+#include <string>
+#include <terminal/GenericDisplay.h>
+#include <terminal/MouseEvent.h>
+#include <objects/ResourceDirectory.h>
+#include <EventProps.h>
+#include <MessageLog.h>
+
+#include <exceptions.h>
+
+extern "C"
+{
+    #include <sys/epoll.h>
+}
+
+// Serves the DRBD resource model to local clients over a UNIX domain stream socket
+//
+// Replaces the terminal display if DrbdMon runs without a terminal. Each client receives
+// a snapshot of the current state, followed by a stream of changes, in JSON lines format
+// (see json_state.h). The snapshot consists of 'exists' records and is finished by an
+// 'exists' record of type '-', the changes are 'create', 'change', 'rename' and 'destroy'
+// records. Records for existing objects contain all of the object's properties, so that
+// a client does not need to merge changes into previously received records.
+// Clients that connect before the initial DRBD state is available receive the snapshot
+// as soon as the initial state becomes available.
+//
+// Changes are collected while events are applied and are sent to the clients whenever
+// DrbdMon would update the display, so that the display update frequency limit also
+// limits the frequency of the clients' wakeups.
+// Clients do not need to send anything; any data received from a client is discarded.
+// A client that does not read the changes fast enough is disconnected once the amount
+// of unsent data exceeds the size of its snapshot by MAX_CHANGES_BACKLOG bytes.
+//
+// Socket I/O is nonblocking and multiplexed on a separate epoll file descriptor,
+// which is in turn monitored by the EventsIo instance.
+class StateServer : public GenericDisplay
+{
+  public:
+    static const size_t MAX_CLIENTS;
+    static const size_t MAX_CHANGES_BACKLOG;
+
+    // @throws std::bad_alloc, EventsIoException
+    StateServer(
+        const std::string&  socket_path_ref,
+        ResourceDirectory&  rsc_dir_ref,
+        MessageLog&         log_ref
+    );
+    virtual ~StateServer() noexcept;
+    StateServer(const StateServer& orig) = delete;
+    StateServer& operator=(const StateServer& orig) = delete;
+    StateServer(StateServer&& orig) = delete;
+    StateServer& operator=(StateServer&& orig) = delete;
+
+    // @return File descriptor that becomes readable when connections are ready for I/O
+    virtual int get_poll_fd() const noexcept;
+
+    // Accepts new clients and performs the pending I/O of connected clients
+    // @throws std::bad_alloc, EventsIoException
+    virtual void process_io();
+
+    // Records the change that was caused by applying an event
+    // Must be called after the event has been applied successfully
+    // @throws std::bad_alloc, EventMessageException, EventObjectException
+    virtual void event_applied(EventProps& event_props, const std::string& event_line);
+
+    virtual void initialize() override;
+    virtual void enter_initial_display() override;
+    // Sends the snapshot to each client that connected before the initial state was available
+    // @throws std::bad_alloc
+    virtual void exit_initial_display() override;
+    // Sends the collected changes to the clients
+    // @return True if any changes were sent, false otherwise
+    // @throws std::bad_alloc
+    virtual bool notify_drbd_changed() override;
+    virtual bool notify_task_queue_changed() override;
+    virtual bool notify_message_log_changed() override;
+    virtual void terminal_size_changed() override;
+    virtual void key_pressed(const uint32_t key) override;
+    virtual void mouse_action(MouseEvent& mouse) override;
+
+  private:
+    class Client
+    {
+      public:
+        Client(const int client_fd);
+        virtual ~Client() noexcept;
+
+        int         fd;
+        // Data queued for sending, data before out_offset has been sent already
+        std::string out_data;
+        size_t      out_offset      {0};
+        // Maximum amount of unsent data before the client is disconnected
+        size_t      backlog_limit   {0};
+        // Set if the client has closed its sending side of the connection
+        bool        input_closed    {false};
+        // Set once the snapshot has been queued for the client
+        bool        have_snapshot   {false};
+        // Currently registered epoll event mask
+        uint32_t    poll_mask       {0};
+    };
+
+    static const size_t     IO_BUFFER_SIZE;
+    static const uint64_t   LISTEN_SLOT;
+    static const mode_t     SOCKET_MODE;
+
+    std::string         socket_path;
+    ResourceDirectory&  rsc_dir;
+    MessageLog&         log;
+
+    int     listen_fd           {-1};
+    int     poll_fd             {-1};
+    bool    have_socket_file    {false};
+    bool    have_initial_state  {false};
+
+    std::unique_ptr<std::unique_ptr<Client>[]>  clients;
+    size_t                                      client_count    {0};
+
+    // Changes collected since the changes were last sent to the clients
+    std::string changes;
+
+    const std::unique_ptr<struct epoll_event[]> fired_events;
+    const std::unique_ptr<char[]>               io_buffer;
+
+    // @throws EventsIoException
+    void bind_socket();
+
+    // @throws std::bad_alloc
+    void accept_clients();
+    // @throws std::bad_alloc
+    void send_snapshots();
+    // Queues data for the client and sends as much of it as possible without blocking
+    // @throws std::bad_alloc
+    void queue_data(const size_t slot, const std::string& data);
+    void send_data(const size_t slot) noexcept;
+    void receive_data(const size_t slot) noexcept;
+    // Updates the epoll event mask of the client according to its pending I/O
+    void update_poll_mask(const size_t slot) noexcept;
+    void disconnect(const size_t slot) noexcept;
+
+    void cleanup() noexcept;
+};
+
+#endif /* STATESERVER_H */
@@ -1,5 +1,6 @@
 #include <platform/Linux/SystemApiImpl.h>
 #include <subprocess/Linux/SubProcessLx.h>
+#include <subprocess/Linux/SubProcessReactorLx.h>
 #include <terminal/Linux/TerminalControlImpl.h>
 #include <exceptions.h>
 #include <cstring>
@@ -43,6 +44,12 @@ std::unique_ptr<SubProcess> LinuxApi::create_subprocess_handler()
     return std::unique_ptr<SubProcess>(dynamic_cast<SubProcess*> (new SubProcessLx()));
 }
 
+// @throws SubProcess::Exception, std::bad_alloc
+std::unique_ptr<SubProcessReactor> LinuxApi::create_subprocess_reactor()
+{
+    return std::unique_ptr<SubProcessReactor>(dynamic_cast<SubProcessReactor*> (new SubProcessReactorLx()));
+}
+
 std::unique_ptr<TerminalControl> LinuxApi::create_terminal_control()
 {
     return std::unique_ptr<TerminalControl>(dynamic_cast<TerminalControl*> (new TerminalControlImpl()));
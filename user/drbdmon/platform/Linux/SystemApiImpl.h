@@ -20,6 +20,7 @@ class LinuxApi : public SystemApi
     virtual void post_thread_invocation() override;
 
     virtual std::unique_ptr<SubProcess> create_subprocess_handler() override;
+    virtual std::unique_ptr<SubProcessReactor> create_subprocess_reactor() override;
     virtual std::unique_ptr<TerminalControl> create_terminal_control() override;
     virtual std::string get_config_file_path() override;
     virtual void prepare_save_config_file() override;
@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include <MessageLog.h>
 #include <subprocess/SubProcess.h>
+#include <subprocess/SubProcessReactor.h>
 #include <terminal/TerminalControl.h>
 
 class SystemApi
@@ -25,6 +26,14 @@ class SystemApi
     }
 
     virtual std::unique_ptr<SubProcess> create_subprocess_handler() = 0;
+
+    // Platforms that do not provide a reactor execute each sub-process on a separate thread
+    // @throws SubProcess::Exception, std::bad_alloc
+    virtual std::unique_ptr<SubProcessReactor> create_subprocess_reactor()
+    {
+        return nullptr;
+    }
+
     virtual std::unique_ptr<TerminalControl> create_terminal_control() = 0;
     virtual std::string get_config_file_path() = 0;
     virtual void prepare_save_config_file() = 0;
@@ -6,6 +6,7 @@
 CmdLine::CmdLine()
 {
     arg_list = std::unique_ptr<StringList>(new StringList(&comparators::compare_string));
+    target_list = std::unique_ptr<StringList>(new StringList(&comparators::compare_string));
 }
 
 CmdLine::CmdLine(const std::string& description):
@@ -23,6 +24,14 @@ CmdLine::~CmdLine() noexcept
         delete cur_arg;
     }
     arg_list->clear();
+
+    StringList::ValuesIterator target_iter(*target_list);
+    while (target_iter.has_next())
+    {
+        std::string* const cur_target = target_iter.next();
+        delete cur_target;
+    }
+    target_list->clear();
 }
 
 size_t CmdLine::get_argument_count() const
@@ -36,6 +45,17 @@ CmdLine::StringList::ValuesIterator CmdLine::get_argument_iterator() const
     return arg_iter;
 }
 
+size_t CmdLine::get_target_count() const
+{
+    return target_list->get_size();
+}
+
+CmdLine::StringList::ValuesIterator CmdLine::get_target_iterator() const
+{
+    StringList::ValuesIterator target_iter(*target_list);
+    return target_iter;
+}
+
 const std::string& CmdLine::get_description() const
 {
     return cmd_description;
@@ -53,3 +73,11 @@ void CmdLine::add_argument(const std::string& arg)
     arg_list->append(new_arg.get());
     new_arg.release();
 }
+
+// @throws std::bad_alloc
+void CmdLine::add_target(const std::string& target)
+{
+    std::unique_ptr<std::string> new_target(new std::string(target));
+    target_list->append(new_target.get());
+    new_target.release();
+}
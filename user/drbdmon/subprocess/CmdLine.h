@@ -18,6 +18,10 @@ class CmdLine
     virtual size_t get_argument_count() const;
     virtual StringList::ValuesIterator get_argument_iterator() const;
 
+    // Objects that the command operates on, if a single command operates on multiple objects
+    virtual size_t get_target_count() const;
+    virtual StringList::ValuesIterator get_target_iterator() const;
+
     virtual const std::string& get_description() const;
 
     // @throws std::bad_alloc
@@ -26,8 +30,12 @@ class CmdLine
     // @throws std::bad_alloc
     virtual void add_argument(const std::string& arg);
 
+    // @throws std::bad_alloc
+    virtual void add_target(const std::string& target);
+
   private:
     std::unique_ptr<StringList> arg_list;
+    std::unique_ptr<StringList> target_list;
     std::string                 cmd_description;
 };
 
@@ -0,0 +1,46 @@
+#include <subprocess/DrbdCmdResult.h>
+
+namespace drbdcmd
+{
+    static bool is_name_char(const char name_char) noexcept;
+
+    target_result get_target_result(const std::string& target, const int exit_status, const std::string& output)
+    {
+        target_result result = target_result::SUCCEEDED;
+        if (exit_status != 0)
+        {
+            result = target_result::UNKNOWN;
+
+            // Search for occurrences of the target object's name that are not part of a longer name
+            const size_t target_length = target.length();
+            const size_t output_length = output.length();
+            size_t search_idx = 0;
+            while (result == target_result::UNKNOWN && target_length > 0 && search_idx < output_length)
+            {
+                const size_t match_idx = output.find(target, search_idx);
+                if (match_idx != std::string::npos)
+                {
+                    const size_t end_idx = match_idx + target_length;
+                    const bool start_bound = match_idx == 0 || !is_name_char(output[match_idx - 1]);
+                    const bool end_bound = end_idx >= output_length || !is_name_char(output[end_idx]);
+                    if (start_bound && end_bound)
+                    {
+                        result = target_result::FAILED;
+                    }
+                    search_idx = match_idx + 1;
+                }
+                else
+                {
+                    search_idx = output_length;
+                }
+            }
+        }
+        return result;
+    }
+
+    static bool is_name_char(const char name_char) noexcept
+    {
+        return (name_char >= 'a' && name_char <= 'z') || (name_char >= 'A' && name_char <= 'Z') ||
+            (name_char >= '0' && name_char <= '9') || name_char == '-' || name_char == '_';
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef DRBDCMDRESULT_H
+#define DRBDCMDRESULT_H
+
+#include <default_types.h>
+#include <string>
+
+namespace drbdcmd
+{
+    enum class target_result : uint8_t
+    {
+        SUCCEEDED,
+        FAILED,
+        UNKNOWN
+    };
+
+    // Determines the result of a command that operated on multiple target objects for one of those objects
+    //
+    // If the command failed, a target object is considered failed if any line of the command's output
+    // names the target object. The result for target objects that are not named in the output of a
+    // failed command is unknown, because the command may have been aborted before reaching those objects.
+    target_result get_target_result(const std::string& target, const int exit_status, const std::string& output);
+}
+
+#endif /* DRBDCMDRESULT_H */
@@ -22,6 +22,8 @@ const char* const EventsSourceSpawner::EVENTS_PROGRAM_ARGS[] =
     nullptr
 };
 const char* const EventsSourceSpawner::SAVED_EVENTS_PROGRAM = "drbd-events-log-supplier";
+const char* const EventsSourceSpawner::SAVED_EVENTS_SEEK_ARG = "--seek";
+const char* const EventsSourceSpawner::SAVED_EVENTS_SPEED_ARG = "--speed";
 
 EventsSourceSpawner::EventsSourceSpawner(MessageLog& logRef):
     log(logRef)
@@ -74,7 +76,11 @@ int EventsSourceSpawner::get_events_err_fd()
 }
 
 // @throws std::bad_alloc, EventSourceException
-void EventsSourceSpawner::spawn_source(const std::string* const save_file_path_ptr)
+void EventsSourceSpawner::spawn_source(
+    const std::string* const save_file_path_ptr,
+    const std::string* const seek_time_ptr,
+    const std::string* const replay_speed_ptr
+)
 {
     // Initialize the pipes
     posix::Pipe out_pipe_mgr(&out_pipe_fd);
@@ -101,10 +107,21 @@ void EventsSourceSpawner::spawn_source(const std::string* const save_file_path_p
     else
     {
         provider_pgm = SAVED_EVENTS_PROGRAM;
-        const char* args[3];
-        args[0] = SAVED_EVENTS_PROGRAM;
-        args[1] = save_file_path_ptr->c_str();
-        args[2] = nullptr;
+        const char* args[7];
+        size_t arg_idx = 0;
+        args[arg_idx++] = SAVED_EVENTS_PROGRAM;
+        if (seek_time_ptr != nullptr && !seek_time_ptr->empty())
+        {
+            args[arg_idx++] = SAVED_EVENTS_SEEK_ARG;
+            args[arg_idx++] = seek_time_ptr->c_str();
+        }
+        if (replay_speed_ptr != nullptr && !replay_speed_ptr->empty())
+        {
+            args[arg_idx++] = SAVED_EVENTS_SPEED_ARG;
+            args[arg_idx++] = replay_speed_ptr->c_str();
+        }
+        args[arg_idx++] = save_file_path_ptr->c_str();
+        args[arg_idx] = nullptr;
         spawn_args = std::unique_ptr<posix::SpawnArgs>(new posix::SpawnArgs(args));
     }
 
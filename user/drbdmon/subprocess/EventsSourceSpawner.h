@@ -20,6 +20,8 @@ class EventsSourceSpawner
     static const char* const EVENTS_PROGRAM;
     static const char* const EVENTS_PROGRAM_ARGS[];
     static const char* const SAVED_EVENTS_PROGRAM;
+    static const char* const SAVED_EVENTS_SEEK_ARG;
+    static const char* const SAVED_EVENTS_SPEED_ARG;
 
     EventsSourceSpawner(MessageLog& logRef);
     virtual ~EventsSourceSpawner();
@@ -33,8 +35,14 @@ class EventsSourceSpawner
     virtual int get_events_out_fd();
     virtual int get_events_err_fd();
 
+    // Spawns drbdsetup, or the events log supplier if a save file path is specified
+    // The seek time and the replay speed are passed to the events log supplier if they are not empty.
     // @throws std::bad_alloc, EventSourceException
-    virtual void spawn_source(const std::string* const save_file_path_ptr);
+    virtual void spawn_source(
+        const std::string* const save_file_path_ptr,
+        const std::string* const seek_time_ptr,
+        const std::string* const replay_speed_ptr
+    );
 
     // @throws EventsSourceException
     virtual void cleanup_child_processes();
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <stdexcept>
 #include <subprocess/Linux/SubProcessLx.h>
+#include <subprocess/Linux/SubProcessReactorLx.h>
 
 extern "C"
 {
@@ -11,40 +12,28 @@ extern "C"
     #include <signal.h>
     #include <fcntl.h>
     #include <sys/wait.h>
-    #include <sys/epoll.h>
+    #include <sys/syscall.h>
     #include <errno.h>
 }
 
 extern char** environ;
 
-const size_t    SubProcessLx::OBSERVED_EVENTS_COUNT     = 3;
-const size_t    SubProcessLx::FIRED_EVENTS_COUNT        = 3;
-
-// Buffer capacity increment steps. Increment steps must be larger than the buffer size for efficient operation.
-// 16 kiB, 64 kiB
-const size_t    SubProcessLx::BUFFER_CAP[]              = {1UL << 14, 1UL << 16};
-const size_t    SubProcessLx::BUFFER_CAP_SIZE           = sizeof (SubProcessLx::BUFFER_CAP) / sizeof (size_t);
-
 SubProcessLx::SubProcessLx():
     SubProcess::SubProcess()
 {
-    subproc_stdout_pipe[PIPE_READ]  = -1;
-    subproc_stdout_pipe[PIPE_WRITE] = -1;
-    subproc_stderr_pipe[PIPE_READ]  = -1;
-    subproc_stderr_pipe[PIPE_WRITE] = -1;
-    wakeup_pipe[PIPE_READ]          = -1;
-    wakeup_pipe[PIPE_WRITE]         = -1;
+    for (size_t idx = 0; idx < CHANNEL_COUNT; ++idx)
+    {
+        channels[idx].owner = this;
+        channels[idx].fd    = -1;
+    }
 }
 
 SubProcessLx::~SubProcessLx() noexcept
 {
-    close_fd(poll_fd);
-    close_fd(subproc_stdout_pipe[PIPE_READ]);
-    close_fd(subproc_stdout_pipe[PIPE_WRITE]);
-    close_fd(subproc_stderr_pipe[PIPE_READ]);
-    close_fd(subproc_stderr_pipe[PIPE_WRITE]);
-    close_fd(wakeup_pipe[PIPE_READ]);
-    close_fd(wakeup_pipe[PIPE_WRITE]);
+    for (size_t idx = 0; idx < CHANNEL_COUNT; ++idx)
+    {
+        close_fd(channels[idx].fd);
+    }
 }
 
 uint64_t SubProcessLx::get_pid() const noexcept
@@ -55,8 +44,43 @@ uint64_t SubProcessLx::get_pid() const noexcept
     return generic_pid;
 }
 
-// @throws SubProcess::Exception
+// @throws SubProcess::Exception, std::bad_alloc
 void SubProcessLx::execute(const CmdLine& cmd)
+{
+    SubProcessReactorLx reactor;
+    reactor.start_process(*this, cmd);
+
+    SubProcess* exited_proc = nullptr;
+    while (exited_proc == nullptr)
+    {
+        exited_proc = reactor.wait_events();
+    }
+}
+
+void SubProcessLx::terminate(const bool force)
+{
+    const int signal_nr = force ? SIGKILL : SIGTERM;
+
+    // The process file descriptor is closed and the process ID is invalidated by the reactor
+    // while holding the proc_lock, after the process has been reaped
+    proc_lock.lock();
+    enable_spawn = false;
+    bool signaled = false;
+    #if defined(SYS_pidfd_send_signal)
+    if (channels[CHANNEL_PROCESS].fd != -1)
+    {
+        signaled = syscall(SYS_pidfd_send_signal, channels[CHANNEL_PROCESS].fd, signal_nr, nullptr, 0) == 0;
+    }
+    #endif
+    if (!signaled && subproc_id != -1 && exit_status.load() == SubProcess::EXIT_STATUS_NONE)
+    {
+        kill(subproc_id, signal_nr);
+    }
+    proc_lock.unlock();
+}
+
+// @throws SubProcess::Exception, std::bad_alloc
+void SubProcessLx::spawn(const CmdLine& cmd)
 {
     std::unique_ptr<SubProcessLx::SysExecArgs> sys_cmd_line(new SubProcessLx::SysExecArgs(cmd));
 
@@ -66,27 +90,26 @@ void SubProcessLx::execute(const CmdLine& cmd)
     posix_spawn_file_actions_t* const file_actions = file_actions_mgr.get();
     posix_spawnattr_t* const spawn_attr = spawn_attr_mgr.get();
 
+    int subproc_stdout_pipe[2] = {-1, -1};
+    int subproc_stderr_pipe[2] = {-1, -1};
+
     std::exception_ptr stored_exc;
 
     bool have_file_actions = false;
     bool have_spawn_attr = false;
     try
     {
+        // Close-on-exec prevents the pipes from leaking into other external processes
         throw_if_nonzero(
-            pipe(subproc_stdout_pipe),
+            pipe2(subproc_stdout_pipe, O_CLOEXEC),
             "Creation of the stdout pipe failed"
         );
 
         throw_if_nonzero(
-            pipe(subproc_stderr_pipe),
+            pipe2(subproc_stderr_pipe, O_CLOEXEC),
             "Creation of the stderr pipe failed"
         );
 
-        throw_if_nonzero(
-            pipe(wakeup_pipe),
-            "Creation of the wakeup pipe failed"
-        );
-
         {
             const int read_io_flags = fcntl(subproc_stdout_pipe[PIPE_READ], F_GETFL, 0);
             fcntl(subproc_stdout_pipe[PIPE_READ], F_SETFL, read_io_flags | O_NONBLOCK);
@@ -95,12 +118,6 @@ void SubProcessLx::execute(const CmdLine& cmd)
             const int read_io_flags = fcntl(subproc_stderr_pipe[PIPE_READ], F_GETFL, 0);
             fcntl(subproc_stderr_pipe[PIPE_READ], F_SETFL, read_io_flags | O_NONBLOCK);
         }
-        {
-            const int read_io_flags = fcntl(wakeup_pipe[PIPE_READ], F_GETFL, 0);
-            fcntl(wakeup_pipe[PIPE_READ], F_SETFL, read_io_flags | O_NONBLOCK);
-            const int write_io_flags = fcntl(wakeup_pipe[PIPE_WRITE], F_GETFL, 0);
-            fcntl(wakeup_pipe[PIPE_WRITE], F_SETFL, write_io_flags | O_NONBLOCK);
-        }
 
         throw_if_nonzero(
             posix_spawn_file_actions_init(file_actions),
@@ -114,6 +131,20 @@ void SubProcessLx::execute(const CmdLine& cmd)
         );
         have_spawn_attr = true;
 
+        // The calling thread blocks all signals, do not pass its signal mask on to the external process
+        {
+            sigset_t subproc_mask;
+            sigemptyset(&subproc_mask);
+            throw_if_nonzero(
+                posix_spawnattr_setsigmask(spawn_attr, &subproc_mask),
+                "Setting the signal mask of the external process failed"
+            );
+            throw_if_nonzero(
+                posix_spawnattr_setflags(spawn_attr, POSIX_SPAWN_SETSIGMASK),
+                "Setting the spawn_attr flags failed"
+            );
+        }
+
         throw_if_nonzero(
             posix_spawn_file_actions_adddup2(
                 file_actions,
@@ -130,34 +161,6 @@ void SubProcessLx::execute(const CmdLine& cmd)
             ),
             "Connecting the stderr pipe failed"
         );
-        throw_if_nonzero(
-            posix_spawn_file_actions_addclose(
-                file_actions,
-                subproc_stdout_pipe[PIPE_READ]
-            ),
-            "Closing the stdout pipe read end failed"
-        );
-        throw_if_nonzero(
-            posix_spawn_file_actions_addclose(
-                file_actions,
-                subproc_stderr_pipe[PIPE_READ]
-            ),
-            "Closing the stderr pipe read end failed"
-        );
-        throw_if_nonzero(
-            posix_spawn_file_actions_addclose(
-                file_actions,
-                wakeup_pipe[PIPE_READ]
-            ),
-            "Closing the wakeup pipe read end failed"
-        );
-        throw_if_nonzero(
-            posix_spawn_file_actions_addclose(
-                file_actions,
-                wakeup_pipe[PIPE_WRITE]
-            ),
-            "Closing the wakeup pipe write end failed"
-        );
 
         char** exec_args = sys_cmd_line->get_exec_args();
         int spawn_rc = 1;
@@ -165,48 +168,39 @@ void SubProcessLx::execute(const CmdLine& cmd)
         if (enable_spawn)
         {
             spawn_rc = posix_spawn(&subproc_id, exec_args[0], file_actions, spawn_attr, exec_args, environ);
-        }
-        proc_lock.unlock();
-        if (spawn_rc == 0)
-        {
-            close_fd(subproc_stdout_pipe[PIPE_WRITE]);
-            close_fd(subproc_stderr_pipe[PIPE_WRITE]);
-
-            read_subproc_output();
-
-            int local_exit_status = -1;
-            int wait_result = -1;
-            do
+            if (spawn_rc == 0)
             {
-                errno = 0;
-                wait_result = waitpid(subproc_id, &local_exit_status, 0);
-                if (wait_result > 0)
+                // If process file descriptors are not supported, the reactor waits for
+                // the end of the process' output instead
+                #if defined(SYS_pidfd_open)
+                const long pid_fd = syscall(SYS_pidfd_open, subproc_id, 0);
+                if (pid_fd >= 0)
                 {
-                    const int subproc_exit_status = WEXITSTATUS(local_exit_status);
-                    exit_status.store(subproc_exit_status);
+                    channels[CHANNEL_PROCESS].fd = static_cast<int> (pid_fd);
+                    fcntl(channels[CHANNEL_PROCESS].fd, F_SETFD, FD_CLOEXEC);
                 }
+                #endif
             }
-            while ((wait_result == -1 && errno == EINTR) ||
-                   (wait_result >= 0 && WIFEXITED(local_exit_status) == 0 && WIFSIGNALED(local_exit_status) == 0));
-            // The Linux docs say these macros "return true" if their defined condition is met,
-            // but that seems to be inaccurate.
-            // The Open Group Base Specification (IEEE Std 1003.1-2017) says they "return non-zero".
-            if (wait_result <= 0)
-            {
-                exit_status.store(EXIT_STATUS_FAILED);
-            }
-
-            close_fd(subproc_stdout_pipe[PIPE_READ]);
-            close_fd(subproc_stderr_pipe[PIPE_READ]);
-            close_fd(wakeup_pipe[PIPE_READ]);
-            close_fd(wakeup_pipe[PIPE_WRITE]);
         }
+        proc_lock.unlock();
+        throw_if_nonzero(spawn_rc, "Spawning the external process failed");
+
+        channels[CHANNEL_STDOUT].fd = subproc_stdout_pipe[PIPE_READ];
+        channels[CHANNEL_STDERR].fd = subproc_stderr_pipe[PIPE_READ];
+        subproc_stdout_pipe[PIPE_READ] = -1;
+        subproc_stderr_pipe[PIPE_READ] = -1;
     }
     catch (std::exception& exc)
     {
         stored_exc = std::current_exception();
+        exit_status.store(EXIT_STATUS_FAILED);
     }
 
+    close_fd(subproc_stdout_pipe[PIPE_READ]);
+    close_fd(subproc_stdout_pipe[PIPE_WRITE]);
+    close_fd(subproc_stderr_pipe[PIPE_READ]);
+    close_fd(subproc_stderr_pipe[PIPE_WRITE]);
+
     if (have_file_actions)
     {
         posix_spawn_file_actions_destroy(file_actions);
@@ -222,187 +216,65 @@ void SubProcessLx::execute(const CmdLine& cmd)
     }
 }
 
-void SubProcessLx::terminate(const bool force)
+bool SubProcessLx::reap(const bool blocking) noexcept
 {
-    // Load/store of exit status and process ID races with the thread that executes the external process.
-    const int local_exit_status = exit_status.load();
-    proc_lock.lock();
-    const pid_t local_pid = subproc_id;
-    enable_spawn = false;
-    proc_lock.unlock();
-
-    if (local_pid != -1 && local_exit_status == SubProcess::EXIT_STATUS_NONE)
+    int local_exit_status = -1;
+    int wait_result = -1;
+    do
     {
-        kill(local_pid, (force ? SIGKILL : SIGTERM));
-        const char wakeup_char = 0;
-        ssize_t write_count = 0;
-        do
-        {
-            errno = 0;
-            write_count = write(wakeup_pipe[PIPE_WRITE], &wakeup_char, 1);
-        }
-        while (write_count == -1 && errno == EINTR);
+        errno = 0;
+        wait_result = waitpid(subproc_id, &local_exit_status, blocking ? 0 : WNOHANG);
     }
-}
-
-// @throws std::bad_alloc
-void SubProcessLx::read_subproc_output()
-{
-    std::unique_ptr<char[]> read_buffer(new char[READ_BUFFER_SIZE]);
-
-    std::unique_ptr<struct epoll_event[]>   observed_events(new struct epoll_event[OBSERVED_EVENTS_COUNT]);
-    std::unique_ptr<struct epoll_event[]>   fired_events(new struct epoll_event[FIRED_EVENTS_COUNT]);
-
-    struct epoll_event* const observed_events_ptr   = observed_events.get();
-    struct epoll_event* const fired_events_ptr      = fired_events.get();
-
-    char* const     read_buffer_ptr     = read_buffer.get();
-
-    poll_fd = epoll_create1(EPOLL_CLOEXEC);
-    if (poll_fd == -1)
+    while ((wait_result == -1 && errno == EINTR) ||
+           (blocking && wait_result > 0 &&
+            WIFEXITED(local_exit_status) == 0 && WIFSIGNALED(local_exit_status) == 0));
+    // The Linux docs say these macros "return true" if their defined condition is met,
+    // but that seems to be inaccurate.
+    // The Open Group Base Specification (IEEE Std 1003.1-2017) says they "return non-zero".
+
+    bool exited = true;
+    if (wait_result > 0 && WIFEXITED(local_exit_status) != 0)
     {
-        throw SubProcessLx::Exception("I/O channel polling initialization failed");
+        exit_status.store(WEXITSTATUS(local_exit_status));
     }
-
-    try
+    else
+    if (wait_result > 0 && WIFSIGNALED(local_exit_status) != 0)
     {
-        observed_events_ptr[0].data.fd = subproc_stdout_pipe[PIPE_READ];
-        observed_events_ptr[0].events = EPOLLIN;
-        throw_if_nonzero(
-            epoll_ctl(poll_fd, EPOLL_CTL_ADD, subproc_stdout_pipe[PIPE_READ], &(observed_events_ptr[0])),
-            "I/O event setup for the stdout pipe failed"
-        );
-        observed_events_ptr[1].data.fd = subproc_stderr_pipe[PIPE_READ];
-        observed_events_ptr[1].events = EPOLLIN;
-        throw_if_nonzero(
-            epoll_ctl(poll_fd, EPOLL_CTL_ADD, subproc_stderr_pipe[PIPE_READ], &(observed_events_ptr[1])),
-            "I/O event setup for the stderr pipe failed"
-        );
-        observed_events_ptr[2].data.fd = wakeup_pipe[PIPE_READ];
-        observed_events_ptr[2].events = EPOLLIN;
-        throw_if_nonzero(
-            epoll_ctl(poll_fd, EPOLL_CTL_ADD, wakeup_pipe[PIPE_READ], &(observed_events_ptr[2])),
-            "I/O event setup for the wakeup pipe failed"
-        );
+        // Same convention as used by shells
+        exit_status.store(128 + WTERMSIG(local_exit_status));
     }
-    catch (SubProcessLx::Exception&)
+    else
+    if (wait_result == 0 || wait_result > 0)
     {
-        close_fd(poll_fd);
-        throw;
+        // Not exited yet, or only stopped or continued
+        exited = false;
     }
-
-    bool poll_fds = false;
-    int event_count = 0;
-    int epoll_errno = 0;
-    do
+    else
     {
-        const bool have_stdout = subproc_stdout_pipe[PIPE_READ] != -1;
-        const bool have_stderr = subproc_stderr_pipe[PIPE_READ] != -1;
-        poll_fds = have_stdout || have_stderr;
-
-        epoll_errno = 0;
-        if (poll_fds)
-        {
-            errno = 0;
-            event_count = epoll_wait(poll_fd, fired_events_ptr, FIRED_EVENTS_COUNT, -1);
-            epoll_errno = errno;
-            if (event_count > -1)
-            {
-                for (size_t idx = 0; idx < static_cast<size_t> (event_count); ++idx)
-                {
-                    if (fired_events_ptr[idx].data.fd == subproc_stdout_pipe[PIPE_READ])
-                    {
-                        if ((fired_events_ptr[idx].events & (EPOLLERR | EPOLLHUP)) == 0)
-                        {
-                            read_subproc_fd(subproc_stdout_pipe[PIPE_READ], read_buffer_ptr,
-                                            subproc_out, out_buffer_cap_idx, SUBPROC_OUT_MAX_SIZE);
-                        }
-                        else
-                        {
-                            epoll_ctl(poll_fd, EPOLL_CTL_DEL, subproc_stdout_pipe[PIPE_READ], nullptr);
-                            close_fd(subproc_stdout_pipe[PIPE_READ]);
-                        }
-                    }
-                    else
-                    if (fired_events_ptr[idx].data.fd == subproc_stderr_pipe[PIPE_READ])
-                    {
-                        if ((fired_events_ptr[idx].events & (EPOLLERR | EPOLLHUP)) == 0)
-                        {
-                            read_subproc_fd(subproc_stderr_pipe[PIPE_READ], read_buffer_ptr,
-                                            subproc_err, err_buffer_cap_idx, SUBPROC_ERR_MAX_SIZE);
-                        }
-                        else
-                        {
-                            epoll_ctl(poll_fd, EPOLL_CTL_DEL, subproc_stderr_pipe[PIPE_READ], nullptr);
-                            close_fd(subproc_stderr_pipe[PIPE_READ]);
-                        }
-                    }
-                    else
-                    if (fired_events_ptr[idx].data.fd == wakeup_pipe[PIPE_READ])
-                    {
-                        if ((fired_events_ptr[idx].events & (EPOLLERR | EPOLLHUP)) == 0)
-                        {
-                            ssize_t read_count = 0;
-                            do
-                            {
-                                errno = 0;
-                                read_count = read(wakeup_pipe[PIPE_READ], read_buffer_ptr, READ_BUFFER_SIZE);
-                            }
-                            while (read_count >= 1 || (read_count == -1 && errno == EINTR));
-                        }
-
-                        epoll_ctl(poll_fd, EPOLL_CTL_DEL, wakeup_pipe[PIPE_READ], nullptr);
-                        poll_fds = false;
-                    }
-                }
-            }
-        }
+        exit_status.store(EXIT_STATUS_FAILED);
     }
-    while (poll_fds && (event_count != -1 || epoll_errno == EINTR));
 
-    close_fd(poll_fd);
+    if (exited)
+    {
+        proc_lock.lock();
+        close_fd(channels[CHANNEL_PROCESS].fd);
+        subproc_id = -1;
+        proc_lock.unlock();
+    }
+    return exited;
 }
 
-// @throws std::bad_alloc
-void SubProcessLx::read_subproc_fd(
-    int&            subproc_fd,
-    char* const     read_buffer_ptr,
-    std::string&    dst_buffer,
-    size_t&         dst_buffer_cap_idx,
-    const size_t    max_size
-)
+void SubProcessLx::close_channel(const size_t channel_idx) noexcept
 {
-    errno = 0;
-    const ssize_t read_count = read(subproc_fd, read_buffer_ptr, READ_BUFFER_SIZE);
-    if (read_count >= 1)
+    if (channel_idx == CHANNEL_PROCESS)
     {
-        const size_t current_length = dst_buffer.length();
-        if (current_length < max_size)
-        {
-            const size_t copy_length = std::min(
-                static_cast<ssize_t> (max_size - current_length), read_count
-            );
-            const size_t result_length = current_length + copy_length;
-            if (result_length > dst_buffer.capacity())
-            {
-                if (dst_buffer_cap_idx < BUFFER_CAP_SIZE)
-                {
-                    dst_buffer.reserve(std::min(BUFFER_CAP[dst_buffer_cap_idx], max_size));
-                    ++dst_buffer_cap_idx;
-                }
-                else
-                {
-                    dst_buffer.reserve(max_size);
-                }
-            }
-            dst_buffer.append(read_buffer_ptr, copy_length);
-        }
+        proc_lock.lock();
+        close_fd(channels[channel_idx].fd);
+        proc_lock.unlock();
     }
     else
-    if (read_count == 0 || errno != EINTR)
     {
-        epoll_ctl(poll_fd, EPOLL_CTL_DEL, subproc_fd, nullptr);
-        close_fd(subproc_fd);
+        close_fd(channels[channel_idx].fd);
     }
 }
 
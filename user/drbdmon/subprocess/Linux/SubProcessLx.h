@@ -7,7 +7,6 @@
 #include <mutex>
 #include <atomic>
 #include <stdexcept>
-#include <thread>
 #include <VList.h>
 #include <subprocess/CmdLine.h>
 #include <subprocess/SubProcess.h>
@@ -17,53 +16,63 @@ extern "C"
     #include <unistd.h>
 }
 
+class SubProcessReactorLx;
+
 class SubProcessLx : public SubProcess
 {
-  public:
-    static const size_t     OBSERVED_EVENTS_COUNT;
-    static const size_t     FIRED_EVENTS_COUNT;
-
-    static const size_t     BUFFER_CAP[];
-    static const size_t     BUFFER_CAP_SIZE;
+    friend class SubProcessReactorLx;
 
+  public:
     SubProcessLx();
     virtual ~SubProcessLx() noexcept;
 
     // @throws SubProcess::Exception
     virtual uint64_t get_pid() const noexcept override;
+    // Executes the external process and waits until it exits
+    // @throws SubProcess::Exception, std::bad_alloc
     virtual void execute(const CmdLine& cmd) override;
     virtual void terminate(const bool force) override;
 
   private:
-    mutable std::mutex  proc_lock;
+    // I/O channels of the external process that are monitored by the reactor
+    static constexpr size_t CHANNEL_STDOUT  = 0;
+    static constexpr size_t CHANNEL_STDERR  = 1;
+    // Process file descriptor, becomes readable when the process exits
+    static constexpr size_t CHANNEL_PROCESS = 2;
+    static constexpr size_t CHANNEL_COUNT   = 3;
 
     static constexpr size_t PIPE_READ   = 0;
     static constexpr size_t PIPE_WRITE  = 1;
 
+    typedef struct io_channel_s
+    {
+        SubProcessLx*   owner;
+        int             fd;
+    }
+    io_channel;
+
+    mutable std::mutex  proc_lock;
+
     bool    enable_spawn    {true};
     pid_t   subproc_id      {-1};
 
-    int poll_fd = -1;
+    io_channel  channels[CHANNEL_COUNT];
 
-    size_t  out_buffer_cap_idx  = 0;
-    size_t  err_buffer_cap_idx  = 0;
-
-    int subproc_stdout_pipe[2];
-    int subproc_stderr_pipe[2];
-    int wakeup_pipe[2];
+    // Next entry in the reactor's list of processes that have exited
+    SubProcessLx*   next_exited {nullptr};
 
+    // Starts the external process without waiting for it to exit
     // @throws SubProcess::Exception, std::bad_alloc
-    void read_subproc_output();
-    // @throws std::bad_alloc
-    void read_subproc_fd(
-        int&            subproc_fd,
-        char* const     read_buffer_ptr,
-        std::string&    dst_buffer,
-        size_t&         dst_buffer_cap_idx,
-        const size_t    max_size
-    );
-    void throw_if_nonzero(const int rc, const char* const error_msg);
-    void close_fd(int& fd) noexcept;
+    void spawn(const CmdLine& cmd);
+    // Waits for the exit of the external process and saves its exit status
+    // @param blocking If false, returns immediately if the process has not exited yet
+    // @return True if the process has exited, false otherwise
+    bool reap(const bool blocking) noexcept;
+    void close_channel(const size_t channel_idx) noexcept;
+
+    // @throws SubProcess::Exception
+    static void throw_if_nonzero(const int rc, const char* const error_msg);
+    static void close_fd(int& fd) noexcept;
 
     class SysExecArgs
     {
@@ -0,0 +1,260 @@
+#include <subprocess/Linux/SubProcessReactorLx.h>
+
+extern "C"
+{
+    #include <unistd.h>
+    #include <signal.h>
+    #include <sys/eventfd.h>
+    #include <errno.h>
+}
+
+const size_t    SubProcessReactorLx::FIRED_EVENTS_COUNT     = 16;
+
+// @throws SubProcess::Exception, std::bad_alloc
+SubProcessReactorLx::SubProcessReactorLx()
+{
+    fired_events = std::unique_ptr<struct epoll_event[]>(new struct epoll_event[FIRED_EVENTS_COUNT]);
+    read_buffer = std::unique_ptr<char[]>(new char[SubProcess::READ_BUFFER_SIZE]);
+
+    poll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (poll_fd == -1)
+    {
+        throw SubProcess::Exception("I/O channel polling initialization failed");
+    }
+
+    wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeup_fd == -1)
+    {
+        SubProcessLx::close_fd(poll_fd);
+        throw SubProcess::Exception("Creation of the wakeup event failed");
+    }
+
+    // The wakeup event is identified by a nullptr instead of an I/O channel
+    struct epoll_event wakeup_event;
+    wakeup_event.data.ptr = nullptr;
+    wakeup_event.events = EPOLLIN;
+    if (epoll_ctl(poll_fd, EPOLL_CTL_ADD, wakeup_fd, &wakeup_event) != 0)
+    {
+        SubProcessLx::close_fd(wakeup_fd);
+        SubProcessLx::close_fd(poll_fd);
+        throw SubProcess::Exception("I/O event setup for the wakeup event failed");
+    }
+}
+
+SubProcessReactorLx::~SubProcessReactorLx() noexcept
+{
+    SubProcessLx::close_fd(wakeup_fd);
+    SubProcessLx::close_fd(poll_fd);
+}
+
+// @throws SubProcess::Exception, std::bad_alloc
+void SubProcessReactorLx::start_process(SubProcess& proc, const CmdLine& cmd)
+{
+    SubProcessLx* const proc_lx = dynamic_cast<SubProcessLx*> (&proc);
+    if (proc_lx == nullptr)
+    {
+        throw SubProcess::Exception("Process type not supported by the reactor");
+    }
+
+    proc_lx->spawn(cmd);
+
+    bool registered = true;
+    for (size_t idx = 0; idx < SubProcessLx::CHANNEL_COUNT && registered; ++idx)
+    {
+        SubProcessLx::io_channel& channel = proc_lx->channels[idx];
+        if (channel.fd != -1)
+        {
+            struct epoll_event channel_event;
+            channel_event.data.ptr = &channel;
+            channel_event.events = EPOLLIN;
+            registered = epoll_ctl(poll_fd, EPOLL_CTL_ADD, channel.fd, &channel_event) == 0;
+        }
+    }
+
+    if (!registered)
+    {
+        // The process cannot be monitored, stop it again
+        proc_lx->terminate(true);
+        for (size_t idx = 0; idx < SubProcessLx::CHANNEL_COUNT; ++idx)
+        {
+            remove_channel(*proc_lx, idx);
+        }
+        proc_lx->reap(true);
+        throw SubProcess::Exception("I/O event setup for the external process failed");
+    }
+}
+
+// @throws SubProcess::Exception, std::bad_alloc
+SubProcess* SubProcessReactorLx::wait_events()
+{
+    if (exited_head == nullptr)
+    {
+        int event_count = -1;
+        do
+        {
+            errno = 0;
+            event_count = epoll_wait(poll_fd, fired_events.get(), FIRED_EVENTS_COUNT, -1);
+        }
+        while (event_count == -1 && errno == EINTR);
+
+        if (event_count == -1)
+        {
+            throw SubProcess::Exception("I/O event polling failed");
+        }
+
+        for (size_t idx = 0; idx < static_cast<size_t> (event_count); ++idx)
+        {
+            handle_event(fired_events[idx]);
+        }
+    }
+
+    SubProcessLx* const exited_proc = exited_head;
+    if (exited_proc != nullptr)
+    {
+        exited_head = exited_proc->next_exited;
+        if (exited_head == nullptr)
+        {
+            exited_tail = nullptr;
+        }
+        exited_proc->next_exited = nullptr;
+    }
+    return exited_proc;
+}
+
+void SubProcessReactorLx::wakeup() noexcept
+{
+    const uint64_t wakeup_value = 1;
+    ssize_t write_count = 0;
+    do
+    {
+        errno = 0;
+        write_count = write(wakeup_fd, &wakeup_value, sizeof (wakeup_value));
+    }
+    while (write_count == -1 && errno == EINTR);
+}
+
+// @throws std::bad_alloc
+void SubProcessReactorLx::handle_event(const struct epoll_event& event)
+{
+    SubProcessLx::io_channel* const channel = static_cast<SubProcessLx::io_channel*> (event.data.ptr);
+    if (channel == nullptr)
+    {
+        clear_wakeup();
+    }
+    else
+    if (channel->fd != -1)
+    {
+        // Events of I/O channels that were released by an earlier event of the same batch are skipped
+        SubProcessLx& proc = *(channel->owner);
+        const size_t channel_idx = static_cast<size_t> (channel - proc.channels);
+        if (channel_idx == SubProcessLx::CHANNEL_PROCESS)
+        {
+            if (proc.reap(false))
+            {
+                process_exited(proc);
+            }
+        }
+        else
+        if (!read_channel(proc, channel_idx, false))
+        {
+            remove_channel(proc, channel_idx);
+
+            // Without a process file descriptor, the end of the process' output
+            // is taken as an indication for the exit of the process
+            const bool have_channels = proc.channels[SubProcessLx::CHANNEL_STDOUT].fd != -1 ||
+                proc.channels[SubProcessLx::CHANNEL_STDERR].fd != -1 ||
+                proc.channels[SubProcessLx::CHANNEL_PROCESS].fd != -1;
+            if (!have_channels)
+            {
+                proc.reap(true);
+                process_exited(proc);
+            }
+        }
+    }
+}
+
+// @throws std::bad_alloc
+bool SubProcessReactorLx::read_channel(SubProcessLx& proc, const size_t channel_idx, const bool drain)
+{
+    const int channel_fd = proc.channels[channel_idx].fd;
+    OutputRingBuffer& dst_buffer = channel_idx == SubProcessLx::CHANNEL_STDOUT ?
+        proc.subproc_out : proc.subproc_err;
+    char* const read_buffer_ptr = read_buffer.get();
+
+    bool is_open = true;
+    bool have_data = true;
+    while (is_open && have_data)
+    {
+        errno = 0;
+        const ssize_t read_count = read(channel_fd, read_buffer_ptr, SubProcess::READ_BUFFER_SIZE);
+        if (read_count >= 1)
+        {
+            dst_buffer.append(read_buffer_ptr, static_cast<size_t> (read_count));
+            // Read only once per event unless the remaining output is being collected,
+            // so that a single process cannot delay the I/O of other processes
+            have_data = drain;
+        }
+        else
+        if (read_count == 0 || (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK))
+        {
+            is_open = false;
+        }
+        else
+        if (errno != EINTR)
+        {
+            have_data = false;
+        }
+    }
+    return is_open;
+}
+
+// @throws std::bad_alloc
+void SubProcessReactorLx::process_exited(SubProcessLx& proc)
+{
+    // Data written by the process before it exited may still be buffered in the pipes. Data written
+    // afterwards by other processes that share the pipes, e.g. child processes, is not waited for.
+    for (size_t idx = SubProcessLx::CHANNEL_STDOUT; idx <= SubProcessLx::CHANNEL_STDERR; ++idx)
+    {
+        if (proc.channels[idx].fd != -1)
+        {
+            static_cast<void> (read_channel(proc, idx, true));
+        }
+    }
+    for (size_t idx = 0; idx < SubProcessLx::CHANNEL_COUNT; ++idx)
+    {
+        remove_channel(proc, idx);
+    }
+
+    proc.next_exited = nullptr;
+    if (exited_tail == nullptr)
+    {
+        exited_head = &proc;
+    }
+    else
+    {
+        exited_tail->next_exited = &proc;
+    }
+    exited_tail = &proc;
+}
+
+void SubProcessReactorLx::remove_channel(SubProcessLx& proc, const size_t channel_idx) noexcept
+{
+    const int channel_fd = proc.channels[channel_idx].fd;
+    if (channel_fd != -1)
+    {
+        epoll_ctl(poll_fd, EPOLL_CTL_DEL, channel_fd, nullptr);
+        proc.close_channel(channel_idx);
+    }
+}
+
+void SubProcessReactorLx::clear_wakeup() noexcept
+{
+    uint64_t wakeup_value = 0;
+    ssize_t read_count = 0;
+    do
+    {
+        errno = 0;
+        read_count = read(wakeup_fd, &wakeup_value, sizeof (wakeup_value));
+    }
+    while (read_count == -1 && errno == EINTR);
+}
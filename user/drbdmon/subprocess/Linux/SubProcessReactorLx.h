@@ -0,0 +1,62 @@
+#ifndef SUBPROCESSREACTORLX_H
+#define SUBPROCESSREACTORLX_H
+
+#include <default_types.h>
+#include <new>
+#include <memory>
+#include <subprocess/SubProcessReactor.h>
+#include <subprocess/Linux/SubProcessLx.h>
+
+extern "C"
+{
+    #include <sys/epoll.h>
+}
+
+// Monitors the stdout and stderr pipes and the process file descriptors of all
+// external processes in a single epoll instance
+class SubProcessReactorLx : public SubProcessReactor
+{
+  public:
+    static const size_t FIRED_EVENTS_COUNT;
+
+    // @throws SubProcess::Exception, std::bad_alloc
+    SubProcessReactorLx();
+    virtual ~SubProcessReactorLx() noexcept;
+
+    SubProcessReactorLx(const SubProcessReactorLx& orig) = delete;
+    SubProcessReactorLx& operator=(const SubProcessReactorLx& orig) = delete;
+    SubProcessReactorLx(SubProcessReactorLx&& orig) = delete;
+    SubProcessReactorLx& operator=(SubProcessReactorLx&& orig) = delete;
+
+    // @throws SubProcess::Exception, std::bad_alloc
+    virtual void start_process(SubProcess& proc, const CmdLine& cmd) override;
+    // @throws SubProcess::Exception, std::bad_alloc
+    virtual SubProcess* wait_events() override;
+    virtual void wakeup() noexcept override;
+
+  private:
+    int poll_fd     {-1};
+    int wakeup_fd   {-1};
+
+    std::unique_ptr<struct epoll_event[]>   fired_events;
+    std::unique_ptr<char[]>                 read_buffer;
+
+    // List of processes that have exited but were not reported by wait_events() yet
+    SubProcessLx*   exited_head     {nullptr};
+    SubProcessLx*   exited_tail     {nullptr};
+
+    // @throws std::bad_alloc
+    void handle_event(const struct epoll_event& event);
+    // Reads from the pipe of an I/O channel
+    // @param drain If true, reads until no more data is available, otherwise reads once
+    // @return True if the pipe is still open, false if it was closed
+    // @throws std::bad_alloc
+    bool read_channel(SubProcessLx& proc, const size_t channel_idx, const bool drain);
+    // Reads the remaining output, releases the process' I/O channels and reports the process as exited
+    // @throws std::bad_alloc
+    void process_exited(SubProcessLx& proc);
+    void remove_channel(SubProcessLx& proc, const size_t channel_idx) noexcept;
+    void clear_wakeup() noexcept;
+};
+
+#endif /* SUBPROCESSREACTORLX_H */
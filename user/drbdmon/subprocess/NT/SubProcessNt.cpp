@@ -5,11 +5,6 @@ std::atomic<uint64_t>   SubProcessNt::instance_id(0);
 const DWORD     SubProcessNt::OUT_BUFFER_SIZE   = 0;
 const DWORD     SubProcessNt::IN_BUFFER_SIZE    = 8192;
 
-// Buffer capacity increment steps. Increment steps must be larger than the buffer size for efficient operation.
-// 16 kiB, 64 kiB
-const size_t    SubProcessNt::BUFFER_CAP[]      = {1UL << 14, 1UL << 16};
-const size_t    SubProcessNt::BUFFER_CAP_SIZE   = sizeof (SubProcessNt::BUFFER_CAP) / sizeof (size_t);
-
 SubProcessNt::SubProcessNt():
     SubProcess::SubProcess()
 {
@@ -255,9 +250,7 @@ void SubProcessNt::read_subproc_output()
                     events_read_buffer_ptr,
                     op_io_state,
                     &subproc_out,
-                    out_buffer_cap_idx,
-                    bytes_read,
-                    SUBPROC_OUT_MAX_SIZE
+                    bytes_read
                 );
             }
             else
@@ -268,9 +261,7 @@ void SubProcessNt::read_subproc_output()
                     errors_read_buffer_ptr,
                     op_io_state,
                     &subproc_err,
-                    err_buffer_cap_idx,
-                    bytes_read,
-                    SUBPROC_ERR_MAX_SIZE
+                    bytes_read
                 );
             }
         }
@@ -324,37 +315,14 @@ void SubProcessNt::submit_read_op(
 }
 
 void SubProcessNt::read_completion_handler(
-    HANDLE*         op_handle_ptr,
-    char*           op_read_buffer,
-    OVERLAPPED*     op_io_state,
-    std::string*    op_data,
-    size_t&         dst_buffer_cap_idx,
-    DWORD           bytes_read,
-    const size_t    max_length
+    HANDLE*             op_handle_ptr,
+    char*               op_read_buffer,
+    OVERLAPPED*         op_io_state,
+    OutputRingBuffer*   op_data,
+    DWORD               bytes_read
 )
 {
-    const size_t current_length = op_data->length();
-    if (current_length < max_length)
-    {
-        const size_t copy_length = std::min(
-            static_cast<size_t> (max_length - current_length),
-            static_cast<size_t> (bytes_read)
-        );
-        const size_t result_length = current_length + copy_length;
-        if (result_length > op_data->capacity())
-        {
-            if (dst_buffer_cap_idx < BUFFER_CAP_SIZE)
-            {
-                op_data->reserve(std::min(BUFFER_CAP[dst_buffer_cap_idx], max_length));
-                ++dst_buffer_cap_idx;
-            }
-            else
-            {
-                op_data->reserve(max_length);
-            }
-        }
-        op_data->append(op_read_buffer, copy_length);
-    }
+    op_data->append(op_read_buffer, static_cast<size_t> (bytes_read));
     submit_read_op(op_handle_ptr, op_io_state, op_read_buffer);
 }
 
@@ -26,9 +26,6 @@ class SubProcessNt : public SubProcess
     static const DWORD  OUT_BUFFER_SIZE;
     static const DWORD  IN_BUFFER_SIZE;
 
-    static const size_t BUFFER_CAP[];
-    static const size_t BUFFER_CAP_SIZE;
-
     SubProcessNt();
     virtual ~SubProcessNt() noexcept;
 
@@ -55,9 +52,6 @@ class SubProcessNt : public SubProcess
     ULONG_PTR events_key    {1};
     ULONG_PTR errors_key    {2};
 
-    size_t  out_buffer_cap_idx  = 0;
-    size_t  err_buffer_cap_idx  = 0;
-
     HANDLE create_pipe(const std::string& pipe_name);
     HANDLE create_pipe_writer(const std::string& pipe_name);
     HANDLE spawn_process(const CmdLine& cmd, HANDLE events_writer, HANDLE errors_writer);
@@ -68,13 +62,11 @@ class SubProcessNt : public SubProcess
         char* const     op_read_buffer
     );
     void read_completion_handler(
-        HANDLE*         op_handle_ptr,
-        char*           op_read_buffer,
-        OVERLAPPED*     op_io_state,
-        std::string*    op_data,
-        size_t&         dst_buffer_cap_idx,
-        DWORD           bytes_read,
-        const size_t    max_length
+        HANDLE*             op_handle_ptr,
+        char*               op_read_buffer,
+        OVERLAPPED*         op_io_state,
+        OutputRingBuffer*   op_data,
+        DWORD               bytes_read
     );
     void await_subproc_exit();
 
@@ -0,0 +1,121 @@
+#include <subprocess/OutputRingBuffer.h>
+#include <cstring>
+#include <algorithm>
+
+// 16 kiB, 64 kiB
+const size_t OutputRingBuffer::CAPACITY_STEPS[]     = {1UL << 14, 1UL << 16};
+const size_t OutputRingBuffer::CAPACITY_STEPS_COUNT = sizeof (CAPACITY_STEPS) / sizeof (CAPACITY_STEPS[0]);
+
+OutputRingBuffer::OutputRingBuffer(const size_t max_capacity_ref):
+    max_capacity(max_capacity_ref)
+{
+}
+
+OutputRingBuffer::~OutputRingBuffer() noexcept
+{
+}
+
+// @throws std::bad_alloc
+void OutputRingBuffer::append(const char* data, size_t data_length)
+{
+    if (data_length > max_capacity)
+    {
+        // Only the most recent max_capacity bytes of the data are kept
+        const size_t skip_length = data_length - max_capacity;
+        discarded += skip_length + length;
+        start_idx = 0;
+        length = 0;
+        data += skip_length;
+        data_length = max_capacity;
+    }
+
+    if (length + data_length > capacity && capacity < max_capacity)
+    {
+        grow(length + data_length);
+    }
+
+    if (data_length > 0)
+    {
+        // Discard the oldest data if there is not enough free space
+        const size_t free_length = capacity - length;
+        if (data_length > free_length)
+        {
+            const size_t discard_length = data_length - free_length;
+            start_idx = (start_idx + discard_length) % capacity;
+            length -= discard_length;
+            discarded += discard_length;
+        }
+
+        const size_t write_idx = (start_idx + length) % capacity;
+        const size_t first_length = std::min(data_length, capacity - write_idx);
+        std::memcpy(&(buffer[write_idx]), data, first_length);
+        if (first_length < data_length)
+        {
+            std::memcpy(&(buffer[0]), &(data[first_length]), data_length - first_length);
+        }
+        length += data_length;
+    }
+}
+
+size_t OutputRingBuffer::get_length() const noexcept
+{
+    return length;
+}
+
+uint64_t OutputRingBuffer::get_discarded_length() const noexcept
+{
+    return discarded;
+}
+
+// @throws std::bad_alloc
+void OutputRingBuffer::copy_to(std::string& dst_text) const
+{
+    dst_text.clear();
+    if (length > 0)
+    {
+        dst_text.reserve(length);
+        const size_t first_length = std::min(length, capacity - start_idx);
+        dst_text.append(&(buffer[start_idx]), first_length);
+        if (first_length < length)
+        {
+            dst_text.append(&(buffer[0]), length - first_length);
+        }
+    }
+}
+
+void OutputRingBuffer::clear() noexcept
+{
+    start_idx = 0;
+    length = 0;
+    discarded = 0;
+}
+
+// @throws std::bad_alloc
+void OutputRingBuffer::grow(const size_t min_capacity)
+{
+    size_t new_capacity = max_capacity;
+    while (capacity_idx < CAPACITY_STEPS_COUNT && new_capacity == max_capacity)
+    {
+        const size_t step_capacity = CAPACITY_STEPS[capacity_idx];
+        if (step_capacity >= min_capacity && step_capacity < max_capacity)
+        {
+            new_capacity = step_capacity;
+        }
+        ++capacity_idx;
+    }
+
+    // Copy the current content to the start of the new buffer
+    std::unique_ptr<char[]> new_buffer(new char[new_capacity]);
+    if (length > 0)
+    {
+        const size_t first_length = std::min(length, capacity - start_idx);
+        std::memcpy(&(new_buffer[0]), &(buffer[start_idx]), first_length);
+        if (first_length < length)
+        {
+            std::memcpy(&(new_buffer[first_length]), &(buffer[0]), length - first_length);
+        }
+    }
+    buffer = std::move(new_buffer);
+    capacity = new_capacity;
+    start_idx = 0;
+}
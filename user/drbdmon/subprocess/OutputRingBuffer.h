@@ -0,0 +1,61 @@
+#ifndef OUTPUTRINGBUFFER_H
+#define OUTPUTRINGBUFFER_H
+
+#include <default_types.h>
+#include <new>
+#include <memory>
+#include <string>
+
+// Bounded buffer for the output of an external process
+//
+// If more data is appended than the buffer can hold, the oldest data is discarded, so that
+// the buffer always contains the most recent output.
+// The buffer's memory is allocated in increasing steps up to the maximum capacity, so that
+// processes that produce only little output do not allocate the maximum capacity.
+class OutputRingBuffer
+{
+  public:
+    // Capacity increment steps
+    static const size_t CAPACITY_STEPS[];
+    static const size_t CAPACITY_STEPS_COUNT;
+
+    explicit OutputRingBuffer(size_t max_capacity_ref);
+    virtual ~OutputRingBuffer() noexcept;
+
+    OutputRingBuffer(const OutputRingBuffer& orig) = delete;
+    OutputRingBuffer& operator=(const OutputRingBuffer& orig) = delete;
+    OutputRingBuffer(OutputRingBuffer&& orig) = delete;
+    OutputRingBuffer& operator=(OutputRingBuffer&& orig) = delete;
+
+    // Appends data to the buffer, discarding the oldest data if the buffer's capacity is exceeded
+    // @throws std::bad_alloc
+    virtual void append(const char* data, size_t length);
+
+    // @return Number of bytes currently contained in the buffer
+    virtual size_t get_length() const noexcept;
+
+    // @return Number of bytes that were discarded to make room for more recent data
+    virtual uint64_t get_discarded_length() const noexcept;
+
+    // Replaces the content of dst_text with the content of the buffer
+    // @throws std::bad_alloc
+    virtual void copy_to(std::string& dst_text) const;
+
+    virtual void clear() noexcept;
+
+  private:
+    const size_t            max_capacity;
+
+    std::unique_ptr<char[]> buffer;
+    size_t                  capacity        {0};
+    size_t                  capacity_idx    {0};
+    // Index of the oldest byte in the buffer
+    size_t                  start_idx       {0};
+    size_t                  length          {0};
+    uint64_t                discarded       {0};
+
+    // @throws std::bad_alloc
+    void grow(size_t min_capacity);
+};
+
+#endif /* OUTPUTRINGBUFFER_H */
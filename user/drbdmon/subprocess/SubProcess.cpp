@@ -9,7 +9,9 @@ const int       SubProcess::EXIT_STATUS_NONE        = -1;
 const int       SubProcess::EXIT_STATUS_FAILED      = -2;
 
 SubProcess::SubProcess():
-    exit_status(EXIT_STATUS_NONE)
+    exit_status(EXIT_STATUS_NONE),
+    subproc_out(SUBPROC_OUT_MAX_SIZE),
+    subproc_err(SUBPROC_ERR_MAX_SIZE)
 {
 }
 
@@ -22,12 +24,12 @@ int SubProcess::get_exit_status() const
     return exit_status.load();
 }
 
-const std::string& SubProcess::get_stdout_output() const noexcept
+const OutputRingBuffer& SubProcess::get_stdout_output() const noexcept
 {
     return subproc_out;
 }
 
-const std::string& SubProcess::get_stderr_output() const noexcept
+const OutputRingBuffer& SubProcess::get_stderr_output() const noexcept
 {
     return subproc_err;
 }
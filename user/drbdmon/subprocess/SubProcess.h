@@ -7,6 +7,7 @@
 #include <atomic>
 #include <stdexcept>
 #include <subprocess/CmdLine.h>
+#include <subprocess/OutputRingBuffer.h>
 
 class SubProcess
 {
@@ -23,8 +24,10 @@ class SubProcess
     virtual ~SubProcess() noexcept;
 
     virtual int get_exit_status() const;
-    virtual const std::string& get_stdout_output() const noexcept;
-    virtual const std::string& get_stderr_output() const noexcept;
+    // The output buffers contain the most recent output of the external process, up to
+    // SUBPROC_OUT_MAX_SIZE / SUBPROC_ERR_MAX_SIZE bytes
+    virtual const OutputRingBuffer& get_stdout_output() const noexcept;
+    virtual const OutputRingBuffer& get_stderr_output() const noexcept;
 
     // @throws SubProcess::Exception
     virtual uint64_t get_pid() const noexcept = 0;
@@ -49,8 +52,8 @@ class SubProcess
   protected:
     std::atomic<int> exit_status;
 
-    std::string subproc_out;
-    std::string subproc_err;
+    OutputRingBuffer subproc_out;
+    OutputRingBuffer subproc_err;
 };
 
 #endif /* SUBPROCESS_H */
@@ -1,4 +1,5 @@
 #include <comparators.h>
+#include <bounds.h>
 #include <subprocess/SubProcessQueue.h>
 
 extern "C"
@@ -8,12 +9,22 @@ extern "C"
 
 const uint64_t  SubProcessQueue::TASKQ_NONE         = UINT64_MAX;
 const size_t    SubProcessQueue::MAX_ENTRY_COUNT    = 1024;
-const size_t    SubProcessQueue::MAX_ACTIVE_COUNT   = 8;
+const size_t    SubProcessQueue::MAX_ACTIVE_COUNT   = 64;
+const size_t    SubProcessQueue::DFLT_ACTIVE_COUNT  = 8;
 
 SubProcessQueue::SubProcessQueue()
 {
     sys_api = system_api::create_system_api();
     map = std::unique_ptr<EntryMapType>(new EntryMapType(&comparators::compare<uint64_t>));
+    try
+    {
+        reactor = sys_api->create_subprocess_reactor();
+    }
+    catch (SubProcess::Exception&)
+    {
+        // Fall back to executing sub-processes on worker threads
+        reactor = nullptr;
+    }
     worker_thread_mgr = std::unique_ptr<std::thread[]>(new std::thread[MAX_ACTIVE_COUNT]);
     worker_slot_mgr = std::unique_ptr<size_t[]>(new size_t[MAX_ACTIVE_COUNT]);
     for (size_t idx = 0; idx < MAX_ACTIVE_COUNT; ++idx)
@@ -39,6 +50,17 @@ SubProcessQueue::~SubProcessQueue() noexcept
                 task_entry->process_mgr->terminate(true);
             }
         }
+
+        if (reactor != nullptr)
+        {
+            reactor->wakeup();
+        }
+    }
+
+    // The reactor thread exits after all active sub-processes have exited
+    if (reactor_thread.joinable())
+    {
+        reactor_thread.join();
     }
 
     for (size_t slot_idx = 0; slot_idx < MAX_ACTIVE_COUNT; ++slot_idx)
@@ -227,6 +249,21 @@ void SubProcessQueue::set_discard_succeeded_tasks(const bool discard_flag)
     discard_succeeded_tasks = discard_flag;
 }
 
+void SubProcessQueue::set_max_active_count(const size_t count)
+{
+    std::unique_lock<std::mutex> lock(queue_lock);
+
+    max_active = bounds<size_t>(1, count, MAX_ACTIVE_COUNT);
+    schedule_threads();
+}
+
+size_t SubProcessQueue::get_max_active_count()
+{
+    std::unique_lock<std::mutex> lock(queue_lock);
+
+    return max_active;
+}
+
 uint64_t SubProcessQueue::get_active_queue_selected_id()
 {
     return active_queue.selected_id;
@@ -328,12 +365,56 @@ bool SubProcessQueue::move_entry(Entry* const queue_entry, Queue& dst_queue)
     return outcome;
 }
 
+// Caller must hold queue_lock
+void SubProcessQueue::end_entry(Entry* const queue_entry)
+{
+    move_entry(queue_entry, ended_queue);
+
+    bool discard_flag = false;
+    if (queue_entry->process_mgr)
+    {
+        discard_flag = discard_finished_tasks;
+        if (!discard_finished_tasks && discard_succeeded_tasks)
+        {
+            const int exit_status = queue_entry->process_mgr->get_exit_status();
+            discard_flag = exit_status == 0;
+        }
+    }
+
+    if (discard_flag)
+    {
+        remove_entry_impl(queue_entry);
+    }
+
+    if (observer != nullptr)
+    {
+        observer->notify_queue_changed();
+    }
+}
+
 // Caller must hold queue_lock
 void SubProcessQueue::schedule_threads()
 {
+    if (!shutdown && reactor != nullptr && !reactor_failed)
+    {
+        if (ready_queue.head != nullptr && active_queue.size < max_active)
+        {
+            if (!reactor_thread.joinable())
+            {
+                sys_api->pre_thread_invocation();
+                reactor_thread = std::thread(&SubProcessQueue::run_reactor, this);
+                sys_api->post_thread_invocation();
+            }
+            else
+            {
+                reactor->wakeup();
+            }
+        }
+    }
+    else
     if (!shutdown)
     {
-        const size_t queue_count = std::min(ready_queue.size + active_queue.size, MAX_ACTIVE_COUNT);
+        const size_t queue_count = std::min(ready_queue.size + active_queue.size, max_active);
         while (queue_count > active_count)
         {
             const size_t slot_idx = worker_slot_mgr[active_count];
@@ -358,7 +439,7 @@ void SubProcessQueue::invoke_thread(const size_t slot_idx)
     try
     {
         WorkerGuard guard(*this, slot_idx);
-        while (!shutdown && ready_queue.head != nullptr)
+        while (!shutdown && ready_queue.head != nullptr && active_queue.size < max_active)
         {
             Entry* const selected_entry = ready_queue.head;
             move_entry(selected_entry, active_queue);
@@ -399,42 +480,113 @@ void SubProcessQueue::invoke_thread(const size_t slot_idx)
                 lock.lock();
             }
 
-            move_entry(selected_entry, ended_queue);
+            end_entry(selected_entry);
 
-            bool discard_flag = false;
-            if (selected_entry->process_mgr)
+            if (stored_exc != nullptr)
             {
-                discard_flag = discard_finished_tasks;
-                if (!discard_finished_tasks && discard_succeeded_tasks)
-                {
-                    const int exit_status = selected_entry->process_mgr->get_exit_status();
-                    discard_flag = exit_status == 0;
-                }
+                std::rethrow_exception(stored_exc);
             }
+        }
+    }
+    catch (std::bad_alloc&)
+    {
+        if (observer != nullptr)
+        {
+            observer->notify_out_of_memory();
+        }
+    }
+}
 
-            if (discard_flag)
-            {
-                remove_entry_impl(selected_entry);
-            }
+void SubProcessQueue::run_reactor()
+{
+    std::unique_lock<std::mutex> lock(queue_lock);
+    try
+    {
+        // Continue after a shutdown until all active sub-processes have been terminated
+        while (!shutdown || active_queue.size > 0)
+        {
+            start_reactor_tasks();
 
-            if (observer != nullptr)
-            {
-                observer->notify_queue_changed();
-            }
+            lock.unlock();
+            SubProcess* const exited_proc = reactor->wait_events();
+            lock.lock();
 
-            if (stored_exc != nullptr)
+            if (exited_proc != nullptr)
             {
-                std::rethrow_exception(stored_exc);
+                Entry* task_entry = active_queue.head;
+                while (task_entry != nullptr && task_entry->process_mgr.get() != exited_proc)
+                {
+                    task_entry = task_entry->next_entry;
+                }
+                if (task_entry != nullptr)
+                {
+                    end_entry(task_entry);
+                }
             }
         }
     }
     catch (std::bad_alloc&)
     {
+        if (!lock.owns_lock())
+        {
+            lock.lock();
+        }
+        reactor_failure();
         if (observer != nullptr)
         {
             observer->notify_out_of_memory();
         }
     }
+    catch (SubProcess::Exception&)
+    {
+        if (!lock.owns_lock())
+        {
+            lock.lock();
+        }
+        reactor_failure();
+        schedule_threads();
+    }
+}
+
+// Caller must hold queue_lock
+// @throws std::bad_alloc
+void SubProcessQueue::start_reactor_tasks()
+{
+    while (!shutdown && ready_queue.head != nullptr && active_queue.size < max_active)
+    {
+        Entry* const selected_entry = ready_queue.head;
+        move_entry(selected_entry, active_queue);
+
+        selected_entry->process_mgr = sys_api->create_subprocess_handler();
+        try
+        {
+            reactor->start_process(*(selected_entry->process_mgr), *(selected_entry->command_mgr));
+            if (observer != nullptr)
+            {
+                observer->notify_queue_changed();
+            }
+        }
+        catch (SubProcess::Exception&)
+        {
+            end_entry(selected_entry);
+        }
+    }
+}
+
+// Caller must hold queue_lock
+void SubProcessQueue::reactor_failure()
+{
+    // Sub-processes that are still active cannot be monitored anymore, terminate them
+    reactor_failed = true;
+    while (active_queue.head != nullptr)
+    {
+        Entry* const task_entry = active_queue.head;
+        if (task_entry->process_mgr != nullptr)
+        {
+            task_entry->process_mgr->terminate(true);
+        }
+        end_entry(task_entry);
+    }
 }
 
 SubProcessQueue::Entry::Entry(const uint64_t entry_id)
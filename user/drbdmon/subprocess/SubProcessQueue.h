@@ -12,6 +12,7 @@
 #include <subprocess/CmdLine.h>
 #include <subprocess/SubProcessObserver.h>
 #include <subprocess/SubProcess.h>
+#include <subprocess/SubProcessReactor.h>
 #include <platform/SystemApi.h>
 
 class SubProcessQueue
@@ -25,8 +26,10 @@ class SubProcessQueue
     // Maximum aggregate number of entries
     static const size_t MAX_ENTRY_COUNT;
 
-    // Maximum number of concurrently active sub-processes
+    // Upper limit for the number of concurrently active sub-processes
     static const size_t MAX_ACTIVE_COUNT;
+    // Default number of concurrently active sub-processes
+    static const size_t DFLT_ACTIVE_COUNT;
 
     enum class entry_state_type : uint8_t
     {
@@ -101,6 +104,10 @@ class SubProcessQueue
     virtual void set_discard_finished_tasks(const bool discard_flag);
     virtual void set_discard_succeeded_tasks(const bool discard_flag);
 
+    // Sets the maximum number of concurrently active sub-processes, limited to 1 - MAX_ACTIVE_COUNT
+    virtual void set_max_active_count(const size_t count);
+    virtual size_t get_max_active_count();
+
     virtual uint64_t get_active_queue_selected_id();
     virtual uint64_t get_pending_queue_selected_id();
     virtual uint64_t get_suspended_queue_selected_id();
@@ -165,8 +172,11 @@ class SubProcessQueue
     uint64_t    next_id         {0};
 
     uint64_t    entry_count     {0};
+    // Number of worker threads
     uint64_t    active_count    {0};
 
+    size_t      max_active      {DFLT_ACTIVE_COUNT};
+
     Queue       wait_queue;
     Queue       ready_queue;
     Queue       active_queue;
@@ -179,6 +189,12 @@ class SubProcessQueue
 
     std::unique_ptr<EntryMapType>   map;
 
+    // If the platform provides a reactor, all sub-processes are executed by the reactor thread,
+    // otherwise each active sub-process is executed by a separate worker thread
+    std::unique_ptr<SubProcessReactor>  reactor;
+    std::thread                         reactor_thread;
+    bool                                reactor_failed  {false};
+
     std::unique_ptr<std::thread[]>  worker_thread_mgr;
     std::unique_ptr<size_t[]>       worker_slot_mgr;
 
@@ -186,8 +202,13 @@ class SubProcessQueue
 
     bool remove_entry_impl(Entry* const queue_entry);
     bool move_entry(Entry* const queue_entry, Queue& dst_queue);
+    void end_entry(Entry* const queue_entry);
     void schedule_threads();
     void invoke_thread(const size_t slot_idx);
+    void run_reactor();
+    // @throws std::bad_alloc
+    void start_reactor_tasks();
+    void reactor_failure();
 };
 
 #endif /* SUBPROCESSQUEUE_H */
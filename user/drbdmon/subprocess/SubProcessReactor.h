@@ -0,0 +1,35 @@
+#ifndef SUBPROCESSREACTOR_H
+#define SUBPROCESSREACTOR_H
+
+#include <default_types.h>
+#include <subprocess/CmdLine.h>
+#include <subprocess/SubProcess.h>
+
+// Executes multiple external processes concurrently on a single thread
+//
+// The reactor waits for the output and for the exit of all processes that it started,
+// and collects their output and exit status.
+// Except for wakeup(), the reactor's methods must be called by the same thread.
+class SubProcessReactor
+{
+  public:
+    virtual ~SubProcessReactor() noexcept
+    {
+    }
+
+    // Starts an external process and adds it to the processes monitored by the reactor
+    // The process object must not be destroyed before wait_events() has reported its exit.
+    // @throws SubProcess::Exception, std::bad_alloc
+    virtual void start_process(SubProcess& proc, const CmdLine& cmd) = 0;
+
+    // Waits for events of the monitored processes and handles them
+    // Returns when a process has exited, or when wakeup() was called.
+    // @return Process that has exited and is no longer monitored, or nullptr
+    // @throws SubProcess::Exception, std::bad_alloc
+    virtual SubProcess* wait_events() = 0;
+
+    // Causes a concurrent or the next call of wait_events() to return
+    virtual void wakeup() noexcept = 0;
+};
+
+#endif /* SUBPROCESSREACTOR_H */
@@ -2,6 +2,7 @@
 
 const std::string AnsiControl::ANSI_CLEAR_SCREEN    = "\x1B[f\x1B[0J\x1B[f";
 const std::string AnsiControl::ANSI_CLEAR_LINE      = "\x1B[K";
+const std::string AnsiControl::ANSI_RESET_ATTR      = "\x1B[0m";
 const std::string AnsiControl::ANSI_CURSOR_OFF      = "\x1B[?25l";
 const std::string AnsiControl::ANSI_CURSOR_ON       = "\x1B[?25h";
 const std::string AnsiControl::ANSI_ALTBFR_ON       = "\x1B[?1049h";
@@ -9,6 +9,7 @@ class AnsiControl
   public:
     static const std::string ANSI_CLEAR_SCREEN;
     static const std::string ANSI_CLEAR_LINE;
+    static const std::string ANSI_RESET_ATTR;
     static const std::string ANSI_CURSOR_OFF;
     static const std::string ANSI_CURSOR_ON;
     static const std::string ANSI_ALTBFR_ON;
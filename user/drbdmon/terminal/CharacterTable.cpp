@@ -1,5 +1,7 @@
 #include <terminal/CharacterTable.h>
 
+constexpr size_t CharacterTable::SYNC_SPARK_LEVELS;
+
 // @throws std::bad_alloc
 CharacterTable::CharacterTable()
 {
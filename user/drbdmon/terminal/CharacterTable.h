@@ -7,6 +7,8 @@
 class CharacterTable
 {
   public:
+    static constexpr size_t SYNC_SPARK_LEVELS = 8;
+
     // Marked element
     std::string sym_marked;
 
@@ -37,6 +39,8 @@ class CharacterTable
 
     std::string sync_blk_fin;
     std::string sync_blk_rmn;
+    // Sparkline symbols for resynchronization progress, from lowest to highest
+    std::string sync_spark[SYNC_SPARK_LEVELS];
 
     std::string checked_box;
     std::string unchecked_box;
@@ -45,6 +45,7 @@ void ComponentsHub::verify() const
         term_size == nullptr ||
         rsc_map == nullptr ||
         prb_rsc_map == nullptr ||
+        flt_rsc_map == nullptr ||
         log == nullptr ||
         debug_log == nullptr ||
         node_name == nullptr ||
@@ -36,6 +36,7 @@ class ComponentsHub
     TermSize*               term_size       {nullptr};
     ResourcesMap*           rsc_map         {nullptr};
     ResourcesMap*           prb_rsc_map     {nullptr};
+    ResourcesMap*           flt_rsc_map     {nullptr};
     MessageLog*             log             {nullptr};
     MessageLog*             debug_log       {nullptr};
     GlobalCommands*         global_cmd_exec {nullptr};
@@ -3,6 +3,7 @@
 
 #include <default_types.h>
 #include <terminal/ModularDisplay.h>
+#include <objects/DrbdVolume.h>
 
 class DisplayCommon
 {
@@ -40,6 +41,9 @@ class DisplayCommon
     virtual void display_connection_header(uint32_t& current_line) const = 0;
     virtual void display_resource_line(uint32_t& current_line) const = 0;
     virtual void display_connection_line(uint32_t& current_line) const = 0;
+    // Displays the recent state transitions and the resynchronization progress history of a volume
+    // Starts on current_line and leaves current_line on the last line that was written.
+    virtual void display_volume_history(const DrbdVolume& vlm, const bool is_peer_vlm, uint32_t& current_line) const = 0;
     virtual uint32_t calculate_page_count(const uint32_t lines, const uint32_t lines_per_page) const = 0;
     virtual void page_navigation_cursor() const = 0;
     virtual void display_selection_mode_label(const bool is_enabled) const = 0;
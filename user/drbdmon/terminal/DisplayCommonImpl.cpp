@@ -9,12 +9,15 @@
 #include <terminal/InputField.h>
 #include <objects/StateFlags.h>
 #include <objects/DrbdResource.h>
+#include <objects/VolumeHistory.h>
 #include <string_transformations.h>
 #include <cppdsaext/src/integerparse.h>
 #include <StringTokenizer.h>
 #include <bounds.h>
 #include <iostream>
 
+const uint16_t DisplayCommonImpl::MAX_HISTORY_TRANSITIONS = 3;
+
 DisplayCommonImpl::DisplayCommonImpl(const ComponentsHub& comp_hub):
     dsp_comp_hub(comp_hub),
     dsp_io(*(comp_hub.dsp_io))
@@ -672,6 +675,124 @@ void DisplayCommonImpl::display_selection_mode_label(const bool is_enabled) cons
     }
 }
 
+void DisplayCommonImpl::display_volume_history(
+    const DrbdVolume&   vlm,
+    const bool          is_peer_vlm,
+    uint32_t&           current_line
+) const
+{
+    const ColorTable& clr = *(dsp_comp_hub.active_color_table);
+    const VolumeHistory* const history = vlm.get_history();
+    const uint64_t now_secs = VolumeHistory::get_current_time();
+
+    dsp_io.cursor_xy(1, current_line);
+    dsp_io.write_text(clr.emphasis_text.c_str());
+    dsp_io.write_text("Last change:");
+    dsp_io.write_text(clr.rst.c_str());
+    dsp_io.cursor_xy(21, current_line);
+    const uint64_t transition_time = history != nullptr ?
+        history->get_last_transition_time() : VolumeHistory::TIME_UNKNOWN;
+    if (transition_time != VolumeHistory::TIME_UNKNOWN && transition_time <= now_secs)
+    {
+        write_duration(now_secs - transition_time);
+        dsp_io.write_text(" ago");
+    }
+    else
+    {
+        dsp_io.write_text("Unknown");
+    }
+
+    if (is_peer_vlm && history != nullptr)
+    {
+        ++current_line;
+        dsp_io.cursor_xy(1, current_line);
+        dsp_io.write_text(clr.emphasis_text.c_str());
+        dsp_io.write_text("Resync rate:");
+        dsp_io.write_text(clr.rst.c_str());
+        dsp_io.cursor_xy(21, current_line);
+        uint32_t perc_per_min = 0;
+        uint64_t eta_secs = 0;
+        if (history->estimate_sync(now_secs, perc_per_min, eta_secs))
+        {
+            dsp_io.write_fmt(
+                "%lu.%02u%% per minute, ETA ",
+                static_cast<unsigned long> (perc_per_min / (DrbdVolume::MAX_FRACT + 1)),
+                static_cast<unsigned int> (perc_per_min % (DrbdVolume::MAX_FRACT + 1))
+            );
+            write_duration(eta_secs);
+        }
+        else
+        if (DrbdVolume::is_resyncing(vlm.get_replication_state()))
+        {
+            dsp_io.write_text("Estimating");
+        }
+        else
+        {
+            dsp_io.write_text("Not resynchronizing");
+        }
+
+        // Sparkline of the resynchronization progress, oldest sample first
+        ++current_line;
+        dsp_io.cursor_xy(1, current_line);
+        dsp_io.write_text(clr.emphasis_text.c_str());
+        dsp_io.write_text("Resync history:");
+        dsp_io.write_text(clr.rst.c_str());
+        dsp_io.cursor_xy(21, current_line);
+        const uint16_t sample_count = history->get_sample_count();
+        const uint16_t spark_width = dsp_comp_hub.term_cols > 21 ?
+            static_cast<uint16_t> (dsp_comp_hub.term_cols - 21) : 0;
+        const uint16_t first_idx = sample_count > spark_width ? sample_count - spark_width : 0;
+        dsp_io.write_text(clr.norm.c_str());
+        VolumeHistory::Sample sample;
+        for (uint16_t idx = first_idx; idx < sample_count; ++idx)
+        {
+            history->get_sample(idx, sample);
+            const size_t level = static_cast<size_t> (sample.sync_perc) * (CharacterTable::SYNC_SPARK_LEVELS - 1) /
+                DrbdVolume::MAX_SYNC_PERC;
+            dsp_io.write_text(dsp_comp_hub.active_character_table->sync_spark[level].c_str());
+        }
+        dsp_io.write_text(clr.rst.c_str());
+    }
+
+    if (history != nullptr)
+    {
+        // Recent state transitions, latest transition first
+        uint16_t transition_count = 0;
+        uint16_t idx = history->get_sample_count();
+        VolumeHistory::Sample sample;
+        while (idx >= 1 && transition_count < MAX_HISTORY_TRANSITIONS)
+        {
+            --idx;
+            history->get_sample(idx, sample);
+            if (sample.transition)
+            {
+                ++current_line;
+                if (transition_count == 0)
+                {
+                    dsp_io.cursor_xy(1, current_line);
+                    dsp_io.write_text(clr.emphasis_text.c_str());
+                    dsp_io.write_text("State history:");
+                    dsp_io.write_text(clr.rst.c_str());
+                }
+                dsp_io.cursor_xy(21, current_line);
+                if (is_peer_vlm)
+                {
+                    dsp_io.write_text(DrbdVolume::repl_state_to_label(sample.repl));
+                    dsp_io.write_text(", peer disk ");
+                }
+                dsp_io.write_text(DrbdVolume::disk_state_to_label(sample.disk));
+                if (sample.time_secs != VolumeHistory::TIME_UNKNOWN && sample.time_secs <= now_secs)
+                {
+                    dsp_io.write_text(" (");
+                    write_duration(now_secs - sample.time_secs);
+                    dsp_io.write_text(" ago)");
+                }
+                ++transition_count;
+            }
+        }
+    }
+}
+
 uint32_t DisplayCommonImpl::calculate_page_count(const uint32_t lines, const uint32_t lines_per_page) const
 {
     const uint32_t result_page_count =
@@ -904,3 +1025,28 @@ void DisplayCommonImpl::hotkey_spacer() const
 {
     dsp_io.write_text("  ");
 }
+
+void DisplayCommonImpl::write_duration(const uint64_t secs) const
+{
+    if (secs >= 3600)
+    {
+        dsp_io.write_fmt(
+            "%luh %02lum",
+            static_cast<unsigned long> (secs / 3600),
+            static_cast<unsigned long> ((secs % 3600) / 60)
+        );
+    }
+    else
+    if (secs >= 60)
+    {
+        dsp_io.write_fmt(
+            "%lum %02lus",
+            static_cast<unsigned long> (secs / 60),
+            static_cast<unsigned long> (secs % 60)
+        );
+    }
+    else
+    {
+        dsp_io.write_fmt("%lus", static_cast<unsigned long> (secs));
+    }
+}
@@ -11,6 +11,9 @@
 class DisplayCommonImpl : public DisplayCommon
 {
   public:
+    // Maximum number of state transitions shown by display_volume_history()
+    static const uint16_t   MAX_HISTORY_TRANSITIONS;
+
     DisplayCommonImpl(const ComponentsHub& comp_hub);
     virtual ~DisplayCommonImpl() noexcept;
 
@@ -30,6 +33,11 @@ class DisplayCommonImpl : public DisplayCommon
     virtual void display_connection_header(uint32_t& current_line) const override;
     virtual void display_resource_line(uint32_t& current_line) const override;
     virtual void display_connection_line(uint32_t& current_line) const override;
+    virtual void display_volume_history(
+        const DrbdVolume&   vlm,
+        const bool          is_peer_vlm,
+        uint32_t&           current_line
+    ) const override;
     virtual uint32_t calculate_page_count(const uint32_t lines, const uint32_t lines_per_page) const override;
     virtual void page_navigation_cursor() const override;
     virtual void display_selection_mode_label(const bool is_enabled) const;
@@ -55,6 +63,7 @@ class DisplayCommonImpl : public DisplayCommon
 
     void write_hotkey(const ColorTable& clr, const char* const key, const char* const label) const;
     void hotkey_spacer() const;
+    void write_duration(const uint64_t secs) const;
     void command_completion(
         const std::string& command,
         const std::string& arguments,
@@ -44,7 +44,8 @@ DisplayController::DisplayController(
     MonitorEnvironment&         mon_env_ref,
     SubProcessObserver&         sub_proc_obs_ref,
     ResourcesMap&               rsc_map_ref,
-    ResourcesMap&               prb_rsc_map_ref
+    ResourcesMap&               prb_rsc_map_ref,
+    ResourcesMap&               flt_rsc_map_ref
 ):
     core_instance(core_instance_ref),
     mon_env(mon_env_ref)
@@ -74,6 +75,7 @@ DisplayController::DisplayController(
     dsp_comp_hub_mgr->term_size         = dynamic_cast<TermSize*> (term_size_mgr.get());
     dsp_comp_hub_mgr->rsc_map           = &rsc_map_ref;
     dsp_comp_hub_mgr->prb_rsc_map       = &prb_rsc_map_ref;
+    dsp_comp_hub_mgr->flt_rsc_map       = &flt_rsc_map_ref;
     dsp_comp_hub_mgr->log               = mon_env.log.get();
     dsp_comp_hub_mgr->debug_log         = mon_env.debug_log.get();
     dsp_comp_hub_mgr->node_name         = &(mon_env.node_name);
@@ -119,6 +121,7 @@ DisplayController::DisplayController(
     // Sub process queue configuration
     sub_proc_queue_mgr->set_discard_succeeded_tasks(mon_env.config->discard_succ_tasks);
     sub_proc_queue_mgr->set_discard_finished_tasks(mon_env.config->discard_fail_tasks);
+    sub_proc_queue_mgr->set_max_active_count(mon_env.config->max_active_tasks);
     dsp_shared_mgr->activate_tasks = !(mon_env.config->suspend_new_tasks);
 
     dsp_stack = std::unique_ptr<DisplayStack>(new DisplayStack(&DisplayController::compare_display_id));
@@ -362,10 +365,21 @@ void DisplayController::exit_initial_display()
 bool DisplayController::notify_drbd_changed()
 {
     bool update_flag = false;
-    if ((update_mask & update_event::UPDATE_FLAG_DRBD) == update_event::UPDATE_FLAG_DRBD)
+    // Skip the display update if none of the DRBD objects changed since the last display update
+    const uint64_t drbd_seq = core_instance.get_drbd_change_seq();
+    if ((update_mask & update_event::UPDATE_FLAG_DRBD) == update_event::UPDATE_FLAG_DRBD &&
+        drbd_seq != displayed_drbd_seq)
     {
-        display();
-        update_flag = true;
+        // Also skip the display update if none of the DRBD objects shown by the active display changed
+        if (active_display->is_drbd_content_changed(displayed_drbd_seq))
+        {
+            display();
+            update_flag = true;
+        }
+        else
+        {
+            displayed_drbd_seq = drbd_seq;
+        }
     }
     return update_flag;
 }
@@ -395,6 +409,8 @@ bool DisplayController::notify_message_log_changed()
 void DisplayController::terminal_size_changed()
 {
     terminal_size_changed_impl();
+    // The terminal may have changed the display's contents while resizing
+    dsp_io_mgr->invalidate_frame();
     display();
 }
 
@@ -426,6 +442,8 @@ void DisplayController::key_pressed(const uint32_t key)
     else
     if (key == KeyCodes::FUNC_05)
     {
+        // Redraw the entire display
+        dsp_io_mgr->invalidate_frame();
         display();
     }
     else
@@ -448,20 +466,34 @@ void DisplayController::mouse_action(MouseEvent& mouse)
 void DisplayController::display()
 {
     ComponentsHub& dsp_comp_hub = *dsp_comp_hub_mgr;
-    dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.ansi_ctl->ANSI_CURSOR_OFF.c_str());
+    displayed_drbd_seq = core_instance.get_drbd_change_seq();
     if (dsp_comp_hub.have_term_size)
     {
-        uint8_t loop_guard = 0;
-        do
+        // Render the display into a frame buffer, so that only the changes are written to the terminal
+        DisplayIo* const dsp_io = dsp_comp_hub.dsp_io;
+        dsp_io->begin_frame(dsp_comp_hub.term_cols, dsp_comp_hub.term_rows);
+        try
+        {
+            dsp_io->write_text(dsp_comp_hub.ansi_ctl->ANSI_CURSOR_OFF.c_str());
+            uint8_t loop_guard = 0;
+            do
+            {
+                refresh_display_flag = false;
+                active_display->display();
+                ++loop_guard;
+            }
+            while (refresh_display_flag && loop_guard < MAX_DSP_REFRESH_LOOPS);
+        }
+        catch (std::exception&)
         {
-            refresh_display_flag = false;
-            active_display->display();
-            ++loop_guard;
+            dsp_io->cancel_frame();
+            throw;
         }
-        while (refresh_display_flag && loop_guard < MAX_DSP_REFRESH_LOOPS);
+        dsp_io->end_frame();
     }
     else
     {
+        dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.ansi_ctl->ANSI_CURSOR_OFF.c_str());
         terminal_size_error();
     }
 }
@@ -52,7 +52,8 @@ class DisplayController : public GenericDisplay, public DisplaySelector
         MonitorEnvironment&         mon_env_ref,
         SubProcessObserver&         sub_proc_obs_ref,
         ResourcesMap&               rsc_map_ref,
-        ResourcesMap&               prb_rsc_map_ref
+        ResourcesMap&               prb_rsc_map_ref,
+        ResourcesMap&               flt_rsc_map_ref
     );
     virtual ~DisplayController() noexcept;
     DisplayController(const DisplayController& other) = delete;
@@ -107,6 +108,8 @@ class DisplayController : public GenericDisplay, public DisplaySelector
 
     ModularDisplay*         active_display  {nullptr};
     uint64_t                update_mask     {static_cast<uint64_t> (0xFFFFFFFFFFFFFFFFULL)};
+    // Change sequence number of the DRBD objects at the time of the last display update
+    uint64_t                displayed_drbd_seq  {static_cast<uint64_t> (0xFFFFFFFFFFFFFFFFULL)};
 
     DisplayId::display_page active_page = DisplayId::display_page::RSC_LIST;
     std::unique_ptr<DisplayStack> dsp_stack;
@@ -17,6 +17,11 @@ DisplayIo::DisplayIo(const int init_output_fd):
 {
     output_buffer_mgr = std::unique_ptr<char[]>(new char[OUTPUT_BUFFER_SIZE]);
     output_buffer = output_buffer_mgr.get();
+
+    front_frame_mgr = std::unique_ptr<FrameBuffer>(new FrameBuffer());
+    back_frame_mgr = std::unique_ptr<FrameBuffer>(new FrameBuffer());
+    front_frame = front_frame_mgr.get();
+    back_frame = back_frame_mgr.get();
 }
 
 DisplayIo::~DisplayIo() noexcept
@@ -29,6 +34,25 @@ void DisplayIo::cursor_xy(const uint16_t column, const uint16_t row) const
               static_cast<unsigned int> (row), static_cast<unsigned int> (column));
 }
 
+/**
+ * Writes buffered data to the current frame, or to the output_fd file descriptor if no frame is active
+ *
+ * @param buffer The buffered data to write
+ * @param length Length of the buffered data in the (possibly larger) buffer
+ */
+void DisplayIo::write_buffer(const char* const buffer, const size_t write_length) const noexcept
+{
+    if (frame_active)
+    {
+        back_frame->write(buffer, write_length);
+    }
+    else
+    {
+        write_output(buffer, write_length);
+        front_frame->write(buffer, write_length);
+    }
+}
+
 /**
  * Writes buffered data to the output_fd file descriptor
  *
@@ -38,8 +62,9 @@ void DisplayIo::cursor_xy(const uint16_t column, const uint16_t row) const
  * @param buffer The buffered data to write
  * @param length Length of the buffered data in the (possibly larger) buffer
  */
-void DisplayIo::write_buffer(const char* const buffer, const size_t write_length) const noexcept
+void DisplayIo::write_output(const char* const buffer, const size_t write_length) const noexcept
 {
+    const char* remain_buffer = buffer;
     size_t length = write_length;
     uint32_t loop_guard {0};
     ssize_t written {0};
@@ -47,9 +72,10 @@ void DisplayIo::write_buffer(const char* const buffer, const size_t write_length
     {
         // Repeat temporarily failing write() calls until the entire contents of the buffer have been written
         errno = 0;
-        written = write(output_fd, static_cast<const void*> (buffer), length);
+        written = write(output_fd, static_cast<const void*> (remain_buffer), length);
         if (written > 0)
         {
+            remain_buffer += written;
             length -= written;
         }
         else
@@ -77,42 +103,13 @@ void DisplayIo::write_buffer(const char* const buffer, const size_t write_length
 }
 
 /**
- * Writes a single character to the output_fd file descriptor
+ * Writes a single character
  *
  * @param ch The character to write
  */
 void DisplayIo::write_char(const char ch) const noexcept
 {
-    // Repeat temporarily failing write() calls until the byte has been written
-    uint32_t loop_guard {0};
-    ssize_t write_count = 0;
-    do
-    {
-        errno = 0;
-        write_count = write(output_fd, static_cast<const void*> (&ch), 1);
-        if (write_count != 1)
-        {
-            if (write_count == -1 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
-            {
-                // I/O error
-                break;
-            }
-
-            if (loop_guard < MAX_YIELD_LOOP)
-            {
-                // Attempt to yield to other processes before retrying
-                static_cast<void> (sched_yield());
-                ++loop_guard;
-            }
-            else
-            {
-                // If yielding to other processes did not lead to any progress,
-                // suspend for a while
-                static_cast<void> (nanosleep(&write_retry_delay, nullptr));
-            }
-        }
-    }
-    while (write_count != 1);
+    write_buffer(&ch, 1);
 }
 
 /**
@@ -236,3 +233,50 @@ void DisplayIo::write_fill_seq(const std::string& seq, const size_t seq_count) c
         }
     }
 }
+
+// @throws std::bad_alloc
+void DisplayIo::begin_frame(const uint16_t columns, const uint16_t rows)
+{
+    if (front_frame->get_columns() != columns || front_frame->get_rows() != rows)
+    {
+        front_frame->resize(columns, rows);
+        back_frame->resize(columns, rows);
+        frame_valid = false;
+    }
+    back_frame->copy_from(*front_frame);
+    frame_active = true;
+}
+
+// @throws std::bad_alloc
+void DisplayIo::end_frame()
+{
+    frame_active = false;
+    frame_output.clear();
+    if (!frame_valid)
+    {
+        // Clear the terminal and write the entire frame
+        front_frame->reset();
+        frame_output.append(AnsiControl::ANSI_RESET_ATTR);
+        frame_output.append(AnsiControl::ANSI_CLEAR_SCREEN);
+        frame_valid = true;
+    }
+    front_frame->render_update(*back_frame, frame_output);
+    if (!frame_output.empty())
+    {
+        write_output(frame_output.data(), frame_output.length());
+    }
+
+    FrameBuffer* const displayed_frame = back_frame;
+    back_frame = front_frame;
+    front_frame = displayed_frame;
+}
+
+void DisplayIo::cancel_frame() noexcept
+{
+    frame_active = false;
+}
+
+void DisplayIo::invalidate_frame() noexcept
+{
+    frame_valid = false;
+}
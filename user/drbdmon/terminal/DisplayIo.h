@@ -5,7 +5,15 @@
 #include <string>
 #include <cstring>
 #include <memory>
+#include <terminal/FrameBuffer.h>
 
+// Terminal output
+//
+// Output that is written between begin_frame() and end_frame() is rendered into an off-screen frame buffer.
+// end_frame() compares the frame with the previous frame and writes only the changes to the terminal,
+// using a single write operation if possible.
+// Output that is written outside of a frame is written to the terminal immediately, and is also applied
+// to the frame buffer that reflects the terminal's current state.
 class DisplayIo
 {
   public:
@@ -30,14 +38,38 @@ class DisplayIo
 
     virtual void write_buffer(const char* buffer, const size_t write_length) const noexcept;
 
+    // Starts rendering a new frame with the specified dimensions
+    // @throws std::bad_alloc
+    virtual void begin_frame(const uint16_t columns, const uint16_t rows);
+    // Writes the changes of the current frame to the terminal
+    // @throws std::bad_alloc
+    virtual void end_frame();
+    // Discards the current frame
+    virtual void cancel_frame() noexcept;
+    // Causes the next frame to be written entirely, e.g. if the terminal's contents may have been changed
+    virtual void invalidate_frame() noexcept;
+
   private:
     const int output_fd;
 
+    // Frame buffer that reflects the terminal's current state
+    std::unique_ptr<FrameBuffer> front_frame_mgr;
+    // Frame buffer for rendering the next frame
+    std::unique_ptr<FrameBuffer> back_frame_mgr;
+    FrameBuffer* front_frame;
+    FrameBuffer* back_frame;
+    bool frame_active   {false};
+    bool frame_valid    {false};
+    // Terminal output generated by end_frame()
+    std::string frame_output;
+
     char* output_buffer;
     std::unique_ptr<char[]> output_buffer_mgr;
 
     // 20 ms delay
     struct timespec write_retry_delay {0, 20000000};
+
+    void write_output(const char* buffer, const size_t write_length) const noexcept;
 };
 
 #endif /* DISPLAYIO_H */
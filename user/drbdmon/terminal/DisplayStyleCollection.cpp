@@ -44,6 +44,15 @@ DisplayStyleCollection::DisplayStyleCollection()
         tbl.sync_blk_fin    = "\xE2\x96\x88";
         tbl.sync_blk_rmn    = "\xE2\x96\x91";
 
+        tbl.sync_spark[0]   = "\xE2\x96\x81";
+        tbl.sync_spark[1]   = "\xE2\x96\x82";
+        tbl.sync_spark[2]   = "\xE2\x96\x83";
+        tbl.sync_spark[3]   = "\xE2\x96\x84";
+        tbl.sync_spark[4]   = "\xE2\x96\x85";
+        tbl.sync_spark[5]   = "\xE2\x96\x86";
+        tbl.sync_spark[6]   = "\xE2\x96\x87";
+        tbl.sync_spark[7]   = "\xE2\x96\x88";
+
         tbl.checked_box     = "\xE2\x98\x92";
         tbl.unchecked_box   = "\xE2\x98\x90";
     }
@@ -81,6 +90,15 @@ DisplayStyleCollection::DisplayStyleCollection()
         tbl.sync_blk_fin    = "#";
         tbl.sync_blk_rmn    = ".";
 
+        tbl.sync_spark[0]   = "_";
+        tbl.sync_spark[1]   = ".";
+        tbl.sync_spark[2]   = ",";
+        tbl.sync_spark[3]   = "-";
+        tbl.sync_spark[4]   = "~";
+        tbl.sync_spark[5]   = "=";
+        tbl.sync_spark[6]   = "*";
+        tbl.sync_spark[7]   = "#";
+
         tbl.checked_box     = "Y";
         tbl.unchecked_box   = "N";
     }
@@ -31,6 +31,35 @@ const std::string   DrbdCommandsImpl::KEY_CMD_RESUME_SYNC("RESUME-SYNC");
 
 const size_t        DrbdCommandsImpl::STRING_PREALLOC_LENGTH    = 450;
 
+const size_t        DrbdCommandsImpl::MAX_BATCH_TARGETS         = 64;
+// 32 kiB, far below the system's limit for the size of the command line arguments
+const size_t        DrbdCommandsImpl::MAX_BATCH_ARG_LENGTH      = 0x8000;
+
+const DrbdCommandsImpl::batch_cmd   DrbdCommandsImpl::BATCH_START =
+{
+    "Start", &drbdcmd::ARG_START, nullptr
+};
+const DrbdCommandsImpl::batch_cmd   DrbdCommandsImpl::BATCH_ADJUST =
+{
+    "Adjust", &drbdcmd::ARG_ADJUST, nullptr
+};
+const DrbdCommandsImpl::batch_cmd   DrbdCommandsImpl::BATCH_CONNECT =
+{
+    "Connect", &drbdcmd::ARG_CONNECT, nullptr
+};
+const DrbdCommandsImpl::batch_cmd   DrbdCommandsImpl::BATCH_DISCONNECT =
+{
+    "Disconnect", &drbdcmd::ARG_DISCONNECT, nullptr
+};
+const DrbdCommandsImpl::batch_cmd   DrbdCommandsImpl::BATCH_FORCE_DISCONNECT =
+{
+    "Force disconnect", &drbdcmd::ARG_DISCONNECT, &drbdcmd::ARG_FORCE
+};
+const DrbdCommandsImpl::batch_cmd   DrbdCommandsImpl::BATCH_DISCARD_CONNECT =
+{
+    "Discard data & connect", &drbdcmd::ARG_CONNECT, &drbdcmd::ARG_DISCARD
+};
+
 DrbdCommandsImpl::DrbdCommandsImpl(const ComponentsHub& comp_hub):
     dsp_comp_hub(comp_hub),
     entry_start(&DrbdCommandsImpl::KEY_CMD_START, &DrbdCommandsImpl::cmd_start),
@@ -132,7 +161,8 @@ bool DrbdCommandsImpl::complete_command(const std::string& prefix, std::string&
 bool DrbdCommandsImpl::exec_for_resources(
     const std::string&  command,
     StringTokenizer&    tokenizer,
-    exec_rsc_type       exec_func
+    exec_rsc_type       exec_func,
+    const batch_cmd*    batch
 )
 {
     bool cmd_valid = false;
@@ -163,12 +193,18 @@ bool DrbdCommandsImpl::exec_for_resources(
             cmd_valid = true;
 
             ResourcesMap& selection_map = dsp_comp_hub.dsp_shared->get_selected_resources_map();
-            ResourcesMap::KeysIterator rsc_iter(selection_map);
-
-            while (rsc_iter.has_next())
+            if (can_batch(batch))
+            {
+                exec_batch(*batch, selection_map);
+            }
+            else
             {
-                const std::string& cur_rsc_name = *(rsc_iter.next());
-                (this->*exec_func)(cur_rsc_name);
+                ResourcesMap::KeysIterator rsc_iter(selection_map);
+                while (rsc_iter.has_next())
+                {
+                    const std::string& cur_rsc_name = *(rsc_iter.next());
+                    (this->*exec_func)(cur_rsc_name);
+                }
             }
         }
         else
@@ -185,7 +221,8 @@ bool DrbdCommandsImpl::exec_for_resources(
 bool DrbdCommandsImpl::exec_for_connections(
     const std::string&  command,
     StringTokenizer&    tokenizer,
-    exec_con_type       exec_func
+    exec_con_type       exec_func,
+    const batch_cmd*    batch
 )
 {
     bool cmd_valid = false;
@@ -220,13 +257,20 @@ bool DrbdCommandsImpl::exec_for_connections(
             cmd_valid = true;
 
             ResourcesMap& selection_map = dsp_comp_hub.dsp_shared->get_selected_resources_map();
-            ResourcesMap::KeysIterator rsc_iter(selection_map);
-
-            std::string empty_con_name;
-            while (rsc_iter.has_next())
+            if (can_batch(batch))
+            {
+                exec_batch(*batch, selection_map);
+            }
+            else
             {
-                std::string& cur_rsc_name = *(rsc_iter.next());
-                (this->*exec_func)(cur_rsc_name, empty_con_name);
+                ResourcesMap::KeysIterator rsc_iter(selection_map);
+
+                std::string empty_con_name;
+                while (rsc_iter.has_next())
+                {
+                    std::string& cur_rsc_name = *(rsc_iter.next());
+                    (this->*exec_func)(cur_rsc_name, empty_con_name);
+                }
             }
         }
         else
@@ -423,52 +467,55 @@ bool DrbdCommandsImpl::exec_for_peer_volumes(
 
 bool DrbdCommandsImpl::cmd_start(const std::string& command, StringTokenizer& tokenizer)
 {
-    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_start);
+    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_start, &BATCH_START);
 }
 
 bool DrbdCommandsImpl::cmd_stop(const std::string& command, StringTokenizer& tokenizer)
 {
-    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_stop);
+    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_stop, nullptr);
 }
 
 bool DrbdCommandsImpl::cmd_adjust(const std::string& command, StringTokenizer& tokenizer)
 {
-    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_adjust);
+    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_adjust, &BATCH_ADJUST);
 }
 
 bool DrbdCommandsImpl::cmd_primary(const std::string& command, StringTokenizer& tokenizer)
 {
-    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_primary);
+    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_primary, nullptr);
 }
 
 bool DrbdCommandsImpl::cmd_force_primary(const std::string& command, StringTokenizer& tokenizer)
 {
-    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_force_primary);
+    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_force_primary, nullptr);
 }
 
 bool DrbdCommandsImpl::cmd_secondary(const std::string& command, StringTokenizer& tokenizer)
 {
-    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_secondary);
+    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_secondary, nullptr);
 }
 
 bool DrbdCommandsImpl::cmd_force_secondary(const std::string& command, StringTokenizer& tokenizer)
 {
-    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_force_secondary);
+    return exec_for_resources(command, tokenizer, &DrbdCommandsImpl::exec_force_secondary, nullptr);
 }
 
 bool DrbdCommandsImpl::cmd_connect(const std::string& command, StringTokenizer& tokenizer)
 {
-    return exec_for_connections(command, tokenizer, &DrbdCommandsImpl::exec_connect);
+    return exec_for_connections(command, tokenizer, &DrbdCommandsImpl::exec_connect, &BATCH_CONNECT);
 }
 
 bool DrbdCommandsImpl::cmd_disconnect(const std::string& command, StringTokenizer& tokenizer)
 {
-    return exec_for_connections(command, tokenizer, &DrbdCommandsImpl::exec_disconnect);
+    return exec_for_connections(command, tokenizer, &DrbdCommandsImpl::exec_disconnect, &BATCH_DISCONNECT);
 }
 
 bool DrbdCommandsImpl::cmd_force_disconnect(const std::string& command, StringTokenizer& tokenizer)
 {
-    return exec_for_connections(command, tokenizer, &DrbdCommandsImpl::exec_force_disconnect);
+    return exec_for_connections(
+        command, tokenizer,
+        &DrbdCommandsImpl::exec_force_disconnect, &BATCH_FORCE_DISCONNECT
+    );
 }
 
 bool DrbdCommandsImpl::cmd_attach(const std::string& command, StringTokenizer& tokenizer)
@@ -483,7 +530,10 @@ bool DrbdCommandsImpl::cmd_detach(const std::string& command, StringTokenizer& t
 
 bool DrbdCommandsImpl::cmd_discard_connect(const std::string& command, StringTokenizer& tokenizer)
 {
-    return exec_for_connections(command, tokenizer, &DrbdCommandsImpl::exec_discard_connect);
+    return exec_for_connections(
+        command, tokenizer,
+        &DrbdCommandsImpl::exec_discard_connect, &BATCH_DISCARD_CONNECT
+    );
 }
 
 bool DrbdCommandsImpl::cmd_verify(const std::string& command, StringTokenizer& tokenizer)
@@ -1066,6 +1116,62 @@ void DrbdCommandsImpl::exec_resume_sync(
     queue_command(command);
 }
 
+void DrbdCommandsImpl::exec_batch(const batch_cmd& batch, ResourcesMap& selection_map)
+{
+    ResourcesMap::KeysIterator rsc_iter(selection_map);
+    while (rsc_iter.has_next())
+    {
+        std::unique_ptr<CmdLine> command(new CmdLine());
+        command->add_argument(drbdcmd::DRBDADM_CMD);
+        command->add_argument(*(batch.cmd_arg));
+        if (batch.option_arg != nullptr)
+        {
+            command->add_argument(*(batch.option_arg));
+        }
+
+        std::string rsc_list;
+        rsc_list.reserve(STRING_PREALLOC_LENGTH);
+
+        // Each chunk is closed as soon as it has reached one of the limits
+        size_t target_count = 0;
+        size_t arg_length = 0;
+        while (rsc_iter.has_next() && target_count < MAX_BATCH_TARGETS && arg_length < MAX_BATCH_ARG_LENGTH)
+        {
+            const std::string& cur_rsc_name = *(rsc_iter.next());
+            command->add_argument(cur_rsc_name);
+            command->add_target(cur_rsc_name);
+
+            if (target_count > 0)
+            {
+                rsc_list.append(", ");
+            }
+            rsc_list.append(cur_rsc_name);
+
+            ++target_count;
+            arg_length += cur_rsc_name.length() + 1;
+        }
+
+        std::string description;
+        description.reserve(STRING_PREALLOC_LENGTH);
+
+        description.append(batch.action);
+        if (target_count == 1)
+        {
+            description.append(" resource ");
+        }
+        else
+        {
+            description.append(" ");
+            description.append(std::to_string(static_cast<unsigned long long> (target_count)));
+            description.append(" resources: ");
+        }
+        description.append(rsc_list);
+        command->set_description(description);
+
+        queue_command(command);
+    }
+}
+
 void DrbdCommandsImpl::get_resource_name(const std::string& argument, std::string& rsc_name)
 {
     rsc_name.clear();
@@ -1189,6 +1295,11 @@ bool DrbdCommandsImpl::can_run_peer_volume_cmd()
             active_page == DisplayId::display_page::PEER_VLM_ACTIONS);
 }
 
+bool DrbdCommandsImpl::can_batch(const batch_cmd* const batch)
+{
+    return batch != nullptr && dsp_comp_hub.config != nullptr && dsp_comp_hub.config->batch_commands;
+}
+
 void DrbdCommandsImpl::queue_command(std::unique_ptr<CmdLine>& command)
 {
     dsp_comp_hub.sub_proc_queue->add_entry(command, dsp_comp_hub.dsp_shared->activate_tasks);
@@ -38,6 +38,11 @@ class DrbdCommandsImpl : public DrbdCommands, public CommandsBase<DrbdCommandsIm
 
     static const size_t         STRING_PREALLOC_LENGTH;
 
+    // Limits for the number of resources and the combined length of the resource names
+    // in a single batched command
+    static const size_t         MAX_BATCH_TARGETS;
+    static const size_t         MAX_BATCH_ARG_LENGTH;
+
     DrbdCommandsImpl(const ComponentsHub& comp_hub);
     virtual ~DrbdCommandsImpl() noexcept;
 
@@ -54,6 +59,22 @@ class DrbdCommandsImpl : public DrbdCommands, public CommandsBase<DrbdCommandsIm
         const uint16_t      vlm_nr
     );
 
+    // drbdadm command that can operate on multiple resources in a single invocation
+    typedef struct batch_cmd_s
+    {
+        const char*         action;
+        const std::string*  cmd_arg;
+        const std::string*  option_arg;
+    }
+    batch_cmd;
+
+    static const batch_cmd  BATCH_START;
+    static const batch_cmd  BATCH_ADJUST;
+    static const batch_cmd  BATCH_CONNECT;
+    static const batch_cmd  BATCH_DISCONNECT;
+    static const batch_cmd  BATCH_FORCE_DISCONNECT;
+    static const batch_cmd  BATCH_DISCARD_CONNECT;
+
     const ComponentsHub& dsp_comp_hub;
 
     Entry entry_start;
@@ -100,8 +121,18 @@ class DrbdCommandsImpl : public DrbdCommands, public CommandsBase<DrbdCommandsIm
     bool cmd_pause_sync(const std::string& command, StringTokenizer& tokenizer);
     bool cmd_resume_sync(const std::string& command, StringTokenizer& tokenizer);
 
-    bool exec_for_resources(const std::string& command, StringTokenizer& tokenizer, exec_rsc_type exec_func);
-    bool exec_for_connections(const std::string& command, StringTokenizer& tokenizer, exec_con_type exec_func);
+    bool exec_for_resources(
+        const std::string&  command,
+        StringTokenizer&    tokenizer,
+        exec_rsc_type       exec_func,
+        const batch_cmd*    batch
+    );
+    bool exec_for_connections(
+        const std::string&  command,
+        StringTokenizer&    tokenizer,
+        exec_con_type       exec_func,
+        const batch_cmd*    batch
+    );
     bool exec_for_volumes(const std::string& command, StringTokenizer& tokenizer, exec_vlm_type exec_func);
     bool exec_for_peer_volumes(const std::string& command, StringTokenizer& tokenizer, exec_peer_vlm_type exec_func);
 
@@ -128,6 +159,9 @@ class DrbdCommandsImpl : public DrbdCommands, public CommandsBase<DrbdCommandsIm
     void exec_pause_sync(const std::string& rsc_name, const std::string& con_name, const uint16_t vlm_nr);
     void exec_resume_sync(const std::string& rsc_name, const std::string& con_name, const uint16_t vlm_nr);
 
+    // Executes a command for all selected resources, using as few drbdadm invocations as possible
+    void exec_batch(const batch_cmd& batch, ResourcesMap& selection_map);
+
     void get_resource_name(const std::string& argument, std::string& rsc_name);
     void get_connection_name(const std::string& argument, std::string& con_name);
     void get_volume_number(const std::string& argument, uint16_t& vlm_nr);
@@ -136,6 +170,7 @@ class DrbdCommandsImpl : public DrbdCommands, public CommandsBase<DrbdCommandsIm
     bool can_run_connection_cmd();
     bool can_run_volume_cmd();
     bool can_run_peer_volume_cmd();
+    bool can_batch(const batch_cmd* const batch);
 
     void queue_command(std::unique_ptr<CmdLine>& command);
 };
@@ -0,0 +1,865 @@
+#include <terminal/FrameBuffer.h>
+#include <terminal/AnsiControl.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+const uint32_t FrameBuffer::CLR_DEFAULT     = 0;
+const uint32_t FrameBuffer::CLR_BASIC       = 0x01000000UL;
+const uint32_t FrameBuffer::CLR_PALETTE     = 0x02000000UL;
+const uint32_t FrameBuffer::CLR_RGB         = 0x03000000UL;
+const uint32_t FrameBuffer::CLR_TYPE_MASK   = 0xFF000000UL;
+const uint32_t FrameBuffer::CLR_VALUE_MASK  = 0x00FFFFFFUL;
+
+const uint8_t FrameBuffer::ATTR_SGR_CODES[] = {1, 2, 3, 4, 5, 7, 8, 9};
+const size_t FrameBuffer::ATTR_COUNT        = sizeof (ATTR_SGR_CODES) / sizeof (ATTR_SGR_CODES[0]);
+
+const size_t FrameBuffer::MAX_SEQ_PARAMS    = 16;
+const size_t FrameBuffer::MAX_GAP_CELLS     = 6;
+
+FrameBuffer::FrameBuffer()
+{
+}
+
+FrameBuffer::~FrameBuffer() noexcept
+{
+    delete[] cells;
+}
+
+// @throws std::bad_alloc
+void FrameBuffer::resize(const uint16_t new_columns, const uint16_t new_rows)
+{
+    cell* const new_cells = new cell[static_cast<size_t> (new_columns) * new_rows];
+    delete[] cells;
+    cells = new_cells;
+    columns = new_columns;
+    rows = new_rows;
+    reset();
+}
+
+uint16_t FrameBuffer::get_columns() const noexcept
+{
+    return columns;
+}
+
+uint16_t FrameBuffer::get_rows() const noexcept
+{
+    return rows;
+}
+
+void FrameBuffer::reset() noexcept
+{
+    cursor_column       = 0;
+    cursor_row          = 0;
+    wrap_pending        = false;
+    cursor_visible      = true;
+    cur_style.fg_color  = CLR_DEFAULT;
+    cur_style.bg_color  = CLR_DEFAULT;
+    cur_style.attr      = 0;
+
+    state               = parser_state::TEXT;
+    seq_length          = 0;
+    utf8_length         = 0;
+    utf8_expected       = 0;
+    passthrough_length  = 0;
+
+    erase_cells(0, static_cast<size_t> (columns) * rows);
+}
+
+void FrameBuffer::copy_from(const FrameBuffer& other) noexcept
+{
+    const size_t cell_count = static_cast<size_t> (columns) * rows;
+    if (cell_count > 0)
+    {
+        std::memcpy(cells, other.cells, cell_count * sizeof (cell));
+    }
+
+    cursor_column       = other.cursor_column;
+    cursor_row          = other.cursor_row;
+    wrap_pending        = other.wrap_pending;
+    cursor_visible      = other.cursor_visible;
+    cur_style           = other.cur_style;
+
+    state               = parser_state::TEXT;
+    seq_length          = 0;
+    utf8_length         = 0;
+    utf8_expected       = 0;
+    passthrough_length  = 0;
+}
+
+void FrameBuffer::write(const char* const data, const size_t length) noexcept
+{
+    for (size_t idx = 0; idx < length; ++idx)
+    {
+        process_byte(data[idx]);
+    }
+}
+
+// @throws std::bad_alloc
+void FrameBuffer::render_update(const FrameBuffer& next_frame, std::string& output) const
+{
+    output.append(next_frame.passthrough_buffer, next_frame.passthrough_length);
+
+    // Hide the cursor while the display is updated
+    const size_t update_start = output.length();
+    if (cursor_visible)
+    {
+        output.append(AnsiControl::ANSI_CURSOR_OFF);
+    }
+    const size_t content_start = output.length();
+
+    // Current state of the terminal
+    style       term_style      = cur_style;
+    uint16_t    term_column     = cursor_column;
+    uint16_t    term_row        = cursor_row;
+    bool        term_pos_known  = !wrap_pending;
+
+    for (uint16_t row = 0; row < rows; ++row)
+    {
+        const cell* const cur_line = &(cells[static_cast<size_t> (row) * columns]);
+        const cell* const next_line = &(next_frame.cells[static_cast<size_t> (row) * columns]);
+
+        // Trailing blank cells of the next frame's line are updated by erasing the rest of the line
+        uint16_t blank_column = columns;
+        while (blank_column > 0 && is_blank(next_line[blank_column - 1]) &&
+               next_line[blank_column - 1].bg_color == next_line[columns - 1].bg_color)
+        {
+            --blank_column;
+        }
+
+        uint16_t column = 0;
+        while (column < columns)
+        {
+            if (cells_equal(cur_line[column], next_line[column]))
+            {
+                ++column;
+            }
+            else
+            if (column >= blank_column)
+            {
+                if (!term_pos_known || term_row != row || term_column != column)
+                {
+                    append_cursor_pos(output, column, row);
+                    term_column = column;
+                    term_row = row;
+                    term_pos_known = true;
+                }
+                const style blank_style = get_cell_style(next_line[column]);
+                if (!styles_equal(term_style, blank_style))
+                {
+                    append_sgr(output, blank_style);
+                    term_style = blank_style;
+                }
+                output.append(AnsiControl::ANSI_CLEAR_LINE);
+                column = columns;
+            }
+            else
+            {
+                // Include the first column of a double-width character
+                uint16_t span_start = column;
+                if (span_start > 0 &&
+                    (cur_line[span_start].text_length == 0 || next_line[span_start].text_length == 0))
+                {
+                    --span_start;
+                }
+
+                // Include short runs of unchanged cells between changed cells
+                uint16_t span_end = column + 1;
+                uint16_t scan_column = span_end;
+                size_t gap_length = 0;
+                while (scan_column < blank_column && gap_length <= MAX_GAP_CELLS)
+                {
+                    if (cells_equal(cur_line[scan_column], next_line[scan_column]))
+                    {
+                        ++gap_length;
+                    }
+                    else
+                    {
+                        gap_length = 0;
+                        span_end = scan_column + 1;
+                    }
+                    ++scan_column;
+                }
+                // Include the second column of a double-width character
+                if (span_end < columns && next_line[span_end].text_length == 0)
+                {
+                    ++span_end;
+                }
+
+                for (uint16_t idx = span_start; idx < span_end; ++idx)
+                {
+                    const cell& next_cell = next_line[idx];
+                    if (next_cell.text_length > 0)
+                    {
+                        if (!term_pos_known || term_row != row || term_column != idx)
+                        {
+                            append_cursor_pos(output, idx, row);
+                            term_column = idx;
+                            term_row = row;
+                            term_pos_known = true;
+                        }
+                        const style cell_style = get_cell_style(next_cell);
+                        if (!styles_equal(term_style, cell_style))
+                        {
+                            append_sgr(output, cell_style);
+                            term_style = cell_style;
+                        }
+                        if (idx + 1 < columns && next_line[idx + 1].text_length == 0)
+                        {
+                            // Clear both columns first, in case the terminal displays the
+                            // character with a single column width
+                            output.append("  ");
+                            append_cursor_pos(output, idx, row);
+                            output.append(next_cell.text, next_cell.text_length);
+                            term_pos_known = false;
+                        }
+                        else
+                        {
+                            output.append(next_cell.text, next_cell.text_length);
+                            ++term_column;
+                            if (term_column >= columns)
+                            {
+                                term_pos_known = false;
+                            }
+                        }
+                    }
+                }
+                column = span_end;
+            }
+        }
+    }
+
+    // Leave the terminal in the state of the next frame
+    if (!styles_equal(term_style, next_frame.cur_style))
+    {
+        append_sgr(output, next_frame.cur_style);
+    }
+    if (!term_pos_known || term_column != next_frame.cursor_column || term_row != next_frame.cursor_row)
+    {
+        append_cursor_pos(output, next_frame.cursor_column, next_frame.cursor_row);
+    }
+
+    if (output.length() == content_start && cursor_visible == next_frame.cursor_visible)
+    {
+        // Nothing changed
+        output.resize(update_start);
+    }
+    else
+    if (next_frame.cursor_visible)
+    {
+        output.append(AnsiControl::ANSI_CURSOR_ON);
+    }
+}
+
+void FrameBuffer::process_byte(const char ch) noexcept
+{
+    const unsigned char byte_value = static_cast<unsigned char> (ch);
+    if (state == parser_state::TEXT)
+    {
+        bool utf8_continuation = false;
+        if (utf8_expected > 0)
+        {
+            utf8_continuation = (byte_value & 0xC0) == 0x80;
+            if (!utf8_continuation)
+            {
+                // Incomplete character, discard
+                utf8_length = 0;
+                utf8_expected = 0;
+            }
+        }
+
+        if (utf8_continuation)
+        {
+            utf8_buffer[utf8_length] = ch;
+            ++utf8_length;
+            if (utf8_length == utf8_expected)
+            {
+                uint32_t code_point = static_cast<unsigned char> (utf8_buffer[0]) & (0x7F >> utf8_expected);
+                for (uint8_t idx = 1; idx < utf8_length; ++idx)
+                {
+                    code_point = (code_point << 6) | (static_cast<unsigned char> (utf8_buffer[idx]) & 0x3F);
+                }
+                put_character(utf8_buffer, utf8_length, is_double_width(code_point));
+                utf8_length = 0;
+                utf8_expected = 0;
+            }
+        }
+        else
+        if (byte_value == 0x1B)
+        {
+            seq_buffer[0] = ch;
+            seq_length = 1;
+            state = parser_state::ESCAPE;
+        }
+        else
+        if (byte_value >= 0x20 && byte_value < 0x7F)
+        {
+            put_character(&ch, 1, false);
+        }
+        else
+        if (byte_value >= 0xC2 && byte_value <= 0xF4)
+        {
+            utf8_buffer[0] = ch;
+            utf8_length = 1;
+            utf8_expected = byte_value >= 0xF0 ? 4 : (byte_value >= 0xE0 ? 3 : 2);
+        }
+        else
+        if (ch == '\n')
+        {
+            // Output post-processing translates newline to carriage return and newline
+            wrap_pending = false;
+            cursor_column = 0;
+            if (cursor_row + 1 < rows)
+            {
+                ++cursor_row;
+            }
+        }
+        else
+        if (ch == '\r')
+        {
+            wrap_pending = false;
+            cursor_column = 0;
+        }
+        else
+        if (ch == '\b')
+        {
+            if (wrap_pending)
+            {
+                wrap_pending = false;
+            }
+            else
+            if (cursor_column > 0)
+            {
+                --cursor_column;
+            }
+        }
+        // Other control characters and invalid bytes are ignored
+    }
+    else
+    {
+        process_escape_byte(ch);
+    }
+}
+
+void FrameBuffer::process_escape_byte(const char ch) noexcept
+{
+    const unsigned char byte_value = static_cast<unsigned char> (ch);
+    // Overlong sequences are discarded when they are complete
+    if (seq_length < sizeof (seq_buffer))
+    {
+        seq_buffer[seq_length] = ch;
+    }
+    ++seq_length;
+
+    switch (state)
+    {
+        case parser_state::ESCAPE:
+        {
+            if (ch == '[')
+            {
+                state = parser_state::CONTROL_SEQUENCE;
+            }
+            else
+            if (byte_value >= 0x20 && byte_value <= 0x2F)
+            {
+                state = parser_state::OTHER_SEQUENCE;
+            }
+            else
+            {
+                add_passthrough(seq_buffer, seq_length);
+                state = parser_state::TEXT;
+            }
+            break;
+        }
+        case parser_state::CONTROL_SEQUENCE:
+        {
+            if (byte_value >= 0x40 && byte_value <= 0x7E)
+            {
+                if (seq_length <= sizeof (seq_buffer))
+                {
+                    process_control_sequence();
+                }
+                state = parser_state::TEXT;
+            }
+            else
+            if (byte_value < 0x20)
+            {
+                // Invalid sequence, discard
+                state = parser_state::TEXT;
+            }
+            break;
+        }
+        case parser_state::OTHER_SEQUENCE:
+        {
+            if (byte_value >= 0x30 && byte_value <= 0x7E)
+            {
+                add_passthrough(seq_buffer, seq_length);
+                state = parser_state::TEXT;
+            }
+            else
+            if (byte_value < 0x20)
+            {
+                state = parser_state::TEXT;
+            }
+            break;
+        }
+        case parser_state::TEXT:
+            // fall-through
+        default:
+        {
+            state = parser_state::TEXT;
+            break;
+        }
+    }
+}
+
+void FrameBuffer::process_control_sequence() noexcept
+{
+    const size_t final_idx = seq_length - 1;
+    const char final_char = seq_buffer[final_idx];
+
+    size_t idx = 2;
+    bool private_seq = false;
+    if (idx < final_idx && seq_buffer[idx] == '?')
+    {
+        private_seq = true;
+        ++idx;
+    }
+
+    uint32_t params[MAX_SEQ_PARAMS];
+    size_t param_count = 0;
+    uint32_t value = 0;
+    bool valid = true;
+    for (; idx < final_idx; ++idx)
+    {
+        const char param_char = seq_buffer[idx];
+        if (param_char >= '0' && param_char <= '9')
+        {
+            if (value < 100000)
+            {
+                value = (value * 10) + static_cast<uint32_t> (param_char - '0');
+            }
+        }
+        else
+        if (param_char == ';' || param_char == ':')
+        {
+            if (param_count < MAX_SEQ_PARAMS)
+            {
+                params[param_count] = value;
+                ++param_count;
+            }
+            value = 0;
+        }
+        else
+        {
+            // Intermediate bytes or unsupported parameters
+            valid = false;
+        }
+    }
+    if (param_count < MAX_SEQ_PARAMS)
+    {
+        params[param_count] = value;
+        ++param_count;
+    }
+
+    if (valid && !private_seq)
+    {
+        const size_t cursor_idx = (static_cast<size_t> (cursor_row) * columns) + cursor_column;
+        const size_t line_idx = static_cast<size_t> (cursor_row) * columns;
+        const size_t cell_count = static_cast<size_t> (columns) * rows;
+        switch (final_char)
+        {
+            case 'H':
+                // fall-through
+            case 'f':
+            {
+                move_cursor(param_count >= 2 ? params[1] : 1, params[0]);
+                break;
+            }
+            case 'J':
+            {
+                if (params[0] == 0)
+                {
+                    erase_cells(cursor_idx, cell_count);
+                }
+                else
+                if (params[0] == 1)
+                {
+                    erase_cells(0, cursor_idx + 1);
+                }
+                else
+                {
+                    erase_cells(0, cell_count);
+                }
+                break;
+            }
+            case 'K':
+            {
+                if (params[0] == 0)
+                {
+                    erase_cells(cursor_idx, line_idx + columns);
+                }
+                else
+                if (params[0] == 1)
+                {
+                    erase_cells(line_idx, cursor_idx + 1);
+                }
+                else
+                {
+                    erase_cells(line_idx, line_idx + columns);
+                }
+                break;
+            }
+            case 'm':
+            {
+                process_sgr(params, param_count);
+                break;
+            }
+            default:
+            {
+                add_passthrough(seq_buffer, seq_length);
+                break;
+            }
+        }
+    }
+    else
+    if (valid && param_count == 1 && params[0] == 25 && (final_char == 'h' || final_char == 'l'))
+    {
+        cursor_visible = final_char == 'h';
+    }
+    else
+    {
+        add_passthrough(seq_buffer, seq_length);
+    }
+}
+
+void FrameBuffer::process_sgr(const uint32_t* const params, const size_t param_count) noexcept
+{
+    size_t idx = 0;
+    while (idx < param_count)
+    {
+        const uint32_t code = params[idx];
+        if (code == 0)
+        {
+            cur_style.fg_color = CLR_DEFAULT;
+            cur_style.bg_color = CLR_DEFAULT;
+            cur_style.attr = 0;
+        }
+        else
+        if (code <= 9)
+        {
+            cur_style.attr |= get_attr_flag(code);
+        }
+        else
+        if (code == 22)
+        {
+            cur_style.attr &= ~(get_attr_flag(1) | get_attr_flag(2));
+        }
+        else
+        if (code >= 23 && code <= 29)
+        {
+            cur_style.attr &= ~get_attr_flag(code - 20);
+        }
+        else
+        if ((code >= 30 && code <= 37) || (code >= 90 && code <= 97))
+        {
+            cur_style.fg_color = CLR_BASIC | code;
+        }
+        else
+        if ((code >= 40 && code <= 47) || (code >= 100 && code <= 107))
+        {
+            cur_style.bg_color = CLR_BASIC | (code - 10);
+        }
+        else
+        if (code == 39)
+        {
+            cur_style.fg_color = CLR_DEFAULT;
+        }
+        else
+        if (code == 49)
+        {
+            cur_style.bg_color = CLR_DEFAULT;
+        }
+        else
+        if (code == 38 || code == 48)
+        {
+            uint32_t color = CLR_DEFAULT;
+            bool have_color = false;
+            if (idx + 2 < param_count && params[idx + 1] == 5)
+            {
+                color = CLR_PALETTE | (params[idx + 2] & 0xFF);
+                have_color = true;
+                idx += 2;
+            }
+            else
+            if (idx + 4 < param_count && params[idx + 1] == 2)
+            {
+                color = CLR_RGB | ((params[idx + 2] & 0xFF) << 16) | ((params[idx + 3] & 0xFF) << 8) |
+                    (params[idx + 4] & 0xFF);
+                have_color = true;
+                idx += 4;
+            }
+            if (have_color)
+            {
+                if (code == 38)
+                {
+                    cur_style.fg_color = color;
+                }
+                else
+                {
+                    cur_style.bg_color = color;
+                }
+            }
+        }
+        ++idx;
+    }
+}
+
+void FrameBuffer::add_passthrough(const char* const data, const size_t length) noexcept
+{
+    // If the buffer is full, further sequences are dropped
+    if (length <= sizeof (passthrough_buffer) - passthrough_length)
+    {
+        std::memcpy(&(passthrough_buffer[passthrough_length]), data, length);
+        passthrough_length += length;
+    }
+}
+
+void FrameBuffer::put_character(const char* const text, const uint8_t text_length, const bool double_width) noexcept
+{
+    const uint16_t char_width = double_width ? 2 : 1;
+    bool fits = columns >= char_width && rows > 0;
+    if (fits && (wrap_pending || cursor_column + char_width > columns))
+    {
+        // Automatic wrap to the next line, scrolling is not supported
+        wrap_pending = false;
+        if (cursor_row + 1 < rows)
+        {
+            ++cursor_row;
+            cursor_column = 0;
+        }
+        else
+        {
+            fits = false;
+        }
+    }
+
+    if (fits)
+    {
+        const size_t line_end_idx = (static_cast<size_t> (cursor_row) + 1) * columns;
+        const size_t cell_idx = (static_cast<size_t> (cursor_row) * columns) + cursor_column;
+        const size_t next_idx = cell_idx + char_width;
+
+        // Overwriting either column of a double-width character clears the other column
+        if (cells[cell_idx].text_length == 0 && cursor_column > 0)
+        {
+            clear_cell(cells[cell_idx - 1]);
+        }
+        if (next_idx < line_end_idx && cells[next_idx].text_length == 0)
+        {
+            clear_cell(cells[next_idx]);
+        }
+
+        cell& target = cells[cell_idx];
+        target.fg_color = cur_style.fg_color;
+        target.bg_color = cur_style.bg_color;
+        target.attr = cur_style.attr;
+        std::memcpy(target.text, text, text_length);
+        target.text_length = text_length;
+        if (double_width)
+        {
+            cell& second_column = cells[cell_idx + 1];
+            second_column = target;
+            second_column.text_length = 0;
+        }
+
+        cursor_column += char_width;
+        if (cursor_column >= columns)
+        {
+            cursor_column = columns - 1;
+            wrap_pending = true;
+        }
+    }
+}
+
+void FrameBuffer::erase_cells(const size_t start_idx, const size_t end_idx) noexcept
+{
+    if (start_idx < end_idx)
+    {
+        // Erasing either column of a double-width character clears the other column
+        if (start_idx > 0 && cells[start_idx].text_length == 0)
+        {
+            clear_cell(cells[start_idx - 1]);
+        }
+        if (end_idx < static_cast<size_t> (columns) * rows && cells[end_idx].text_length == 0)
+        {
+            clear_cell(cells[end_idx]);
+        }
+
+        // Erased cells have the current background color
+        for (size_t idx = start_idx; idx < end_idx; ++idx)
+        {
+            cell& target = cells[idx];
+            target.fg_color = CLR_DEFAULT;
+            target.bg_color = cur_style.bg_color;
+            target.attr = 0;
+            target.text[0] = ' ';
+            target.text_length = 1;
+        }
+    }
+    wrap_pending = false;
+}
+
+void FrameBuffer::clear_cell(cell& target) noexcept
+{
+    target.text[0] = ' ';
+    target.text_length = 1;
+}
+
+void FrameBuffer::move_cursor(const uint32_t column, const uint32_t row) noexcept
+{
+    // Coordinates are 1-based, 0 is treated like 1
+    const uint32_t column_idx = column > 0 ? column - 1 : 0;
+    const uint32_t row_idx = row > 0 ? row - 1 : 0;
+    cursor_column = columns > 0 ? static_cast<uint16_t> (std::min<uint32_t>(column_idx, columns - 1)) : 0;
+    cursor_row = rows > 0 ? static_cast<uint16_t> (std::min<uint32_t>(row_idx, rows - 1)) : 0;
+    wrap_pending = false;
+}
+
+bool FrameBuffer::cells_equal(const cell& cell_a, const cell& cell_b) noexcept
+{
+    return cell_a.text_length == cell_b.text_length && cell_a.fg_color == cell_b.fg_color &&
+        cell_a.bg_color == cell_b.bg_color && cell_a.attr == cell_b.attr &&
+        std::memcmp(cell_a.text, cell_b.text, cell_a.text_length) == 0;
+}
+
+bool FrameBuffer::is_blank(const cell& target) noexcept
+{
+    return target.text_length == 1 && target.text[0] == ' ' && target.fg_color == CLR_DEFAULT &&
+        target.attr == 0;
+}
+
+bool FrameBuffer::styles_equal(const style& style_a, const style& style_b) noexcept
+{
+    return style_a.fg_color == style_b.fg_color && style_a.bg_color == style_b.bg_color &&
+        style_a.attr == style_b.attr;
+}
+
+FrameBuffer::style FrameBuffer::get_cell_style(const cell& target) noexcept
+{
+    style cell_style;
+    cell_style.fg_color = target.fg_color;
+    cell_style.bg_color = target.bg_color;
+    cell_style.attr = target.attr;
+    return cell_style;
+}
+
+// Approximation of the East Asian Wide and Fullwidth ranges, and of the emoji that are displayed
+// with a double width by default, e.g. U+231B, which is the symbol for 'working'
+bool FrameBuffer::is_double_width(const uint32_t code_point) noexcept
+{
+    return (
+        (code_point >= 0x1100 && code_point <= 0x115F) ||
+        (code_point >= 0x231A && code_point <= 0x231B) ||
+        (code_point >= 0x2329 && code_point <= 0x232A) ||
+        (code_point >= 0x23E9 && code_point <= 0x23EC) ||
+        code_point == 0x23F0 || code_point == 0x23F3 ||
+        (code_point >= 0x25FD && code_point <= 0x25FE) ||
+        (code_point >= 0x2614 && code_point <= 0x2615) ||
+        (code_point >= 0x2E80 && code_point <= 0x303E) ||
+        (code_point >= 0x3041 && code_point <= 0xA4CF) ||
+        (code_point >= 0xAC00 && code_point <= 0xD7A3) ||
+        (code_point >= 0xF900 && code_point <= 0xFAFF) ||
+        (code_point >= 0xFE30 && code_point <= 0xFE4F) ||
+        (code_point >= 0xFF00 && code_point <= 0xFF60) ||
+        (code_point >= 0xFFE0 && code_point <= 0xFFE6) ||
+        (code_point >= 0x1F300 && code_point <= 0x1F64F) ||
+        (code_point >= 0x1F900 && code_point <= 0x1F9FF) ||
+        (code_point >= 0x20000 && code_point <= 0x3FFFD)
+    );
+}
+
+uint8_t FrameBuffer::get_attr_flag(const uint32_t sgr_code) noexcept
+{
+    uint8_t flag = 0;
+    for (size_t idx = 0; idx < ATTR_COUNT; ++idx)
+    {
+        if (ATTR_SGR_CODES[idx] == sgr_code)
+        {
+            flag = static_cast<uint8_t> (1 << idx);
+            break;
+        }
+    }
+    return flag;
+}
+
+// @throws std::bad_alloc
+void FrameBuffer::append_sgr(std::string& output, const style& sgr_style)
+{
+    output.append("\x1B[0");
+    for (size_t idx = 0; idx < ATTR_COUNT; ++idx)
+    {
+        if ((sgr_style.attr & (1 << idx)) != 0)
+        {
+            output.push_back(';');
+            output.push_back(static_cast<char> ('0' + ATTR_SGR_CODES[idx]));
+        }
+    }
+    append_color(output, sgr_style.fg_color, false);
+    append_color(output, sgr_style.bg_color, true);
+    output.push_back('m');
+}
+
+// @throws std::bad_alloc
+void FrameBuffer::append_color(std::string& output, const uint32_t color, const bool background)
+{
+    const uint32_t color_type = color & CLR_TYPE_MASK;
+    const uint32_t color_value = color & CLR_VALUE_MASK;
+    char color_seq[24];
+    int seq_length = 0;
+    if (color_type == CLR_BASIC)
+    {
+        seq_length = std::snprintf(
+            color_seq, sizeof (color_seq), ";%u",
+            static_cast<unsigned int> (background ? color_value + 10 : color_value)
+        );
+    }
+    else
+    if (color_type == CLR_PALETTE)
+    {
+        seq_length = std::snprintf(
+            color_seq, sizeof (color_seq), ";%u;5;%u",
+            background ? 48U : 38U, static_cast<unsigned int> (color_value)
+        );
+    }
+    else
+    if (color_type == CLR_RGB)
+    {
+        seq_length = std::snprintf(
+            color_seq, sizeof (color_seq), ";%u;2;%u;%u;%u",
+            background ? 48U : 38U,
+            static_cast<unsigned int> ((color_value >> 16) & 0xFF),
+            static_cast<unsigned int> ((color_value >> 8) & 0xFF),
+            static_cast<unsigned int> (color_value & 0xFF)
+        );
+    }
+    // The default color is selected by resetting the graphic rendition
+    if (seq_length > 0)
+    {
+        output.append(color_seq, static_cast<size_t> (seq_length));
+    }
+}
+
+// @throws std::bad_alloc
+void FrameBuffer::append_cursor_pos(std::string& output, const uint16_t column, const uint16_t row)
+{
+    char pos_seq[24];
+    const int seq_length = std::snprintf(
+        pos_seq, sizeof (pos_seq), AnsiControl::ANSI_FMT_CURSOR_POS.c_str(),
+        static_cast<unsigned int> (row) + 1, static_cast<unsigned int> (column) + 1
+    );
+    if (seq_length > 0)
+    {
+        output.append(pos_seq, static_cast<size_t> (seq_length));
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <default_types.h>
+#include <new>
+#include <string>
+
+// Off-screen character cell grid of the terminal display
+//
+// Terminal output that is written to a frame buffer is interpreted and applied to the grid's cells
+// instead of being displayed. The interpreter supports the subset of ANSI escape sequences used by
+// the display implementations: cursor positioning, erasing the display or parts of a line, select
+// graphic rendition and cursor visibility. Other escape sequences are passed through unchanged.
+//
+// Comparing two frame buffers yields the terminal output that changes the display from the state
+// of one frame buffer to the state of the other one.
+class FrameBuffer
+{
+  public:
+    FrameBuffer();
+    virtual ~FrameBuffer() noexcept;
+
+    FrameBuffer(const FrameBuffer& orig) = delete;
+    FrameBuffer& operator=(const FrameBuffer& orig) = delete;
+    FrameBuffer(FrameBuffer&& orig) = delete;
+    FrameBuffer& operator=(FrameBuffer&& orig) = delete;
+
+    // Changes the dimensions of the grid and resets the frame buffer
+    // @throws std::bad_alloc
+    virtual void resize(uint16_t new_columns, uint16_t new_rows);
+    virtual uint16_t get_columns() const noexcept;
+    virtual uint16_t get_rows() const noexcept;
+
+    // Clears all cells and resets the cursor position, the graphic rendition and the cursor visibility
+    virtual void reset() noexcept;
+
+    // Copies the cells, cursor position, graphic rendition and cursor visibility of a frame buffer
+    // with the same dimensions
+    virtual void copy_from(const FrameBuffer& other) noexcept;
+
+    // Interprets terminal output
+    virtual void write(const char* data, size_t length) noexcept;
+
+    // Appends the terminal output that changes the display from the state of this frame buffer
+    // to the state of the specified frame buffer, which must have the same dimensions
+    // @throws std::bad_alloc
+    virtual void render_update(const FrameBuffer& next_frame, std::string& output) const;
+
+  private:
+    typedef struct style_s
+    {
+        uint32_t    fg_color;
+        uint32_t    bg_color;
+        uint8_t     attr;
+    }
+    style;
+
+    typedef struct cell_s
+    {
+        uint32_t    fg_color;
+        uint32_t    bg_color;
+        // UTF-8 encoded character
+        char        text[4];
+        // Length of the UTF-8 encoded character, 0 for the second column of a double-width character
+        uint8_t     text_length;
+        uint8_t     attr;
+    }
+    cell;
+
+    enum class parser_state : uint8_t
+    {
+        TEXT,
+        ESCAPE,
+        CONTROL_SEQUENCE,
+        OTHER_SEQUENCE
+    };
+
+    // Color encoding: type in the most significant byte, color value in the lower bytes
+    static const uint32_t CLR_DEFAULT;
+    // Colors selected by SGR codes 30 - 37, 40 - 47, 90 - 97 and 100 - 107, value is the fg color code
+    static const uint32_t CLR_BASIC;
+    // 256 color palette
+    static const uint32_t CLR_PALETTE;
+    // 24 bit RGB color
+    static const uint32_t CLR_RGB;
+    static const uint32_t CLR_TYPE_MASK;
+    static const uint32_t CLR_VALUE_MASK;
+
+    // SGR codes of the attribute flags, the flag for the code at index n is (1 << n)
+    static const uint8_t ATTR_SGR_CODES[];
+    static const size_t ATTR_COUNT;
+
+    static const size_t MAX_SEQ_PARAMS;
+    // Maximum number of unchanged cells that are rewritten to avoid repositioning the cursor
+    static const size_t MAX_GAP_CELLS;
+
+    cell*       cells           {nullptr};
+    uint16_t    columns         {0};
+    uint16_t    rows            {0};
+
+    uint16_t    cursor_column   {0};
+    uint16_t    cursor_row      {0};
+    // Set if a character was written to the last column and the cursor did not advance yet
+    bool        wrap_pending    {false};
+    bool        cursor_visible  {true};
+    // Graphic rendition, the default colors are encoded as 0
+    style       cur_style       {0, 0, 0};
+
+    parser_state    state           {parser_state::TEXT};
+    char            seq_buffer[32];
+    size_t          seq_length      {0};
+    char            utf8_buffer[4];
+    uint8_t         utf8_length     {0};
+    uint8_t         utf8_expected   {0};
+
+    // Escape sequences that are not interpreted, emitted by render_update() before any other output
+    char            passthrough_buffer[256];
+    size_t          passthrough_length  {0};
+
+    void process_byte(char ch) noexcept;
+    void process_escape_byte(char ch) noexcept;
+    void process_control_sequence() noexcept;
+    void process_sgr(const uint32_t* params, size_t param_count) noexcept;
+    void add_passthrough(const char* data, size_t length) noexcept;
+
+    void put_character(const char* text, uint8_t text_length, bool double_width) noexcept;
+    void erase_cells(size_t start_idx, size_t end_idx) noexcept;
+    void clear_cell(cell& target) noexcept;
+    void move_cursor(uint32_t column, uint32_t row) noexcept;
+
+    static bool cells_equal(const cell& cell_a, const cell& cell_b) noexcept;
+    static bool is_blank(const cell& target) noexcept;
+    static bool styles_equal(const style& style_a, const style& style_b) noexcept;
+    static style get_cell_style(const cell& target) noexcept;
+    static bool is_double_width(uint32_t code_point) noexcept;
+    static uint8_t get_attr_flag(uint32_t sgr_code) noexcept;
+
+    // @throws std::bad_alloc
+    static void append_sgr(std::string& output, const style& sgr_style);
+    // @throws std::bad_alloc
+    static void append_color(std::string& output, uint32_t color, bool background);
+    // @throws std::bad_alloc
+    static void append_cursor_pos(std::string& output, uint16_t column, uint16_t row);
+};
+
+#endif /* FRAMEBUFFER_H */
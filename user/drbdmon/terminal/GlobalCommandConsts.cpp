@@ -20,4 +20,6 @@ namespace cmd_names
     const std::string   KEY_CMD_VOLUME("VOLUME");
     const std::string   KEY_CMD_MINOR_NR("MINOR-NR");
     const std::string   KEY_CMD_CLOSE("CLOSE");
+    const std::string   KEY_CMD_FILTER("FILTER");
+    const std::string   KEY_CMD_SEARCH("SEARCH");
 }
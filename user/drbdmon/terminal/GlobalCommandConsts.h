@@ -23,6 +23,8 @@ namespace cmd_names
     extern const std::string    KEY_CMD_VOLUME;
     extern const std::string    KEY_CMD_MINOR_NR;
     extern const std::string    KEY_CMD_CLOSE;
+    extern const std::string    KEY_CMD_FILTER;
+    extern const std::string    KEY_CMD_SEARCH;
 }
 
 #endif /* GLOBALCOMMANDCONSTS_H */
@@ -32,7 +32,9 @@ GlobalCommandsImpl::GlobalCommandsImpl(ComponentsHub& comp_hub, Configuration& c
     entry_connection(&cmd_names::KEY_CMD_CONNECTION, &GlobalCommandsImpl::cmd_connection),
     entry_volume(&cmd_names::KEY_CMD_VOLUME, &GlobalCommandsImpl::cmd_volume),
     entry_minor_nr(&cmd_names::KEY_CMD_MINOR_NR, &GlobalCommandsImpl::cmd_minor_nr),
-    entry_close(&cmd_names::KEY_CMD_CLOSE, &GlobalCommandsImpl::cmd_close)
+    entry_close(&cmd_names::KEY_CMD_CLOSE, &GlobalCommandsImpl::cmd_close),
+    entry_filter(&cmd_names::KEY_CMD_FILTER, &GlobalCommandsImpl::local_command),
+    entry_search(&cmd_names::KEY_CMD_SEARCH, &GlobalCommandsImpl::local_command)
 {
     add_command(entry_exit);
     add_command(entry_display);
@@ -51,6 +53,8 @@ GlobalCommandsImpl::GlobalCommandsImpl(ComponentsHub& comp_hub, Configuration& c
     add_command(entry_volume);
     add_command(entry_minor_nr);
     add_command(entry_close);
+    add_command(entry_filter);
+    add_command(entry_search);
 }
 
 GlobalCommandsImpl::~GlobalCommandsImpl() noexcept
@@ -200,7 +204,7 @@ bool GlobalCommandsImpl::cmd_select_all(const std::string& command, StringTokeni
         {
             std::unique_lock<std::recursive_mutex> lock(log->queue_lock);
 
-            MessageLog::Queue::ValuesIterator entry_iter = log->iterator();
+            MessageLog::EntriesIterator entry_iter = log->iterator();
             while (entry_iter.has_next())
             {
                 MessageLog::Entry* const entry = entry_iter.next();
@@ -40,6 +40,8 @@ class GlobalCommandsImpl : public GlobalCommands, public CommandsBase<GlobalComm
     Entry entry_volume;
     Entry entry_minor_nr;
     Entry entry_close;
+    Entry entry_filter;
+    Entry entry_search;
 
     bool cmd_exit(const std::string& command, StringTokenizer& tokenizer);
     bool cmd_display(const std::string& command, StringTokenizer& tokenizer);
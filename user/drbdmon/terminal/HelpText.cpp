@@ -36,6 +36,7 @@ namespace helptext
         "\x1B\x01" "Contents" "\x1B\xFF" "\n"
         "\n"
         "Resource list overview\n"
+        "Filtering the resource list\n"
         "Display columns and symbols\n"
         "Navigation Keys\n"
         "Commands\n"
@@ -47,6 +48,26 @@ namespace helptext
         "its volumes and connections.\n"
         "\n"
         "\n"
+        "\x1B\x01" "Filtering the resource list" "\x1B\xFF" "\n"
+        "\n"
+        "\x1B\x04" "/filter" "\x1B\xFF" " terms...\n"
+        "    Shows only the resources that match the filter. A term of the form key=state,state,... selects "
+        "resources by their state, any other term is a resource name. Resource names and states may contain "
+        "the '*' wildcard character, states are matched case-insensitively. A resource must match one of the "
+        "resource names, if any were specified, and each of the specified keys.\n"
+        "    Keys:\n"
+        "      role       Role of the resource\n"
+        "      peer-role  Role of any of the peers\n"
+        "      disk       Disk state of any of the volumes\n"
+        "      peer-disk  Disk state of any of the peer volumes\n"
+        "      repl       Replication state of any of the peer volumes\n"
+        "      conn       State of any of the connections\n"
+        "    Example: /filter pg-* repl=SyncTarget,PausedSyncT\n"
+        "    While a filter is active, the problem mode does not apply to the resource list.\n"
+        "\x1B\x04" "/filter" "\x1B\xFF" "\n"
+        "    Shows all resources again.\n"
+        "\n"
+        "\n"
         "\x1B\x01" "Display columns and symbols" "\x1B\xFF" "\n"
         "\n"
         "The resource list display shows, from left to right, the following columns:\n";
@@ -363,7 +384,12 @@ namespace helptext
         "\x1B\x05" "BACKSPACE  " "\x1B\xFF" " Same as " "\x1B\x05" "S" "\x1B\xFF" "\n"
         "\x1B\x05" "P          " "\x1B\xFF" " Moves a suspended task to the pending tasks queue\n"
         "\x1B\x05" "INSERT     " "\x1B\xFF" " Same as " "\x1B\x05" "P" "\x1B\xFF" "\n"
-        "\x1B\x05" "DEL        " "\x1B\xFF" " Terminates a running task\n";
+        "\x1B\x05" "DEL        " "\x1B\xFF" " Terminates a running task\n"
+        "\n"
+        "\x1B\x04" "/search" "\x1B\xFF" " words...\n"
+        "    Shows the first line of the task details that contains all of the specified words\n"
+        "\x1B\x04" "/search" "\x1B\xFF" "\n"
+        "    Shows the next line that matches the last search\n";
 
     const char* const RSC_DETAIL_HELP_1 =
         "\x1B\x01" "Help - Resource details" "\x1B\xFF" "\n"
@@ -575,6 +601,7 @@ namespace helptext
         "\x1B\x01" "Contents" "\x1B\xFF" "\n"
         "\n"
         "Message log overview\n"
+        "Filtering the message log\n"
         "Navigation keys\n"
         "\n"
         "\n"
@@ -586,6 +613,16 @@ namespace helptext
         "level of the event, the time of the event, and the first line of the event's log message. "
         "The first line of the log message will be truncated if it is too long to fit on one line. "
         "The full log message can be displayed using the message details display.\n"
+        "\n"
+        "\n"
+        "\x1B\x01" "Filtering the message log" "\x1B\xFF" "\n"
+        "\n"
+        "\x1B\x04" "/filter" "\x1B\xFF" " words...\n"
+        "    Shows only the log events that contain all of the specified words. Words are matched "
+        "case-insensitively against the words of the log message and against the date (YYYY-MM-DD) and time "
+        "(HH:MM or HH:MM:SS, UTC) of the log event.\n"
+        "\x1B\x04" "/filter" "\x1B\xFF" "\n"
+        "    Shows all log events again.\n"
         "\n";
 
     const char* const MSG_LOG_HELP_2 =
@@ -47,6 +47,12 @@ void MDspBase::notify_data_updated()
     // Default no-op action; to be overridden by subclasses
 }
 
+bool MDspBase::is_drbd_content_changed(const uint64_t since_seq)
+{
+    // Default action, update the display on any change; to be overridden by subclasses
+    return true;
+}
+
 void MDspBase::display()
 {
     dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.ansi_ctl->ANSI_CURSOR_OFF.c_str());
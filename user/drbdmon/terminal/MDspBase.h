@@ -30,6 +30,7 @@ class MDspBase : public ModularDisplay
     virtual void reset_display() override;
 
     virtual void notify_data_updated() override;
+    virtual bool is_drbd_content_changed(const uint64_t since_seq) override;
 
     virtual void display() override;
     virtual void display_content() = 0;
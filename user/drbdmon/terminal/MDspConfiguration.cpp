@@ -783,6 +783,7 @@ void MDspConfiguration::apply_config()
 
     dsp_comp_hub.sub_proc_queue->set_discard_finished_tasks(config->discard_fail_tasks);
     dsp_comp_hub.sub_proc_queue->set_discard_succeeded_tasks(config->discard_succ_tasks);
+    dsp_comp_hub.sub_proc_queue->set_max_active_count(config->max_active_tasks);
     dsp_comp_hub.dsp_shared->activate_tasks = !config->suspend_new_tasks;
 
     if (config->enable_mouse_nav)
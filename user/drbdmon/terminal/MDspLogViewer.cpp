@@ -3,6 +3,7 @@
 #include <terminal/navigation.h>
 #include <terminal/DisplayUpdateEvent.h>
 #include <terminal/HelpText.h>
+#include <terminal/GlobalCommandConsts.h>
 #include <MessageLog.h>
 #include <string>
 #include <mutex>
@@ -35,7 +36,20 @@ void MDspLogViewer::display_list()
     std::unique_lock<std::recursive_mutex> lock(log.queue_lock);
 
     const uint32_t lines_per_page = get_lines_per_page();
-    MessageLog::Queue::ValuesIterator msg_iter = log.iterator();
+    if (is_filtering())
+    {
+        display_filtered_list(lines_per_page);
+    }
+    else
+    {
+        display_all_entries(lines_per_page);
+    }
+}
+
+// Caller must hold the log's queue_lock
+void MDspLogViewer::display_all_entries(const uint32_t lines_per_page)
+{
+    MessageLog::EntriesIterator msg_iter = log.iterator();
     if (msg_iter.get_size() >= 1)
     {
         const bool selecting = is_selecting();
@@ -50,7 +64,7 @@ void MDspLogViewer::display_list()
             if (first_entry != nullptr)
             {
                 const uint64_t first_entry_id = first_entry->get_id();
-                MessageLog::Queue::ValuesIterator dsp_msg_iter = log.iterator(first_entry_id);
+                MessageLog::EntriesIterator dsp_msg_iter = log.iterator(first_entry_id);
                 uint32_t current_line = LOG_LIST_Y;
                 uint32_t line_ctr = 0;
                 while (dsp_msg_iter.has_next() && line_ctr < lines_per_page)
@@ -175,33 +189,51 @@ void MDspLogViewer::list_item_clicked(MouseEvent& mouse)
 
     std::unique_lock<std::recursive_mutex> lock(log.queue_lock);
 
-    MessageLog::Queue::ValuesIterator msg_iter = log.iterator();
-    navigation::find_first_item_on_page(get_page_nr(), get_line_offset(), lines_per_page, msg_iter);
-    uint32_t line_ctr = 0;
-    while (msg_iter.has_next() && line_ctr <= selected_line)
+    MessageLog::Entry* msg_entry = nullptr;
+    if (is_filtering())
     {
-        MessageLog::Entry* const msg_entry = msg_iter.next();
-        if (line_ctr == selected_line)
+        update_filter_matches();
+        const size_t match_idx = get_first_match_index_on_page(lines_per_page) + selected_line;
+        if (match_idx < filter_matches.get_count())
         {
-            uint64_t& message_id = get_message_id();
-            message_id = msg_entry->get_id();
-            if (mouse.button == MouseEvent::button_id::BUTTON_01 &&
-                mouse.coord_column <= DisplayConsts::MAX_SELECT_X)
-            {
-                toggle_select_cursor_item();
-                dsp_comp_hub.dsp_selector->refresh_display();
-            }
-            else
-            if (mouse.button == MouseEvent::button_id::BUTTON_03 && mouse.event == MouseEvent::event_id::MOUSE_RELEASE)
-            {
-                dsp_comp_hub.dsp_selector->switch_to_display(DisplayId::display_page::MSG_VIEWER);
-            }
-            else
+            msg_entry = log.get_entry(filter_matches.get_id(match_idx));
+        }
+    }
+    else
+    {
+        MessageLog::EntriesIterator msg_iter = log.iterator();
+        navigation::find_first_item_on_page(get_page_nr(), get_line_offset(), lines_per_page, msg_iter);
+        uint32_t line_ctr = 0;
+        while (msg_iter.has_next() && line_ctr <= selected_line)
+        {
+            MessageLog::Entry* const cur_entry = msg_iter.next();
+            if (line_ctr == selected_line)
             {
-                dsp_comp_hub.dsp_selector->refresh_display();
+                msg_entry = cur_entry;
             }
+            ++line_ctr;
+        }
+    }
+
+    if (msg_entry != nullptr)
+    {
+        uint64_t& message_id = get_message_id();
+        message_id = msg_entry->get_id();
+        if (mouse.button == MouseEvent::button_id::BUTTON_01 &&
+            mouse.coord_column <= DisplayConsts::MAX_SELECT_X)
+        {
+            toggle_select_cursor_item();
+            dsp_comp_hub.dsp_selector->refresh_display();
+        }
+        else
+        if (mouse.button == MouseEvent::button_id::BUTTON_03 && mouse.event == MouseEvent::event_id::MOUSE_RELEASE)
+        {
+            dsp_comp_hub.dsp_selector->switch_to_display(DisplayId::display_page::MSG_VIEWER);
+        }
+        else
+        {
+            dsp_comp_hub.dsp_selector->refresh_display();
         }
-        ++line_ctr;
     }
 }
 
@@ -220,6 +252,8 @@ void MDspLogViewer::reset_display()
     MDspStdListBase::reset_display();
     uint64_t& message_id = get_message_id();
     message_id = MessageLog::ID_NONE;
+    filter_query.clear();
+    filter_matches.clear();
 }
 
 void MDspLogViewer::synchronize_data()
@@ -231,6 +265,18 @@ void MDspLogViewer::cursor_to_next_item()
     std::unique_lock<std::recursive_mutex> lock(log.queue_lock);
 
     uint64_t& message_id = get_message_id();
+    if (is_filtering())
+    {
+        update_filter_matches();
+        const size_t match_idx = message_id != MessageLog::ID_NONE ?
+            filter_matches.find_ceiling(message_id + 1) : 0;
+        if (match_idx < filter_matches.get_count())
+        {
+            message_id = filter_matches.get_id(match_idx);
+            dsp_comp_hub.dsp_selector->refresh_display();
+        }
+    }
+    else
     if (message_id != MessageLog::ID_NONE)
     {
         MessageLog::Entry* msg_entry = log.get_next_entry(message_id);
@@ -242,7 +288,7 @@ void MDspLogViewer::cursor_to_next_item()
     }
     else
     {
-        MessageLog::Queue::ValuesIterator msg_iter = log.iterator();
+        MessageLog::EntriesIterator msg_iter = log.iterator();
         if (msg_iter.has_next())
         {
             MessageLog::Entry* const msg_entry = msg_iter.next();
@@ -257,6 +303,23 @@ void MDspLogViewer::cursor_to_previous_item()
     std::unique_lock<std::recursive_mutex> lock(log.queue_lock);
 
     uint64_t& message_id = get_message_id();
+    if (is_filtering())
+    {
+        update_filter_matches();
+        if (filter_matches.get_count() >= 1)
+        {
+            size_t match_idx = 0;
+            if (message_id != MessageLog::ID_NONE)
+            {
+                match_idx = filter_matches.find_ceiling(message_id);
+                // Stays on the first matching entry if there is no previous matching entry
+                match_idx = match_idx >= 1 ? match_idx - 1 : 0;
+            }
+            message_id = filter_matches.get_id(match_idx);
+            dsp_comp_hub.dsp_selector->refresh_display();
+        }
+    }
+    else
     if (message_id != MessageLog::ID_NONE)
     {
         MessageLog::Entry* msg_entry = log.get_previous_entry(message_id);
@@ -268,7 +331,7 @@ void MDspLogViewer::cursor_to_previous_item()
     }
     else
     {
-        MessageLog::Queue::ValuesIterator msg_iter = log.iterator();
+        MessageLog::EntriesIterator msg_iter = log.iterator();
         if (msg_iter.has_next())
         {
             MessageLog::Entry* const msg_entry = msg_iter.next();
@@ -311,12 +374,29 @@ void MDspLogViewer::reset_cursor_position()
 {
     std::unique_lock<std::recursive_mutex> lock(log.queue_lock);
 
-    MessageLog::Queue::ValuesIterator msg_iter = log.iterator();
+    MessageLog::Entry* msg_entry = nullptr;
+    if (is_filtering())
+    {
+        update_filter_matches();
+        const size_t match_idx = get_first_match_index_on_page(get_lines_per_page());
+        if (match_idx < filter_matches.get_count())
+        {
+            msg_entry = log.get_entry(filter_matches.get_id(match_idx));
+        }
+    }
+    else
+    {
+        MessageLog::EntriesIterator msg_iter = log.iterator();
+
+        navigation::find_first_item_on_page(get_page_nr(), get_line_offset(), get_lines_per_page(), msg_iter);
+        if (msg_iter.has_next())
+        {
+            msg_entry = msg_iter.next();
+        }
+    }
 
-    navigation::find_first_item_on_page(get_page_nr(), get_line_offset(), get_lines_per_page(), msg_iter);
-    if (msg_iter.has_next())
+    if (msg_entry != nullptr)
     {
-        MessageLog::Entry* const msg_entry = msg_iter.next();
         uint64_t& message_id = get_message_id();
         message_id = msg_entry->get_id();
         dsp_comp_hub.dsp_selector->refresh_display();
@@ -433,7 +513,26 @@ void MDspLogViewer::cursor_to_nearest_item()
         uint64_t& message_id = get_message_id();
         if (message_id != MessageLog::ID_NONE)
         {
-            MessageLog::Entry* const near_entry = log.get_entry_near(message_id);
+            MessageLog::Entry* near_entry = nullptr;
+            if (is_filtering())
+            {
+                update_filter_matches();
+                const size_t match_count = filter_matches.get_count();
+                if (match_count >= 1)
+                {
+                    size_t match_idx = filter_matches.find_ceiling(message_id);
+                    if (match_idx >= match_count)
+                    {
+                        match_idx = match_count - 1;
+                    }
+                    near_entry = log.get_entry(filter_matches.get_id(match_idx));
+                }
+            }
+            else
+            {
+                near_entry = log.get_entry_near(message_id);
+            }
+
             if (near_entry != nullptr)
             {
                 message_id = near_entry->get_id();
@@ -467,3 +566,134 @@ MessageMap& MDspLogViewer::get_selected_log_entries() noexcept
         dsp_comp_hub.dsp_shared->selected_log_entries.get();
     return *map;
 }
+
+bool MDspLogViewer::execute_custom_command(const std::string& command, StringTokenizer& tokenizer)
+{
+    bool accepted = false;
+    if (command == cmd_names::KEY_CMD_FILTER)
+    {
+        std::string query;
+        while (tokenizer.has_next())
+        {
+            if (!query.empty())
+            {
+                query += ' ';
+            }
+            query += tokenizer.next();
+        }
+
+        if (query.empty())
+        {
+            filter_query.clear();
+            filter_matches.clear();
+            accepted = true;
+        }
+        else
+        {
+            std::unique_lock<std::recursive_mutex> lock(log.queue_lock);
+
+            // Queries that do not contain any words are rejected
+            accepted = log.find_entries(query, filter_matches);
+            if (accepted)
+            {
+                filter_query = query;
+            }
+        }
+
+        if (accepted)
+        {
+            // The entry under the cursor may no longer be displayed
+            uint64_t& message_id = get_message_id();
+            message_id = MessageLog::ID_NONE;
+            set_page_nr(1);
+            dsp_comp_hub.dsp_selector->refresh_display();
+        }
+    }
+    return accepted;
+}
+
+bool MDspLogViewer::is_filtering() const noexcept
+{
+    return !filter_query.empty();
+}
+
+// Caller must hold the log's queue_lock
+// @throws std::bad_alloc
+void MDspLogViewer::update_filter_matches()
+{
+    log.find_entries(filter_query, filter_matches);
+}
+
+// Caller must hold the log's queue_lock and must have updated the filter matches
+size_t MDspLogViewer::get_first_match_index_on_page(const uint32_t lines_per_page)
+{
+    return navigation::get_first_item_index_on_page(
+        get_page_nr(), get_line_offset(), lines_per_page, filter_matches.get_count()
+    );
+}
+
+// Caller must hold the log's queue_lock
+// @throws std::bad_alloc
+void MDspLogViewer::display_filtered_list(const uint32_t lines_per_page)
+{
+    update_filter_matches();
+    display_filter_label();
+
+    const size_t match_count = filter_matches.get_count();
+    if (match_count >= 1)
+    {
+        const bool selecting = is_selecting();
+        size_t match_idx = 0;
+        if (is_cursor_nav())
+        {
+            // Display the page that contains the cursor, or the matching entry that follows the cursor
+            const uint64_t& message_id = get_message_id();
+            size_t cursor_idx = filter_matches.find_ceiling(message_id);
+            if (cursor_idx >= match_count)
+            {
+                cursor_idx = match_count - 1;
+            }
+            match_idx = (cursor_idx / lines_per_page) * lines_per_page;
+            set_page_nr(static_cast<uint32_t> (cursor_idx / lines_per_page) + 1);
+        }
+        else
+        {
+            match_idx = get_first_match_index_on_page(lines_per_page);
+        }
+
+        uint32_t current_line = LOG_LIST_Y;
+        uint32_t line_ctr = 0;
+        while (match_idx < match_count && line_ctr < lines_per_page)
+        {
+            MessageLog::Entry* const msg_entry = log.get_entry(filter_matches.get_id(match_idx));
+            if (msg_entry != nullptr)
+            {
+                write_log_line(msg_entry, selecting, current_line);
+                ++line_ctr;
+            }
+            ++match_idx;
+        }
+    }
+    else
+    {
+        dsp_comp_hub.dsp_io->cursor_xy(1, LOG_LIST_Y);
+        dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.active_color_table->norm.c_str());
+        dsp_comp_hub.dsp_io->write_text("No message log entries match the filter");
+    }
+    set_page_count(
+        dsp_comp_hub.dsp_common->calculate_page_count(
+            static_cast<uint32_t> (match_count),
+            lines_per_page
+        )
+    );
+}
+
+void MDspLogViewer::display_filter_label()
+{
+    dsp_comp_hub.dsp_io->cursor_xy(dsp_comp_hub.term_cols - DisplayConsts::PRB_MODE_X, DisplayConsts::PAGE_NAV_Y);
+    dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.active_color_table->status_label.c_str());
+    dsp_comp_hub.dsp_io->write_text("Filter:");
+    dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.active_color_table->rst.c_str());
+    dsp_comp_hub.dsp_io->write_text(" ");
+    dsp_comp_hub.dsp_io->write_string_field(filter_query, DisplayConsts::PRB_MODE_X - 8, false);
+}
@@ -3,9 +3,11 @@
 
 #include <default_types.h>
 #include <MessageLog.h>
+#include <TextIndex.h>
 #include <map_types.h>
 #include <terminal/MDspStdListBase.h>
 #include <functional>
+#include <string>
 
 class MDspLogViewer : public MDspStdListBase
 {
@@ -22,6 +24,7 @@ class MDspLogViewer : public MDspStdListBase
 
     virtual bool key_pressed(const uint32_t key) override;
     virtual bool mouse_action(MouseEvent& mouse) override;
+    virtual bool execute_custom_command(const std::string& command, StringTokenizer& tokenizer) override;
 
     virtual void display_activated() override;
     virtual void display_deactivated() override;
@@ -43,6 +46,25 @@ class MDspLogViewer : public MDspStdListBase
   private:
     MessageLog& log;
 
+    // Words that log entries must contain to be displayed, empty if all log entries are displayed
+    std::string         filter_query;
+    // Entries that match the filter query, only valid while holding the log's queue_lock
+    TextIndex::Matches  filter_matches;
+
+    bool is_filtering() const noexcept;
+    // Caller must hold the log's queue_lock
+    // @throws std::bad_alloc
+    void update_filter_matches();
+    // Returns the index of the first matching entry on the current page
+    // Caller must hold the log's queue_lock and must have updated the filter matches
+    size_t get_first_match_index_on_page(const uint32_t lines_per_page);
+    // Caller must hold the log's queue_lock
+    void display_all_entries(const uint32_t lines_per_page);
+    // Caller must hold the log's queue_lock
+    // @throws std::bad_alloc
+    void display_filtered_list(const uint32_t lines_per_page);
+    void display_filter_label();
+
     uint32_t get_lines_per_page() noexcept;
     void list_item_clicked(MouseEvent& mouse);
     void display_log_header();
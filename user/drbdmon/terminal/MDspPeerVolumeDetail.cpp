@@ -160,6 +160,9 @@ void MDspPeerVolumeDetail::display_content()
                                 dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.active_color_table->norm.c_str());
                                 dsp_comp_hub.dsp_io->write_text("Yes");
                             }
+                            ++current_line;
+
+                            dsp_comp_hub.dsp_common->display_volume_history(*vlm, true, current_line);
 
                             if (is_action_available())
                             {
@@ -1,5 +1,7 @@
 #include <terminal/MDspPgmInfo.h>
 #include <DrbdMonConsts.h>
+#include <objects/ObjectPools.h>
+#include <objects/VolumeHistory.h>
 
 const char* const MDspPgmInfo::PGM_INFO_TEXT =
     "Monitoring and administration utility for LINBIT(R) DRBD(R)\n"
@@ -45,6 +47,8 @@ void MDspPgmInfo::display_content()
     info_text.append("\n\n");
 
     info_text.append(PGM_INFO_TEXT);
+    append_memory_info(info_text);
+    append_refresh_info(info_text);
     format_text.set_text(&info_text);
 
     dsp_comp_hub.dsp_common->display_page_id(DisplayId::MDSP_PGM_INFO);
@@ -63,6 +67,69 @@ void MDspPgmInfo::display_content()
     }
 }
 
+// @throws std::bad_alloc
+void MDspPgmInfo::append_memory_info(std::string& info_text)
+{
+    info_text.append("\n");
+    info_text.append("\x1B\x04");
+    info_text.append("Object memory pools");
+    info_text.append("\x1B\xFF");
+    info_text.append("\n");
+    for (size_t idx = 0; idx < ObjectPools::POOL_COUNT; ++idx)
+    {
+        const SlabPool& pool = *(ObjectPools::POOLS[idx]);
+        info_text.append(ObjectPools::POOL_LABELS[idx]);
+        info_text.append(": ");
+        info_text.append(std::to_string(static_cast<unsigned long long> (pool.get_blocks_in_use())));
+        info_text.append(" in use, ");
+        info_text.append(std::to_string(static_cast<unsigned long long> (pool.get_slab_count())));
+        info_text.append(" slabs, ");
+        info_text.append(std::to_string(static_cast<unsigned long long> (pool.get_footprint() / 1024)));
+        info_text.append(" KiB\n");
+    }
+    info_text.append("Total: ");
+    info_text.append(std::to_string(static_cast<unsigned long long> (ObjectPools::get_footprint() / 1024)));
+    info_text.append(" KiB\n");
+    info_text.append("Volume histories: ");
+    info_text.append(std::to_string(static_cast<unsigned long long> (VolumeHistory::get_instance_count())));
+    info_text.append(" in use, ");
+    info_text.append(std::to_string(static_cast<unsigned long long> (VolumeHistory::get_footprint() / 1024)));
+    info_text.append(" KiB\n");
+}
+
+// @throws std::bad_alloc
+void MDspPgmInfo::append_refresh_info(std::string& info_text)
+{
+    const RefreshScheduler& refresh_sched = dsp_comp_hub.core_instance->get_refresh_scheduler();
+    info_text.append("\n");
+    info_text.append("\x1B\x04");
+    info_text.append("Display refresh");
+    info_text.append("\x1B\xFF");
+    info_text.append("\n");
+    info_text.append("Frame budget: ");
+    info_text.append(std::to_string(static_cast<unsigned int> (refresh_sched.get_frame_budget())));
+    info_text.append(" ms, current interval: ");
+    info_text.append(std::to_string(static_cast<unsigned int> (refresh_sched.get_interval())));
+    info_text.append(" ms\n");
+    info_text.append("Frames rendered: ");
+    info_text.append(std::to_string(static_cast<unsigned long long> (refresh_sched.get_frame_count())));
+    info_text.append(", deferred updates: ");
+    info_text.append(std::to_string(static_cast<unsigned long long> (refresh_sched.get_deferred_count())));
+    info_text.append("\n");
+    info_text.append("Render time: ");
+    info_text.append(std::to_string(static_cast<unsigned long long> (refresh_sched.get_last_render_usecs())));
+    info_text.append(" us last, ");
+    info_text.append(std::to_string(static_cast<unsigned long long> (refresh_sched.get_avg_render_usecs())));
+    info_text.append(" us average, ");
+    info_text.append(std::to_string(static_cast<unsigned long long> (refresh_sched.get_max_render_usecs())));
+    info_text.append(" us max\n");
+    info_text.append("Events per frame: ");
+    info_text.append(std::to_string(static_cast<unsigned long long> (refresh_sched.get_last_frame_events())));
+    info_text.append(" last, ");
+    info_text.append(std::to_string(static_cast<unsigned long long> (refresh_sched.get_max_frame_events())));
+    info_text.append(" max\n");
+}
+
 void MDspPgmInfo::enter_command_line_mode()
 {
 }
@@ -2,6 +2,7 @@
 #define MDSPPGMINFO_H
 
 #include <default_types.h>
+#include <string>
 #include <terminal/MDspBase.h>
 #include <terminal/TextColumn.h>
 
@@ -31,6 +32,13 @@ class MDspPgmInfo : public MDspBase
 
   private:
     TextColumn format_text;
+
+    // Appends the memory usage of the object pools to the information text
+    // @throws std::bad_alloc
+    void append_memory_info(std::string& info_text);
+    // Appends the display refresh statistics to the information text
+    // @throws std::bad_alloc
+    void append_refresh_info(std::string& info_text);
 };
 
 #endif /* MDSPPGMINFO_H */
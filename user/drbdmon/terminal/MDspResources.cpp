@@ -51,6 +51,7 @@ void MDspResources::reset_display()
 
 void MDspResources::display_list()
 {
+    dsp_rsc_count = 0;
     dsp_comp_hub.dsp_common->display_page_id(DisplayId::MDSP_RSC_LIST);
     display_rsc_header();
 
@@ -75,34 +76,14 @@ void MDspResources::display_at_cursor()
     const uint32_t lines_per_page = get_lines_per_page();
 
     ResourcesMap& selected_map = select_resources_map();
-    dsp_comp_hub.dsp_common->display_problem_mode_label(&selected_map == dsp_comp_hub.prb_rsc_map);
-    DrbdResource* const search_rsc = find_resource_near_cursor(selected_map);
-    if (search_rsc != nullptr)
+    display_map_label(selected_map);
+    ResourcesMap::Node* const search_node = find_resource_node_near_cursor(selected_map);
+    if (search_node != nullptr)
     {
         uint32_t rsc_idx = 0;
-        uint32_t page_line_ctr  = 0;
-        ResourcesMap::Node* page_first_node = nullptr;
-        {
-            ResourcesMap::NodesIterator nodes_iter(selected_map);
-            while (nodes_iter.has_next())
-            {
-                ResourcesMap::Node* const cur_node = nodes_iter.next();
-                if (page_line_ctr == 0)
-                {
-                    page_first_node = cur_node;
-                }
-                if (search_rsc == cur_node->get_value())
-                {
-                    break;
-                }
-                ++rsc_idx;
-                ++page_line_ctr;
-                if (page_line_ctr >= lines_per_page)
-                {
-                    page_line_ctr = 0;
-                }
-            }
-        }
+        ResourcesMap::Node* const page_first_node = navigation::find_first_node_on_cursor_page(
+            search_node, selected_map, lines_per_page, rsc_idx
+        );
 
         set_page_nr((rsc_idx / lines_per_page) + 1);
         set_page_count(
@@ -130,7 +111,7 @@ void MDspResources::display_at_cursor()
 
         if (line_nr == 0)
         {
-            write_no_resources_line(&selected_map == dsp_comp_hub.prb_rsc_map);
+            write_no_resources_line(selected_map);
         }
     }
     else
@@ -138,7 +119,7 @@ void MDspResources::display_at_cursor()
         // Zero resources
         set_page_nr(1);
         set_line_offset(0);
-        write_no_resources_line(&selected_map == dsp_comp_hub.prb_rsc_map);
+        write_no_resources_line(selected_map);
     }
 
     display_common_unfiltered_stats();
@@ -147,7 +128,7 @@ void MDspResources::display_at_cursor()
 void MDspResources::display_at_page()
 {
     ResourcesMap& dsp_rsc_map = select_resources_map();
-    dsp_comp_hub.dsp_common->display_problem_mode_label(&dsp_rsc_map == dsp_comp_hub.prb_rsc_map);
+    display_map_label(dsp_rsc_map);
 
     const uint32_t lines_per_page = get_lines_per_page();
     set_page_count(
@@ -157,28 +138,58 @@ void MDspResources::display_at_page()
         )
     );
 
-    ResourcesMap::ValuesIterator rsc_iter(dsp_rsc_map);
-    navigation::find_first_item_on_page(get_page_nr(), get_line_offset(), lines_per_page, rsc_iter);
+    ResourcesMap::Node* const page_first_node = navigation::find_first_node_on_page(
+        get_page_nr(), get_line_offset(), lines_per_page, dsp_rsc_map
+    );
 
     // Display all resources on the selected page, or the last page that shows any resources
-    const bool selecting = dsp_comp_hub.dsp_shared->have_resources_selection();
     uint32_t line_nr = 0;
-    uint32_t current_line = RSC_LIST_Y;
-    while (rsc_iter.has_next() && line_nr < lines_per_page)
+    if (page_first_node != nullptr)
     {
-        DrbdResource* const rsc = rsc_iter.next();
-        write_resource_line(rsc, current_line, selecting);
-        ++line_nr;
+        const bool selecting = dsp_comp_hub.dsp_shared->have_resources_selection();
+        uint32_t current_line = RSC_LIST_Y;
+        ResourcesMap::ValuesIterator rsc_iter(dsp_rsc_map, *page_first_node);
+        while (rsc_iter.has_next() && line_nr < lines_per_page)
+        {
+            DrbdResource* const rsc = rsc_iter.next();
+            write_resource_line(rsc, current_line, selecting);
+            ++line_nr;
+        }
     }
 
     if (line_nr == 0)
     {
-        write_no_resources_line(&dsp_rsc_map == dsp_comp_hub.prb_rsc_map);
+        write_no_resources_line(dsp_rsc_map);
     }
 
     display_common_unfiltered_stats();
 }
 
+void MDspResources::display_map_label(const ResourcesMap& selected_map)
+{
+    const ResourceFilter* const rsc_filter = dsp_comp_hub.core_instance->get_resource_filter();
+    if (rsc_filter != nullptr && &selected_map == dsp_comp_hub.flt_rsc_map)
+    {
+        dsp_comp_hub.dsp_io->cursor_xy(
+            dsp_comp_hub.term_cols - DisplayConsts::PRB_MODE_X,
+            DisplayConsts::PAGE_NAV_Y
+        );
+        dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.active_color_table->status_label.c_str());
+        dsp_comp_hub.dsp_io->write_text("Filter:");
+        dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.active_color_table->rst.c_str());
+        dsp_comp_hub.dsp_io->write_text(" ");
+        dsp_comp_hub.dsp_io->write_string_field(
+            rsc_filter->get_expression(),
+            DisplayConsts::PRB_MODE_X - 8,
+            false
+        );
+    }
+    else
+    {
+        dsp_comp_hub.dsp_common->display_problem_mode_label(&selected_map == dsp_comp_hub.prb_rsc_map);
+    }
+}
+
 void MDspResources::display_common_unfiltered_stats()
 {
     dsp_comp_hub.dsp_io->cursor_xy(1, dsp_comp_hub.term_rows - 2);
@@ -206,12 +217,12 @@ void MDspResources::reset_cursor_position()
     cursor_rsc.clear();
     const uint32_t lines_per_page = get_lines_per_page();
     ResourcesMap& rsc_map = select_resources_map();
-    ResourcesMap::ValuesIterator rsc_iter(rsc_map);
-    navigation::find_first_item_on_page(get_page_nr(), get_line_offset(), lines_per_page, rsc_iter);
-    if (rsc_iter.has_next())
+    ResourcesMap::Node* const page_first_node = navigation::find_first_node_on_page(
+        get_page_nr(), get_line_offset(), lines_per_page, rsc_map
+    );
+    if (page_first_node != nullptr)
     {
-        const DrbdResource* const rsc = rsc_iter.next();
-        cursor_rsc = rsc->get_name();
+        cursor_rsc = *(page_first_node->get_key());
     }
 }
 
@@ -227,6 +238,8 @@ bool MDspResources::is_selecting()
 
 void MDspResources::write_resource_line(DrbdResource* const rsc, uint32_t& current_line, const bool selecting)
 {
+    record_displayed_resource(rsc);
+
     DisplayIo* const dsp_io = dsp_comp_hub.dsp_io;
     dsp_io->cursor_xy(1, current_line);
     const std::string& rsc_name = rsc->get_name();
@@ -468,11 +481,16 @@ void MDspResources::write_resource_line(DrbdResource* const rsc, uint32_t& curre
     ++current_line;
 }
 
-void MDspResources::write_no_resources_line(const bool problem_mode_flag)
+void MDspResources::write_no_resources_line(const ResourcesMap& selected_map)
 {
     dsp_comp_hub.dsp_io->cursor_xy(1, RSC_LIST_Y);
     dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.active_color_table->norm.c_str());
-    if (problem_mode_flag)
+    if (&selected_map == dsp_comp_hub.flt_rsc_map)
+    {
+        dsp_comp_hub.dsp_io->write_text("No resources match the filter");
+    }
+    else
+    if (&selected_map == dsp_comp_hub.prb_rsc_map)
     {
         dsp_comp_hub.dsp_io->write_text("No resources with problem status");
     }
@@ -590,6 +608,45 @@ bool MDspResources::mouse_action(MouseEvent& mouse)
 bool MDspResources::execute_custom_command(const std::string& command, StringTokenizer& tokenizer)
 {
     bool accepted = false;
+    if (command == cmd_names::KEY_CMD_FILTER)
+    {
+        std::string filter_expr;
+        while (tokenizer.has_next())
+        {
+            if (!filter_expr.empty())
+            {
+                filter_expr += ' ';
+            }
+            filter_expr += tokenizer.next();
+        }
+
+        dsp_comp_hub.dsp_common->application_working();
+        try
+        {
+            std::unique_ptr<ResourceFilter> rsc_filter;
+            if (!filter_expr.empty())
+            {
+                rsc_filter = std::unique_ptr<ResourceFilter>(new ResourceFilter(filter_expr));
+            }
+            dsp_comp_hub.core_instance->set_resource_filter(std::move(rsc_filter));
+            set_page_nr(1);
+            accepted = true;
+        }
+        catch (ResourceFilter::SyntaxException& syntax_exc)
+        {
+            std::string error_msg(cmd_names::KEY_CMD_FILTER);
+            error_msg += " command rejected: ";
+            error_msg += syntax_exc.get_error_msg();
+            dsp_comp_hub.log->add_entry(MessageLog::log_level::ALERT, error_msg);
+        }
+        catch (string_matching::PatternLimitException&)
+        {
+            std::string error_msg(cmd_names::KEY_CMD_FILTER);
+            error_msg += " command rejected: Excessive number of wildcard characters";
+            dsp_comp_hub.log->add_entry(MessageLog::log_level::ALERT, error_msg);
+        }
+    }
+    else
     if (command == cmd_names::KEY_CMD_CURSOR)
     {
         if (tokenizer.has_next())
@@ -705,19 +762,20 @@ void MDspResources::list_item_clicked(MouseEvent& mouse)
 {
     const uint32_t lines_per_page = get_lines_per_page();
     ResourcesMap& selected_map = select_resources_map();
-    ResourcesMap::ValuesIterator rsc_iter(selected_map);
-    navigation::find_first_item_on_page(get_page_nr(), get_line_offset(), lines_per_page, rsc_iter);
+    ResourcesMap::Node* const page_first_node = navigation::find_first_node_on_page(
+        get_page_nr(), get_line_offset(), lines_per_page, selected_map
+    );
 
     const uint32_t selected_line = mouse.coord_row - RSC_LIST_Y;
-    uint32_t line_ctr = 0;
-    while (rsc_iter.has_next() && line_ctr < selected_line)
+    ResourcesMap::Node* selected_node = nullptr;
+    if (page_first_node != nullptr)
     {
-        rsc_iter.next();
-        ++line_ctr;
+        const size_t selected_idx = selected_map.get_node_index(page_first_node) + selected_line;
+        selected_node = selected_map.get_node_at_index(selected_idx);
     }
-    if (rsc_iter.has_next())
+    if (selected_node != nullptr)
     {
-        DrbdResource* const selected_rsc = rsc_iter.next();
+        DrbdResource* const selected_rsc = selected_node->get_value();
         cursor_rsc = selected_rsc->get_name();
         if (mouse.coord_column <= DisplayConsts::MAX_SELECT_X)
         {
@@ -732,15 +790,21 @@ uint32_t MDspResources::get_lines_per_page()
     return dsp_comp_hub.term_rows - RSC_LIST_Y - 2;
 }
 
-DrbdResource* MDspResources::find_resource_near_cursor(ResourcesMap& selected_map)
+ResourcesMap::Node* MDspResources::find_resource_node_near_cursor(ResourcesMap& selected_map)
 {
-    return (cursor_rsc.length() >= 1 ? navigation::find_item_near_cursor(selected_map, &cursor_rsc) : nullptr);
+    return (cursor_rsc.length() >= 1 ? navigation::find_node_near_cursor(selected_map, &cursor_rsc) : nullptr);
 }
 
+// The filtered resources map takes precedence over the problem mode
 ResourcesMap& MDspResources::select_resources_map() const
 {
     ResourcesMap* selected_map = dsp_comp_hub.rsc_map;
     DisplayCommon::problem_mode_type problem_mode = dsp_comp_hub.dsp_common->get_problem_mode();
+    if (dsp_comp_hub.core_instance->get_resource_filter() != nullptr)
+    {
+        selected_map = dsp_comp_hub.flt_rsc_map;
+    }
+    else
     if (
         problem_mode == DisplayCommon::problem_mode_type::LOCK ||
         (problem_mode == DisplayCommon::problem_mode_type::AUTO &&
@@ -829,3 +893,34 @@ uint64_t MDspResources::get_update_mask() noexcept
     return update_event::UPDATE_FLAG_DRBD;
 }
 
+bool MDspResources::is_drbd_content_changed(const uint64_t since_seq)
+{
+    // The number of resources, the number of problem resources and the selection of the displayed resources
+    // only change with changes that count as changes of every resource
+    DrbdMonCore* const core_instance = dsp_comp_hub.core_instance;
+    bool changed = core_instance->is_resource_changed_since(NameTable::INVALID_HANDLE, since_seq);
+    for (uint32_t idx = 0; idx < dsp_rsc_count && !changed; ++idx)
+    {
+        changed = core_instance->is_resource_changed_since(dsp_rsc_handles[idx], since_seq);
+    }
+    return changed;
+}
+
+// @throws std::bad_alloc
+void MDspResources::record_displayed_resource(DrbdResource* const rsc)
+{
+    if (dsp_rsc_count >= dsp_rsc_capacity)
+    {
+        const uint32_t new_capacity = dsp_rsc_capacity > 0 ? dsp_rsc_capacity * 2 : 64;
+        std::unique_ptr<NameTable::handle[]> new_handles(new NameTable::handle[new_capacity]);
+        for (uint32_t idx = 0; idx < dsp_rsc_count; ++idx)
+        {
+            new_handles[idx] = dsp_rsc_handles[idx];
+        }
+        dsp_rsc_handles = std::move(new_handles);
+        dsp_rsc_capacity = new_capacity;
+    }
+    dsp_rsc_handles[dsp_rsc_count] = rsc->get_name_handle();
+    ++dsp_rsc_count;
+}
+
@@ -6,6 +6,7 @@
 #include <terminal/MDspStdListBase.h>
 #include <terminal/MouseEvent.h>
 #include <objects/DrbdResource.h>
+#include <objects/ResourceFilter.h>
 #include <map_types.h>
 #include <string>
 #include <memory>
@@ -43,10 +44,16 @@ class MDspResources : public MDspStdListBase
     virtual void notify_data_updated() override;
 
     virtual uint64_t get_update_mask() noexcept override;
+    virtual bool is_drbd_content_changed(const uint64_t since_seq) override;
 
   private:
     std::string cursor_rsc;
 
+    // Name handles of the resources shown by the last display update
+    std::unique_ptr<NameTable::handle[]>    dsp_rsc_handles;
+    uint32_t                                dsp_rsc_capacity    {0};
+    uint32_t                                dsp_rsc_count       {0};
+
     std::function<bool(DrbdResource*)>  problem_filter;
 
     void display_rsc_header();
@@ -55,13 +62,16 @@ class MDspResources : public MDspStdListBase
     void display_common_unfiltered_stats();
     void list_item_clicked(MouseEvent& mouse);
     void write_resource_line(DrbdResource* const rsc, uint32_t& current_line, const bool selecting);
-    void write_no_resources_line(const bool problem_mode_flag);
+    // @throws std::bad_alloc
+    void record_displayed_resource(DrbdResource* const rsc);
+    void write_no_resources_line(const ResourcesMap& selected_map);
+    void display_map_label(const ResourcesMap& selected_map);
     bool is_problem_mode(DrbdResource* const rsc);
     // @throws std::bad_alloc, string_matching::PatternLimitException
     bool change_selection(const std::string& pattern_text, const bool select_flag);
 
     uint32_t get_lines_per_page();
-    DrbdResource* find_resource_near_cursor(ResourcesMap& selected_map);
+    ResourcesMap::Node* find_resource_node_near_cursor(ResourcesMap& selected_map);
     ResourcesMap& select_resources_map() const;
 };
 
@@ -158,3 +158,11 @@ void MDspStdListBase::last_page()
     }
     dsp_comp_hub.dsp_selector->refresh_display();
 }
+
+bool MDspStdListBase::is_monitor_resource_changed(const uint64_t since_seq)
+{
+    // If the monitored resource does not exist, only the creation or renaming of a resource can change the display
+    DrbdResource* const rsc = dsp_comp_hub.get_monitor_resource();
+    const NameTable::handle rsc_name_handle = rsc != nullptr ? rsc->get_name_handle() : NameTable::INVALID_HANDLE;
+    return dsp_comp_hub.core_instance->is_resource_changed_since(rsc_name_handle, since_seq);
+}
@@ -38,6 +38,11 @@ class MDspStdListBase : public MDspBase
     virtual void toggle_select_cursor_item() = 0;
     virtual void clear_selection() = 0;
 
+  protected:
+    // Indicates whether the resource selected for monitoring, or any of its connections or volumes,
+    // changed since the specified DRBD change sequence number
+    bool is_monitor_resource_changed(const uint64_t since_seq);
+
   private:
     bool list_focused       {false};
 };
@@ -2,6 +2,8 @@
 #include <terminal/DisplayUpdateEvent.h>
 #include <terminal/KeyCodes.h>
 #include <terminal/HelpText.h>
+#include <terminal/GlobalCommandConsts.h>
+#include <subprocess/DrbdCmdResult.h>
 #include <string_transformations.h>
 
 MDspTaskDetail::MDspTaskDetail(const ComponentsHub& comp_hub):
@@ -27,6 +29,10 @@ void MDspTaskDetail::display_content()
     {
         std::unique_ptr<std::string> proc_stdout;
         std::unique_ptr<std::string> proc_stderr;
+        bool stdout_truncated = false;
+        bool stderr_truncated = false;
+        std::unique_ptr<std::string[]> proc_targets;
+        size_t target_count = 0;
 
         std::mutex& queue_lock = dsp_comp_hub.sub_proc_queue->get_queue_lock();
         std::unique_lock<std::mutex> lock(queue_lock);
@@ -67,8 +73,26 @@ void MDspTaskDetail::display_content()
                         proc_stdout = std::unique_ptr<std::string>(new std::string());
                         proc_stderr = std::unique_ptr<std::string>(new std::string());
 
-                        *proc_stdout = task_proc->get_stdout_output();
-                        *proc_stderr = task_proc->get_stderr_output();
+                        const OutputRingBuffer& stdout_buffer = task_proc->get_stdout_output();
+                        const OutputRingBuffer& stderr_buffer = task_proc->get_stderr_output();
+                        stdout_buffer.copy_to(*proc_stdout);
+                        stderr_buffer.copy_to(*proc_stderr);
+                        stdout_truncated = stdout_buffer.get_discarded_length() > 0;
+                        stderr_truncated = stderr_buffer.get_discarded_length() > 0;
+
+                        const CmdLine* const command = task_entry->get_command();
+                        if (command != nullptr && command->get_target_count() > 0)
+                        {
+                            proc_targets = std::unique_ptr<std::string[]>(
+                                new std::string[command->get_target_count()]
+                            );
+                            VList<std::string>::ValuesIterator target_iter = command->get_target_iterator();
+                            while (target_iter.has_next())
+                            {
+                                proc_targets[target_count] = *(target_iter.next());
+                                ++target_count;
+                            }
+                        }
                     }
                 }
 
@@ -123,12 +147,47 @@ void MDspTaskDetail::display_content()
                 const bool have_proc_stderr = proc_stderr_length > 0;
 
                 proc_info.append("\n\n");
+                if (target_count > 0)
+                {
+                    // Results for each of the objects that a batched command operated on
+                    proc_info.append("\x1B\x02" "Results:" "\x1B\xFF" "\n");
+                    for (size_t idx = 0; idx < target_count; ++idx)
+                    {
+                        const std::string& target = proc_targets[idx];
+                        drbdcmd::target_result result = drbdcmd::get_target_result(target, exit_code, *proc_stderr);
+                        if (result == drbdcmd::target_result::UNKNOWN)
+                        {
+                            result = drbdcmd::get_target_result(target, exit_code, *proc_stdout);
+                        }
+
+                        proc_info.append(target);
+                        if (result == drbdcmd::target_result::SUCCEEDED)
+                        {
+                            proc_info.append(": Succeeded\n");
+                        }
+                        else
+                        if (result == drbdcmd::target_result::FAILED)
+                        {
+                            proc_info.append(": Failed\n");
+                        }
+                        else
+                        {
+                            proc_info.append(": Unknown\n");
+                        }
+                    }
+                    proc_info.append("\n\n");
+                }
+
                 if (have_proc_stdout || have_proc_stderr)
                 {
                     proc_info.reserve(proc_info.length() + proc_stdout_length + proc_stderr_length + 0x400);
                     if (have_proc_stdout)
                     {
                         proc_info.append("\x1B\x02" "Process stdout output:" "\x1B\xFF" "\n");
+                        if (stdout_truncated)
+                        {
+                            proc_info.append("(Earlier output was discarded)\n");
+                        }
                         proc_info.append(filtered_stdout);
                     }
                     else
@@ -140,6 +199,10 @@ void MDspTaskDetail::display_content()
                     {
                         proc_info.append("\n\n");
                         proc_info.append("\x1B\x02" "Process stderr output:" "\x1B\xFF" "\n");
+                        if (stderr_truncated)
+                        {
+                            proc_info.append("(Earlier output was discarded)\n");
+                        }
                         proc_info.append(filtered_stderr);
                     }
                     else
@@ -238,15 +301,32 @@ void MDspTaskDetail::display_content()
             {
                 format_text.restart();
                 format_text.set_line_length(dsp_comp_hub.term_cols);
+                line_index.clear();
+                std::string index_line;
                 uint32_t line_ctr = 0;
-                while (format_text.skip_line())
+                while (format_text.next_line(index_line, dsp_comp_hub.active_color_table->rst))
                 {
+                    line_index.add_text(line_ctr, index_line);
                     ++line_ctr;
                 }
                 page_count = dsp_comp_hub.dsp_common->calculate_page_count(
                     line_ctr + first_page_lines, lines_per_page
                 );
                 set_page_count(page_count);
+                saved_term_cols = dsp_comp_hub.term_cols;
+                saved_term_rows = dsp_comp_hub.term_rows;
+
+                if (have_search_line)
+                {
+                    // Line numbers change if the text is formatted differently, search again
+                    search_start_line = 0;
+                    search_pending = true;
+                }
+            }
+
+            if (search_pending)
+            {
+                search_text(first_page_lines, lines_per_page);
             }
 
             uint32_t page_nr = get_page_nr();
@@ -259,9 +339,11 @@ void MDspTaskDetail::display_content()
             // Skip to the selected page
             uint32_t page_ctr = 1;
             uint32_t page_line_ctr = first_page_lines;
+            uint32_t text_line_nr = 0;
             format_text.restart();
             while (page_ctr < page_nr && format_text.skip_line())
             {
+                ++text_line_nr;
                 ++page_line_ctr;
                 if (page_line_ctr >= lines_per_page)
                 {
@@ -272,12 +354,33 @@ void MDspTaskDetail::display_content()
 
             std::string line;
             uint32_t line_ctr = page_nr == 1 ? line_offset : 0;
-            while (format_text.next_line(line, dsp_comp_hub.active_color_table->rst) && line_ctr < lines_per_page)
+            bool have_line = true;
+            while (have_line && line_ctr < lines_per_page)
             {
-                dsp_comp_hub.dsp_io->cursor_xy(1, current_line);
-                dsp_comp_hub.dsp_io->write_text(line.c_str());
-                ++current_line;
-                ++line_ctr;
+                // The line that matched the last search is highlighted, therefore, its text color
+                // must not reset the background color
+                const bool is_search_line = have_search_line && text_line_nr == search_line;
+                have_line = format_text.next_line(
+                    line,
+                    is_search_line ? dsp_comp_hub.active_color_table->rst_fg : dsp_comp_hub.active_color_table->rst
+                );
+                if (have_line)
+                {
+                    dsp_comp_hub.dsp_io->cursor_xy(1, current_line);
+                    if (is_search_line)
+                    {
+                        dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.active_color_table->bg_marked.c_str());
+                        dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.ansi_ctl->ANSI_CLEAR_LINE.c_str());
+                    }
+                    dsp_comp_hub.dsp_io->write_text(line.c_str());
+                    if (is_search_line)
+                    {
+                        dsp_comp_hub.dsp_io->write_text(dsp_comp_hub.active_color_table->rst.c_str());
+                    }
+                    ++current_line;
+                    ++line_ctr;
+                    ++text_line_nr;
+                }
             }
         }
         else
@@ -365,6 +468,66 @@ bool MDspTaskDetail::key_pressed(const uint32_t key)
     return intercepted;
 }
 
+bool MDspTaskDetail::execute_custom_command(const std::string& command, StringTokenizer& tokenizer)
+{
+    bool accepted = false;
+    if (command == cmd_names::KEY_CMD_SEARCH)
+    {
+        std::string query;
+        while (tokenizer.has_next())
+        {
+            if (!query.empty())
+            {
+                query += ' ';
+            }
+            query += tokenizer.next();
+        }
+
+        if (!query.empty())
+        {
+            search_query = query;
+            search_start_line = 0;
+            accepted = true;
+        }
+        else
+        if (!search_query.empty())
+        {
+            // Continue with the line after the last matching line
+            search_start_line = have_search_line ? search_line + 1 : 0;
+            accepted = true;
+        }
+
+        if (accepted)
+        {
+            // The search is performed when the display is updated, because the text is formatted at that time
+            search_pending = true;
+            dsp_comp_hub.dsp_selector->refresh_display();
+        }
+    }
+    return accepted;
+}
+
+// @throws std::bad_alloc
+void MDspTaskDetail::search_text(const uint32_t first_page_lines, const uint32_t lines_per_page)
+{
+    search_pending = false;
+    have_search_line = false;
+    line_index.find(search_query, search_matches);
+    const size_t match_count = search_matches.get_count();
+    if (match_count >= 1)
+    {
+        size_t match_idx = search_matches.find_ceiling(search_start_line);
+        if (match_idx >= match_count)
+        {
+            // Continue with the first match
+            match_idx = 0;
+        }
+        search_line = static_cast<uint32_t> (search_matches.get_id(match_idx));
+        have_search_line = true;
+        set_page_nr((first_page_lines + search_line) / lines_per_page + 1);
+    }
+}
+
 void MDspTaskDetail::text_cursor_ops()
 {
     // no-op; prevents MDspMenuBase from positioning the cursor for the option field, which is not used
@@ -398,6 +561,13 @@ void MDspTaskDetail::reset()
     proc_info.clear();
     task_state          = SubProcessQueue::entry_state_type::INVALID_ID;
     saved_task_id       = SubProcessQueue::TASKQ_NONE;
+    line_index.clear();
+    search_matches.clear();
+    search_query.clear();
+    search_start_line   = 0;
+    search_line         = 0;
+    search_pending      = false;
+    have_search_line    = false;
 }
 
 bool MDspTaskDetail::is_task_state(const uint64_t task_id, const SubProcessQueue::entry_state_type query_task_state)
@@ -5,6 +5,7 @@
 #include <terminal/MDspMenuBase.h>
 #include <terminal/TextColumn.h>
 #include <subprocess/SubProcessQueue.h>
+#include <TextIndex.h>
 #include <string>
 
 class MDspTaskDetail : public MDspMenuBase
@@ -16,6 +17,7 @@ class MDspTaskDetail : public MDspMenuBase
     virtual void display_content() override;
     virtual uint64_t get_update_mask() noexcept override;
     virtual bool key_pressed(const uint32_t key) override;
+    virtual bool execute_custom_command(const std::string& command, StringTokenizer& tokenizer) override;
 
     virtual void text_cursor_ops() override;
 
@@ -35,6 +37,17 @@ class MDspTaskDetail : public MDspMenuBase
     std::string proc_info;
     SubProcessQueue::entry_state_type task_state {SubProcessQueue::entry_state_type::INVALID_ID};
 
+    // Index of the words in the formatted lines of text, rebuilt whenever the text is formatted
+    TextIndex           line_index;
+    TextIndex::Matches  search_matches;
+    std::string         search_query;
+    // Number of the first text line that may match a pending search
+    uint32_t            search_start_line   {0};
+    // Number of the text line that matched the last search
+    uint32_t            search_line         {0};
+    bool                search_pending      {false};
+    bool                have_search_line    {false};
+
     std::function<void()>   cmd_fn_suspend;
     std::function<void()>   cmd_fn_make_pending;
     std::function<void()>   cmd_fn_terminate;
@@ -51,6 +64,10 @@ class MDspTaskDetail : public MDspMenuBase
     void opt_remove();
 
     void reset();
+    // Finds the first line that matches the search query, starting at search_start_line,
+    // and selects the page that contains the line
+    // @throws std::bad_alloc
+    void search_text(const uint32_t first_page_lines, const uint32_t lines_per_page);
     bool is_task_state(const uint64_t task_id, const SubProcessQueue::entry_state_type task_state);
 
     uint32_t get_lines_per_page() noexcept;
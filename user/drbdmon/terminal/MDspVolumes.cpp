@@ -847,3 +847,8 @@ uint64_t MDspVolumes::get_update_mask() noexcept
 {
     return update_event::UPDATE_FLAG_DRBD;
 }
+
+bool MDspVolumes::is_drbd_content_changed(const uint64_t since_seq)
+{
+    return is_monitor_resource_changed(since_seq);
+}
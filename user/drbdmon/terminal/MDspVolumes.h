@@ -46,6 +46,7 @@ class MDspVolumes : public MDspStdListBase
     virtual void notify_data_updated() override;
 
     virtual uint64_t get_update_mask() noexcept override;
+    virtual bool is_drbd_content_changed(const uint64_t since_seq) override;
 
   private:
     std::string displayed_rsc;
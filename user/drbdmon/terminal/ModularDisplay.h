@@ -49,6 +49,10 @@ class ModularDisplay
 
     // Returns the display update mask describing the events that will cause this display to be updated
     virtual uint64_t get_update_mask() noexcept = 0;
+
+    // Indicates whether any of the DRBD objects shown by this display changed since the specified
+    // DRBD change sequence number
+    virtual bool is_drbd_content_changed(const uint64_t since_seq) = 0;
 };
 
 #endif /* MODULARDISPLAY_H */
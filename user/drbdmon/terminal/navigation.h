@@ -6,17 +6,15 @@
 
 namespace navigation
 {
-    // Advances the iterator to the first item on the selected page, or if that page is empty, instead to
-    // the first item on the last page that contains any items
-    template<typename I>
-    void find_first_item_on_page(
+    // Returns the index of the first item on the selected page, or if that page is empty, instead the index
+    // of the first item on the last page that contains any items
+    inline uint32_t get_first_item_index_on_page(
         const uint32_t  page_nr,
         const uint32_t  line_offset,
         const uint32_t  lines_per_page,
-        I&              item_iter
+        const size_t    item_count
     )
     {
-        const size_t item_count = item_iter.get_size();
         uint32_t search_item_idx = ((std::max(page_nr, static_cast<uint32_t> (1)) - 1) * lines_per_page) +
             line_offset;
         if (search_item_idx >= item_count)
@@ -27,6 +25,22 @@ namespace navigation
                 ((std::max(item_count, static_cast<size_t> (1)) - 1) / lines_per_page) * lines_per_page
             );
         }
+        return search_item_idx;
+    }
+
+    // Advances the iterator to the first item on the selected page, or if that page is empty, instead to
+    // the first item on the last page that contains any items
+    template<typename I>
+    void find_first_item_on_page(
+        const uint32_t  page_nr,
+        const uint32_t  line_offset,
+        const uint32_t  lines_per_page,
+        I&              item_iter
+    )
+    {
+        const uint32_t search_item_idx = get_first_item_index_on_page(
+            page_nr, line_offset, lines_per_page, item_iter.get_size()
+        );
         uint32_t item_idx = 0;
         while (item_iter.has_next() && item_idx < search_item_idx)
         {
@@ -35,6 +49,38 @@ namespace navigation
         }
     }
 
+    // Returns the map's node for the first item on the selected page, or if that page is empty, instead
+    // the node for the first item on the last page that contains any items.
+    // Returns nullptr if the map is empty.
+    // Looks up the node by its index, which is O(log n) for maps that track the index of their nodes.
+    template<typename M>
+    typename M::Node* find_first_node_on_page(
+        const uint32_t  page_nr,
+        const uint32_t  line_offset,
+        const uint32_t  lines_per_page,
+        const M&        map
+    )
+    {
+        const uint32_t search_item_idx = get_first_item_index_on_page(
+            page_nr, line_offset, lines_per_page, map.get_size()
+        );
+        return map.get_node_at_index(search_item_idx);
+    }
+
+    // Returns the map's node for the first item on the page that shows the specified node, and sets
+    // item_idx to the index of the specified node
+    template<typename M>
+    typename M::Node* find_first_node_on_cursor_page(
+        const typename M::Node* const   cursor_node,
+        const M&                        map,
+        const uint32_t                  lines_per_page,
+        uint32_t&                       item_idx
+    )
+    {
+        item_idx = static_cast<uint32_t> (map.get_node_index(cursor_node));
+        return map.get_node_at_index((item_idx / lines_per_page) * lines_per_page);
+    }
+
     template<typename I, typename K>
     I* find_first_item_on_cursor_page(
         const K&                        cursor_key,
@@ -191,23 +237,23 @@ namespace navigation
         return page_first_item;
     }
 
-    // Selects the item closest to the cursor if it exists.
+    // Selects the node of the item closest to the cursor if it exists.
     // The selection order is:
-    // 1. the item selected by the cursor
-    // 2. its successor item
-    // 3. its predecessor item
+    // 1. the node of the item selected by the cursor
+    // 2. the node of its successor item
+    // 3. the node of its predecessor item
     // 4. nullptr, since there are zero items
     template<template<typename, typename> class M, typename K, typename V>
-    V* find_item_near_cursor(M<K, V>& map, const K* const key)
+    typename M<K, V>::Node* find_node_near_cursor(M<K, V>& map, const K* const key)
     {
-        V* search_item = map.get_ceiling_value(key);
-        if (search_item == nullptr)
+        typename M<K, V>::Node* search_node = map.get_ceiling_node(key);
+        if (search_node == nullptr)
         {
             // Item name under cursor not in map and no successor item
             // Select predecessor item
-            search_item = map.get_floor_value(key);
+            search_node = map.get_floor_node(key);
         }
-        return search_item;
+        return search_node;
     }
 }
 
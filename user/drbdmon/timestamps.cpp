@@ -0,0 +1,139 @@
+#include <timestamps.h>
+
+extern "C"
+{
+    #include <time.h>
+}
+
+namespace timestamps
+{
+    static bool parse_digits(
+        const std::string& text,
+        size_t& idx,
+        const size_t digit_count,
+        unsigned int& value
+    );
+
+    bool parse_timestamp(const std::string& timestamp, int64_t& usecs)
+    {
+        unsigned int year = 0;
+        unsigned int month = 0;
+        unsigned int day = 0;
+        unsigned int hour = 0;
+        unsigned int minute = 0;
+        unsigned int second = 0;
+        int64_t fraction = 0;
+
+        size_t idx = 0;
+        const size_t length = timestamp.length();
+        bool result = parse_digits(timestamp, idx, 4, year) && idx < length && timestamp[idx++] == '-' &&
+            parse_digits(timestamp, idx, 2, month) && idx < length && timestamp[idx++] == '-' &&
+            parse_digits(timestamp, idx, 2, day);
+        if (result && idx < length && timestamp[idx] == 'T')
+        {
+            ++idx;
+            result = parse_digits(timestamp, idx, 2, hour) && idx < length && timestamp[idx++] == ':' &&
+                parse_digits(timestamp, idx, 2, minute);
+            if (result && idx < length && timestamp[idx] == ':')
+            {
+                ++idx;
+                result = parse_digits(timestamp, idx, 2, second);
+                if (result && idx < length && timestamp[idx] == '.')
+                {
+                    ++idx;
+                    const size_t fraction_begin = idx;
+                    int64_t scale = 1000000;
+                    while (idx < length && timestamp[idx] >= '0' && timestamp[idx] <= '9')
+                    {
+                        scale /= 10;
+                        fraction += (timestamp[idx] - '0') * scale;
+                        ++idx;
+                    }
+                    result = idx > fraction_begin;
+                }
+            }
+        }
+        result = result && year >= 1 && month >= 1 && month <= 12 && day >= 1 && day <= 31 &&
+            hour <= 23 && minute <= 59 && second <= 60;
+
+        if (result)
+        {
+            int64_t secs = 0;
+            if (idx < length && (timestamp[idx] == '+' || timestamp[idx] == '-' || timestamp[idx] == 'Z'))
+            {
+                const bool east = timestamp[idx] == '+';
+                unsigned int offset_hours = 0;
+                unsigned int offset_minutes = 0;
+                if (timestamp[idx] == 'Z')
+                {
+                    ++idx;
+                }
+                else
+                {
+                    ++idx;
+                    result = parse_digits(timestamp, idx, 2, offset_hours) && idx < length &&
+                        timestamp[idx++] == ':' && parse_digits(timestamp, idx, 2, offset_minutes) &&
+                        offset_hours <= 23 && offset_minutes <= 59;
+                }
+
+                // Days since the epoch in the proleptic Gregorian calendar
+                const int shifted_year = static_cast<int> (month <= 2 ? year - 1 : year);
+                const int era = shifted_year / 400;
+                const int year_of_era = shifted_year - era * 400;
+                const int day_of_year = (153 * static_cast<int> (month > 2 ? month - 3 : month + 9) + 2) / 5 +
+                    static_cast<int> (day) - 1;
+                const int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+                const int64_t days = static_cast<int64_t> (era) * 146097 + day_of_era - 719468;
+
+                const int64_t offset_secs = offset_hours * 3600 + offset_minutes * 60;
+                secs = days * 86400 + hour * 3600 + minute * 60 + second + (east ? -offset_secs : offset_secs);
+            }
+            else
+            {
+                // Local time, including daylight saving time if it applies at that time
+                struct tm local_time {};
+                local_time.tm_year = static_cast<int> (year) - 1900;
+                local_time.tm_mon = static_cast<int> (month) - 1;
+                local_time.tm_mday = static_cast<int> (day);
+                local_time.tm_hour = static_cast<int> (hour);
+                local_time.tm_min = static_cast<int> (minute);
+                local_time.tm_sec = static_cast<int> (second);
+                local_time.tm_isdst = -1;
+                const time_t local_secs = mktime(&local_time);
+                result = local_secs != static_cast<time_t> (-1);
+                secs = static_cast<int64_t> (local_secs);
+            }
+
+            // Reject trailing garbage
+            result = result && idx == length;
+            if (result)
+            {
+                usecs = secs * 1000000 + fraction;
+            }
+        }
+        return result;
+    }
+
+    // Parses exactly digit_count decimal digits starting at idx and advances idx
+    static bool parse_digits(
+        const std::string& text,
+        size_t& idx,
+        const size_t digit_count,
+        unsigned int& value
+    )
+    {
+        value = 0;
+        bool result = idx + digit_count <= text.length();
+        for (size_t count = 0; result && count < digit_count; ++count)
+        {
+            const char digit = text[idx];
+            result = digit >= '0' && digit <= '9';
+            if (result)
+            {
+                value = value * 10 + static_cast<unsigned int> (digit - '0');
+                ++idx;
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef TIMESTAMPS_H
+#define TIMESTAMPS_H
+
+#include <default_types.h>
+#include <string>
+
+namespace timestamps
+{
+    // Converts an ISO 8601 timestamp like drbdsetup's 2024-03-01T14:20:05.123456+01:00
+    // to microseconds since the epoch
+    //
+    // The seconds, the fraction and the time may be omitted, e.g. 2024-03-01T14:20 or 2024-03-01.
+    // A timestamp without an UTC offset is in local time.
+    //
+    // @return True if the timestamp is valid, false otherwise
+    bool parse_timestamp(const std::string& timestamp, int64_t& usecs);
+}
+
+#endif /* TIMESTAMPS_H */
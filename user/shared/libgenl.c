@@ -1,3 +1,4 @@
+#define _GNU_SOURCE /* recvmmsg() */
 #include "libgenl.h"
 
 #include <sys/types.h>
@@ -152,6 +153,139 @@ int genl_send(struct genl_sock *s, struct msg_buff *msg)
 	return do_send(s->s_fd, msg->data, n->nlmsg_len);
 }
 
+#ifdef HAVE_RECVMMSG
+#define GENL_RECV_BATCH 16
+
+struct genl_recv_batch {
+	unsigned int next; /* index of the next datagram to hand out */
+	unsigned int count; /* number of datagrams received */
+	struct mmsghdr msgs[GENL_RECV_BATCH];
+	struct iovec iovs[GENL_RECV_BATCH];
+	struct sockaddr_nl addrs[GENL_RECV_BATCH];
+};
+#endif
+
+int genl_enable_recv_batch(struct genl_sock *s)
+{
+#ifdef HAVE_RECVMMSG
+	struct genl_recv_batch *b;
+	int i;
+
+	if (s->s_recv_batch)
+		return 0;
+
+	b = calloc(1, sizeof(*b));
+	if (!b)
+		return -1;
+
+	for (i = 0; i < GENL_RECV_BATCH; i++) {
+		b->iovs[i].iov_len = GENL_RECV_BUF_SIZE;
+		b->iovs[i].iov_base = malloc(GENL_RECV_BUF_SIZE);
+		if (!b->iovs[i].iov_base) {
+			while (i--)
+				free(b->iovs[i].iov_base);
+			free(b);
+			return -1;
+		}
+		b->msgs[i].msg_hdr.msg_iov = &b->iovs[i];
+		b->msgs[i].msg_hdr.msg_iovlen = 1;
+		b->msgs[i].msg_hdr.msg_name = &b->addrs[i];
+	}
+	s->s_recv_batch = b;
+#endif
+	return 0;
+}
+
+bool genl_recv_pending(struct genl_sock *s)
+{
+#ifdef HAVE_RECVMMSG
+	struct genl_recv_batch *b = s->s_recv_batch;
+
+	return b && b->next < b->count;
+#else
+	return false;
+#endif
+}
+
+/* Wait until the socket is readable. Only used once the socket has been
+ * drained, so that a stream of messages costs one system call per batch. */
+static bool genl_wait_readable(struct genl_sock *s, int timeout_ms)
+{
+	struct pollfd pfd = {
+		.fd = s->s_fd,
+		.events = POLLIN,
+	};
+
+	return poll(&pfd, 1, timeout_ms) == 1 && (pfd.revents & POLLIN);
+}
+
+static int genl_recv_error(int n)
+{
+	if (errno == ENOBUFS) {
+		dbg(3, "recvmsg() returned ENOBUFS\n");
+		return -E_RCV_ENOBUFS;
+	}
+	dbg(3, "recvmsg() returned %d, errno = %d\n", n, errno);
+	return -E_RCV_FAILED;
+}
+
+#ifdef HAVE_RECVMMSG
+static int genl_recv_batched(struct genl_sock *s, struct iovec *iov, int timeout_ms)
+{
+	struct genl_recv_batch *b = s->s_recv_batch;
+	bool polled = false;
+	int i, n;
+
+	for (;;) {
+		while (b->next < b->count) {
+			struct mmsghdr *m = &b->msgs[b->next];
+			void *tmp;
+
+			i = b->next++;
+			if (m->msg_len > GENL_RECV_BUF_SIZE) {
+				dbg(3, "datagram of %u bytes truncated\n", m->msg_len);
+				return -E_RCV_MSG_TRUNC;
+			}
+			if (m->msg_hdr.msg_namelen != sizeof(struct sockaddr_nl))
+				return -E_RCV_NO_SOURCE_ADDR;
+			if (b->addrs[i].nl_pid != 0) {
+				dbg(3, "ignoring message from sender pid %u != 0\n",
+						b->addrs[i].nl_pid);
+				continue;
+			}
+
+			/* hand out the filled buffer instead of copying it */
+			tmp = iov->iov_base;
+			iov->iov_base = b->iovs[i].iov_base;
+			iov->iov_len = GENL_RECV_BUF_SIZE;
+			b->iovs[i].iov_base = tmp;
+			return m->msg_len;
+		}
+
+		b->next = b->count = 0;
+		for (i = 0; i < GENL_RECV_BATCH; i++)
+			b->msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_nl);
+
+		n = recvmmsg(s->s_fd, b->msgs, GENL_RECV_BATCH, MSG_DONTWAIT | MSG_TRUNC, NULL);
+		if (n < 0) {
+			if (errno == EINTR) {
+				dbg(3, "recvmmsg() returned EINTR, retrying\n");
+				continue;
+			} else if (errno == EAGAIN) {
+				if (polled || !genl_wait_readable(s, timeout_ms))
+					return 0; /* which is E_RCV_TIMEDOUT */
+				polled = true;
+				continue;
+			}
+			return genl_recv_error(n);
+		}
+		if (!n)
+			return 0;
+		b->count = n;
+	}
+}
+#endif
+
 /* "inspired" by libnl nl_recv()
  * You pass in one iovec, which may contain pre-allocated buffer space,
  * obtained by malloc(). It will be realloc()ed on demand.
@@ -161,8 +295,6 @@ int genl_send(struct genl_sock *s, struct msg_buff *msg)
 int genl_recv_timeout(struct genl_sock *s, struct iovec *iov, int timeout_ms)
 {
 	struct sockaddr_nl addr;
-	struct pollfd pfd;
-	int flags;
 	struct msghdr msg = {
 		.msg_name = &addr,
 		.msg_namelen = sizeof(struct sockaddr_nl),
@@ -172,25 +304,28 @@ int genl_recv_timeout(struct genl_sock *s, struct iovec *iov, int timeout_ms)
 		.msg_controllen = 0,
 		.msg_flags = 0,
 	};
+	bool polled = false;
 	int n;
 
-	if (!iov->iov_len) {
-		iov->iov_len = 8192;
-		iov->iov_base = malloc(iov->iov_len);
+	/* With a buffer that can hold any datagram the kernel sends, each
+	 * datagram is copied exactly once. */
+	if (iov->iov_len < GENL_RECV_BUF_SIZE) {
+		void *tmp = realloc(iov->iov_base, GENL_RECV_BUF_SIZE);
+		if (!tmp)
+			return -E_RCV_FAILED;
+		iov->iov_base = tmp;
+		iov->iov_len = GENL_RECV_BUF_SIZE;
 	}
 
-	flags = MSG_PEEK;
+#ifdef HAVE_RECVMMSG
+	if (s->s_recv_batch)
+		return genl_recv_batched(s, iov, timeout_ms);
+#endif
+
 retry:
-	pfd.fd = s->s_fd;
-	pfd.events = POLLIN;
-	if ((poll(&pfd, 1, timeout_ms) != 1) || !(pfd.revents & POLLIN))
-		return 0; /* which is E_RCV_TIMEDOUT */
-
-	/* for most cases this method will memcopy twice, as the default buffer
-	 * is large enough.  But for those few other cases, we now have a
-	 * chance to realloc before the rest of the datagram is discarded.
-	 */
-	n = recvmsg(s->s_fd, &msg, flags);
+	msg.msg_namelen = sizeof(struct sockaddr_nl);
+	/* MSG_TRUNC: return the real length of a datagram that did not fit */
+	n = recvmsg(s->s_fd, &msg, MSG_DONTWAIT | MSG_TRUNC);
 	if (!n)
 		return 0;
 	else if (n < 0) {
@@ -198,32 +333,18 @@ retry:
 			dbg(3, "recvmsg() returned EINTR, retrying\n");
 			goto retry;
 		} else if (errno == EAGAIN) {
-			dbg(3, "recvmsg() returned EAGAIN, aborting\n");
-			return 0;
-		} else if (errno == ENOBUFS) {
-			dbg(3, "recvmsg() returned ENOBUFS\n");
-			return -E_RCV_ENOBUFS;
-		} else {
-			dbg(3, "recvmsg() returned %d, errno = %d\n", n, errno);
-			return -E_RCV_FAILED;
+			/* the socket is drained, wait for more */
+			if (polled || !genl_wait_readable(s, timeout_ms))
+				return 0; /* which is E_RCV_TIMEDOUT */
+			polled = true;
+			goto retry;
 		}
+		return genl_recv_error(n);
 	}
 
-	if (iov->iov_len < (unsigned)n ||
-	    msg.msg_flags & MSG_TRUNC) {
-		/* Provided buffer is not long enough, enlarge it
-		 * and try again. */
-		void *tmp;
-		iov->iov_len *= 2;
-		tmp = realloc(iov->iov_base, iov->iov_len);
-		if (!tmp)
-			return -E_RCV_FAILED;
-		iov->iov_base = tmp;
-		goto retry;
-	} else if (flags != 0) {
-		/* Buffer is big enough, do the actual reading */
-		flags = 0;
-		goto retry;
+	if (iov->iov_len < (unsigned)n || msg.msg_flags & MSG_TRUNC) {
+		dbg(3, "datagram of %d bytes truncated\n", n);
+		return -E_RCV_MSG_TRUNC;
 	}
 
 	if (msg.msg_namelen != sizeof(struct sockaddr_nl))
@@ -232,6 +353,7 @@ retry:
 	if (addr.nl_pid != 0) {
 		dbg(3, "ignoring message from sender pid %u != 0\n",
 				addr.nl_pid);
+		polled = false;
 		goto retry;
 	}
 	return n;
@@ -258,6 +380,8 @@ int genl_recv_msgs(struct genl_sock *s, struct iovec *iov, char **err_desc, int
 				? "no source address!"
 				: ( c == -E_RCV_ENOBUFS)
 			        ? "packets droped, socket receive buffer overrun"
+				: (c == -E_RCV_MSG_TRUNC)
+				? "truncated message in netlink reply"
 				: "failed to receive netlink reply";
 		return c;
 	}
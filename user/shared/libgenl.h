@@ -87,6 +87,12 @@ struct msg_buff {
 
 #define DEFAULT_MSG_SIZE	8192
 
+/* The kernel never builds netlink datagrams larger than 32 KiB (dump replies
+ * are capped there, notifications use NLMSG_GOODSIZE). A receive buffer of
+ * this size can therefore be filled by a single recvmsg() without first
+ * peeking at the size of the datagram. */
+#define GENL_RECV_BUF_SIZE	32768
+
 static inline unsigned char *msg_tail_pointer(struct msg_buff *msg)
 {
 	return msg->tail;
@@ -1062,6 +1068,7 @@ struct genl_sock {
 	struct sockaddr_nl	s_local;
 	struct sockaddr_nl	s_peer;
 	int			s_fd;
+	struct genl_recv_batch	*s_recv_batch;
 #else
 	HANDLE			s_handle;
 #endif
@@ -1091,6 +1098,12 @@ enum {
 };
 /* returns negative E_RCV_*, or length of message */
 extern int genl_recv_msgs(struct genl_sock *s, struct iovec *iov, char **err_desc, int timeout_ms);
+/* Receive several datagrams per system call from now on. The buffer passed
+ * to genl_recv_msgs() is exchanged with an internal one instead of copied,
+ * so callers must not keep pointers into it across calls. */
+extern int genl_enable_recv_batch(struct genl_sock *s);
+/* true if genl_recv_msgs() can return a datagram without waiting */
+extern bool genl_recv_pending(struct genl_sock *s);
 extern bool genl_op_known(struct genl_family *family, int id);
 
 #endif	/* LIBGENL_H */
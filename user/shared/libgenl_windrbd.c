@@ -204,6 +204,17 @@ int genl_recv_msgs(struct genl_sock *s, struct iovec *iov, char **err_desc, int
 	return verify_header(s, iov, size, err_desc);
 }
 
+/* The driver hands out one packet per ioctl, there is nothing to batch. */
+int genl_enable_recv_batch(struct genl_sock *s)
+{
+	return 0;
+}
+
+bool genl_recv_pending(struct genl_sock *s)
+{
+	return false;
+}
+
 struct genl_sock *genl_connect_to_family(struct genl_family *family, struct genl_connect_options *opts)
 {
 	struct genl_sock *s = NULL;
@@ -802,7 +802,7 @@ static int _generic_config_cmd(const struct drbd_cmd *cm, int argc,
 	struct iovec iov;
 
 	/* pre allocate request message and reply buffer */
-	iov.iov_len = DEFAULT_MSG_SIZE;
+	iov.iov_len = GENL_RECV_BUF_SIZE;
 	iov.iov_base = malloc(iov.iov_len);
 	smsg = msg_new(DEFAULT_MSG_SIZE);
 	if (!smsg || !iov.iov_base) {
@@ -1160,7 +1160,7 @@ static int generic_get(const struct drbd_cmd *cm, int timeout_arg, void *u_ptr)
 	int err = 0;
 
 	/* pre allocate request message and reply buffer */
-	iov.iov_len = DEFAULT_MSG_SIZE;
+	iov.iov_len = GENL_RECV_BUF_SIZE;
 	iov.iov_base = malloc(iov.iov_len);
 	smsg = msg_new(DEFAULT_MSG_SIZE);
 	if (!smsg || !iov.iov_base) {
@@ -1529,7 +1529,7 @@ static int generic_get_cmd(const struct drbd_cmd *cm, int argc, char **argv)
 		struct iovec iov;
 		int rr;
 
-		iov.iov_len = 8192;
+		iov.iov_len = GENL_RECV_BUF_SIZE;
 		iov.iov_base = malloc(iov.iov_len);
 		smsg = msg_new(DEFAULT_MSG_SIZE);
 		if (!smsg || !iov.iov_base) {
@@ -184,6 +184,11 @@ static int udev_cmd(const struct drbd_cmd *cm, int argc, char **argv);
        int print_event(const struct drbd_cmd *, struct genl_info *, void *); /* is in drbdsetup_events2.c */
        void events2_prepare_update(); /* is in drbdsetup_events2.c */
        void events2_reset(); /* is in drbdsetup_events2.c */
+       void events2_resync(unsigned int seq); /* is in drbdsetup_events2.c */
+       bool events2_overrun(bool dump_in_progress); /* is in drbdsetup_events2.c */
+       bool events2_dump_done(void); /* is in drbdsetup_events2.c */
+       int events2_gap_timeout_ms(void); /* is in drbdsetup_events2.c */
+       int events2_gap_timeout_expired(void); /* is in drbdsetup_events2.c */
 static int wait_for_family(const struct drbd_cmd *, struct genl_info *, void *);
 static int remember_resource(const struct drbd_cmd *, struct genl_info *, void *);
 static int remember_device(const struct drbd_cmd *, struct genl_info *, void *);
@@ -1107,7 +1112,7 @@ int _generic_config_cmd(const struct drbd_cmd *cm, int argc, char **argv)
 	};
 
 	/* pre allocate request message and reply buffer */
-	iov.iov_len = DEFAULT_MSG_SIZE;
+	iov.iov_len = GENL_RECV_BUF_SIZE;
 	iov.iov_base = malloc(iov.iov_len);
 	smsg = msg_new(DEFAULT_MSG_SIZE);
 	if (!smsg || !iov.iov_base) {
@@ -1693,6 +1698,19 @@ static int generic_send(const struct drbd_cmd *cm)
 	return err;
 }
 
+/* Events were lost. Request the initial state again and print only what changed. */
+static int events2_request_resync(const struct drbd_cmd *cm)
+{
+	int err;
+
+	err = generic_send(cm);
+	if (err)
+		return err;
+	events2_resync(drbd_sock->s_seq_expect);
+	drbd_sock->s_seq_expect = 0;
+	return 0;
+}
+
 static int generic_recv(const struct drbd_cmd *cm, int timeout_arg, void *u_ptr, int extra_poll_fd, bool expect_reply)
 {
 	struct nlattr *tla[ARRAY_SIZE(drbd_tla_nl_policy)] = { 0, };
@@ -1703,7 +1721,7 @@ static int generic_recv(const struct drbd_cmd *cm, int timeout_arg, void *u_ptr,
 	int err = 0;
 
 	/* preallocate reply buffer */
-	iov.iov_len = DEFAULT_MSG_SIZE;
+	iov.iov_len = GENL_RECV_BUF_SIZE;
 	iov.iov_base = malloc(iov.iov_len);
 	if (!iov.iov_base) {
 		desc = "could not allocate netlink reply buffer";
@@ -1714,9 +1732,17 @@ static int generic_recv(const struct drbd_cmd *cm, int timeout_arg, void *u_ptr,
 	/* disable sequence number check in genl_recv_msgs */
 	drbd_sock->s_seq_expect = 0;
 
+	/* event streams: receive several notifications per system call */
+	if (cm->continuous_poll && genl_enable_recv_batch(drbd_sock)) {
+		desc = "could not allocate netlink receive buffers";
+		rv = OTHER_ERROR;
+		goto out;
+	}
+
 	for (;;) {
 		int received, rem, ret;
-		struct nlmsghdr *nlh = (struct nlmsghdr *)iov.iov_base;
+		int poll_timeout_ms;
+		struct nlmsghdr *nlh;
 		struct timeval before;
 
 		gettimeofday(&before, NULL);
@@ -1724,17 +1750,34 @@ static int generic_recv(const struct drbd_cmd *cm, int timeout_arg, void *u_ptr,
 		timeout_ms =
 			timeout_arg == MULTIPLE_TIMEOUTS ? shortest_timeout(u_ptr) : timeout_arg;
 
+		/* events2: wake up to give up on missing messages */
+		poll_timeout_ms = timeout_ms;
+		if (cm->handle_reply == &print_event) {
+			int gap_timeout_ms = events2_gap_timeout_ms();
+
+			if (gap_timeout_ms != -1 &&
+			    (poll_timeout_ms == -1 || gap_timeout_ms < poll_timeout_ms))
+				poll_timeout_ms = gap_timeout_ms;
+		}
+
 		/* Wait for new data or error/HUP. We want to receive the full
 		 * reply before returning, so only check for data on
 		 * extra_poll_fd if we are not still expecting to receive a
 		 * reply. */
-		ret = poll_hup(drbd_sock, timeout_ms, expect_reply ? -1 : extra_poll_fd);
-		if (ret == E_POLL_EXTRA_FD) {
-			goto out;
-		} else if (ret > 0) { /* failed */
-			if (ret == E_POLL_TIMEOUT)
-				err = 5;
-			goto out;
+		if (!genl_recv_pending(drbd_sock)) {
+			ret = poll_hup(drbd_sock, poll_timeout_ms, expect_reply ? -1 : extra_poll_fd);
+			if (ret == E_POLL_EXTRA_FD) {
+				goto out;
+			} else if (ret == E_POLL_TIMEOUT && poll_timeout_ms != timeout_ms) {
+				err = events2_gap_timeout_expired();
+				if (err)
+					goto out;
+				continue;
+			} else if (ret > 0) { /* failed */
+				if (ret == E_POLL_TIMEOUT)
+					err = 5;
+				goto out;
+			}
 		}
 
 		/* Linux: At this point we know that there is data available on
@@ -1743,6 +1786,8 @@ static int generic_recv(const struct drbd_cmd *cm, int timeout_arg, void *u_ptr,
 		 *
 		 * Windows: extra_poll_fd is not supported; this may block. */
 		received = genl_recv_msgs(drbd_sock, &iov, &desc, timeout_ms);
+		/* the receive buffer may have been replaced */
+		nlh = (struct nlmsghdr *)iov.iov_base;
 		if (received <= 0) {
 			switch(received) {
 			case E_RCV_TIMEDOUT:
@@ -1763,6 +1808,13 @@ static int generic_recv(const struct drbd_cmd *cm, int timeout_arg, void *u_ptr,
 				continue;
 			case -E_RCV_NLMSG_DONE:
 				expect_reply = false;
+				if (cm->handle_reply == &print_event && cm->continuous_poll &&
+				    events2_dump_done()) {
+					err = events2_request_resync(cm);
+					if (err)
+						goto out;
+					expect_reply = true;
+				}
 				if (cm->continuous_poll)
 					continue;
 				err = cm->handle_reply(cm, NULL, u_ptr);
@@ -1785,6 +1837,19 @@ static int generic_recv(const struct drbd_cmd *cm, int timeout_arg, void *u_ptr,
 					       desc);
 				err = 20;
 				goto out;
+			case -E_RCV_ENOBUFS:
+				if (cm->handle_reply == &print_event && cm->continuous_poll) {
+					/* While a dump reply is still expected,
+					 * the request is sent after its end. */
+					if (events2_overrun(expect_reply)) {
+						err = events2_request_resync(cm);
+						if (err)
+							goto out;
+						expect_reply = true;
+					}
+					continue;
+				}
+				/* fall through */
 			default:
 				if (!desc)
 					desc = "error receiving config reply";
@@ -2140,7 +2205,7 @@ static int generic_events_cmd(const struct drbd_cmd *cm, int argc, char **argv)
 		if (!peer_devices)
 			return 0;
 
-		iov.iov_len = DEFAULT_MSG_SIZE;
+		iov.iov_len = GENL_RECV_BUF_SIZE;
 		iov.iov_base = malloc(iov.iov_len);
 		smsg = msg_new(DEFAULT_MSG_SIZE);
 		if (!smsg || !iov.iov_base) {
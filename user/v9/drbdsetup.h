@@ -90,6 +90,11 @@ enum {
 	E_POLL_EXTRA_FD,
 };
 
+struct promotion_info {
+	bool may_promote;
+	int promotion_score;
+};
+
 struct resources_list {
 	struct resources_list *next;
 	char *name;
@@ -100,6 +105,11 @@ struct resources_list {
 	bool destroyed; /* only used by events2 */
 	struct devices_list *devices; /* only used by events2 */
 	struct connections_list *connections; /* only used by events2 */
+	void *device_index; /* only used by events2 */
+	void *connection_index; /* only used by events2 */
+	struct resource_update *update; /* only used by events2 */
+	struct promotion_info promotion_info; /* only used by events2 */
+	bool stale; /* only used by events2 */
 };
 struct devices_list {
 	struct devices_list *next;
@@ -110,6 +120,10 @@ struct devices_list {
 	struct nlattr *device_conf_nl;
 	struct device_info info;
 	struct device_statistics statistics;
+	struct devices_list *old; /* only used by events2 */
+	struct devices_list *next_updated; /* only used by events2 */
+	bool updated; /* only used by events2 */
+	bool stale; /* only used by events2 */
 };
 struct connections_list {
 	struct connections_list *next;
@@ -120,6 +134,12 @@ struct connections_list {
 	struct connection_statistics statistics;
 	struct peer_devices_list *peer_devices; /* only used by events2 */
 	struct paths_list *paths; /* only used by events2 */
+	void *peer_device_index; /* only used by events2 */
+	void *path_index; /* only used by events2 */
+	struct connections_list *old; /* only used by events2 */
+	struct connections_list *next_updated; /* only used by events2 */
+	bool updated; /* only used by events2 */
+	bool stale; /* only used by events2 */
 };
 struct peer_devices_list {
 	struct peer_devices_list *next;
@@ -129,11 +149,18 @@ struct peer_devices_list {
 	struct peer_device_statistics statistics;
 	struct devices_list *device;
 	int timeout_ms; /* used only by wait_for_family() */
+	struct peer_devices_list *old; /* only used by events2 */
+	struct peer_devices_list *next_updated; /* only used by events2 */
+	bool updated; /* only used by events2 */
+	bool stale; /* only used by events2 */
 };
 struct paths_list {
 	struct paths_list *next;
 	struct drbd_cfg_context ctx;
 	struct drbd_path_info info;
+	struct paths_list *old; /* only used by events2 */
+	struct paths_list *next_updated; /* only used by events2 */
+	bool updated; /* only used by events2 */
 };
 enum usage_type {
 	BRIEF,
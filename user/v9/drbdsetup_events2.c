@@ -56,6 +56,7 @@ static const char *action_destroy = "destroy";
 static const char *action_call = "call";
 static const char *action_response = "response";
 static const char *action_rename = "rename";
+static const char *action_resync = "resync";
 
 static const char *object_resource = "resource";
 static const char *object_device = "device";
@@ -63,13 +64,42 @@ static const char *object_connection = "connection";
 static const char *object_peer_device = "peer-device";
 static const char *object_helper = "helper";
 static const char *object_path = "path";
+static const char *object_events2 = "events2";
 
 bool initial_state = true; /* receiving new data in "exists" messages */
 bool receive_update = false; /* receiving updates in "exists" messages */
+static bool receive_resync = false; /* receiving a new initial state after an overrun */
+static uint32_t resync_seq; /* nlmsg_seq of the request for the new initial state */
+static bool resync_pending = false; /* an overrun happened while a dump was in progress */
 void *all_resources;
-struct resources_list *update_resources;
+
+/* The changes to a resource are applied to the objects in place while the
+ * notifications of an update are received. The state that an object had before
+ * the update is cloned when the update first touches the object, so that only
+ * the objects that were touched need to be copied and compared. */
+struct resource_update {
+	struct resource_update *next;
+	struct resources_list *resource;
+	/* state of the resource itself before the update, without its objects;
+	 * NULL if the update creates the resource */
+	struct resources_list *old_resource;
+	struct promotion_info old_promotion_info;
+	/* objects that the update created or changed, linked by next_updated */
+	struct devices_list *updated_devices;
+	struct connections_list *updated_connections;
+	struct peer_devices_list *updated_peer_devices;
+	struct paths_list *updated_paths;
+	/* state before the update of the objects that the update destroyed */
+	struct devices_list *destroyed_devices;
+	struct connections_list *destroyed_connections;
+	struct peer_devices_list *destroyed_peer_devices;
+	struct paths_list *destroyed_paths;
+};
+
+struct resource_update *update_resources;
 
 static int apply_event(const char *prefix, struct genl_info *info);
+static void commit_updates(const char *prefix);
 
 static int resource_obj_cmp(const void *a, const void *b)
 {
@@ -99,104 +129,448 @@ static void delete_resource(struct resources_list *resource)
 	tdelete(resource, &all_resources, resource_obj_cmp);
 }
 
-static void store_update_resource(struct resources_list *new_resource)
+/* The objects of a resource are indexed by trees in addition to their lists,
+ * so that looking up an object does not depend on the number of objects. The
+ * lists own the objects, the trees only refer to them. */
+
+static int volume_cmp(unsigned a, unsigned b)
 {
-	new_resource->next = update_resources;
-	update_resources = new_resource;
+	return a < b ? -1 : a > b;
 }
 
-static struct devices_list *find_device(struct resources_list *resource, unsigned volume)
+static int device_obj_cmp(const void *a, const void *b)
 {
-	struct devices_list *device;
-	for (device = resource->devices; device; device = device->next) {
-		if (device->ctx.ctx_volume == volume)
-			return device;
+	return volume_cmp(((const struct devices_list *)a)->ctx.ctx_volume,
+			((const struct devices_list *)b)->ctx.ctx_volume);
+}
+
+static int connection_obj_cmp(const void *a, const void *b)
+{
+	return strcmp(((const struct connections_list *)a)->ctx.ctx_conn_name,
+			((const struct connections_list *)b)->ctx.ctx_conn_name);
+}
+
+static int peer_device_obj_cmp(const void *a, const void *b)
+{
+	return volume_cmp(((const struct peer_devices_list *)a)->ctx.ctx_volume,
+			((const struct peer_devices_list *)b)->ctx.ctx_volume);
+}
+
+static int path_obj_cmp(const void *a, const void *b)
+{
+	const struct drbd_cfg_context *ctx_a = &((const struct paths_list *)a)->ctx;
+	const struct drbd_cfg_context *ctx_b = &((const struct paths_list *)b)->ctx;
+	int cmp;
+
+	/* Just compare bytes. Strictly speaking, there can be situations where
+	 * addresses with different binary reprepresentations correspond to the
+	 * same address. However, we can rely on DRBD always using the same
+	 * representation for a given path. */
+
+	if (ctx_a->ctx_my_addr_len != ctx_b->ctx_my_addr_len)
+		return ctx_a->ctx_my_addr_len < ctx_b->ctx_my_addr_len ? -1 : 1;
+
+	if (ctx_a->ctx_peer_addr_len != ctx_b->ctx_peer_addr_len)
+		return ctx_a->ctx_peer_addr_len < ctx_b->ctx_peer_addr_len ? -1 : 1;
+
+	cmp = memcmp(ctx_a->ctx_my_addr, ctx_b->ctx_my_addr, ctx_a->ctx_my_addr_len);
+	if (cmp)
+		return cmp;
+
+	return memcmp(ctx_a->ctx_peer_addr, ctx_b->ctx_peer_addr, ctx_a->ctx_peer_addr_len);
+}
+
+static void free_index_node(void *node)
+{
+	/* the objects are owned by the lists */
+}
+
+static void free_connection_index(struct connections_list *connection)
+{
+	tdestroy(connection->peer_device_index, free_index_node);
+	connection->peer_device_index = NULL;
+	tdestroy(connection->path_index, free_index_node);
+	connection->path_index = NULL;
+}
+
+static struct resource_update *store_update_resource(struct resources_list *resource, bool created)
+{
+	struct resource_update *update;
+
+	update = calloc(1, sizeof(*update));
+	update->resource = resource;
+
+	if (!created) {
+		struct resources_list *old_resource;
+
+		old_resource = malloc(sizeof(*old_resource));
+		*old_resource = *resource;
+		old_resource->next = NULL;
+		old_resource->name = NULL;
+		old_resource->res_opts = NULL;
+		old_resource->devices = NULL;
+		old_resource->connections = NULL;
+		old_resource->device_index = NULL;
+		old_resource->connection_index = NULL;
+		old_resource->update = NULL;
+
+		update->old_resource = old_resource;
+		update->old_promotion_info = resource->promotion_info;
 	}
-	return NULL;
+
+	resource->update = update;
+	update->next = update_resources;
+	update_resources = update;
+	return update;
+}
+
+/* The clones of the previous states do not own any attributes or objects, so
+ * they are freed with free() */
+
+static void device_updated(struct resource_update *update, struct devices_list *device, struct devices_list *old_device)
+{
+	device->old = old_device;
+	device->updated = true;
+	device->next_updated = update->updated_devices;
+	update->updated_devices = device;
+}
+
+static void device_before_change(struct resource_update *update, struct devices_list *device)
+{
+	struct devices_list *old_device;
+
+	if (device->updated)
+		return;
+
+	old_device = malloc(sizeof(*old_device));
+	*old_device = *device;
+	old_device->next = NULL;
+	old_device->disk_conf_nl = NULL;
+	old_device->device_conf_nl = NULL;
+
+	device_updated(update, device, old_device);
+}
+
+static void connection_updated(struct resource_update *update, struct connections_list *connection, struct connections_list *old_connection)
+{
+	connection->old = old_connection;
+	connection->updated = true;
+	connection->next_updated = update->updated_connections;
+	update->updated_connections = connection;
+}
+
+static void connection_before_change(struct resource_update *update, struct connections_list *connection)
+{
+	struct connections_list *old_connection;
+
+	if (connection->updated)
+		return;
+
+	old_connection = malloc(sizeof(*old_connection));
+	*old_connection = *connection;
+	old_connection->next = NULL;
+	old_connection->path_list = NULL;
+	old_connection->net_conf = NULL;
+	old_connection->peer_devices = NULL;
+	old_connection->paths = NULL;
+	old_connection->peer_device_index = NULL;
+	old_connection->path_index = NULL;
+
+	connection_updated(update, connection, old_connection);
+}
+
+static void peer_device_updated(struct resource_update *update, struct peer_devices_list *peer_device, struct peer_devices_list *old_peer_device)
+{
+	peer_device->old = old_peer_device;
+	peer_device->updated = true;
+	peer_device->next_updated = update->updated_peer_devices;
+	update->updated_peer_devices = peer_device;
+}
+
+static void peer_device_before_change(struct resource_update *update, struct peer_devices_list *peer_device)
+{
+	struct peer_devices_list *old_peer_device;
+
+	if (peer_device->updated)
+		return;
+
+	old_peer_device = malloc(sizeof(*old_peer_device));
+	*old_peer_device = *peer_device;
+	old_peer_device->next = NULL;
+	old_peer_device->peer_device_conf = NULL;
+	old_peer_device->device = NULL;
+
+	peer_device_updated(update, peer_device, old_peer_device);
+}
+
+static void path_updated(struct resource_update *update, struct paths_list *path, struct paths_list *old_path)
+{
+	path->old = old_path;
+	path->updated = true;
+	path->next_updated = update->updated_paths;
+	update->updated_paths = path;
+}
+
+static void path_before_change(struct resource_update *update, struct paths_list *path)
+{
+	struct paths_list *old_path;
+
+	if (path->updated)
+		return;
+
+	old_path = malloc(sizeof(*old_path));
+	*old_path = *path;
+	old_path->next = NULL;
+
+	path_updated(update, path, old_path);
+}
+
+/* Forget the previous states of the objects that an update touched */
+static void free_resource_update(struct resource_update *update)
+{
+	struct devices_list *device, *next_device;
+	struct connections_list *connection, *next_connection;
+	struct peer_devices_list *peer_device, *next_peer_device;
+	struct paths_list *path, *next_path;
+
+	for (device = update->updated_devices; device; device = next_device) {
+		next_device = device->next_updated;
+		free(device->old);
+		device->old = NULL;
+		device->next_updated = NULL;
+		device->updated = false;
+	}
+
+	for (connection = update->updated_connections; connection; connection = next_connection) {
+		next_connection = connection->next_updated;
+		free(connection->old);
+		connection->old = NULL;
+		connection->next_updated = NULL;
+		connection->updated = false;
+	}
+
+	for (peer_device = update->updated_peer_devices; peer_device; peer_device = next_peer_device) {
+		next_peer_device = peer_device->next_updated;
+		free(peer_device->old);
+		peer_device->old = NULL;
+		peer_device->next_updated = NULL;
+		peer_device->updated = false;
+	}
+
+	for (path = update->updated_paths; path; path = next_path) {
+		next_path = path->next_updated;
+		free(path->old);
+		path->old = NULL;
+		path->next_updated = NULL;
+		path->updated = false;
+	}
+
+	free_devices(update->destroyed_devices);
+	free_connections(update->destroyed_connections);
+	free_peer_devices(update->destroyed_peer_devices);
+	free_paths(update->destroyed_paths);
+	update->resource->update = NULL;
+	free(update->old_resource);
+	free(update);
+}
+
+static struct devices_list *find_device(struct resources_list *resource, unsigned volume)
+{
+	struct devices_list **found;
+	struct devices_list key = { .ctx.ctx_volume = volume };
+
+	found = tfind(&key, &resource->device_index, device_obj_cmp);
+	return found ? *found : NULL;
 }
 
 static void store_device(struct resources_list *resource, struct devices_list *new_device)
 {
 	new_device->next = resource->devices;
 	resource->devices = new_device;
+	tsearch(new_device, &resource->device_index, device_obj_cmp);
 }
 
-static void store_device_check(struct resources_list *resource, struct devices_list *new_device)
+static void store_device_check(struct resource_update *update, struct devices_list *new_device)
 {
 	struct devices_list *old_device;
 
-	old_device = find_device(resource, new_device->ctx.ctx_volume);
+	old_device = find_device(update->resource, new_device->ctx.ctx_volume);
 	if (old_device) {
 		free_device(new_device);
 		return;
 	}
 
-	store_device(resource, new_device);
+	store_device(update->resource, new_device);
+	device_updated(update, new_device, NULL);
 }
 
-static void delete_device(struct resources_list *resource, unsigned volume)
+/* Keep the state of the device before the update for printing its destruction */
+static void store_destroyed_device(struct resource_update *update, struct devices_list *device)
 {
-	struct devices_list *device, **previous_next = &resource->devices;
-	for (device = resource->devices; device; device = device->next) {
-		if (device->ctx.ctx_volume == volume) {
-			*previous_next = device->next;
-			free_device(device);
-			return;
-		}
-		previous_next = &device->next;
+	struct devices_list *old_device = device;
+
+	if (device->updated) {
+		struct devices_list **previous_next = &update->updated_devices;
+
+		while (*previous_next != device)
+			previous_next = &(*previous_next)->next_updated;
+		*previous_next = device->next_updated;
+
+		old_device = device->old;
+		free_device(device);
+	}
+
+	if (old_device) {
+		old_device->next = update->destroyed_devices;
+		update->destroyed_devices = old_device;
 	}
 }
 
+static void delete_device(struct resource_update *update, unsigned volume)
+{
+	struct resources_list *resource = update->resource;
+	struct devices_list *device, **previous_next = &resource->devices;
+
+	device = find_device(resource, volume);
+	if (!device)
+		return;
+
+	tdelete(device, &resource->device_index, device_obj_cmp);
+	while (*previous_next != device)
+		previous_next = &(*previous_next)->next;
+	*previous_next = device->next;
+	store_destroyed_device(update, device);
+}
+
 static struct connections_list *find_connection(struct resources_list *resource, const char *name)
 {
-	struct connections_list *connection;
-	for (connection = resource->connections; connection; connection = connection->next) {
-		if (!strcmp(connection->ctx.ctx_conn_name, name))
-			return connection;
-	}
-	return NULL;
+	struct connections_list **found;
+	struct connections_list key;
+
+	/* only the name of the key is compared */
+	strncpy(key.ctx.ctx_conn_name, name, sizeof(key.ctx.ctx_conn_name));
+	found = tfind(&key, &resource->connection_index, connection_obj_cmp);
+	return found ? *found : NULL;
 }
 
 static void store_connection(struct resources_list *resource, struct connections_list *new_connection)
 {
 	new_connection->next = resource->connections;
 	resource->connections = new_connection;
+	tsearch(new_connection, &resource->connection_index, connection_obj_cmp);
 }
 
-static void store_connection_check(struct resources_list *resource, struct connections_list *new_connection)
+static void store_connection_check(struct resource_update *update, struct connections_list *new_connection)
 {
 	struct connections_list *old_connection;
 
-	old_connection = find_connection(resource, new_connection->ctx.ctx_conn_name);
+	old_connection = find_connection(update->resource, new_connection->ctx.ctx_conn_name);
 	if (old_connection) {
 		free_connection(new_connection);
 		return;
 	}
 
-	store_connection(resource, new_connection);
+	store_connection(update->resource, new_connection);
+	connection_updated(update, new_connection, NULL);
 }
 
-static void delete_connection(struct resources_list *resource, const char *name)
+/* Keep the state of the connection before the update for printing its
+ * destruction. The destruction of its peer devices and paths is not printed. */
+static void store_destroyed_connection(struct resource_update *update, struct connections_list *connection)
 {
-	struct connections_list *connection, **previous_next = &resource->connections;
-	for (connection = resource->connections; connection; connection = connection->next) {
-		if (!strcmp(connection->ctx.ctx_conn_name, name)) {
-			*previous_next = connection->next;
-			free_connection(connection);
-			return;
+	struct connections_list *old_connection = connection;
+	struct connections_list **connection_next;
+	struct peer_devices_list *peer_device, **peer_device_next;
+	struct paths_list *path, **path_next;
+
+	free_connection_index(connection);
+
+	/* the peer devices and paths remain in the lists of the connection */
+	peer_device_next = &update->updated_peer_devices;
+	while ((peer_device = *peer_device_next)) {
+		if (!strcmp(peer_device->ctx.ctx_conn_name, connection->ctx.ctx_conn_name)) {
+			*peer_device_next = peer_device->next_updated;
+			free(peer_device->old);
+			peer_device->old = NULL;
+			peer_device->next_updated = NULL;
+			peer_device->updated = false;
+		} else {
+			peer_device_next = &peer_device->next_updated;
+		}
+	}
+
+	path_next = &update->updated_paths;
+	while ((path = *path_next)) {
+		if (!strcmp(path->ctx.ctx_conn_name, connection->ctx.ctx_conn_name)) {
+			*path_next = path->next_updated;
+			free(path->old);
+			path->old = NULL;
+			path->next_updated = NULL;
+			path->updated = false;
+		} else {
+			path_next = &path->next_updated;
+		}
+	}
+
+	peer_device_next = &update->destroyed_peer_devices;
+	while ((peer_device = *peer_device_next)) {
+		if (!strcmp(peer_device->ctx.ctx_conn_name, connection->ctx.ctx_conn_name)) {
+			*peer_device_next = peer_device->next;
+			free_peer_device(peer_device);
+		} else {
+			peer_device_next = &peer_device->next;
 		}
-		previous_next = &connection->next;
 	}
+
+	path_next = &update->destroyed_paths;
+	while ((path = *path_next)) {
+		if (!strcmp(path->ctx.ctx_conn_name, connection->ctx.ctx_conn_name)) {
+			*path_next = path->next;
+			free(path);
+		} else {
+			path_next = &path->next;
+		}
+	}
+
+	if (connection->updated) {
+		connection_next = &update->updated_connections;
+		while (*connection_next != connection)
+			connection_next = &(*connection_next)->next_updated;
+		*connection_next = connection->next_updated;
+
+		old_connection = connection->old;
+		free_connection(connection);
+	}
+
+	if (old_connection) {
+		old_connection->next = update->destroyed_connections;
+		update->destroyed_connections = old_connection;
+	}
+}
+
+static void delete_connection(struct resource_update *update, const char *name)
+{
+	struct resources_list *resource = update->resource;
+	struct connections_list *connection, **previous_next = &resource->connections;
+
+	connection = find_connection(resource, name);
+	if (!connection)
+		return;
+
+	tdelete(connection, &resource->connection_index, connection_obj_cmp);
+	while (*previous_next != connection)
+		previous_next = &(*previous_next)->next;
+	*previous_next = connection->next;
+	store_destroyed_connection(update, connection);
 }
 
 static struct peer_devices_list *connection_find_peer_device(struct connections_list *connection, unsigned volume)
 {
-	struct peer_devices_list *peer_device;
-	for (peer_device = connection->peer_devices; peer_device; peer_device = peer_device->next) {
-		if (peer_device->ctx.ctx_volume == volume)
-			return peer_device;
-	}
-	return NULL;
+	struct peer_devices_list **found;
+	struct peer_devices_list key = { .ctx.ctx_volume = volume };
+
+	found = tfind(&key, &connection->peer_device_index, peer_device_obj_cmp);
+	return found ? *found : NULL;
 }
 
 static struct peer_devices_list *find_peer_device(struct resources_list *resource, struct drbd_cfg_context *ctx)
@@ -214,14 +588,15 @@ static void connection_store_peer_device(struct connections_list *connection, st
 {
 	new_peer_device->next = connection->peer_devices;
 	connection->peer_devices = new_peer_device;
+	tsearch(new_peer_device, &connection->peer_device_index, peer_device_obj_cmp);
 }
 
-static void store_peer_device_check(struct resources_list *resource, struct peer_devices_list *new_peer_device)
+static void store_peer_device_check(struct resource_update *update, struct peer_devices_list *new_peer_device)
 {
 	struct connections_list *connection;
 	struct peer_devices_list *old_peer_device;
 
-	connection = find_connection(resource, new_peer_device->ctx.ctx_conn_name);
+	connection = find_connection(update->resource, new_peer_device->ctx.ctx_conn_name);
 	if (!connection) {
 		free_peer_device(new_peer_device);
 		return;
@@ -234,26 +609,50 @@ static void store_peer_device_check(struct resources_list *resource, struct peer
 	}
 
 	connection_store_peer_device(connection, new_peer_device);
+	peer_device_updated(update, new_peer_device, NULL);
+}
+
+/* Keep the state of the peer device before the update for printing its destruction */
+static void store_destroyed_peer_device(struct resource_update *update, struct peer_devices_list *peer_device)
+{
+	struct peer_devices_list *old_peer_device = peer_device;
+
+	if (peer_device->updated) {
+		struct peer_devices_list **previous_next = &update->updated_peer_devices;
+
+		while (*previous_next != peer_device)
+			previous_next = &(*previous_next)->next_updated;
+		*previous_next = peer_device->next_updated;
+
+		old_peer_device = peer_device->old;
+		free_peer_device(peer_device);
+	}
+
+	if (old_peer_device) {
+		old_peer_device->next = update->destroyed_peer_devices;
+		update->destroyed_peer_devices = old_peer_device;
+	}
 }
 
-static void delete_peer_device(struct resources_list *resource, struct drbd_cfg_context *ctx)
+static void delete_peer_device(struct resource_update *update, struct drbd_cfg_context *ctx)
 {
 	struct connections_list *connection;
 	struct peer_devices_list *peer_device, **previous_next;
 
-	connection = find_connection(resource, ctx->ctx_conn_name);
+	connection = find_connection(update->resource, ctx->ctx_conn_name);
 	if (!connection)
 		return;
 
+	peer_device = connection_find_peer_device(connection, ctx->ctx_volume);
+	if (!peer_device)
+		return;
+
+	tdelete(peer_device, &connection->peer_device_index, peer_device_obj_cmp);
 	previous_next = &connection->peer_devices;
-	for (peer_device = connection->peer_devices; peer_device; peer_device = peer_device->next) {
-		if (peer_device->ctx.ctx_volume == ctx->ctx_volume) {
-			*previous_next = peer_device->next;
-			free_peer_device(peer_device);
-			return;
-		}
-		previous_next = &peer_device->next;
-	}
+	while (*previous_next != peer_device)
+		previous_next = &(*previous_next)->next;
+	*previous_next = peer_device->next;
+	store_destroyed_peer_device(update, peer_device);
 }
 
 static bool path_address_strs(struct drbd_cfg_context *ctx, char *my_addr, char *peer_addr)
@@ -273,36 +672,18 @@ static bool path_address_strs(struct drbd_cfg_context *ctx, char *my_addr, char
 	return true;
 }
 
-static bool paths_equal(struct drbd_cfg_context *ctx_a, struct drbd_cfg_context *ctx_b)
-{
-	/* Just compare bytes. Strictly speaking, there can be situations where
-	 * addresses with different binary reprepresentations correspond to the
-	 * same address. However, we can rely on DRBD always using the same
-	 * representation for a given path. */
-
-	if (ctx_a->ctx_my_addr_len != ctx_b->ctx_my_addr_len)
-		return false;
-
-	if (ctx_a->ctx_peer_addr_len != ctx_b->ctx_peer_addr_len)
-		return false;
-
-	if (memcmp(ctx_a->ctx_my_addr, ctx_b->ctx_my_addr, ctx_a->ctx_my_addr_len))
-		return false;
-
-	if (memcmp(ctx_a->ctx_peer_addr, ctx_b->ctx_peer_addr, ctx_a->ctx_peer_addr_len))
-		return false;
-
-	return true;
-}
-
 static struct paths_list *connection_find_path(struct connections_list *connection, struct drbd_cfg_context *ctx)
 {
-	struct paths_list *path;
-	for (path = connection->paths; path; path = path->next) {
-		if (paths_equal(&path->ctx, ctx))
-			return path;
-	}
-	return NULL;
+	struct paths_list **found;
+	struct paths_list key;
+
+	/* only the addresses of the key are compared */
+	key.ctx.ctx_my_addr_len = ctx->ctx_my_addr_len;
+	memcpy(key.ctx.ctx_my_addr, ctx->ctx_my_addr, ctx->ctx_my_addr_len);
+	key.ctx.ctx_peer_addr_len = ctx->ctx_peer_addr_len;
+	memcpy(key.ctx.ctx_peer_addr, ctx->ctx_peer_addr, ctx->ctx_peer_addr_len);
+	found = tfind(&key, &connection->path_index, path_obj_cmp);
+	return found ? *found : NULL;
 }
 
 static struct paths_list *find_path(struct resources_list *resource, struct drbd_cfg_context *ctx)
@@ -320,14 +701,15 @@ static void connection_store_path(struct connections_list *connection, struct pa
 {
 	new_path->next = connection->paths;
 	connection->paths = new_path;
+	tsearch(new_path, &connection->path_index, path_obj_cmp);
 }
 
-static void store_path_check(struct resources_list *resource, struct paths_list *new_path)
+static void store_path_check(struct resource_update *update, struct paths_list *new_path)
 {
 	struct connections_list *connection;
 	struct paths_list *old_path;
 
-	connection = find_connection(resource, new_path->ctx.ctx_conn_name);
+	connection = find_connection(update->resource, new_path->ctx.ctx_conn_name);
 	if (!connection) {
 		free(new_path);
 		return;
@@ -340,116 +722,61 @@ static void store_path_check(struct resources_list *resource, struct paths_list
 	}
 
 	connection_store_path(connection, new_path);
+	path_updated(update, new_path, NULL);
 }
 
-static void delete_path(struct resources_list *resource, struct drbd_cfg_context *ctx)
+/* Keep the state of the path before the update for printing its destruction */
+static void store_destroyed_path(struct resource_update *update, struct paths_list *path)
 {
-	struct connections_list *connection;
-	struct paths_list *path, **previous_next;
+	struct paths_list *old_path = path;
 
-	connection = find_connection(resource, ctx->ctx_conn_name);
-	if (!connection)
-		return;
-
-	previous_next = &connection->paths;
-	for (path = connection->paths; path; path = path->next) {
-		if (paths_equal(&path->ctx, ctx)) {
-			*previous_next = path->next;
-			free(path);
-			return;
-		}
-		previous_next = &path->next;
-	}
-}
+	if (path->updated) {
+		struct paths_list **previous_next = &update->updated_paths;
 
-static struct nlattr *nla_copy(const struct nlattr *old_nla)
-{
-	int size;
-	struct nlattr *new_nla;
+		while (*previous_next != path)
+			previous_next = &(*previous_next)->next_updated;
+		*previous_next = path->next_updated;
 
-	if (!old_nla)
-		return NULL;
+		old_path = path->old;
+		free(path);
+	}
 
-	size = nla_total_size(nla_len(old_nla));
-	new_nla = malloc(size);
-	memcpy(new_nla, old_nla, size);
-	return new_nla;
+	if (old_path) {
+		old_path->next = update->destroyed_paths;
+		update->destroyed_paths = old_path;
+	}
 }
 
-static struct resources_list *deep_copy_resource(struct resources_list *old_resource)
+static void delete_path(struct resource_update *update, struct drbd_cfg_context *ctx)
 {
-	struct resources_list *new_resource;
-	struct devices_list *old_device;
-	struct connections_list *old_connection;
-
-	new_resource = calloc(1, sizeof(*new_resource));
-
-	new_resource->name = strdup(old_resource->name);
-	new_resource->res_opts = nla_copy(old_resource->res_opts);
-	new_resource->info = old_resource->info;
-	new_resource->statistics = old_resource->statistics;
-	new_resource->rename_info = old_resource->rename_info;
-
-	for (old_device = old_resource->devices; old_device; old_device = old_device->next) {
-		struct devices_list *new_device;
-
-		new_device = calloc(1, sizeof(*new_device));
-
-		new_device->minor = old_device->minor;
-		new_device->ctx = old_device->ctx;
-		new_device->disk_conf_nl = nla_copy(old_device->disk_conf_nl);
-		new_device->disk_conf = old_device->disk_conf;
-		new_device->info = old_device->info;
-		new_device->statistics = old_device->statistics;
-
-		store_device(new_resource, new_device);
-	}
-
-	for (old_connection = old_resource->connections; old_connection; old_connection = old_connection->next) {
-		struct connections_list *new_connection;
-		struct peer_devices_list *old_peer_device;
-		struct paths_list *old_path;
-
-		new_connection = calloc(1, sizeof(*new_connection));
-
-		new_connection->ctx = old_connection->ctx;
-		new_connection->path_list = nla_copy(old_connection->path_list);
-		new_connection->net_conf = nla_copy(old_connection->net_conf);
-		new_connection->info = old_connection->info;
-		new_connection->statistics = old_connection->statistics;
-
-		for (old_peer_device = old_connection->peer_devices; old_peer_device; old_peer_device = old_peer_device->next) {
-			struct peer_devices_list *new_peer_device;
-
-			new_peer_device = calloc(1, sizeof(*new_peer_device));
-
-			new_peer_device->ctx = old_peer_device->ctx;
-			new_peer_device->peer_device_conf = nla_copy(old_peer_device->peer_device_conf);
-			new_peer_device->info = old_peer_device->info;
-			new_peer_device->statistics = old_peer_device->statistics;
-
-			connection_store_peer_device(new_connection, new_peer_device);
-		}
-
-		for (old_path = old_connection->paths; old_path; old_path = old_path->next) {
-			struct paths_list *new_path;
-
-			new_path = calloc(1, sizeof(*new_path));
-
-			new_path->ctx = old_path->ctx;
-			new_path->info = old_path->info;
+	struct connections_list *connection;
+	struct paths_list *path, **previous_next;
 
-			connection_store_path(new_connection, new_path);
-		}
+	connection = find_connection(update->resource, ctx->ctx_conn_name);
+	if (!connection)
+		return;
 
-		store_connection(new_resource, new_connection);
-	}
+	path = connection_find_path(connection, ctx);
+	if (!path)
+		return;
 
-	return new_resource;
+	tdelete(path, &connection->path_index, path_obj_cmp);
+	previous_next = &connection->paths;
+	while (*previous_next != path)
+		previous_next = &(*previous_next)->next;
+	*previous_next = path->next;
+	store_destroyed_path(update, path);
 }
 
 static void free_resource(struct resources_list *resource)
 {
+	struct connections_list *connection;
+
+	for (connection = resource->connections; connection; connection = connection->next)
+		free_connection_index(connection);
+	tdestroy(resource->connection_index, free_index_node);
+	tdestroy(resource->device_index, free_index_node);
+
 	free(resource->name);
 	free(resource->res_opts);
 	free_devices(resource->devices);
@@ -469,10 +796,9 @@ static int count_up_to_date_replicas(struct resources_list *resource, struct dev
 	}
 
 	for (connection = resource->connections; connection; connection = connection->next) {
-		for (peer_device = connection->peer_devices; peer_device; peer_device = peer_device->next) {
-			if (peer_device->ctx.ctx_volume == device->ctx.ctx_volume && peer_device->info.peer_disk_state == D_UP_TO_DATE)
-				up_to_date_replicas++;
-		}
+		peer_device = connection_find_peer_device(connection, device->ctx.ctx_volume);
+		if (peer_device && peer_device->info.peer_disk_state == D_UP_TO_DATE)
+			up_to_date_replicas++;
 	}
 
 	return up_to_date_replicas;
@@ -491,12 +817,11 @@ static bool have_stable_up_to_date_replicas(struct resources_list *resource, str
 	}
 
 	for (connection = resource->connections; connection; connection = connection->next) {
-		for (peer_device = connection->peer_devices; peer_device; peer_device = peer_device->next) {
-			if (peer_device->ctx.ctx_volume == device->ctx.ctx_volume &&
-					peer_device->info.peer_disk_state == D_UP_TO_DATE &&
-					peer_device->statistics.peer_dev_uuid_flags & UUID_FLAG_STABLE)
-				return true;
-		}
+		peer_device = connection_find_peer_device(connection, device->ctx.ctx_volume);
+		if (peer_device &&
+				peer_device->info.peer_disk_state == D_UP_TO_DATE &&
+				peer_device->statistics.peer_dev_uuid_flags & UUID_FLAG_STABLE)
+			return true;
 	}
 
 	return false;
@@ -517,11 +842,6 @@ static bool have_primary(struct resources_list *resource)
 	return false;
 }
 
-struct promotion_info {
-	bool may_promote;
-	int promotion_score;
-};
-
 static struct promotion_info compute_promotion_info(struct resources_list *resource)
 {
 	struct promotion_info info = {false, 0};
@@ -585,7 +905,49 @@ static struct promotion_info compute_promotion_info(struct resources_list *resou
 	return info;
 }
 
-static void print_resource_changes(const char *prefix, const char *action_new, struct resources_list *old_resource, struct resources_list *new_resource)
+/* The promotion info only depends on the roles, the disk states and the
+ * quorum, so most updates, such as resync progress, leave it unchanged */
+static bool promotion_inputs_changed(struct resource_update *update)
+{
+	struct resources_list *resource = update->resource;
+	struct resources_list *old_resource = update->old_resource;
+	struct devices_list *device;
+	struct connections_list *connection;
+	struct peer_devices_list *peer_device;
+
+	if (!old_resource ||
+			resource->info.res_role != old_resource->info.res_role ||
+			resource->info.res_fail_io != old_resource->info.res_fail_io)
+		return true;
+
+	if (update->destroyed_devices || update->destroyed_connections || update->destroyed_peer_devices)
+		return true;
+
+	for (device = update->updated_devices; device; device = device->next_updated) {
+		if (!device->old ||
+				device->info.dev_disk_state != device->old->info.dev_disk_state ||
+				device->info.dev_has_quorum != device->old->info.dev_has_quorum)
+			return true;
+	}
+
+	for (connection = update->updated_connections; connection; connection = connection->next_updated) {
+		if (!connection->old ||
+				connection->info.conn_role != connection->old->info.conn_role)
+			return true;
+	}
+
+	for (peer_device = update->updated_peer_devices; peer_device; peer_device = peer_device->next_updated) {
+		if (!peer_device->old ||
+				peer_device->info.peer_disk_state != peer_device->old->info.peer_disk_state ||
+				(peer_device->statistics.peer_dev_uuid_flags ^
+				 peer_device->old->statistics.peer_dev_uuid_flags) & UUID_FLAG_STABLE)
+			return true;
+	}
+
+	return false;
+}
+
+static void print_resource_changes(const char *prefix, const char *action_new, struct resources_list *old_resource, struct promotion_info *old_resource_promotion_info, struct resources_list *new_resource)
 {
 	struct promotion_info new_promotion_info;
 	struct promotion_info old_promotion_info = { 0 };
@@ -596,7 +958,7 @@ static void print_resource_changes(const char *prefix, const char *action_new, s
 	bool fail_io_changed;
 	bool renamed;
 
-	new_promotion_info = compute_promotion_info(new_resource);
+	new_promotion_info = new_resource->promotion_info;
 
 	role_changed = !old_resource || new_resource->info.res_role != old_resource->info.res_role;
 	info_changed = !old_resource ||
@@ -611,7 +973,7 @@ static void print_resource_changes(const char *prefix, const char *action_new, s
 		 memcmp(&new_resource->statistics, &old_resource->statistics, sizeof(struct resource_statistics)));
 
 	if (old_resource) {
-		old_promotion_info = compute_promotion_info(old_resource);
+		old_promotion_info = *old_resource_promotion_info;
 		promotion_info_changed = new_promotion_info.may_promote != old_promotion_info.may_promote ||
 			new_promotion_info.promotion_score != old_promotion_info.promotion_score;
 	} else {
@@ -914,86 +1276,65 @@ static void print_connection_changes(const char *prefix, const char *action_new,
 	printf("\n");
 }
 
-static void print_changes(const char *prefix, const char *action_new, struct resources_list *old_resource, struct resources_list *new_resource)
+static void print_changes(const char *prefix, const char *action_new, struct resource_update *update)
 {
-	struct devices_list *new_device, *old_device;
-	struct connections_list *new_connection, *old_connection;
-
-	print_resource_changes(prefix, action_new, old_resource, new_resource);
+	struct resources_list *resource = update->resource;
+	struct devices_list *device;
+	struct connections_list *connection;
+	struct peer_devices_list *peer_device;
+	struct paths_list *path;
 
-	for (new_connection = new_resource->connections; new_connection; new_connection = new_connection->next) {
-		old_connection = old_resource ? find_connection(old_resource, new_connection->ctx.ctx_conn_name) : NULL;
-		print_connection_changes(prefix, action_new, new_resource->name, new_connection, old_connection);
-	}
+	if (promotion_inputs_changed(update))
+		resource->promotion_info = compute_promotion_info(resource);
 
-	for (new_device = new_resource->devices; new_device; new_device = new_device->next) {
-		old_device = old_resource ? find_device(old_resource, new_device->ctx.ctx_volume) : NULL;
-		print_device_changes(prefix, action_new, new_resource->name, new_device, old_device);
-	}
+	print_resource_changes(prefix, action_new, update->old_resource, &update->old_promotion_info, resource);
 
-	for (new_connection = new_resource->connections; new_connection; new_connection = new_connection->next) {
-		struct peer_devices_list *new_peer_device, *old_peer_device;
-		struct paths_list *new_path, *old_path;
+	for (connection = update->updated_connections; connection; connection = connection->next_updated)
+		print_connection_changes(prefix, action_new, resource->name, connection, connection->old);
 
-		old_connection = old_resource ? find_connection(old_resource, new_connection->ctx.ctx_conn_name) : NULL;
+	for (device = update->updated_devices; device; device = device->next_updated)
+		print_device_changes(prefix, action_new, resource->name, device, device->old);
 
-		for (new_peer_device = new_connection->peer_devices; new_peer_device; new_peer_device = new_peer_device->next) {
-			old_peer_device = old_connection ? connection_find_peer_device(old_connection, new_peer_device->ctx.ctx_volume) : NULL;
-			print_peer_device_changes(prefix, action_new, new_resource->name, new_peer_device, old_peer_device);
-		}
+	for (peer_device = update->updated_peer_devices; peer_device; peer_device = peer_device->next_updated)
+		print_peer_device_changes(prefix, action_new, resource->name, peer_device, peer_device->old);
 
-		for (new_path = new_connection->paths; new_path; new_path = new_path->next) {
-			old_path = old_connection ? connection_find_path(old_connection, &new_path->ctx) : NULL;
-			print_path_changes(prefix, action_new, new_resource->name, new_path, old_path);
-		}
+	for (path = update->updated_paths; path; path = path->next_updated)
+		print_path_changes(prefix, action_new, resource->name, path, path->old);
 
-		for (old_path = old_connection ? old_connection->paths : NULL; old_path; old_path = old_path->next) {
-			struct paths_list *new_path = connection_find_path(new_connection, &old_path->ctx);
-			if (!new_path) {
-				char my_addr[ADDRESS_STR_MAX];
-				char peer_addr[ADDRESS_STR_MAX];
+	for (path = update->destroyed_paths; path; path = path->next) {
+		char my_addr[ADDRESS_STR_MAX];
+		char peer_addr[ADDRESS_STR_MAX];
 
-				if (!path_address_strs(&old_path->ctx, my_addr, peer_addr))
-					continue;
+		if (!path_address_strs(&path->ctx, my_addr, peer_addr))
+			continue;
 
-				printf("%s%s %s name:%s peer-node-id:%u conn-name:%s local:%s peer:%s\n",
-						prefix, action_destroy, object_path, new_resource->name,
-						old_path->ctx.ctx_peer_node_id, old_path->ctx.ctx_conn_name,
-						my_addr, peer_addr);
-			}
-		}
+		printf("%s%s %s name:%s peer-node-id:%u conn-name:%s local:%s peer:%s\n",
+				prefix, action_destroy, object_path, resource->name,
+				path->ctx.ctx_peer_node_id, path->ctx.ctx_conn_name,
+				my_addr, peer_addr);
+	}
 
-		for (old_peer_device = old_connection ? old_connection->peer_devices : NULL; old_peer_device; old_peer_device = old_peer_device->next) {
-			struct peer_devices_list *new_peer_device = connection_find_peer_device(new_connection, old_peer_device->ctx.ctx_volume);
-			if (!new_peer_device) {
-				printf("%s%s %s name:%s peer-node-id:%u conn-name:%s volume:%u\n",
-						prefix, action_destroy, object_peer_device, new_resource->name,
-						old_peer_device->ctx.ctx_peer_node_id, old_peer_device->ctx.ctx_conn_name,
-						old_peer_device->ctx.ctx_volume);
-			}
-		}
+	for (peer_device = update->destroyed_peer_devices; peer_device; peer_device = peer_device->next) {
+		printf("%s%s %s name:%s peer-node-id:%u conn-name:%s volume:%u\n",
+				prefix, action_destroy, object_peer_device, resource->name,
+				peer_device->ctx.ctx_peer_node_id, peer_device->ctx.ctx_conn_name,
+				peer_device->ctx.ctx_volume);
 	}
 
-	for (old_connection = old_resource ? old_resource->connections : NULL; old_connection; old_connection = old_connection->next) {
-		struct connections_list *new_connection = find_connection(new_resource, old_connection->ctx.ctx_conn_name);
-		if (!new_connection) {
-			printf("%s%s %s name:%s peer-node-id:%u conn-name:%s\n",
-					prefix, action_destroy, object_connection, new_resource->name,
-					old_connection->ctx.ctx_peer_node_id, old_connection->ctx.ctx_conn_name);
-		}
+	for (connection = update->destroyed_connections; connection; connection = connection->next) {
+		printf("%s%s %s name:%s peer-node-id:%u conn-name:%s\n",
+				prefix, action_destroy, object_connection, resource->name,
+				connection->ctx.ctx_peer_node_id, connection->ctx.ctx_conn_name);
 	}
 
-	for (old_device = old_resource ? old_resource->devices : NULL; old_device; old_device = old_device->next) {
-		struct devices_list *new_device = find_device(new_resource, old_device->ctx.ctx_volume);
-		if (!new_device) {
-			printf("%s%s %s name:%s volume:%u\n",
-					prefix, action_destroy, object_device, new_resource->name,
-					old_device->ctx.ctx_volume);
-		}
+	for (device = update->destroyed_devices; device; device = device->next) {
+		printf("%s%s %s name:%s volume:%u\n",
+				prefix, action_destroy, object_device, resource->name,
+				device->ctx.ctx_volume);
 	}
 
-	if (new_resource->destroyed) {
-		printf("%s%s %s name:%s\n", prefix, action_destroy, object_resource, new_resource->name);
+	if (resource->destroyed) {
+		printf("%s%s %s name:%s\n", prefix, action_destroy, object_resource, resource->name);
 	}
 }
 
@@ -1064,19 +1405,149 @@ static void print_helper(const char *timestamp_prefix, struct drbd_cfg_context *
 	printf("\n");
 }
 
-/* singly-linked list entry with a netlink message */
+/* Messages that cannot be applied yet because messages with lower sequence
+ * numbers are missing are kept in a min-heap ordered by sequence number. If a
+ * missing message does not arrive within REORDER_GAP_TIMEOUT_MS, or if more
+ * than REORDER_CAPACITY messages are waiting for it, it is given up and the
+ * waiting messages are applied. The receive loop polls no longer than
+ * events2_gap_timeout_ms() so that this also happens when no further messages
+ * arrive. */
+#define REORDER_CAPACITY 4096
+#define REORDER_GAP_TIMEOUT_MS 1000
+
 struct nlmsg_entry {
-	struct nlmsg_entry *next;
 	struct nlmsghdr *nlh;
+	uint64_t arrival_ms;
 };
 
-/* copy an entire netlink message */
-static struct nlmsg_entry *nlmsg_copy(struct genl_info *info)
+struct reorder_buffer {
+	struct nlmsg_entry *entries;
+	unsigned int count;
+	unsigned int size;
+	uint32_t next_seq; /* nlmsg_seq of the next message to apply */
+	bool next_seq_known;
+	uint32_t highest_seq; /* highest nlmsg_seq received so far */
+	uint64_t oldest_arrival_ms; /* arrival of the longest waiting message */
+	bool oldest_arrival_known;
+};
+
+static struct reorder_buffer reorder_buffer;
+
+/* counters shown with --statistics */
+struct events2_statistics {
+	unsigned int reordered; /* messages that arrived out of order */
+	unsigned int gaps; /* missing messages that were given up on */
+	unsigned int resyncs; /* new initial states after receive buffer overruns */
+};
+
+static struct events2_statistics events2_statistics;
+static struct events2_statistics printed_statistics;
+
+static uint64_t monotonic_ms(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static bool seq_a_less_or_equal_b(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b) <= 0;
+}
+
+static bool seq_a_less_b(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b) < 0;
+}
+
+static void swap_entries(struct nlmsg_entry *a, struct nlmsg_entry *b)
+{
+	struct nlmsg_entry tmp = *a;
+	*a = *b;
+	*b = tmp;
+}
+
+/* copy an entire netlink message into the buffer */
+static void reorder_buffer_push(struct reorder_buffer *buffer, struct genl_info *info)
+{
+	struct nlmsg_entry *entries = buffer->entries;
+	unsigned int i;
+
+	if (buffer->count == buffer->size) {
+		buffer->size = buffer->size ? buffer->size * 2 : 16;
+		buffer->entries = realloc(buffer->entries, buffer->size * sizeof(*buffer->entries));
+		entries = buffer->entries;
+	}
+
+	i = buffer->count++;
+	entries[i].nlh = malloc(info->nlhdr->nlmsg_len);
+	memcpy(entries[i].nlh, info->nlhdr, info->nlhdr->nlmsg_len);
+	entries[i].arrival_ms = monotonic_ms();
+
+	/* later messages never arrived earlier than the ones already waiting */
+	if (i == 0) {
+		buffer->oldest_arrival_ms = entries[i].arrival_ms;
+		buffer->oldest_arrival_known = true;
+	}
+
+	while (i > 0) {
+		unsigned int parent = (i - 1) / 2;
+
+		if (!seq_a_less_b(entries[i].nlh->nlmsg_seq, entries[parent].nlh->nlmsg_seq))
+			break;
+		swap_entries(&entries[i], &entries[parent]);
+		i = parent;
+	}
+}
+
+static struct nlmsg_entry reorder_buffer_pop(struct reorder_buffer *buffer)
+{
+	struct nlmsg_entry *entries = buffer->entries;
+	struct nlmsg_entry first = entries[0];
+	unsigned int i = 0;
+
+	entries[0] = entries[--buffer->count];
+	if (first.arrival_ms == buffer->oldest_arrival_ms)
+		buffer->oldest_arrival_known = false;
+
+	for (;;) {
+		unsigned int left = 2 * i + 1;
+		unsigned int right = left + 1;
+		unsigned int smallest = i;
+
+		if (left < buffer->count &&
+				seq_a_less_b(entries[left].nlh->nlmsg_seq, entries[smallest].nlh->nlmsg_seq))
+			smallest = left;
+		if (right < buffer->count &&
+				seq_a_less_b(entries[right].nlh->nlmsg_seq, entries[smallest].nlh->nlmsg_seq))
+			smallest = right;
+		if (smallest == i)
+			break;
+		swap_entries(&entries[i], &entries[smallest]);
+		i = smallest;
+	}
+
+	return first;
+}
+
+/* Messages leave the heap in sequence order rather than in arrival order, so
+ * the arrival time of the longest waiting message is searched again after that
+ * message has been applied. */
+static uint64_t reorder_buffer_oldest_arrival(struct reorder_buffer *buffer)
 {
-	struct nlmsg_entry *entry = calloc(1, sizeof(struct nlmsg_entry));
-	entry->nlh = malloc(info->nlhdr->nlmsg_len);
-	memcpy(entry->nlh, info->nlhdr, info->nlhdr->nlmsg_len);
-	return entry;
+	unsigned int i;
+
+	if (!buffer->oldest_arrival_known) {
+		buffer->oldest_arrival_ms = buffer->entries[0].arrival_ms;
+		for (i = 1; i < buffer->count; i++) {
+			if (buffer->entries[i].arrival_ms < buffer->oldest_arrival_ms)
+				buffer->oldest_arrival_ms = buffer->entries[i].arrival_ms;
+		}
+		buffer->oldest_arrival_known = true;
+	}
+
+	return buffer->oldest_arrival_ms;
 }
 
 static int apply_stored_event(const char *timestamp_prefix, struct nlmsg_entry *entry)
@@ -1094,35 +1565,139 @@ static int apply_stored_event(const char *timestamp_prefix, struct nlmsg_entry *
 	err = drbd_tla_parse(stored_info.attrs, entry->nlh);
 	if (err) {
 		fprintf(stderr, "drbd_tla_parse() failed");
+		free(entry->nlh);
 		return 1;
 	}
 
 	err = apply_event(timestamp_prefix, &stored_info);
 
 	free(entry->nlh);
-	free(entry);
 
 	return err;
 }
 
-static bool seq_a_less_or_equal_b(uint32_t a, uint32_t b)
+static void print_events2_statistics(const char *timestamp_prefix)
 {
-	return (int32_t)a - (int32_t)b <= 0;
+	struct events2_statistics *s = &events2_statistics;
+
+	if (!memcmp(s, &printed_statistics, sizeof(*s)))
+		return;
+
+	printf("%s%s %s reordered:%u gaps:%u resyncs:%u\n", timestamp_prefix, action_change,
+			object_events2, s->reordered, s->gaps, s->resyncs);
+	fflush(stdout);
+	printed_statistics = *s;
 }
 
-int print_event(const struct drbd_cmd *cm, struct genl_info *info, void *u_ptr)
+/* An object that is still stale when the new initial state is complete no
+ * longer exists. Paths are not marked, because DRBD does not send initial
+ * exists messages for them. */
+static void mark_stale(const void *nodep, VISIT which, int depth)
 {
-	static uint32_t next_seq; /* nlmsg_seq of the next message to apply */
-	static bool next_seq_known;
-	static struct nlmsg_entry *stored_messages = NULL;
-	static struct nlmsg_entry **tail_next = &stored_messages;
+	struct resources_list *resource = *(struct resources_list **)nodep;
+	struct devices_list *device;
+	struct connections_list *connection;
+	struct peer_devices_list *peer_device;
+
+	if (which != postorder && which != leaf)
+		return;
+
+	resource->stale = true;
+	for (device = resource->devices; device; device = device->next)
+		device->stale = true;
+	for (connection = resource->connections; connection; connection = connection->next) {
+		connection->stale = true;
+		for (peer_device = connection->peer_devices; peer_device; peer_device = peer_device->next)
+			peer_device->stale = true;
+	}
+}
+
+static struct resource_update *get_update_resource(struct resources_list *resource)
+{
+	return resource->update ? resource->update : store_update_resource(resource, false);
+}
+
+static void delete_stale(const void *nodep, VISIT which, int depth)
+{
+	struct resources_list *resource = *(struct resources_list **)nodep;
+	struct devices_list *device, *next_device;
+	struct connections_list *connection, *next_connection;
+	struct peer_devices_list *peer_device, *next_peer_device;
+
+	if (which != postorder && which != leaf)
+		return;
+
+	for (device = resource->devices; device; device = next_device) {
+		next_device = device->next;
+		if (device->stale)
+			delete_device(get_update_resource(resource), device->ctx.ctx_volume);
+	}
+
+	for (connection = resource->connections; connection; connection = next_connection) {
+		next_connection = connection->next;
+		if (connection->stale) {
+			delete_connection(get_update_resource(resource), connection->ctx.ctx_conn_name);
+			continue;
+		}
+
+		for (peer_device = connection->peer_devices; peer_device; peer_device = next_peer_device) {
+			next_peer_device = peer_device->next;
+			if (peer_device->stale)
+				delete_peer_device(get_update_resource(resource), &peer_device->ctx);
+		}
+	}
+
+	if (resource->stale) {
+		get_update_resource(resource);
+		resource->destroyed = true;
+	}
+}
+
+/* Apply the waiting messages in order according to their nlmsg_seq values.
+ * Give up on a missing message once the messages waiting for it have waited
+ * for REORDER_GAP_TIMEOUT_MS, or when there are too many of them. */
+static int reorder_buffer_release(struct reorder_buffer *buffer, const char *timestamp_prefix)
+{
+	uint64_t now = monotonic_ms();
+	int err;
 
+	while (buffer->count) {
+		struct nlmsg_entry entry;
+		uint32_t seq = buffer->entries[0].nlh->nlmsg_seq;
+
+		/* if the first messages were out-of-order, seq may decrease */
+		if (!seq_a_less_or_equal_b(seq, buffer->next_seq)) {
+			if (buffer->count <= REORDER_CAPACITY &&
+					now - reorder_buffer_oldest_arrival(buffer) < REORDER_GAP_TIMEOUT_MS)
+				break;
+
+			buffer->next_seq = seq;
+			events2_statistics.gaps++;
+		}
+
+		if (seq == buffer->next_seq)
+			buffer->next_seq++;
+
+		entry = reorder_buffer_pop(buffer);
+		err = apply_stored_event(timestamp_prefix, &entry);
+		if (err)
+			return err;
+	}
+
+	if (opt_statistics)
+		print_events2_statistics(timestamp_prefix);
+
+	return 0;
+}
+
+int print_event(const struct drbd_cmd *cm, struct genl_info *info, void *u_ptr)
+{
+	struct reorder_buffer *buffer = &reorder_buffer;
 	struct drbd_notification_header nh = { .nh_type = -1U };
 	enum drbd_notification_type action;
 	struct drbd_genlmsghdr *dh;
 	int err;
 	char timestamp_prefix[TIMESTAMP_LEN];
-	struct nlmsg_entry *entry, **iter_prev_next;
 
 	if (!info)
 		return 0;
@@ -1142,60 +1717,77 @@ int print_event(const struct drbd_cmd *cm, struct genl_info *info, void *u_ptr)
 	if (err)
 		exit(20);
 
+	/* ignore the rest of an initial state that was superseded by a resync */
+	if (receive_resync && info->nlhdr->nlmsg_seq != resync_seq &&
+			(info->genlhdr->cmd == DRBD_INITIAL_STATE_DONE || action == NOTIFY_EXISTS))
+		return 0;
+
 	if (info->genlhdr->cmd == DRBD_INITIAL_STATE_DONE) {
+		if (receive_resync) {
+			twalk(all_resources, delete_stale);
+			commit_updates(timestamp_prefix);
+		}
+
 		if (initial_state)
 			printf("%s%s -\n", timestamp_prefix, action_exists);
+		if (receive_resync)
+			printf("%s%s -\n", timestamp_prefix, action_resync);
 		fflush(stdout);
 
 		initial_state = false;
 		receive_update = false;
+		receive_resync = false;
 	} else if (action == NOTIFY_EXISTS) {
 		/* apply initial state "exists" messages immediately */
 		return apply_event(timestamp_prefix, info);
 	} else {
 		uint32_t seq = info->nlhdr->nlmsg_seq;
-		struct nlmsg_entry *entry = nlmsg_copy(info);
 
-		if (!next_seq_known) {
-			next_seq = seq;
-			next_seq_known = true;
+		if (!buffer->next_seq_known) {
+			buffer->next_seq = seq;
+			buffer->highest_seq = seq;
+			buffer->next_seq_known = true;
+		} else if (seq_a_less_b(seq, buffer->highest_seq)) {
+			events2_statistics.reordered++;
+		} else {
+			buffer->highest_seq = seq;
 		}
 
-		*tail_next = entry;
-		tail_next = &entry->next;
+		reorder_buffer_push(buffer, info);
 	}
 
 	if (initial_state || receive_update)
 		return 0;
 
-	/* apply messages in order according to their nlmsg_seq values */
-restart:
-	iter_prev_next = &stored_messages;
-	entry = stored_messages;
-	while (entry) {
-		/* if the first messages were out-of-order, seq may decrease */
-		if (seq_a_less_or_equal_b(entry->nlh->nlmsg_seq, next_seq)) {
-			if (tail_next == &entry->next) /* tail element will be freed */
-				tail_next = iter_prev_next;
+	return reorder_buffer_release(buffer, timestamp_prefix);
+}
+
+/* Print the changes of the complete updates and fold them into the master copy */
+static void commit_updates(const char *prefix)
+{
+	struct resource_update *update, *next_update;
 
-			if (entry->nlh->nlmsg_seq == next_seq)
-				next_seq++;
+	for (update = update_resources; update; update = next_update) {
+		struct resources_list *resource = update->resource;
+		bool renamed;
 
-			/* remove entry from list */
-			*iter_prev_next = entry->next;
+		/* the name is the key in the master copy and is changed when the rename is printed */
+		renamed = resource->rename_info.res_new_name_len > 0;
+		if (resource->destroyed || renamed)
+			delete_resource(resource);
 
-			err = apply_stored_event(timestamp_prefix, entry);
-			if (err)
-				return err;
+		print_changes(prefix, initial_state ? action_exists : action_create, update);
 
-			goto restart;
-		} else {
-			iter_prev_next = &entry->next;
-			entry = entry->next;
+		next_update = update->next;
+		free_resource_update(update);
+		if (resource->destroyed) {
+			free_resource(resource);
+		} else if (renamed) {
+			store_resource(resource);
 		}
 	}
 
-	return 0;
+	update_resources = NULL;
 }
 
 static int apply_event(const char *prefix, struct genl_info *info)
@@ -1205,8 +1797,9 @@ static int apply_event(const char *prefix, struct genl_info *info)
 	enum drbd_notification_type action;
 	struct drbd_cfg_context ctx = { .ctx_volume = -1U, .ctx_peer_node_id = -1U, };
 	bool is_resource_create;
-	struct resources_list *new_resource;
-	struct resources_list *old_resource;
+	bool resync_exists;
+	struct resource_update *update;
+	struct resources_list *resource;
 	struct devices_list *device;
 	struct connections_list *connection;
 	struct peer_devices_list *peer_device;
@@ -1217,6 +1810,10 @@ static int apply_event(const char *prefix, struct genl_info *info)
 		return 0;
 	action = nh.nh_type & ~NOTIFY_FLAGS;
 
+	/* the initial state after an overrun may contain objects that were
+	 * created while messages were lost */
+	resync_exists = action == NOTIFY_EXISTS && receive_resync;
+
 	if (action == NOTIFY_EXISTS && receive_update)
 		action = NOTIFY_CHANGE; /* exists messages are actually updates */
 
@@ -1224,33 +1821,32 @@ static int apply_event(const char *prefix, struct genl_info *info)
 	if (err)
 		return 0;
 
-	is_resource_create = info->genlhdr->cmd == DRBD_RESOURCE_STATE &&
-		(action == NOTIFY_CREATE || action == NOTIFY_EXISTS);
+	/* resources that are created by the current update are already in the
+	 * master copy */
+	resource = find_resource(ctx.ctx_resource_name);
+	update = resource ? resource->update : NULL;
 
-	/* look for the resource in the current update */
-	for (new_resource = update_resources; new_resource; new_resource = new_resource->next) {
-		if (!strcmp(new_resource->name, ctx.ctx_resource_name))
-			break;
-	}
-	/* look for the resource in the master copy */
-	old_resource = find_resource(ctx.ctx_resource_name);
+	is_resource_create = info->genlhdr->cmd == DRBD_RESOURCE_STATE &&
+		(action == NOTIFY_CREATE || action == NOTIFY_EXISTS || (resync_exists && !resource));
 
 	if (is_resource_create) {
-		if (new_resource || old_resource)
+		if (resource)
 			return 0;
 
-		new_resource = new_resource_from_info(info);
-		store_update_resource(new_resource);
-	} else if (!new_resource) {
-		if (!old_resource)
+		resource = new_resource_from_info(info);
+		store_resource(resource);
+		update = store_update_resource(resource, true);
+	} else if (!update) {
+		if (!resource)
 			return 0;
 
-		new_resource = deep_copy_resource(old_resource);
-		store_update_resource(new_resource);
+		update = store_update_resource(resource, false);
 	}
 
-	new_resource->rename_info.res_new_name[0] = '\0';
-	new_resource->rename_info.res_new_name_len = 0;
+	resource->rename_info.res_new_name[0] = '\0';
+	resource->rename_info.res_new_name_len = 0;
+	if (info->genlhdr->cmd == DRBD_RESOURCE_STATE)
+		resource->stale = false;
 
 	switch (action) {
 	case NOTIFY_EXISTS:
@@ -1261,19 +1857,19 @@ static int apply_event(const char *prefix, struct genl_info *info)
 			break;
 		case DRBD_DEVICE_STATE:
 			device = new_device_from_info(info);
-			store_device_check(new_resource, device);
+			store_device_check(update, device);
 			break;
 		case DRBD_CONNECTION_STATE:
 			connection = new_connection_from_info(info);
-			store_connection_check(new_resource, connection);
+			store_connection_check(update, connection);
 			break;
 		case DRBD_PEER_DEVICE_STATE:
 			peer_device = new_peer_device_from_info(info);
-			store_peer_device_check(new_resource, peer_device);
+			store_peer_device_check(update, peer_device);
 			break;
 		case DRBD_PATH_STATE:
 			path = new_path_from_info(info);
-			store_path_check(new_resource, path);
+			store_path_check(update, path);
 			break;
 		default:
 			dbg(1, "unknown exists/create notification %d\n", info->genlhdr->cmd);
@@ -1283,14 +1879,19 @@ static int apply_event(const char *prefix, struct genl_info *info)
 	case NOTIFY_CHANGE:
 		switch(info->genlhdr->cmd) {
 		case DRBD_RESOURCE_STATE:
-			resource_info_from_attrs(&new_resource->info, info);
-			memset(&new_resource->statistics, -1, sizeof(new_resource->statistics));
-			resource_statistics_from_attrs(&new_resource->statistics, info);
+			resource_info_from_attrs(&resource->info, info);
+			memset(&resource->statistics, -1, sizeof(resource->statistics));
+			resource_statistics_from_attrs(&resource->statistics, info);
 			break;
 		case DRBD_DEVICE_STATE:
-			device = find_device(new_resource, ctx.ctx_volume);
-			if (!device)
+			device = find_device(resource, ctx.ctx_volume);
+			if (!device) {
+				if (resync_exists)
+					store_device_check(update, new_device_from_info(info));
 				break;
+			}
+			device->stale = false;
+			device_before_change(update, device);
 			disk_conf_from_attrs(&device->disk_conf, info);
 			device->info.dev_disk_state = D_DISKLESS;
 			device->info.is_intentional_diskless = IS_INTENTIONAL_DEF;
@@ -1300,17 +1901,27 @@ static int apply_event(const char *prefix, struct genl_info *info)
 			device_statistics_from_attrs(&device->statistics, info);
 			break;
 		case DRBD_CONNECTION_STATE:
-			connection = find_connection(new_resource, ctx.ctx_conn_name);
-			if (!connection)
+			connection = find_connection(resource, ctx.ctx_conn_name);
+			if (!connection) {
+				if (resync_exists)
+					store_connection_check(update, new_connection_from_info(info));
 				break;
+			}
+			connection->stale = false;
+			connection_before_change(update, connection);
 			connection_info_from_attrs(&connection->info, info);
 			memset(&connection->statistics, -1, sizeof(connection->statistics));
 			connection_statistics_from_attrs(&connection->statistics, info);
 			break;
 		case DRBD_PEER_DEVICE_STATE:
-			peer_device = find_peer_device(new_resource, &ctx);
-			if (!peer_device)
+			peer_device = find_peer_device(resource, &ctx);
+			if (!peer_device) {
+				if (resync_exists)
+					store_peer_device_check(update, new_peer_device_from_info(info));
 				break;
+			}
+			peer_device->stale = false;
+			peer_device_before_change(update, peer_device);
 			peer_device->info.peer_is_intentional_diskless = IS_INTENTIONAL_DEF;
 			peer_device_info_from_attrs(&peer_device->info, info);
 			memset(&peer_device->statistics, -1, sizeof(peer_device->statistics));
@@ -1320,12 +1931,13 @@ static int apply_event(const char *prefix, struct genl_info *info)
 			/* DRBD does not send initial exists messages for paths
 			 * so we have to be prepared for changes to unknown
 			 * paths */
-			path = find_path(new_resource, &ctx);
+			path = find_path(resource, &ctx);
 			if (path) {
+				path_before_change(update, path);
 				drbd_path_info_from_attrs(&path->info, info);
 			} else {
 				path = new_path_from_info(info);
-				store_path_check(new_resource, path);
+				store_path_check(update, path);
 			}
 			break;
 		default:
@@ -1337,22 +1949,22 @@ static int apply_event(const char *prefix, struct genl_info *info)
 	case NOTIFY_DESTROY:
 		switch(info->genlhdr->cmd) {
 		case DRBD_RESOURCE_STATE:
-			new_resource->destroyed = true;
+			resource->destroyed = true;
 			break;
 		case DRBD_DEVICE_STATE:
-			delete_device(new_resource, ctx.ctx_volume);
+			delete_device(update, ctx.ctx_volume);
 			break;
 		case DRBD_CONNECTION_STATE:
-			delete_connection(new_resource, ctx.ctx_conn_name);
+			delete_connection(update, ctx.ctx_conn_name);
 			break;
 		case DRBD_PEER_DEVICE_STATE:
-			delete_peer_device(new_resource, &ctx);
+			delete_peer_device(update, &ctx);
 			break;
 		case DRBD_PATH_STATE:
 			/* DRBD does not send initial exists messages for paths
 			 * so we have to be prepared for destroy messages for
 			 * unknown paths */
-			delete_path(new_resource, &ctx);
+			delete_path(update, &ctx);
 			break;
 		default:
 			dbg(1, "unknown destroy notification %d\n", info->genlhdr->cmd);
@@ -1383,7 +1995,7 @@ static int apply_event(const char *prefix, struct genl_info *info)
         case NOTIFY_RENAME:
 		switch(info->genlhdr->cmd) {
 			case DRBD_RESOURCE_STATE:
-				rename_resource_info_from_attrs(&new_resource->rename_info, info);
+				rename_resource_info_from_attrs(&resource->rename_info, info);
 				break;
                 }
                 break;
@@ -1392,29 +2004,8 @@ static int apply_event(const char *prefix, struct genl_info *info)
 		goto out;
 	}
 
-	if (!(nh.nh_type & NOTIFY_CONTINUES)) {
-		struct resources_list *next_resource;
-
-		for (new_resource = update_resources; new_resource; new_resource = next_resource) {
-			struct resources_list *old_resource = find_resource(new_resource->name);
-
-			print_changes(prefix, initial_state ? action_exists : action_create, old_resource, new_resource);
-
-			if (old_resource) {
-				delete_resource(old_resource);
-				free_resource(old_resource);
-			}
-
-			next_resource = new_resource->next;
-			if (new_resource->destroyed) {
-				free_resource(new_resource);
-			} else {
-				store_resource(new_resource);
-			}
-		}
-
-		update_resources = NULL;
-	}
+	if (!(nh.nh_type & NOTIFY_CONTINUES))
+		commit_updates(prefix);
 
 out:
 	fflush(stdout);
@@ -1432,10 +2023,95 @@ void events2_prepare_update()
 typedef void (*__free_fn_t) (void *__nodep);
 #endif
 
+/* Messages were lost because the receive buffer of the socket overran, and a
+ * new initial state was requested with sequence number seq. Its "exists"
+ * messages are compared to the known state, so that only the net changes
+ * are printed; objects that it does not contain are destroyed. */
+/* Milliseconds until a missing message is given up on, or -1 if no messages
+ * are waiting. */
+int events2_gap_timeout_ms(void)
+{
+	struct reorder_buffer *buffer = &reorder_buffer;
+	uint64_t waited;
+
+	if (!buffer->count || initial_state || receive_update)
+		return -1;
+
+	waited = monotonic_ms() - reorder_buffer_oldest_arrival(buffer);
+	return waited < REORDER_GAP_TIMEOUT_MS ? REORDER_GAP_TIMEOUT_MS - waited : 0;
+}
+
+/* Called when the poll timeout from events2_gap_timeout_ms() has expired. */
+int events2_gap_timeout_expired(void)
+{
+	char timestamp_prefix[TIMESTAMP_LEN];
+	int err;
+
+	if (initial_state || receive_update)
+		return 0;
+
+	err = format_timestamp(timestamp_prefix);
+	if (err)
+		exit(20);
+
+	return reorder_buffer_release(&reorder_buffer, timestamp_prefix);
+}
+
+void events2_resync(unsigned int seq)
+{
+	struct reorder_buffer *buffer = &reorder_buffer;
+
+	/* the new initial state supersedes the messages that are waiting */
+	while (buffer->count) {
+		struct nlmsg_entry entry = reorder_buffer_pop(buffer);
+		free(entry.nlh);
+	}
+	buffer->next_seq_known = false;
+
+	twalk(all_resources, mark_stale);
+	receive_update = true;
+	receive_resync = true;
+	resync_seq = seq;
+	events2_statistics.resyncs++;
+}
+
+/* Called when events were lost. Returns true if a new initial state is to be
+ * requested now. The kernel refuses a new dump request with EBUSY while a dump
+ * is in progress, so the request is then deferred until the end of that dump,
+ * see events2_dump_done(). */
+bool events2_overrun(bool dump_in_progress)
+{
+	if (dump_in_progress) {
+		resync_pending = true;
+		return false;
+	}
+	return true;
+}
+
+/* Called at the end of a dump. Returns true if a new initial state that was
+ * deferred by events2_overrun() is to be requested now. */
+bool events2_dump_done(void)
+{
+	bool request = resync_pending;
+
+	resync_pending = false;
+	return request;
+}
+
 /* Drop all data and start again with new initial state. */
 void events2_reset()
 {
+	struct resource_update *update, *next_update;
+
+	/* drop an incomplete update */
+	for (update = update_resources; update; update = next_update) {
+		next_update = update->next;
+		free_resource_update(update);
+	}
+	update_resources = NULL;
+
 	tdestroy(all_resources, (__free_fn_t) free_resource);
 	all_resources = NULL;
 	initial_state = true;
+	resync_pending = false;
 }
@@ -28,6 +28,7 @@
 
 #include <stdio.h>
 #include <getopt.h>
+#include <time.h>
 
 #include <netinet/in.h>
 
@@ -37,6 +38,9 @@
 #include "drbd_protocol.h"
 
 int print_event(struct drbd_cmd *cm, struct genl_info *info, void *u_ptr);
+void events2_resync(unsigned int seq);
+bool events2_overrun(bool dump_in_progress);
+bool events2_dump_done(void);
 
 extern struct genl_family drbd_genl_family;
 
@@ -50,10 +54,12 @@ static char *test_backing_dev_path = "/dev/sda";
 
 struct test_vars {
 	int msg_seq;
+	unsigned int resource_number;
 	int auto_promote;
 	unsigned int on_no_quorum;
 	unsigned int minor;
 	unsigned int volume_number;
+	unsigned int peer_node_id;
 	int diskless;
 	int inconsistent;
 	int has_quorum;
@@ -70,6 +76,30 @@ struct test_vars {
  * ################# Helper functions #################
  */
 
+/* The first resource keeps the plain resource name, so that existing tests are unaffected */
+static const char *test_res_name(struct test_vars *vars)
+{
+	static char res_name[32];
+
+	if (vars->resource_number == 0)
+		return test_resource_name;
+
+	snprintf(res_name, sizeof(res_name), "%s-%u", test_resource_name, vars->resource_number);
+	return res_name;
+}
+
+/* The default peer keeps the plain peer name, so that existing tests are unaffected */
+static const char *test_conn_name(struct test_vars *vars)
+{
+	static char conn_name[32];
+
+	if (vars->peer_node_id == test_peer_node_id)
+		return test_peer_name;
+
+	snprintf(conn_name, sizeof(conn_name), "%s-%u", test_peer_name, vars->peer_node_id);
+	return conn_name;
+}
+
 static char *backing_dev(__u32 disk_state)
 {
 	if (disk_state == D_UP_TO_DATE || disk_state == D_INCONSISTENT)
@@ -97,7 +127,7 @@ void test_notification_header(struct msg_buff *smsg, __u32 nh_type)
 void test_resource_context(struct msg_buff *smsg, struct test_vars *vars)
 {
 	struct nlattr *nla = nla_nest_start(smsg, DRBD_NLA_CFG_CONTEXT);
-	nla_put_string(smsg, T_ctx_resource_name, test_resource_name);
+	nla_put_string(smsg, T_ctx_resource_name, test_res_name(vars));
 	nla_nest_end(smsg, nla);
 }
 
@@ -131,7 +161,7 @@ void test_resource_statistics(struct msg_buff *smsg, struct test_vars *vars)
 void test_device_context(struct msg_buff *smsg, struct test_vars *vars)
 {
 	struct nlattr *nla = nla_nest_start(smsg, DRBD_NLA_CFG_CONTEXT);
-	nla_put_string(smsg, T_ctx_resource_name, test_resource_name);
+	nla_put_string(smsg, T_ctx_resource_name, test_res_name(vars));
 	nla_put_u32(smsg, T_ctx_volume, vars->volume_number);
 	nla_nest_end(smsg, nla);
 }
@@ -191,9 +221,9 @@ void test_device_statistics(struct msg_buff *smsg, struct test_vars *vars)
 void test_connection_context(struct msg_buff *smsg, struct test_vars *vars)
 {
 	struct nlattr *nla = nla_nest_start(smsg, DRBD_NLA_CFG_CONTEXT);
-	nla_put_string(smsg, T_ctx_resource_name, test_resource_name);
-	nla_put_string(smsg, T_ctx_conn_name, test_peer_name);
-	nla_put_u32(smsg, T_ctx_peer_node_id, test_peer_node_id);
+	nla_put_string(smsg, T_ctx_resource_name, test_res_name(vars));
+	nla_put_string(smsg, T_ctx_conn_name, test_conn_name(vars));
+	nla_put_u32(smsg, T_ctx_peer_node_id, vars->peer_node_id);
 	nla_nest_end(smsg, nla);
 }
 
@@ -225,9 +255,9 @@ void test_connection_statistics(struct msg_buff *smsg, struct test_vars *vars)
 void test_peer_device_context(struct msg_buff *smsg, struct test_vars *vars)
 {
 	struct nlattr *nla = nla_nest_start(smsg, DRBD_NLA_CFG_CONTEXT);
-	nla_put_string(smsg, T_ctx_resource_name, test_resource_name);
-	nla_put_string(smsg, T_ctx_conn_name, test_peer_name);
-	nla_put_u32(smsg, T_ctx_peer_node_id, test_peer_node_id);
+	nla_put_string(smsg, T_ctx_resource_name, test_res_name(vars));
+	nla_put_string(smsg, T_ctx_conn_name, test_conn_name(vars));
+	nla_put_u32(smsg, T_ctx_peer_node_id, vars->peer_node_id);
 	nla_put_u32(smsg, T_ctx_volume, vars->volume_number);
 	nla_nest_end(smsg, nla);
 }
@@ -294,9 +324,9 @@ void test_path_context(struct msg_buff *smsg, struct test_vars *vars)
 		.sin_addr = { .s_addr = 0x08070605 },
 	};
 	struct nlattr *nla = nla_nest_start(smsg, DRBD_NLA_CFG_CONTEXT);
-	nla_put_string(smsg, T_ctx_resource_name, test_resource_name);
-	nla_put_string(smsg, T_ctx_conn_name, test_peer_name);
-	nla_put_u32(smsg, T_ctx_peer_node_id, test_peer_node_id);
+	nla_put_string(smsg, T_ctx_resource_name, test_res_name(vars));
+	nla_put_string(smsg, T_ctx_conn_name, test_conn_name(vars));
+	nla_put_u32(smsg, T_ctx_peer_node_id, vars->peer_node_id);
 	nla_put(smsg, T_ctx_my_addr, sizeof(test_my_addr), &test_my_addr);
 	nla_put(smsg, T_ctx_peer_addr, sizeof(test_peer_addr), &test_peer_addr);
 	nla_nest_end(smsg, nla);
@@ -395,6 +425,15 @@ void test_device_destroy(struct msg_buff *smsg, struct test_vars *vars)
 	test_notification_header(smsg, NOTIFY_DESTROY);
 }
 
+void test_connection_exists(struct msg_buff *smsg, struct test_vars *vars)
+{
+	test_msg_put(smsg, DRBD_CONNECTION_STATE, -1U);
+	test_connection_context(smsg, vars);
+	test_notification_header(smsg, NOTIFY_EXISTS);
+	test_connection_info(smsg, vars, C_CONNECTED, R_SECONDARY);
+	test_connection_statistics(smsg, vars);
+}
+
 void test_connection_create(struct msg_buff *smsg, struct test_vars *vars)
 {
 	test_msg_put(smsg, DRBD_CONNECTION_STATE, -1U);
@@ -429,6 +468,15 @@ void test_connection_destroy(struct msg_buff *smsg, struct test_vars *vars)
 	test_notification_header(smsg, NOTIFY_DESTROY);
 }
 
+void test_peer_device_exists(struct msg_buff *smsg, struct test_vars *vars)
+{
+	test_msg_put(smsg, DRBD_PEER_DEVICE_STATE, -1U);
+	test_peer_device_context(smsg, vars);
+	test_notification_header(smsg, NOTIFY_EXISTS);
+	test_peer_device_info(smsg, vars, L_ESTABLISHED, D_UP_TO_DATE);
+	test_peer_device_statistics(smsg, vars, false);
+}
+
 void test_peer_device_create(struct msg_buff *smsg, struct test_vars *vars)
 {
 	test_msg_put(smsg, DRBD_PEER_DEVICE_STATE, -1U);
@@ -573,7 +621,7 @@ static struct genl_info nlmsghdr_to_genl_info(struct nlmsghdr *nlh, struct nlatt
 	} \
 } while (0)
 
-int test_build_msg(struct msg_buff *smsg, char *msg_name, struct test_vars *vars)
+int test_build_msg(struct msg_buff *smsg, const char *msg_name, struct test_vars *vars)
 {
 	TEST_MSG(initial_state_done);
 	TEST_MSG(resource_exists);
@@ -584,10 +632,12 @@ int test_build_msg(struct msg_buff *smsg, char *msg_name, struct test_vars *vars
 	TEST_MSG(device_create);
 	TEST_MSG(device_change);
 	TEST_MSG(device_destroy);
+	TEST_MSG(connection_exists);
 	TEST_MSG(connection_create);
 	TEST_MSG(connection_change_connection);
 	TEST_MSG(connection_change_role);
 	TEST_MSG(connection_destroy);
+	TEST_MSG(peer_device_exists);
 	TEST_MSG(peer_device_create);
 	TEST_MSG(peer_device_change_replication);
 	TEST_MSG(peer_device_change_sync);
@@ -611,10 +661,12 @@ struct test_vars test_init_vars()
 {
 	struct test_vars vars = {
 		.msg_seq = -1,
+		.resource_number = 0,
 		.auto_promote = 1,
 		.on_no_quorum = 1,
 		.minor = test_minor,
 		.volume_number = test_volume_number,
+		.peer_node_id = test_peer_node_id,
 		.diskless = 0,
 		.inconsistent = 0,
 		.has_quorum = 1,
@@ -656,10 +708,12 @@ int test_parse_vars(char *input, char *msg_name, struct test_vars *vars)
 		input += consumed;
 
 		TEST_VAR(var_name, consumed, input, msg_seq, "%d")
+		TEST_VAR(var_name, consumed, input, resource_number, "%u")
 		TEST_VAR(var_name, consumed, input, auto_promote, "%d")
 		TEST_VAR(var_name, consumed, input, on_no_quorum, "%u")
 		TEST_VAR(var_name, consumed, input, minor, "%u")
 		TEST_VAR(var_name, consumed, input, volume_number, "%u")
+		TEST_VAR(var_name, consumed, input, peer_node_id, "%u")
 		TEST_VAR(var_name, consumed, input, diskless, "%d")
 		TEST_VAR(var_name, consumed, input, inconsistent, "%d")
 		TEST_VAR(var_name, consumed, input, has_quorum, "%d")
@@ -681,6 +735,8 @@ int test_parse_vars(char *input, char *msg_name, struct test_vars *vars)
 int test_events2()
 {
 	int next_msg_seq = 0;
+	/* the messages start with the reply to the initial state request */
+	bool dump_in_progress = true;
 	char input[MAX_INPUT_LENGTH];
 
 	while (fgets(input, MAX_INPUT_LENGTH, stdin)) {
@@ -700,6 +756,25 @@ int test_events2()
 		if (vars.msg_seq != -1)
 			next_msg_seq = vars.msg_seq;
 
+		/* messages were lost; msg_seq is that of the new initial state request */
+		if (!strcmp(msg_name, "overrun")) {
+			if (events2_overrun(dump_in_progress)) {
+				events2_resync(next_msg_seq);
+				dump_in_progress = true;
+			}
+			continue;
+		}
+
+		/* end of a dump reply; msg_seq is that of a deferred new initial state request */
+		if (!strcmp(msg_name, "nlmsg_done")) {
+			dump_in_progress = false;
+			if (events2_dump_done()) {
+				events2_resync(next_msg_seq);
+				dump_in_progress = true;
+			}
+			continue;
+		}
+
 		/* build msg as if sending */
 		smsg = msg_new(DEFAULT_MSG_SIZE);
 		err = test_build_msg(smsg, msg_name, &vars);
@@ -730,6 +805,146 @@ int test_events2()
 	return 0;
 }
 
+/*
+ * ################# events2 benchmark #################
+ */
+
+/* Returns a copy of the message in transfer format, which is much smaller than the message buffer */
+static struct nlmsghdr *test_bench_build_msg(const char *msg_name, struct test_vars *vars)
+{
+	struct msg_buff *smsg;
+	struct nlmsghdr *nlh;
+	struct nlmsghdr *copy;
+
+	/* build msg as if sending */
+	smsg = msg_new(DEFAULT_MSG_SIZE);
+	if (test_build_msg(smsg, msg_name, vars))
+		exit(1);
+
+	/* convert to transfer format */
+	nlh = (struct nlmsghdr *)smsg->data;
+	nlh->nlmsg_len = smsg->tail - smsg->data;
+	nlh->nlmsg_flags |= NLM_F_REQUEST;
+
+	copy = malloc(nlh->nlmsg_len);
+	if (!copy) {
+		fprintf(stderr, "Failed to allocate the benchmark messages\n");
+		exit(1);
+	}
+	memcpy(copy, nlh, nlh->nlmsg_len);
+	msg_free(smsg);
+
+	return copy;
+}
+
+static int test_bench_apply_msg(struct nlmsghdr *nlh, int msg_seq)
+{
+	struct drbd_cmd cm;
+	struct nlattr *tla[128];
+	struct genl_info info;
+
+	nlh->nlmsg_seq = msg_seq;
+
+	/* read message as if receiving */
+	info = nlmsghdr_to_genl_info(nlh, tla);
+
+	return print_event(&cm, &info, NULL);
+}
+
+static int test_bench_setup_msg(const char *msg_name, struct test_vars *vars, int msg_seq)
+{
+	struct nlmsghdr *nlh = test_bench_build_msg(msg_name, vars);
+	int err;
+
+	err = test_bench_apply_msg(nlh, msg_seq);
+	free(nlh);
+
+	return err;
+}
+
+/*
+ * Feeds recorded notifications for resources with many volumes and peers
+ * through print_event() and reports the cost per event on stderr.
+ */
+int test_bench_events2(unsigned int resources, unsigned int volumes, unsigned int peers, unsigned int iterations)
+{
+	unsigned long long workload_count = 2ULL * resources * volumes * peers;
+	struct nlmsghdr **workload_msgs;
+	struct test_vars vars;
+	struct timespec start, end;
+	unsigned long long elapsed_ns, events, w;
+	unsigned int i, r, v, p;
+	int msg_seq = 0;
+	int err;
+
+	workload_msgs = calloc(workload_count, sizeof(*workload_msgs));
+	if (!workload_msgs) {
+		fprintf(stderr, "Failed to allocate the benchmark messages\n");
+		exit(1);
+	}
+
+	vars = test_init_vars();
+	err = test_bench_setup_msg("initial_state_done", &vars, msg_seq++);
+	for (r = 0; r < resources && !err; r++) {
+		vars.resource_number = r;
+		err = test_bench_setup_msg("resource_create", &vars, msg_seq++);
+		for (v = 0; v < volumes && !err; v++) {
+			vars.volume_number = v;
+			vars.minor = test_minor + r * volumes + v;
+			err = test_bench_setup_msg("device_create", &vars, msg_seq++);
+		}
+		for (p = 0; p < peers && !err; p++) {
+			vars.peer_node_id = test_peer_node_id + p;
+			err = test_bench_setup_msg("connection_create", &vars, msg_seq++);
+			if (!err)
+				err = test_bench_setup_msg("path_create", &vars, msg_seq++);
+			for (v = 0; v < volumes && !err; v++) {
+				vars.volume_number = v;
+				vars.minor = test_minor + r * volumes + v;
+				err = test_bench_setup_msg("peer_device_create", &vars, msg_seq++);
+			}
+		}
+	}
+
+	/* a resync starts and finishes on every peer device */
+	w = 0;
+	for (r = 0; r < resources; r++) {
+		vars.resource_number = r;
+		for (p = 0; p < peers; p++) {
+			vars.peer_node_id = test_peer_node_id + p;
+			for (v = 0; v < volumes; v++) {
+				vars.volume_number = v;
+				vars.minor = test_minor + r * volumes + v;
+				workload_msgs[w++] = test_bench_build_msg("peer_device_change_sync", &vars);
+				workload_msgs[w++] = test_bench_build_msg("peer_device_change_replication", &vars);
+			}
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < iterations && !err; i++) {
+		for (w = 0; w < workload_count && !err; w++)
+			err = test_bench_apply_msg(workload_msgs[w], msg_seq++);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	fflush(stdout);
+
+	elapsed_ns = (end.tv_sec - start.tv_sec) * 1000000000ULL + end.tv_nsec - start.tv_nsec;
+	events = iterations * workload_count;
+	if (!err && events) {
+		fprintf(stderr, "resources:%u volumes:%u peers:%u events:%llu time:%llu.%09llus per-event:%lluns\n",
+				resources, volumes, peers, events,
+				elapsed_ns / 1000000000ULL, elapsed_ns % 1000000000ULL,
+				elapsed_ns / events);
+	}
+
+	for (w = 0; w < workload_count; w++)
+		free(workload_msgs[w]);
+	free(workload_msgs);
+
+	return err;
+}
+
 int generic_get_instrumented(const struct drbd_cmd *cm, int timeout_arg, void *u_ptr)
 {
 	char input[MAX_INPUT_LENGTH];
@@ -863,6 +1078,69 @@ int main_events2(int argc, char **argv)
 	return test_events2();
 }
 
+int main_bench_events2(int argc, char **argv)
+{
+	struct option options[] = {
+		{ "help", no_argument, 0, 'h' },
+		{ "resources", required_argument, 0, 'r' },
+		{ "volumes", required_argument, 0, 'v' },
+		{ "peers", required_argument, 0, 'p' },
+		{ "iterations", required_argument, 0, 'i' },
+		{ "statistics", no_argument, 0, 's' },
+		{ }
+	};
+	unsigned int resources = 1;
+	unsigned int volumes = 16;
+	unsigned int peers = 7;
+	unsigned int iterations = 1000;
+
+	opt_color = NEVER_COLOR;
+	for(;;) {
+		int c;
+		c = getopt_long(argc, argv, "hr:v:p:i:s", options, NULL);
+		if (c == -1)
+			break;
+		switch(c) {
+		default:
+		case 'h':
+		case '?':
+			fprintf(stderr, "drbdsetup_instrumented bench-events2 - Measure the cost of events2 notifications\n\n");
+			fprintf(stderr, "The events2 output is written to stdout, the timing to stderr.\n\n");
+			fprintf(stderr, "USAGE: drbdsetup_instrumented %s [options]\n", argv[0]);
+			fprintf(stderr, "    [--resources=1] [--volumes=16] [--peers=7] [--iterations=1000] [--statistics]\n");
+			return 1;
+
+		case 'r':
+			resources = strtoul(optarg, NULL, 10);
+			break;
+
+		case 'v':
+			volumes = strtoul(optarg, NULL, 10);
+			break;
+
+		case 'p':
+			peers = strtoul(optarg, NULL, 10);
+			break;
+
+		case 'i':
+			iterations = strtoul(optarg, NULL, 10);
+			break;
+
+		case 's':
+			++opt_verbose;
+			opt_statistics = true;
+			break;
+		}
+	}
+
+	if (!resources || !volumes || !peers) {
+		fprintf(stderr, "At least one resource, one volume and one peer are required\n");
+		return 1;
+	}
+
+	return test_bench_events2(resources, volumes, peers, iterations);
+}
+
 int main_generic_instrumented(int argc, char **argv)
 {
 	/* Prevent reading of version from /proc/drbd */
@@ -882,17 +1160,20 @@ int main_generic_instrumented(int argc, char **argv)
 int main(int argc, char **argv)
 {
 	if (argc < 2) {
-		fprintf(stderr, "USAGE: drbdsetup_instrumented {events2|show} [options]\n");
+		fprintf(stderr, "USAGE: drbdsetup_instrumented {events2|bench-events2|show} [options]\n");
 		return 1;
 	}
 
 	if (strcmp(argv[1], "events2") == 0)
 		return main_events2(argc - 1, argv + 1);
 
+	if (strcmp(argv[1], "bench-events2") == 0)
+		return main_bench_events2(argc - 1, argv + 1);
+
 	if (strcmp(argv[1], "show") == 0)
 		return main_generic_instrumented(argc, argv);
 
 	fprintf(stderr, "Unknown command '%s'\n", argv[1]);
-	fprintf(stderr, "USAGE: drbdsetup_instrumented {events2|show} [options]\n");
+	fprintf(stderr, "USAGE: drbdsetup_instrumented {events2|bench-events2|show} [options]\n");
 	return 1;
 }